@@ -0,0 +1,75 @@
+#ifndef CYTNX_CORE_BENCH_BENCH_H_
+#define CYTNX_CORE_BENCH_BENCH_H_
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cytnx_core {
+  namespace bench {
+
+    struct Options {
+      int warmup = 3;  // untimed repetitions before the timed ones
+      int reps = 15;  // timed repetitions
+      double min_rep_seconds = 2e-3;  // calls are batched until a repetition takes this long
+      std::vector<int> threads;  // thread counts to sweep
+      std::string filter;  // run the cases whose id contains this
+      std::string json;  // write the results here
+      bool list = false;  // print the case ids only
+      bool quick = false;  // the smallest sizes only, for smoke runs
+    };
+
+    using Params = std::vector<std::pair<std::string, std::string>>;
+
+    struct Result {
+      std::string id;  // name/key=value/...
+      std::string name;
+      Params params;
+      double flops;  // per call
+      double bytes;  // per call
+      int inner;  // calls per repetition
+      std::vector<double> seconds;  // per call, one per repetition
+      double min, median, mean, stddev;
+    };
+
+    /**
+     * @brief Times benchmark cases and collects their statistics.
+     *
+     * @details A case is run once to calibrate the number of calls per repetition, then warmed
+     * up, then timed for Options::reps repetitions. Rates are computed from the median.
+     */
+    class Runner {
+     public:
+      explicit Runner(const Options &options) : _options(options) {}
+
+      const Options &options() const { return _options; }
+
+      // whether the case would run; set up expensive inputs only when it does
+      bool selected(const std::string &name, const Params &params) const;
+
+      // time fn, which does flops and moves bytes per call
+      void run(const std::string &name, const Params &params, const double &flops,
+               const double &bytes, const std::function<void()> &fn);
+
+      const std::vector<Result> &results() const { return _results; }
+      std::string json() const;
+
+     private:
+      Options _options;
+      std::vector<Result> _results;
+    };
+
+    std::string make_id(const std::string &name, const Params &params);
+
+    // the suites, in bench_memory.cpp and bench_linalg.cpp
+    void bench_memory(Runner &runner);
+    void bench_linalg(Runner &runner);
+
+    // set the threads of the BLAS library, if it can be controlled
+    void set_blas_threads(const int &threads);
+
+  }  // namespace bench
+}  // namespace cytnx_core
+
+#endif  // CYTNX_CORE_BENCH_BENCH_H_
@@ -0,0 +1,410 @@
+// BLAS/LAPACK wrappers: GFLOP/s over sizes, dtypes and BLAS threads
+
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Counters.hpp>
+#include <cytnx_core/KrylovExpmv.hpp>
+#include <cytnx_core/LinOp.hpp>
+#include <cytnx_core/Type.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+#include <cytnx_core/SparseMatrix.hpp>
+#include <cytnx_core/linalg.hpp>
+
+#include "utils_internal/cpu/Eigh_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace bench {
+
+    namespace {
+      // the wrappers overloaded on the element type
+      void gemm(const blas_int &n, const double *a, const double *b, double *c) {
+        const double one = 1, zero = 0;
+        dgemm("N", "N", &n, &n, &n, &one, a, &n, b, &n, &zero, c, &n);
+      }
+      void gemm(const blas_int &n, const float *a, const float *b, float *c) {
+        const float one = 1, zero = 0;
+        sgemm("N", "N", &n, &n, &n, &one, a, &n, b, &n, &zero, c, &n);
+      }
+      void gemm(const blas_int &n, const cytnx_complex128 *a, const cytnx_complex128 *b,
+                cytnx_complex128 *c) {
+        const cytnx_complex128 one = 1, zero = 0;
+        zgemm("N", "N", &n, &n, &n, &one, a, &n, b, &n, &zero, c, &n);
+      }
+      void gemm(const blas_int &n, const cytnx_complex64 *a, const cytnx_complex64 *b,
+                cytnx_complex64 *c) {
+        const cytnx_complex64 one = 1, zero = 0;
+        cgemm("N", "N", &n, &n, &n, &one, a, &n, b, &n, &zero, c, &n);
+      }
+
+      void gemv(const blas_int &n, const double *a, const double *x, double *y) {
+        const double one = 1, zero = 0;
+        const blas_int inc = 1;
+        dgemv("N", &n, &n, &one, a, &n, x, &inc, &zero, y, &inc);
+      }
+      void gemv(const blas_int &n, const float *a, const float *x, float *y) {
+        const float one = 1, zero = 0;
+        const blas_int inc = 1;
+        sgemv("N", &n, &n, &one, a, &n, x, &inc, &zero, y, &inc);
+      }
+      void gemv(const blas_int &n, const cytnx_complex128 *a, const cytnx_complex128 *x,
+                cytnx_complex128 *y) {
+        const cytnx_complex128 one = 1, zero = 0;
+        const blas_int inc = 1;
+        zgemv("N", &n, &n, &one, a, &n, x, &inc, &zero, y, &inc);
+      }
+
+      // singular values and thin vectors of a square matrix, overwriting a
+      struct SvdWork {
+        vector<double> s, rwork;
+        vector<double> u, vt, work;
+        vector<cytnx_complex128> zu, zvt, zwork;
+      };
+      void gesvd(const blas_int &n, double *a, SvdWork &w) {
+        blas_int lwork = -1, info;
+        w.s.resize(n);
+        w.u.resize(size_t(n) * n);
+        w.vt.resize(size_t(n) * n);
+        if (w.work.empty()) {
+          double query;
+          dgesvd("S", "S", &n, &n, a, &n, w.s.data(), w.u.data(), &n, w.vt.data(), &n, &query,
+                 &lwork, &info);
+          w.work.resize(size_t(query));
+        }
+        lwork = w.work.size();
+        dgesvd("S", "S", &n, &n, a, &n, w.s.data(), w.u.data(), &n, w.vt.data(), &n,
+               w.work.data(), &lwork, &info);
+      }
+      void gesvd(const blas_int &n, cytnx_complex128 *a, SvdWork &w) {
+        blas_int lwork = -1, info;
+        w.s.resize(n);
+        w.rwork.resize(5 * size_t(n));
+        w.zu.resize(size_t(n) * n);
+        w.zvt.resize(size_t(n) * n);
+        if (w.zwork.empty()) {
+          cytnx_complex128 query;
+          zgesvd("S", "S", &n, &n, a, &n, w.s.data(), w.zu.data(), &n, w.zvt.data(), &n, &query,
+                 &lwork, w.rwork.data(), &info);
+          w.zwork.resize(size_t(query.real()));
+        }
+        lwork = w.zwork.size();
+        zgesvd("S", "S", &n, &n, a, &n, w.s.data(), w.zu.data(), &n, w.zvt.data(), &n,
+               w.zwork.data(), &lwork, w.rwork.data(), &info);
+      }
+
+      void geqrf(const blas_int &n, double *a, vector<double> &tau, vector<double> &work) {
+        blas_int lwork = -1, info;
+        tau.resize(n);
+        if (work.empty()) {
+          double query;
+          dgeqrf(&n, &n, a, &n, tau.data(), &query, &lwork, &info);
+          work.resize(size_t(query));
+        }
+        lwork = work.size();
+        dgeqrf(&n, &n, a, &n, tau.data(), work.data(), &lwork, &info);
+      }
+      void geqrf(const blas_int &n, cytnx_complex128 *a, vector<cytnx_complex128> &tau,
+                 vector<cytnx_complex128> &work) {
+        blas_int lwork = -1, info;
+        tau.resize(n);
+        if (work.empty()) {
+          cytnx_complex128 query;
+          zgeqrf(&n, &n, a, &n, tau.data(), &query, &lwork, &info);
+          work.resize(size_t(query.real()));
+        }
+        lwork = work.size();
+        zgeqrf(&n, &n, a, &n, tau.data(), work.data(), &lwork, &info);
+      }
+
+      // deterministic, well-conditioned enough inputs
+      template <class T>
+      vector<T> random_matrix(const cytnx_uint64 &elems) {
+        vector<T> a(elems);
+        std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+        for (auto &x : a) {
+          state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+          x = T(double(state >> 11) * 0x1.0p-53 - 0.5);
+        }
+        return a;
+      }
+
+      Params params_of(const char *dtype, const blas_int &n, const int &threads) {
+        return {{"dtype", dtype}, {"n", to_string(n)}, {"threads", to_string(threads)}};
+      }
+
+      template <class T>
+      void bench_gemm(Runner &runner, const char *dtype, const blas_int &n, const int &threads) {
+        const Params params = params_of(dtype, n, threads);
+        if (!runner.selected("gemm", params)) return;
+        const vector<T> a = random_matrix<T>(size_t(n) * n), b = random_matrix<T>(size_t(n) * n);
+        vector<T> c(size_t(n) * n);
+        runner.run("gemm", params, counters::flop_factor<T> * 2.0 * n * n * n,
+                   3.0 * n * n * sizeof(T), [&]() { gemm(n, a.data(), b.data(), c.data()); });
+      }
+
+      template <class T>
+      void bench_gemv(Runner &runner, const char *dtype, const blas_int &n, const int &threads) {
+        const Params params = params_of(dtype, n, threads);
+        if (!runner.selected("gemv", params)) return;
+        const vector<T> a = random_matrix<T>(size_t(n) * n), x = random_matrix<T>(n);
+        vector<T> y(n);
+        runner.run("gemv", params, counters::flop_factor<T> * 2.0 * n * n,
+                   (double(n) * n + 2.0 * n) * sizeof(T),
+                   [&]() { gemv(n, a.data(), x.data(), y.data()); });
+      }
+
+      // a^H * b through linalg::Matmul, with the adjoint folded into transa = 'C' or packed first
+      template <class T>
+      void bench_adjoint(Runner &runner, const unsigned int &dtype, const blas_int &n,
+                         const int &threads) {
+        for (const bool packed : {false, true}) {
+          Params params = params_of(Type.enum_name(dtype), n, threads);
+          params.push_back({"adjoint", packed ? "packed" : "lazy"});
+          if (!runner.selected("gemm_adjoint", params)) continue;
+          const vector<T> values = random_matrix<T>(size_t(n) * n);
+          Storage s(values.size(), dtype);
+          std::copy(values.begin(), values.end(), s.data<T>());
+          const StorageView a(s, {cytnx_uint64(n), cytnx_uint64(n)});
+          const StorageView ah = a.transpose(0, 1).conj();
+          runner.run("gemm_adjoint", params, counters::flop_factor<T> * 2.0 * n * n * n,
+                     3.0 * n * n * sizeof(T), [&]() {
+                       linalg::Matmul(packed ? ah.contiguous() : ah, a);
+                     });
+        }
+      }
+
+      // k vectors through a DenseLinOp, as one matmat() block (gemm) or k matvec() calls (gemv)
+      void bench_linop(Runner &runner, const blas_int &n, const int &threads) {
+        const cytnx_uint64 k = 16;
+        const vector<cytnx_double> values = random_matrix<cytnx_double>(size_t(n) * n);
+        Storage s(values.size(), Type.Double);
+        std::copy(values.begin(), values.end(), s.data<cytnx_double>());
+        const DenseLinOp op(StorageView(s, {cytnx_uint64(n), cytnx_uint64(n)}));
+        const StorageView x(Storage(n * k, Type.Double), {cytnx_uint64(n), k});
+        StorageView y(Storage(n * k, Type.Double), {cytnx_uint64(n), k});
+        vector<Storage> xs, ys;
+        for (cytnx_uint64 i = 0; i < k; i++) {
+          xs.emplace_back(n, Type.Double);
+          ys.emplace_back(n, Type.Double);
+        }
+        for (const bool block : {true, false}) {
+          Params params = params_of("Double", n, threads);
+          params.push_back({"k", to_string(k)});
+          params.push_back({"apply", block ? "block" : "vectors"});
+          if (!runner.selected("linop_block", params)) continue;
+          runner.run("linop_block", params, 2.0 * n * n * k, 8.0 * (double(n) * n + 2.0 * n * k),
+                     [&]() {
+                       if (block) {
+                         op.matmat(x, y);
+                       } else {
+                         for (cytnx_uint64 i = 0; i < k; i++) op.matvec(xs[i], ys[i]);
+                       }
+                     });
+        }
+      }
+
+      // the 5-point Laplacian of an L x L lattice, or its upper triangle
+      CooMatrix laplacian(const cytnx_uint64 &side, const bool &upper = false) {
+        const cytnx_uint64 n = side * side;
+        vector<cytnx_uint64> rows, cols;
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          for (const cytnx_uint64 j : {i, i + 1, i + side}) {
+            if (j >= n || (j == i + 1 && j % side == 0)) continue;
+            rows.push_back(i);
+            cols.push_back(j);
+            if (j == i || upper) continue;
+            rows.push_back(j);
+            cols.push_back(i);
+          }
+        }
+        Storage values(rows.size(), Type.Double);
+        for (cytnx_uint64 e = 0; e < rows.size(); e++)
+          values.data<cytnx_double>()[e] = rows[e] == cols[e] ? 4 : -1;
+        return CooMatrix(n, n, rows, cols, values);
+      }
+
+      // y = H x for the Laplacian, stored in full or as its upper half
+      void bench_spmv(Runner &runner, const cytnx_uint64 &side) {
+        const cytnx_uint64 n = side * side;
+        Storage x(n, Type.Double), y(n, Type.Double);
+        x.fill(1.0);
+        for (const bool half : {false, true}) {
+          const Params params = {{"n", to_string(n)}, {"storage", half ? "half" : "full"}};
+          if (!runner.selected("spmv", params)) continue;
+          const CsrMatrix h = laplacian(side, half)
+                                .to_csr(half ? SparseSymmetry::Symmetric : SparseSymmetry::General);
+          // 8 bytes of value and 8 of index per nonzero, plus x and y
+          runner.run("spmv", params, 2.0 * h.nnz() * (half ? 2 : 1),
+                     16.0 * h.nnz() + 8.0 * (n + 1) + 16.0 * n, [&]() { h.matvec(x, y); });
+        }
+      }
+
+      // v = exp(-i dt H) v for the Laplacian over Krylov spaces of m, one time step per call
+      void bench_expmv(Runner &runner, const cytnx_uint64 &side) {
+        const cytnx_uint64 n = side * side;
+        const SparseLinOp op(laplacian(side, true).to_csr(SparseSymmetry::Symmetric));
+        const cytnx_complex128 dt(0, -0.1);
+        Storage v(n, Type.ComplexDouble);
+        for (const cytnx_uint64 m : {10, 30}) {
+          const Params params = {{"n", to_string(n)}, {"m", to_string(m)}};
+          if (!runner.selected("expmv", params)) continue;
+          KrylovExpmv expmv(op, m);
+          v.fill(cytnx_complex128(1));
+          expmv.apply(v, dt);
+          // a product applies the real H to the real and imaginary parts, and orthogonalizes
+          // against about m / 2 basis vectors twice, 32 flops per element and vector; each
+          // basis vector is written once and read by both Gram-Schmidt passes
+          const double matvecs = double(expmv.stats().matvecs);
+          const double nnz = 5.0 * n;
+          runner.run("expmv", params, matvecs * (4 * nnz + 16.0 * m * n),
+                     matvecs * 3 * 16.0 * n, [&]() { expmv.apply(v, dt); });
+        }
+      }
+
+      // the SVD of the blocks of a U(1)-symmetric matrix, of dimensions falling off as a
+      // Gaussian in the charge from `largest`: one at a time, scheduled by BlockSvd(), and
+      // truncated to the `largest` leading values over all blocks
+      void bench_block_svd(Runner &runner, const cytnx_uint64 &largest) {
+        vector<StorageView> blocks;
+        double flops = 0, bytes = 0;
+        for (int q = -8; q <= 8; q++) {
+          const cytnx_uint64 n = std::max<cytnx_uint64>(
+            cytnx_uint64(double(largest) * std::exp(-q * q / 8.0)), 1);
+          Storage s(n * n, Type.Double);
+          const vector<double> a = random_matrix<double>(n * n);
+          std::copy(a.begin(), a.end(), s.data<double>());
+          blocks.emplace_back(s, vector<cytnx_uint64>{n, n});
+          flops += counters::gesvd_flops('S', 'S', n, n);
+          bytes += counters::gesvd_elems('S', 'S', n, n) * sizeof(double);
+        }
+        for (const char *schedule : {"serial", "blocks", "truncate"}) {
+          const Params params = {{"largest", to_string(largest)},
+                                 {"blocks", to_string(blocks.size())},
+                                 {"schedule", schedule}};
+          if (!runner.selected("block_svd", params)) continue;
+          const string which = schedule;
+          runner.run("block_svd", params, flops, bytes, [&]() {
+            if (which == "serial")
+              for (const StorageView &b : blocks) linalg::Svd(b);
+            else if (which == "blocks")
+              linalg::BlockSvd(blocks);
+            else
+              linalg::BlockSvdTruncate(blocks, largest);
+          });
+        }
+      }
+
+      // the input is restored before each call, since the routines overwrite it
+      template <class T>
+      void bench_gesvd(Runner &runner, const char *dtype, const blas_int &n, const int &threads) {
+        const Params params = params_of(dtype, n, threads);
+        if (!runner.selected("gesvd", params)) return;
+        const vector<T> a = random_matrix<T>(size_t(n) * n);
+        vector<T> scratch(a.size());
+        SvdWork work;
+        runner.run("gesvd", params,
+                   counters::flop_factor<T> * counters::gesvd_flops('S', 'S', n, n),
+                   counters::gesvd_elems('S', 'S', n, n) * sizeof(T), [&]() {
+                     scratch = a;
+                     gesvd(n, scratch.data(), work);
+                   });
+      }
+
+      template <class T>
+      void bench_geqrf(Runner &runner, const char *dtype, const blas_int &n, const int &threads) {
+        const Params params = params_of(dtype, n, threads);
+        if (!runner.selected("geqrf", params)) return;
+        const vector<T> a = random_matrix<T>(size_t(n) * n);
+        vector<T> scratch(a.size()), tau, work;
+        runner.run("geqrf", params, counters::flop_factor<T> * counters::geqrf_flops(n, n),
+                   2.0 * n * n * sizeof(T), [&]() {
+                     scratch = a;
+                     geqrf(n, scratch.data(), tau, work);
+                   });
+      }
+
+      // all eigenpairs, or the lowest tenth, by each driver; the flops of a range are those of
+      // its cheapest driver, so that the rates compare as inverse times
+      template <class T>
+      void bench_eigh(Runner &runner, const char *dtype, const blas_int &n, const int &threads) {
+        using utils_internal::EighDriver;
+        const vector<T> a = random_matrix<T>(size_t(n) * n);
+        vector<T> scratch(a.size()), z(a.size());
+        vector<utils_internal::eigh_real_t<T>> w(n);
+        for (const bool all : {true, false}) {
+          utils_internal::EighRange range;
+          if (!all) {
+            range.range = 'I';
+            range.iu = std::max<blas_int>(n / 10, 1);
+          }
+          const double flops = counters::flop_factor<T> *
+                               (all ? counters::syevd_flops('V', n)
+                                    : counters::syevr_flops('V', n, range.iu - range.il));
+          for (const EighDriver driver : {EighDriver::DivideConquer, EighDriver::Mrrr}) {
+            Params params = params_of(dtype, n, threads);
+            params.emplace_back("range", all ? "all" : "tenth");
+            params.emplace_back("driver", driver == EighDriver::Mrrr ? "mrrr" : "dc");
+            if (!runner.selected("eigh", params)) continue;
+            runner.run("eigh", params, flops, 2.0 * n * n * sizeof(T), [&]() {
+              scratch = a;
+              utils_internal::Eigh_cpu(scratch.data(), n, range, true, w.data(), z.data(),
+                                       driver);
+            });
+          }
+        }
+      }
+    }  // namespace
+
+    void bench_linalg(Runner &runner) {
+      const bool quick = runner.options().quick;
+      const vector<blas_int> gemm_sizes = quick ? vector<blas_int>{64}
+                                                : vector<blas_int>{64, 256, 1024};
+      const vector<blas_int> gemv_sizes = quick ? vector<blas_int>{256}
+                                                : vector<blas_int>{256, 1024, 4096};
+      const vector<blas_int> factor_sizes = quick ? vector<blas_int>{32}
+                                                  : vector<blas_int>{64, 256, 512};
+      for (const cytnx_uint64 side : quick ? vector<cytnx_uint64>{64}
+                                           : vector<cytnx_uint64>{256, 1024})
+        bench_spmv(runner, side);
+      for (const cytnx_uint64 side : quick ? vector<cytnx_uint64>{32}
+                                           : vector<cytnx_uint64>{128, 512})
+        bench_expmv(runner, side);
+      // scheduled over Device.Ncores threads, whatever the BLAS threads
+      for (const cytnx_uint64 largest : quick ? vector<cytnx_uint64>{32}
+                                              : vector<cytnx_uint64>{128, 512})
+        bench_block_svd(runner, largest);
+      for (const int threads : runner.options().threads) {
+        set_blas_threads(threads);
+        for (const blas_int n : gemm_sizes) {
+          bench_gemm<cytnx_double>(runner, "Double", n, threads);
+          bench_gemm<cytnx_float>(runner, "Float", n, threads);
+          bench_gemm<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+          bench_gemm<cytnx_complex64>(runner, "ComplexFloat", n, threads);
+          bench_adjoint<cytnx_complex128>(runner, Type.ComplexDouble, n, threads);
+          bench_linop(runner, n, threads);
+        }
+        for (const blas_int n : gemv_sizes) {
+          bench_gemv<cytnx_double>(runner, "Double", n, threads);
+          bench_gemv<cytnx_float>(runner, "Float", n, threads);
+          bench_gemv<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+        }
+        for (const blas_int n : factor_sizes) {
+          bench_gesvd<cytnx_double>(runner, "Double", n, threads);
+          bench_gesvd<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+          bench_geqrf<cytnx_double>(runner, "Double", n, threads);
+          bench_geqrf<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+          bench_eigh<cytnx_double>(runner, "Double", n, threads);
+          bench_eigh<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+        }
+      }
+    }
+
+  }  // namespace bench
+}  // namespace cytnx_core
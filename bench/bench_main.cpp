@@ -0,0 +1,242 @@
+// cytnx_core_bench: micro-benchmarks of the CPU kernels and the BLAS/LAPACK wrappers.
+//
+//   cytnx_core_bench [--filter=<substring>] [--reps=<n>] [--warmup=<n>] [--min-time=<seconds>]
+//                    [--threads=<n,n,...>] [--json=<path>] [--list] [--quick]
+
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#ifdef UNI_MKL
+  #include <mkl.h>
+#else
+// OpenBLAS exports this; weak so that other BLAS libraries still link
+extern "C" void openblas_set_num_threads(int) __attribute__((weak));
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace bench {
+
+    namespace {
+      double now_seconds() {
+        return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+      }
+
+      void append_json_string(string &out, const string &s) {
+        out += '"';
+        for (const char c : s) {
+          if (c == '"' || c == '\\') out += '\\';
+          out += c;
+        }
+        out += '"';
+      }
+
+      string json_number(const double &v) {
+        if (!std::isfinite(v)) return "null";
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.9g", v);
+        return buf;
+      }
+
+      vector<int> parse_ints(const string &s) {
+        vector<int> out;
+        stringstream ss(s);
+        string item;
+        while (getline(ss, item, ',')) {
+          const int v = atoi(item.c_str());
+          cytnx_input_error_msg(v <= 0, "[ERROR][bench] invalid thread count: %s\n",
+                                item.c_str());
+          out.push_back(v);
+        }
+        return out;
+      }
+
+      // the value of --key=value, or nullptr
+      const char *flag_value(const char *arg, const char *key) {
+        const size_t n = strlen(key);
+        return strncmp(arg, key, n) == 0 && arg[n] == '=' ? arg + n + 1 : nullptr;
+      }
+    }  // namespace
+
+    string make_id(const string &name, const Params &params) {
+      string id = name;
+      for (const auto &p : params) id += "/" + p.first + "=" + p.second;
+      return id;
+    }
+
+    bool Runner::selected(const string &name, const Params &params) const {
+      return make_id(name, params).find(_options.filter) != string::npos;
+    }
+
+    void Runner::run(const string &name, const Params &params, const double &flops,
+                     const double &bytes, const function<void()> &fn) {
+      if (!selected(name, params)) return;
+      Result r;
+      r.id = make_id(name, params);
+      r.name = name;
+      r.params = params;
+      r.flops = flops;
+      r.bytes = bytes;
+      if (_options.list) {
+        cout << r.id << endl;
+        return;
+      }
+
+      // calibrate: enough calls per repetition to dwarf the timer resolution
+      double t0 = now_seconds();
+      fn();
+      const double once = now_seconds() - t0;
+      r.inner = once >= _options.min_rep_seconds
+                  ? 1
+                  : int(std::min(1e6, std::ceil(_options.min_rep_seconds / std::max(once, 1e-9))));
+
+      for (int w = 0; w < _options.warmup; w++)
+        for (int i = 0; i < r.inner; i++) fn();
+      for (int rep = 0; rep < _options.reps; rep++) {
+        t0 = now_seconds();
+        for (int i = 0; i < r.inner; i++) fn();
+        r.seconds.push_back((now_seconds() - t0) / r.inner);
+      }
+
+      vector<double> sorted = r.seconds;
+      sort(sorted.begin(), sorted.end());
+      const size_t n = sorted.size();
+      r.min = sorted[0];
+      r.median = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+      r.mean = 0;
+      for (const double s : sorted) r.mean += s / n;
+      r.stddev = 0;
+      for (const double s : sorted) r.stddev += (s - r.mean) * (s - r.mean);
+      r.stddev = n > 1 ? std::sqrt(r.stddev / (n - 1)) : 0;
+
+      char buf[256];
+      snprintf(buf, sizeof(buf), "%-56s %12.3f us %7.1f%% %10.2f GB/s %10.2f GFLOP/s",
+               r.id.c_str(), r.median * 1e6, r.mean > 0 ? 100 * r.stddev / r.mean : 0.0,
+               r.bytes / r.median * 1e-9, r.flops / r.median * 1e-9);
+      cout << buf << endl;
+      _results.push_back(std::move(r));
+    }
+
+    string Runner::json() const {
+      string out = "{\n\"context\":{";
+      char date[64];
+      const time_t t = time(nullptr);
+      strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&t));
+      out += "\"date\":";
+      append_json_string(out, date);
+      out += ",\"cpu\":";
+      append_json_string(out, Device.cpu_signature());
+      out += ",\"ncpus\":" + to_string(Device.Ncpus);
+      out += ",\"check_level\":" + to_string(CYTNX_CHECK_LEVEL);
+      out += string(",\"trace\":") + (trace::compiled() ? "true" : "false");
+      out += ",\"warmup\":" + to_string(_options.warmup);
+      out += ",\"reps\":" + to_string(_options.reps);
+      out += ",\"min_rep_seconds\":" + json_number(_options.min_rep_seconds);
+      out += "},\n\"benchmarks\":[";
+      bool first = true;
+      for (const auto &r : _results) {
+        out += first ? "\n{\"id\":" : ",\n{\"id\":";
+        first = false;
+        append_json_string(out, r.id);
+        out += ",\"name\":";
+        append_json_string(out, r.name);
+        out += ",\"params\":{";
+        for (size_t i = 0; i < r.params.size(); i++) {
+          if (i) out += ',';
+          append_json_string(out, r.params[i].first);
+          out += ':';
+          append_json_string(out, r.params[i].second);
+        }
+        out += "},\"flops\":" + json_number(r.flops);
+        out += ",\"bytes\":" + json_number(r.bytes);
+        out += ",\"inner\":" + to_string(r.inner);
+        out += ",\"min\":" + json_number(r.min);
+        out += ",\"median\":" + json_number(r.median);
+        out += ",\"mean\":" + json_number(r.mean);
+        out += ",\"stddev\":" + json_number(r.stddev);
+        out += ",\"gbs\":" + json_number(r.bytes / r.median * 1e-9);
+        out += ",\"gflops\":" + json_number(r.flops / r.median * 1e-9);
+        out += ",\"seconds\":[";
+        for (size_t i = 0; i < r.seconds.size(); i++)
+          out += (i ? "," : "") + json_number(r.seconds[i]);
+        out += "]}";
+      }
+      out += "\n]}\n";
+      return out;
+    }
+
+    void set_blas_threads(const int &threads) {
+#ifdef UNI_MKL
+      mkl_set_num_threads(threads);
+#else
+      if (openblas_set_num_threads) openblas_set_num_threads(threads);
+#endif
+    }
+
+  }  // namespace bench
+}  // namespace cytnx_core
+
+int main(int argc, char *argv[]) {
+  using namespace cytnx_core::bench;
+  Options options;
+  // a bad argument (e.g. --threads=0) throws, so the arguments are parsed inside the try
+  try {
+    for (int i = 1; i < argc; i++) {
+      const char *arg = argv[i], *v;
+      if ((v = flag_value(arg, "--filter")))
+        options.filter = v;
+      else if ((v = flag_value(arg, "--reps")))
+        options.reps = std::max(1, atoi(v));
+      else if ((v = flag_value(arg, "--warmup")))
+        options.warmup = std::max(0, atoi(v));
+      else if ((v = flag_value(arg, "--min-time")))
+        options.min_rep_seconds = atof(v);
+      else if ((v = flag_value(arg, "--threads")))
+        options.threads = parse_ints(v);
+      else if ((v = flag_value(arg, "--json")))
+        options.json = v;
+      else if (strcmp(arg, "--list") == 0)
+        options.list = true;
+      else if (strcmp(arg, "--quick") == 0)
+        options.quick = true;
+      else {
+        fprintf(stderr, "usage: %s [--filter=s] [--reps=n] [--warmup=n] [--min-time=s]"
+                        " [--threads=n,...] [--json=path] [--list] [--quick]\n", argv[0]);
+        return 2;
+      }
+    }
+    if (options.threads.empty()) {
+      const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+      options.threads = max_threads > 1 ? std::vector<int>{1, max_threads} : std::vector<int>{1};
+    }
+
+    Runner runner(options);
+    bench_memory(runner);
+    bench_linalg(runner);
+    if (!options.json.empty() && !options.list) {
+      std::ofstream f(options.json, std::ios::trunc);
+      f << runner.json();
+      cytnx_system_error_msg(!f, "[ERROR][bench] cannot write %s.\n", options.json.c_str());
+    }
+  } catch (const std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,211 @@
+// allocation, fill and conversion kernels: bandwidth over sizes, dtypes and threads
+
+#include "Bench.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+
+#include "utils_internal/cpu/Alloc_cpu.hpp"
+#include "utils_internal/cpu/Blocking_cpu.hpp"
+#include "utils_internal/cpu/Complexmem_cpu.hpp"
+#include "utils_internal/cpu/Convert_cpu.hpp"
+#include "utils_internal/cpu/Fill_cpu.hpp"
+#include "utils_internal/cpu/Permute_cpu.hpp"
+#include "utils_internal/cpu/Quantize_cpu.hpp"
+#include "utils_internal/cpu/Random_cpu.hpp"
+#include "utils_internal/cpu/SetZeros_cpu.hpp"
+#include "utils_internal/cpu/SplitComplex_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace bench {
+
+    namespace {
+      // element counts: in L1/L2, in the last-level cache, and in DRAM
+      vector<cytnx_uint64> sizes(const Runner &runner) {
+        if (runner.options().quick) return {1 << 12};
+        return {1 << 12, 1 << 18, 1 << 24};
+      }
+
+      template <class T>
+      void bench_fill(Runner &runner, const char *dtype, const cytnx_uint64 &n,
+                      const int &threads) {
+        const Params params = {
+          {"dtype", dtype}, {"n", to_string(n)}, {"threads", to_string(threads)}};
+        if (!runner.selected("fill", params)) return;
+        vector<T> buf(n);
+        utils_internal::BlockingParams blocking = utils_internal::GetBlockingParams();
+        blocking.fill_threads = threads;
+        const T value = T(1);
+        runner.run("fill", params, 0, double(n) * sizeof(T),
+                   [&]() { utils_internal::FillCpu(buf.data(), value, n, blocking); });
+      }
+
+      // counter-based uniform and normal fills, against std::mt19937_64 on one thread
+      template <class T>
+      void bench_random(Runner &runner, const char *dtype, const cytnx_uint64 &n,
+                        const int &threads) {
+        vector<T> buf(n);
+        utils_internal::BlockingParams blocking = utils_internal::GetBlockingParams();
+        blocking.fill_threads = threads;
+        for (const bool normal : {false, true}) {
+          for (const bool philox : {true, false}) {
+            if (!philox && threads != 1) continue;
+            const Params params = {{"dtype", dtype},
+                                   {"dist", normal ? "normal" : "uniform"},
+                                   {"generator", philox ? "philox" : "mt19937"},
+                                   {"n", to_string(n)},
+                                   {"threads", to_string(threads)}};
+            if (!runner.selected("random", params)) continue;
+            std::mt19937_64 engine(1);
+            std::uniform_real_distribution<T> uniform;
+            std::normal_distribution<T> gauss;
+            runner.run("random", params, 0, double(n) * sizeof(T), [&]() {
+              if (philox && normal) {
+                utils_internal::Normal_cpu(buf.data(), n, 0, 1, 1, 0, blocking);
+              } else if (philox) {
+                utils_internal::Uniform_cpu(buf.data(), n, 0, 1, 1, 0, blocking);
+              } else if (normal) {
+                for (T &v : buf) v = gauss(engine);
+              } else {
+                for (T &v : buf) v = uniform(engine);
+              }
+            });
+          }
+        }
+      }
+    }  // namespace
+
+    void bench_memory(Runner &runner) {
+      for (const cytnx_uint64 n : sizes(runner)) {
+        const cytnx_uint64 bytes = n * sizeof(cytnx_double);
+        // allocation is timed with its free; untouched pages are not counted as traffic
+        runner.run("malloc", {{"bytes", to_string(bytes)}}, 0, 0,
+                   [&]() { free(utils_internal::Malloc_cpu(bytes)); });
+        runner.run("calloc", {{"bytes", to_string(bytes)}}, 0, 0,
+                   [&]() { free(utils_internal::Calloc_cpu(n, sizeof(cytnx_double))); });
+        if (runner.selected("setzeros", {{"bytes", to_string(bytes)}})) {
+          vector<char> buf(bytes);
+          runner.run("setzeros", {{"bytes", to_string(bytes)}}, 0, bytes,
+                     [&]() { utils_internal::SetZeros(buf.data(), bytes); });
+        }
+
+        for (const int threads : runner.options().threads) {
+          bench_fill<cytnx_double>(runner, "Double", n, threads);
+          bench_fill<cytnx_float>(runner, "Float", n, threads);
+          bench_fill<cytnx_complex128>(runner, "ComplexDouble", n, threads);
+          bench_fill<cytnx_int64>(runner, "Int64", n, threads);
+          bench_random<cytnx_double>(runner, "Double", n, threads);
+          bench_random<cytnx_float>(runner, "Float", n, threads);
+
+          utils_internal::BlockingParams blocking = utils_internal::GetBlockingParams();
+          blocking.convert_threads = threads;
+          const Params params = {{"n", to_string(n)}, {"threads", to_string(threads)}};
+          if (runner.selected("complexmem_cdtd", params)) {
+            vector<cytnx_complex128> in(n, cytnx_complex128(1, 2));
+            vector<cytnx_double> out(n);
+            runner.run("complexmem_cdtd", params, 0,
+                       double(n) * (sizeof(cytnx_complex128) + sizeof(cytnx_double)), [&]() {
+                         utils_internal::Complexmem_cpu_cdtd(out.data(), in.data(), n, true,
+                                                             blocking);
+                       });
+          }
+          if (runner.selected("complexmem_cftf", params)) {
+            vector<cytnx_complex64> in(n, cytnx_complex64(1, 2));
+            vector<cytnx_float> out(n);
+            runner.run("complexmem_cftf", params, 0,
+                       double(n) * (sizeof(cytnx_complex64) + sizeof(cytnx_float)), [&]() {
+                         utils_internal::Complexmem_cpu_cftf(out.data(), in.data(), n, true,
+                                                             blocking);
+                       });
+          }
+          if (runner.selected("deinterleave", params)) {
+            vector<cytnx_complex128> in(n, cytnx_complex128(1, 2));
+            vector<cytnx_double> re(n), im(n);
+            runner.run("deinterleave", params, 0, 2.0 * n * sizeof(cytnx_complex128), [&]() {
+              utils_internal::Deinterleave_cpu(re.data(), im.data(), in.data(), n, blocking);
+            });
+          }
+          if (runner.selected("split_mul", params)) {
+            vector<cytnx_double> are(n, 1), aim(n, 2), bre(n, 3), bim(n, 4);
+            runner.run("split_mul", params, 6.0 * n, 6.0 * n * sizeof(cytnx_double), [&]() {
+              utils_internal::SplitMul_cpu(are.data(), aim.data(), are.data(), aim.data(),
+                                           bre.data(), bim.data(), n, blocking);
+            });
+          }
+          if (runner.selected("half_to_float", params)) {
+            vector<cytnx_float16> in(n, cytnx_float16(1.5f));
+            vector<cytnx_float> out(n);
+            runner.run("half_to_float", params, 0,
+                       double(n) * (sizeof(cytnx_float16) + sizeof(cytnx_float)), [&]() {
+                         utils_internal::HalfToFloat_cpu(out.data(), in.data(), n, blocking);
+                       });
+          }
+          if (runner.selected("float_to_bfloat16", params)) {
+            vector<cytnx_float> in(n, 1.5f);
+            vector<cytnx_bfloat16> out(n);
+            runner.run("float_to_bfloat16", params, 0,
+                       double(n) * (sizeof(cytnx_float) + sizeof(cytnx_bfloat16)), [&]() {
+                         utils_internal::FloatToBFloat16_cpu(out.data(), in.data(), n, blocking);
+                       });
+          }
+        }
+
+        if (runner.selected("sum_bfloat16", {{"n", to_string(n)}})) {
+          vector<cytnx_bfloat16> in(n, cytnx_bfloat16(1.0f));
+          runner.run("sum_bfloat16", {{"n", to_string(n)}}, double(n),
+                     double(n) * sizeof(cytnx_bfloat16),
+                     [&]() { utils_internal::Sum_cpu(in.data(), n); });
+        }
+
+        for (const int bits : {8, 4}) {
+          const Params params = {{"bits", to_string(bits)}, {"n", to_string(n)}};
+          if (!runner.selected("quantize", params)) continue;
+          vector<cytnx_float> in(n);
+          for (cytnx_uint64 i = 0; i < n; i++) in[i] = std::sin(double(i));
+          vector<cytnx_int8> q(n);
+          vector<cytnx_float> scales(n / 64 + 1);
+          runner.run("quantize", params, 0, double(n) * (sizeof(cytnx_float) + bits / 8.0), [&]() {
+            utils_internal::Quantize_cpu(q.data(), scales.data(), in.data(), Type.Float, n, 64,
+                                         bits, nullptr);
+          });
+          runner.run("dequantize", params, 0, double(n) * (sizeof(cytnx_float) + bits / 8.0),
+                     [&]() {
+                       utils_internal::Dequantize_cpu(in.data(), Type.Float, q.data(),
+                                                      scales.data(), n, 64, bits);
+                     });
+        }
+
+        // a square matrix of n elements, copied into the real parts of a complex one
+        const cytnx_uint64 side = cytnx_uint64(std::sqrt(double(n)));
+        const Params params = {{"m", to_string(side)}, {"n", to_string(side)}};
+        if (runner.selected("complex_from_real_cd", params)) {
+          vector<cytnx_double> in(side * side, 1);
+          vector<cytnx_complex128> out(side * side);
+          runner.run("complex_from_real_cd", params, 0,
+                     double(side * side) * (sizeof(cytnx_double) + sizeof(cytnx_complex128)),
+                     [&]() {
+                       utils_internal::ComplexMatrix_from_real_cd(out.data(), in.data(), side,
+                                                                  side, true);
+                     });
+        }
+        // the same matrix transposed into contiguous memory by the tiled kernel
+        if (runner.selected("transpose", params)) {
+          vector<cytnx_double> in(side * side, 1);
+          vector<cytnx_double> out(side * side);
+          runner.run("transpose", params, 0, 2.0 * side * side * sizeof(cytnx_double), [&]() {
+            utils_internal::StridedCopy_cpu(out.data(), in.data(), sizeof(cytnx_double),
+                                            {side, side}, {1, side});
+          });
+        }
+      }
+    }
+
+  }  // namespace bench
+}  // namespace cytnx_core
@@ -0,0 +1,217 @@
+"""Compare cytnx_core_bench results against a stored baseline.
+
+A case regresses when its repetition samples are significantly slower than the
+baseline ones (one-sided Mann-Whitney U test at ``alpha``) *and* its median
+slowed down by more than ``threshold``; the second condition keeps tiny but
+consistent shifts from failing the run.
+
+Usage::
+
+    python bench/regression.py compare baseline.json current.json
+    python bench/regression.py run --bench build/bench/cytnx_core_bench \\
+        --baseline baseline.json [--save]
+
+``run`` executes the benchmarks, compares them with the baseline, and exits
+with status 1 on a regression. ``--save`` writes the new results as the
+baseline instead. The pytest entry point is test/test_bench_regression.py.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+import tempfile
+from dataclasses import dataclass
+from functools import lru_cache
+
+ALPHA = 0.01
+THRESHOLD = 0.05
+
+
+@lru_cache(maxsize=None)
+def _count_u(n1: int, n2: int, u: int) -> int:
+    """The number of orderings of n1 + n2 distinct values with U statistic u."""
+    if u < 0 or u > n1 * n2:
+        return 0
+    if n1 == 0 or n2 == 0:
+        return 1 if u == 0 else 0
+    # the largest value belongs to the first sample (beating all n2) or the second
+    return _count_u(n1 - 1, n2, u - n2) + _count_u(n1, n2 - 1, u)
+
+
+def mann_whitney_greater(x: list[float], y: list[float]) -> float:
+    """The p-value of H1: x tends to be larger than y.
+
+    Exact for small samples without ties, otherwise the normal approximation
+    with tie and continuity corrections.
+    """
+    n1, n2 = len(x), len(y)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    u = sum(1.0 if a > b else 0.5 if a == b else 0.0 for a in x for b in y)
+
+    values = sorted(x + y)
+    ties = []
+    i = 0
+    while i < len(values):
+        j = i
+        while j < len(values) and values[j] == values[i]:
+            j += 1
+        if j - i > 1:
+            ties.append(j - i)
+        i = j
+
+    if not ties and n1 <= 20 and n2 <= 20:
+        total = math.comb(n1 + n2, n1)
+        tail = sum(_count_u(n1, n2, k) for k in range(math.ceil(u), n1 * n2 + 1))
+        return tail / total
+
+    n = n1 + n2
+    mu = n1 * n2 / 2
+    tie_term = sum(t**3 - t for t in ties) / (n * (n - 1))
+    sigma = math.sqrt(n1 * n2 / 12 * ((n + 1) - tie_term))
+    if sigma == 0:
+        return 1.0
+    z = (u - mu - 0.5) / sigma
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def _median(samples: list[float]) -> float:
+    s = sorted(samples)
+    n = len(s)
+    return s[n // 2] if n % 2 else (s[n // 2 - 1] + s[n // 2]) / 2
+
+
+@dataclass
+class Comparison:
+    id: str
+    base_median: float | None
+    new_median: float | None
+    p_slower: float
+    p_faster: float
+    verdict: str  # regression, improvement, same, new or missing
+
+    @property
+    def change(self) -> float | None:
+        if not self.base_median or self.new_median is None:
+            return None
+        return self.new_median / self.base_median - 1
+
+
+def compare(
+    baseline: dict, current: dict, alpha: float = ALPHA, threshold: float = THRESHOLD
+) -> list[Comparison]:
+    """Compare two cytnx_core_bench JSON documents case by case."""
+    base = {b["id"]: b["seconds"] for b in baseline["benchmarks"]}
+    new = {b["id"]: b["seconds"] for b in current["benchmarks"]}
+    out = []
+    for case_id in sorted(base.keys() | new.keys()):
+        if case_id not in base:
+            out.append(Comparison(case_id, None, _median(new[case_id]), 1, 1, "new"))
+            continue
+        if case_id not in new:
+            base_median = _median(base[case_id])
+            out.append(Comparison(case_id, base_median, None, 1, 1, "missing"))
+            continue
+        x, y = new[case_id], base[case_id]
+        c = Comparison(
+            case_id,
+            _median(y),
+            _median(x),
+            mann_whitney_greater(x, y),
+            mann_whitney_greater(y, x),
+            "same",
+        )
+        change = c.change or 0
+        if c.p_slower < alpha and change > threshold:
+            c.verdict = "regression"
+        elif c.p_faster < alpha and change < -threshold:
+            c.verdict = "improvement"
+        out.append(c)
+    return out
+
+
+def format_table(comparisons: list[Comparison]) -> str:
+    def us(t: float | None) -> str:
+        return "-" if t is None else f"{t * 1e6:.3f}"
+
+    rows = [("case", "base[us]", "new[us]", "change", "p", "verdict")]
+    for c in comparisons:
+        change = "-" if c.change is None else f"{c.change * 100:+.1f}%"
+        p = min(c.p_slower, c.p_faster)
+        rows.append(
+            (c.id, us(c.base_median), us(c.new_median), change, f"{p:.2g}", c.verdict)
+        )
+    widths = [max(len(r[i]) for r in rows) for i in range(len(rows[0]))]
+    lines = []
+    for r in rows:
+        cells = [r[0].ljust(widths[0])]
+        cells += [r[i].rjust(widths[i]) for i in range(1, len(r))]
+        lines.append("  ".join(cells))
+    return "\n".join(lines)
+
+
+def run_bench(bench: str, args: list[str]) -> dict:
+    """Run the benchmark binary and return its JSON results."""
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "bench.json")
+        subprocess.run([bench, f"--json={path}", *args], check=True)
+        with open(path) as f:
+            return json.load(f)
+
+
+def _load(path: str) -> dict:
+    with open(path) as f:
+        return json.load(f)
+
+
+def _report(baseline: dict, current: dict, alpha: float, threshold: float) -> int:
+    if baseline.get("context", {}).get("cpu") != current.get("context", {}).get("cpu"):
+        print("warning: the baseline was recorded on a different CPU", file=sys.stderr)
+    comparisons = compare(baseline, current, alpha, threshold)
+    print(format_table(comparisons))
+    regressions = [c for c in comparisons if c.verdict == "regression"]
+    if regressions:
+        print(
+            f"\n{len(regressions)} regression(s) at alpha={alpha}, "
+            f"threshold={threshold}"
+        )
+        return 1
+    return 0
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+    p_cmp = sub.add_parser("compare", help="compare two result files")
+    p_cmp.add_argument("baseline")
+    p_cmp.add_argument("current")
+    p_run = sub.add_parser("run", help="run the benchmarks and compare")
+    p_run.add_argument("--bench", required=True, help="the cytnx_core_bench binary")
+    p_run.add_argument("--baseline", required=True)
+    p_run.add_argument(
+        "--save", action="store_true", help="store the results as the baseline"
+    )
+    p_run.add_argument("bench_args", nargs="*", help="passed on, e.g. --filter=gemm")
+    for p in (p_cmp, p_run):
+        p.add_argument("--alpha", type=float, default=ALPHA)
+        p.add_argument("--threshold", type=float, default=THRESHOLD)
+    args = parser.parse_args(argv)
+
+    if args.command == "compare":
+        baseline, current = _load(args.baseline), _load(args.current)
+        return _report(baseline, current, args.alpha, args.threshold)
+    current = run_bench(args.bench, args.bench_args)
+    if args.save:
+        with open(args.baseline, "w") as f:
+            json.dump(current, f, indent=1)
+        return 0
+    return _report(_load(args.baseline), current, args.alpha, args.threshold)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,69 @@
+#ifndef CYTNX_AUTOTUNE_H_
+#define CYTNX_AUTOTUNE_H_
+
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Autotuning of the blocking parameters of the CPU kernels.
+   *
+   * @details The best chunk size and thread count of a kernel depend on the machine. prewarm()
+   * benchmarks every tunable kernel over a set of candidate configurations derived from
+   * `Device`, and persists the winners to a per-machine cache file keyed by
+   * Device_class::cpu_signature(). Every run reloads the file at startup; kernels missing from it
+   * keep the parameters derived from `Device`. Tuning takes seconds, so it never runs on first
+   * use of a kernel unless asked to by CYTNX_AUTOTUNE.
+   *
+   * The behaviour is controlled by the environment:
+   *
+   *  variable              |  description
+   * -----------------------|-----------------------------------------------------------------
+   *  CYTNX_AUTOTUNE        |  set to 1 to benchmark the uncached kernels on first use
+   *  CYTNX_AUTOTUNE_CACHE  |  path of the cache file, overriding the default location
+   *
+   * By default the cache lives in `$XDG_CACHE_HOME/cytnx_core` (or `~/.cache/cytnx_core`).
+   */
+  namespace autotune {
+
+    struct Entry {
+      std::string kernel;  // "fill", "convert", ...
+      cytnx_uint64 block_bytes;  // bytes per scheduling chunk
+      int threads;
+      double seconds;  // time of the winner on the benchmark problem
+    };
+
+    // the cache file used on this machine
+    std::string cache_path();
+
+    // whether kernels are benchmarked on first use when the cache has no entry for them
+    bool enabled();
+
+    // the entries stored in the cache file of this machine
+    std::vector<Entry> entries();
+
+    // the entries in effect for this process: cached ones, plus newly tuned ones when enabled(),
+    // with the thread counts capped by omp_get_max_threads()
+    std::vector<Entry> tuned_entries();
+
+    /**
+     * @brief Benchmark all tunable kernels and persist the winners.
+     *
+     * @param force retune kernels that already have a cache entry
+     * @return the entries now stored in the cache
+     *
+     * Intended to be run once per machine at deploy time, so that production runs never pay
+     * for tuning. Parameters already in use by this process are not changed.
+     */
+    std::vector<Entry> prewarm(bool force = false);
+
+    // remove the cache file of this machine
+    void clear_cache();
+
+  }  // namespace autotune
+}  // namespace cytnx_core
+
+#endif  // CYTNX_AUTOTUNE_H_
@@ -0,0 +1,164 @@
+#ifndef CYTNX_CORE_COUNTERS_H_
+#define CYTNX_CORE_COUNTERS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Operation counters of the BLAS and LAPACK wrappers (lapack_wrapper.hpp).
+   *
+   * @details While enabled, every wrapper call adds its analytic flop count, the bytes of its
+   * operands and its wall time to counters kept per routine and dtype by the calling thread.
+   * report() merges the counters of all threads into a roofline-style table:
+   * \code
+   * counters::enable();
+   * ...
+   * std::cout << counters::report(peak_gflops, peak_gbs);
+   * \endcode
+   *
+   * Flop counts follow LAWN 41, with a complex flop counted as four real ones; bytes count each
+   * operand read once and each output written once, so they are a lower bound on the traffic.
+   * While disabled, a wrapper call costs a relaxed atomic load.
+   */
+  namespace counters {
+
+    enum Routine : unsigned int {
+      Gemm,
+      Gemv,
+      Axpy,
+      Dot,
+      Nrm2,
+      Scal,
+      Asum,
+      Copy,
+      Gesvd,
+      Geqrf,
+      Getrf,
+      Getri,
+      Syevd,
+      Syevr,
+      N_Routine
+    };
+    const char *routine_name(const unsigned int &routine);
+
+    void enable(const bool &on = true);
+    void disable();
+    bool enabled();
+
+    // zero the counters of all threads
+    void reset();
+
+    struct Entry {
+      unsigned int routine;
+      unsigned int dtype;
+      std::uint64_t calls;
+      double flops;
+      double bytes;
+      double seconds;
+    };
+
+    // the counters with at least one call, summed over threads, in (routine, dtype) order
+    std::vector<Entry> entries();
+
+    /**
+     * @brief the counters as a table, with the achieved rates and arithmetic intensity.
+     * @param peak_gflops, peak_gbs the peak compute rate and memory bandwidth of the machine;
+     * when both are given, each row also shows whether the roofline bounds it by compute or
+     * memory, and the fraction of that bound achieved
+     */
+    std::string report(const double &peak_gflops = 0, const double &peak_gbs = 0);
+
+    // analytic flop counts of the real routines; the complex ones do flop_factor<T> times more
+    template <class T>
+    constexpr double flop_factor = 1;
+    template <>
+    constexpr double flop_factor<std::complex<double>> = 4;
+    template <>
+    constexpr double flop_factor<std::complex<float>> = 4;
+
+    inline double getrf_flops(const double &m, const double &n) {
+      const double k = std::min(m, n);
+      return 2 * (m * n * k - (m + n) * k * k / 2 + k * k * k / 3);
+    }
+    inline double getri_flops(const double &n) { return 4 * n * n * n / 3; }
+    inline double geqrf_flops(const double &m, const double &n) {
+      const double big = std::max(m, n), k = std::min(m, n);
+      return 2 * big * k * k - 2 * k * k * k / 3;
+    }
+    // ?syevd/?heevd: the reduction to tridiagonal form, plus with jobz = 'V' the divide and
+    // conquer solve and the back-transformation of all n vectors
+    inline double syevd_flops(const char &jobz, const double &n) {
+      return jobz == 'V' ? 14 * n * n * n / 3 : 4 * n * n * n / 3;
+    }
+    // ?syevr/?heevr for m eigenpairs: the reduction, plus the back-transformation of m vectors
+    inline double syevr_flops(const char &jobz, const double &n, const double &m) {
+      return 4 * n * n * n / 3 + (jobz == 'V' ? 2 * n * n * m : 0);
+    }
+    // jobu/jobvt as for ?gesvd: 'A' full, 'S'/'O' thin, 'N' no vectors
+    inline double gesvd_flops(const char &jobu, const char &jobvt, const double &m,
+                              const double &n) {
+      const double big = std::max(m, n), k = std::min(m, n);
+      if (jobu == 'N' && jobvt == 'N') return 4 * big * k * k - 4 * k * k * k / 3;
+      if (jobu == 'A' || jobvt == 'A') return 4 * big * big * k + 8 * big * k * k + 9 * k * k * k;
+      return 14 * big * k * k + 8 * k * k * k;
+    }
+    // the elements of a, u and vt touched by ?gesvd
+    inline double gesvd_elems(const char &jobu, const char &jobvt, const double &m,
+                              const double &n) {
+      const double k = std::min(m, n);
+      const double u = jobu == 'A' ? m * m : (jobu == 'S' ? m * k : 0);
+      const double vt = jobvt == 'A' ? n * n : (jobvt == 'S' ? k * n : 0);
+      return 2 * m * n + u + vt;
+    }
+
+    /// @cond
+    extern std::atomic<bool> _enabled;
+
+    void record(const unsigned int &routine, const unsigned int &dtype, const double &flops,
+                const double &bytes, const std::uint64_t &ns);
+
+    // RAII counter of one wrapper call; counted = false for e.g. workspace queries
+    class Count {
+     public:
+      Count(const unsigned int &routine, const unsigned int &dtype, const double &flops,
+            const double &bytes, const bool &counted = true)
+          : _on(counted && _enabled.load(std::memory_order_relaxed)),
+            _routine(routine),
+            _dtype(dtype),
+            _flops(flops),
+            _bytes(bytes),
+            _begin(_on ? trace::now_ns() : 0) {}
+      ~Count() {
+        if (_on) record(_routine, _dtype, _flops, _bytes, trace::now_ns() - _begin);
+      }
+      Count(const Count &) = delete;
+      Count &operator=(const Count &) = delete;
+
+     private:
+      bool _on;
+      unsigned int _routine, _dtype;
+      double _flops, _bytes;
+      std::uint64_t _begin;
+    };
+    /// @endcond
+
+  }  // namespace counters
+}  // namespace cytnx_core
+
+// count a call of routine (a counters::Routine) on elements of type T, doing the given number of
+// real-routine flops and touching the given number of elements
+#define CYTNX_COUNT_OP(routine, T, flops, elems, ...)                                    \
+  cytnx_core::counters::Count CYTNX_TRACE_CAT(_cytnx_count_, __LINE__)(                  \
+    cytnx_core::counters::routine, cytnx_core::Type_class::cy_typeid_v<T>,               \
+    cytnx_core::counters::flop_factor<T> * (flops), sizeof(T) * (elems), ##__VA_ARGS__)
+
+#endif  // CYTNX_CORE_COUNTERS_H_
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include <cytnx_core/Type.hpp>
+
 namespace cytnx_core {
 
   /// @cond
@@ -17,9 +19,25 @@ namespace cytnx_core {
     int Ngpus;
     int Ncpus;
     std::vector<std::vector<bool>> CanAccessPeer;
+
+    // CPU topology, discovered from sysfs (Linux) with sysconf/cpuid fallbacks.
+    std::string Cpu_model;
+    int Nsockets;
+    int Nnuma;
+    int Ncores;  // physical cores over all sockets
+    int Nsmt;  // hardware threads (SMT siblings) per physical core
+    cytnx_uint64 L1d_size;  // bytes, per core
+    cytnx_uint64 L2_size;  // bytes, per core
+    cytnx_uint64 L3_size;  // bytes, per last-level cache domain (shared)
+    cytnx_uint64 Cacheline_size;  // bytes
+    std::vector<std::string> Simd;  // supported SIMD extensions, e.g. "avx2", "avx512f"
+
     Device_class();
     void print_property();
     std::string getname(const int &device_id);
+    bool has_simd(const std::string &ext) const;
+    // a string identifying the CPU model, topology, caches and SIMD set of this machine
+    std::string cpu_signature() const;
     ~Device_class();
     // void cudaDeviceSynchronize();
   };
@@ -0,0 +1,115 @@
+#ifndef CYTNX_FLOAT16_H_
+#define CYTNX_FLOAT16_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace cytnx_core {
+
+  /// @cond
+  namespace internal {
+    inline std::uint32_t float_bits(const float &f) {
+      std::uint32_t x;
+      std::memcpy(&x, &f, sizeof(x));
+      return x;
+    }
+    inline float bits_float(const std::uint32_t &x) {
+      float f;
+      std::memcpy(&f, &x, sizeof(f));
+      return f;
+    }
+
+    // IEEE binary16, rounding to nearest even
+    inline std::uint16_t float_to_half_bits(const float &f) {
+      std::uint32_t x = float_bits(f);
+      const std::uint16_t sign = (x >> 16) & 0x8000;
+      x &= 0x7fffffff;
+      if (x > 0x7f800000) return sign | 0x7e00;  // NaN
+      if (x >= 0x477ff000) return sign | 0x7c00;  // rounds to infinity
+      if (x < 0x38800000) {
+        // a subnormal half: adding 0.5 aligns the value to the half ulp 2^-24 and rounds it
+        return sign | std::uint16_t(float_bits(bits_float(x) + 0.5f) - 0x3f000000);
+      }
+      x += 0xc8000fff + ((x >> 13) & 1);  // rebias the exponent by -112 and round
+      return sign | std::uint16_t(x >> 13);
+    }
+
+    inline float half_bits_to_float(const std::uint16_t &h) {
+      const std::uint32_t sign = std::uint32_t(h & 0x8000) << 16;
+      const std::uint32_t exp = (h >> 10) & 0x1f, mant = h & 0x3ff;
+      if (exp == 0) {
+        const float f = float(mant) * 0x1p-24f;
+        return sign ? -f : f;
+      }
+      if (exp == 0x1f) return bits_float(sign | 0x7f800000 | (mant << 13));
+      return bits_float(sign | ((exp + 112) << 23) | (mant << 13));
+    }
+
+    // the upper half of a binary32, rounding to nearest even
+    inline std::uint16_t float_to_bfloat16_bits(const float &f) {
+      const std::uint32_t x = float_bits(f);
+      if ((x & 0x7fffffff) > 0x7f800000) return std::uint16_t((x >> 16) | 0x40);  // quiet NaN
+      return std::uint16_t((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+    }
+
+    inline float bfloat16_bits_to_float(const std::uint16_t &b) {
+      return bits_float(std::uint32_t(b) << 16);
+    }
+  }  // namespace internal
+  /// @endcond
+
+  /**
+   * @brief IEEE 754 half precision (binary16) storage type.
+   *
+   * @details Values convert implicitly to and from float; arithmetic is done in float and
+   * rounded once when stored back, so expressions of cytnx_float16 evaluate in float.
+   */
+  struct cytnx_float16 {
+    std::uint16_t bits;
+
+    cytnx_float16() = default;
+    cytnx_float16(const float &f) : bits(internal::float_to_half_bits(f)) {}
+    operator float() const { return internal::half_bits_to_float(bits); }
+
+    static cytnx_float16 from_bits(const std::uint16_t &b) {
+      cytnx_float16 h;
+      h.bits = b;
+      return h;
+    }
+
+    cytnx_float16 &operator+=(const float &rhs) { return *this = float(*this) + rhs; }
+    cytnx_float16 &operator-=(const float &rhs) { return *this = float(*this) - rhs; }
+    cytnx_float16 &operator*=(const float &rhs) { return *this = float(*this) * rhs; }
+    cytnx_float16 &operator/=(const float &rhs) { return *this = float(*this) / rhs; }
+  };
+
+  /**
+   * @brief bfloat16 storage type: the upper 16 bits of a binary32.
+   *
+   * @details Same range as float with an 8-bit significand. Converts like cytnx_float16.
+   */
+  struct cytnx_bfloat16 {
+    std::uint16_t bits;
+
+    cytnx_bfloat16() = default;
+    cytnx_bfloat16(const float &f) : bits(internal::float_to_bfloat16_bits(f)) {}
+    operator float() const { return internal::bfloat16_bits_to_float(bits); }
+
+    static cytnx_bfloat16 from_bits(const std::uint16_t &b) {
+      cytnx_bfloat16 h;
+      h.bits = b;
+      return h;
+    }
+
+    cytnx_bfloat16 &operator+=(const float &rhs) { return *this = float(*this) + rhs; }
+    cytnx_bfloat16 &operator-=(const float &rhs) { return *this = float(*this) - rhs; }
+    cytnx_bfloat16 &operator*=(const float &rhs) { return *this = float(*this) * rhs; }
+    cytnx_bfloat16 &operator/=(const float &rhs) { return *this = float(*this) / rhs; }
+  };
+
+  static_assert(sizeof(cytnx_float16) == 2 && sizeof(cytnx_bfloat16) == 2,
+                "16-bit floating point types must be 2 bytes");
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_FLOAT16_H_
@@ -0,0 +1,85 @@
+#ifndef CYTNX_KRYLOVEXPMV_H_
+#define CYTNX_KRYLOVEXPMV_H_
+
+#include <memory>
+#include <vector>
+
+#include <cytnx_core/LinOp.hpp>
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/StorageView.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  namespace utils_internal {
+    struct ExpmWork;
+  }
+
+  /**
+   * @brief The action exp(t A) v of the exponential of a LinOp A on a vector, by Krylov
+   * projection, for time evolution: exp(-iHt) v is apply(v, -1i * t) with A = H.
+   *
+   * @details Each step builds an orthonormal basis of the Krylov space {v, A v, ..., A^(m-1) v}
+   * by Arnoldi with a second Gram-Schmidt pass (zgemv), and takes the exponential of the
+   * projected m x m Hessenberg matrix by Padé approximation (see linalg::Expm()). The steps are
+   * sized adaptively as in Expokit (Sidje, ACM TOMS 24, 1998): a step is shrunk and retried,
+   * without new products by A, while its local error estimate exceeds tol per unit of |t|, and
+   * the next step grows from the error of the last. An invariant Krylov space (a happy
+   * breakdown) ends the evolution exactly.
+   *
+   * The basis, the projected matrix and all scratch are allocated once, at construction, and
+   * reused by every apply(), so a time stepping loop does not allocate. A is applied to one
+   * vector at a time; a real (Double) A is applied to the real and imaginary parts of a vector
+   * together, as a block of two columns (see LinOp::matmat()).
+   *
+   * The LinOp is referred to, not copied, and must outlive the KrylovExpmv.
+   */
+  class KrylovExpmv {
+   public:
+    /**
+     * @param op the square operator A, of dtype Double or ComplexDouble
+     * @param krylov_dim the dimension m of the Krylov space of each step, capped at op.nx()
+     * @param tol the error allowed per unit of |t|, relative to the norm of v
+     */
+    explicit KrylovExpmv(const LinOp &op, const cytnx_uint64 &krylov_dim = 30,
+                         const double &tol = 1e-12);
+    ~KrylovExpmv();
+
+    const LinOp &op() const { return *_op; }
+    cytnx_uint64 krylov_dim() const { return _m; }
+    double tol() const { return _tol; }
+
+    // v = exp(t A) v in place, for a ComplexDouble Storage of op().nx() elements
+    void apply(Storage &v, const cytnx_complex128 &t);
+
+    // what the last apply() did
+    struct Stats {
+      cytnx_uint64 steps = 0;     // accepted steps
+      cytnx_uint64 rejected = 0;  // steps shrunk and retried
+      cytnx_uint64 matvecs = 0;   // products by A
+      double error = 0;           // sum of the local error estimates, relative to |v|
+    };
+    const Stats &stats() const { return _stats; }
+
+   private:
+    const LinOp *_op;
+    cytnx_uint64 _n;
+    cytnx_uint64 _m;
+    double _tol;
+    Stats _stats;
+    // the Krylov basis, m + 2 vectors of n, one after the other
+    std::vector<cytnx_complex128> _basis;
+    // the (m + 2) x (m + 2) projected matrix, its exponential and the Gram-Schmidt coefficients
+    std::vector<cytnx_complex128> _h, _f, _g;
+    std::unique_ptr<utils_internal::ExpmWork> _work;
+    // the operands of A: a ComplexDouble x and y, or n x 2 Double views for a real A
+    Storage _x, _y;
+    StorageView _xv, _yv;
+
+    // out = A in, both n elements of the basis or of v
+    void apply_op(const cytnx_complex128 *in, cytnx_complex128 *out);
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_KRYLOVEXPMV_H_
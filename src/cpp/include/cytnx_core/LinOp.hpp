@@ -0,0 +1,113 @@
+#ifndef CYTNX_LINOP_H_
+#define CYTNX_LINOP_H_
+
+#include <cytnx_core/SparseMatrix.hpp>
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/StorageView.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief A square linear operator of dimension nx known only by its action, the input of
+   * iterative solvers.
+   *
+   * @details matvec() applies the operator to one vector, matmat() to a block of k vectors at
+   * once, held as the columns of a row-major nx x k view. A block lets an operator use one
+   * matrix-matrix product instead of k matrix-vector ones (gemm instead of gemv for a dense
+   * matrix, one SpMM pass over the nonzeros for a sparse one), so solvers working on several
+   * vectors should prefer it.
+   *
+   * A subclass overrides apply_vec(), apply_block() or both; each one defaults to the other,
+   * apply_block() by applying apply_vec() column by column. The public calls check the shapes
+   * and dtypes, so the overrides get contiguous operands of dtype() and the right size.
+   */
+  class LinOp {
+   public:
+    LinOp(const cytnx_uint64 &nx, const unsigned int &dtype = Type.Double);
+    virtual ~LinOp() = default;
+
+    cytnx_uint64 nx() const { return _nx; }
+    unsigned int dtype() const { return _dtype; }
+
+    // y = A x; x and y hold nx elements of dtype() and must not share memory
+    void matvec(const Storage &x, Storage &y) const;
+    Storage matvec(const Storage &x) const;
+
+    // Y = A X for a rank-2 view X of nx x k; y must be a contiguous nx x k view of dtype(),
+    // which is detached from a shared buffer first (see StorageView::mutable_data())
+    void matmat(const StorageView &x, StorageView &y) const;
+    // returns a contiguous nx x k view
+    StorageView matmat(const StorageView &x) const;
+
+   protected:
+    // y = A x, y to be overwritten
+    virtual void apply_vec(const Storage &x, Storage &y) const;
+    // Y = A X with x and y contiguous nx x k views, y unshared and to be overwritten
+    virtual void apply_block(const StorageView &x, StorageView &y) const;
+
+   private:
+    cytnx_uint64 _nx;
+    unsigned int _dtype;
+  };
+
+  /**
+   * @brief A LinOp of elements T, any type of Type_list, implemented on raw memory.
+   * @details A subclass implements apply(), which serves both matvec() (k = 1) and matmat().
+   */
+  template <class T>
+  class TypedLinOp : public LinOp {
+    static_assert(Type_class::cy_typeid_v<T> < N_Type, "T must be a type of Type_list");
+
+   public:
+    explicit TypedLinOp(const cytnx_uint64 &nx) : LinOp(nx, Type_class::cy_typeid_v<T>) {}
+
+   protected:
+    // y = A x for x and y of nx x k elements, row-major (vector i is the column x[j * k + i])
+    virtual void apply(const T *x, T *y, const cytnx_uint64 &k) const = 0;
+
+    void apply_vec(const Storage &x, Storage &y) const override {
+      apply(x.data<T>(), y.data<T>(), 1);
+    }
+    void apply_block(const StorageView &x, StorageView &y) const override {
+      apply(static_cast<const T *>(x.data()), static_cast<T *>(y.mutable_data()), x.shape()[1]);
+    }
+  };
+
+  /**
+   * @brief The LinOp of a square dense matrix, a rank-2 view of Double, Float, ComplexDouble or
+   * ComplexFloat. A block goes to gemm, a vector to gemv; transposed and conjugated views are
+   * applied without copies (see linalg::Matmul()).
+   */
+  class DenseLinOp : public LinOp {
+   public:
+    explicit DenseLinOp(const StorageView &matrix);
+    const StorageView &matrix() const { return _matrix; }
+
+   protected:
+    void apply_vec(const Storage &x, Storage &y) const override;
+    void apply_block(const StorageView &x, StorageView &y) const override;
+
+   private:
+    StorageView _matrix;
+  };
+
+  /**
+   * @brief The LinOp of a square CsrMatrix, applied with its multithreaded SpMV and SpMM.
+   */
+  class SparseLinOp : public LinOp {
+   public:
+    explicit SparseLinOp(const CsrMatrix &matrix);
+    const CsrMatrix &matrix() const { return _matrix; }
+
+   protected:
+    void apply_vec(const Storage &x, Storage &y) const override;
+    void apply_block(const StorageView &x, StorageView &y) const override;
+
+   private:
+    CsrMatrix _matrix;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_LINOP_H_
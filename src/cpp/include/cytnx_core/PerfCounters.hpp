@@ -0,0 +1,121 @@
+#ifndef CYTNX_CORE_PERFCOUNTERS_H_
+#define CYTNX_CORE_PERFCOUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Trace.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Hardware performance counters of named code regions, read with perf_event_open.
+   *
+   * @details Each thread opens one counter group on its first region while enabled; a region
+   * reads the group when it is entered and left and adds the difference to the totals of its
+   * name. Regions nest, and each is counted inclusively. The counters follow the thread that
+   * entered the region only: the work of OpenMP threads forked inside it is not included, so
+   * profile such kernels with a single thread.
+   * \code
+   * void my_kernel(...) {
+   *   CYTNX_PERF_SCOPE("kernel.my_kernel");  // must be a string literal
+   *   ...
+   * }
+   * perf::enable();
+   * ...
+   * std::cout << perf::report();
+   * \endcode
+   *
+   * The counters are only available on Linux, and only when the kernel allows it (see
+   * /proc/sys/kernel/perf_event_paranoid; containers and VMs often hide the hardware events).
+   * Events that cannot be opened are reported as missing, and regions always count their calls
+   * and wall time, so the same code runs everywhere. Counts are scaled up when the kernel
+   * multiplexes the group. While disabled, a region costs a relaxed atomic load.
+   */
+  namespace perf {
+
+    enum Event : unsigned int {
+      Cycles,
+      Instructions,
+      CacheReferences,
+      CacheMisses,
+      DTLBMisses,  // data TLB load misses
+      BranchMisses,
+      PageFaults,
+      N_Event
+    };
+    const char *event_name(const unsigned int &event);
+
+    /**
+     * @brief whether at least one event can be counted.
+     * @details probed once, on the calling thread; status() tells why events are missing.
+     */
+    bool available();
+    // whether each event can be counted
+    std::array<bool, N_Event> events();
+    std::string status();
+
+    void enable(const bool &on = true);
+    void disable();
+    bool enabled();
+
+    // zero the totals of all regions
+    void reset();
+
+    struct Region {
+      std::string name;
+      std::uint64_t calls;
+      double seconds;
+      std::array<double, N_Event> counts;  // < 0 for events that could not be counted
+      double ipc() const {
+        return counts[Cycles] > 0 && counts[Instructions] >= 0
+                 ? counts[Instructions] / counts[Cycles]
+                 : -1;
+      }
+    };
+
+    // the totals of each region name, summed over threads, in name order
+    std::vector<Region> regions();
+
+    // the totals as a table, with IPC and the miss rates per thousand instructions
+    std::string report();
+
+    /// @cond
+    extern std::atomic<bool> _enabled;
+
+    struct Sample {
+      std::uint64_t ns;
+      std::array<double, N_Event> counts;
+    };
+    void begin(Sample &s);
+    void end(const char *name, const Sample &begin);
+
+    // RAII region, see CYTNX_PERF_SCOPE
+    class Scope {
+     public:
+      explicit Scope(const char *name)
+          : _name(_enabled.load(std::memory_order_relaxed) ? name : nullptr) {
+        if (_name) begin(_begin);
+      }
+      ~Scope() {
+        if (_name) end(_name, _begin);
+      }
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+     private:
+      const char *_name;
+      Sample _begin;
+    };
+    /// @endcond
+
+  }  // namespace perf
+}  // namespace cytnx_core
+
+#define CYTNX_PERF_SCOPE(name) \
+  cytnx_core::perf::Scope CYTNX_TRACE_CAT(_cytnx_perf_scope_, __LINE__)(name)
+
+#endif  // CYTNX_CORE_PERFCOUNTERS_H_
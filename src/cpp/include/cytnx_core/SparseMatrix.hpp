@@ -0,0 +1,126 @@
+#ifndef CYTNX_SPARSEMATRIX_H_
+#define CYTNX_SPARSEMATRIX_H_
+
+#include <vector>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/StorageView.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief What a CsrMatrix stores: all of a general matrix, or only the upper triangle (with
+   * the diagonal) of a symmetric or Hermitian one.
+   */
+  enum class SparseSymmetry : int { General = 0, Symmetric = 1, Hermitian = 2 };
+
+  class CsrMatrix;
+
+  /**
+   * @brief A sparse matrix as (row, col, value) triplets, the form a Hamiltonian is assembled
+   * in. Triplets may repeat and come in any order; to_csr() sums and sorts them.
+   */
+  class CooMatrix {
+   public:
+    CooMatrix();
+
+    // the triplets (rows[i], cols[i], values[i]) of an nrows x ncols matrix; values is a CPU
+    // Storage of Double, Float, ComplexDouble or ComplexFloat
+    CooMatrix(const cytnx_uint64 &nrows, const cytnx_uint64 &ncols,
+              const std::vector<cytnx_uint64> &rows, const std::vector<cytnx_uint64> &cols,
+              const Storage &values);
+
+    cytnx_uint64 nrows() const { return _nrows; }
+    cytnx_uint64 ncols() const { return _ncols; }
+    // the number of triplets, counting repeats
+    cytnx_uint64 nnz() const { return _rows.size(); }
+    unsigned int dtype() const { return _values.dtype(); }
+    const std::vector<cytnx_uint64> &rows() const { return _rows; }
+    const std::vector<cytnx_uint64> &cols() const { return _cols; }
+    const Storage &values() const { return _values; }
+
+    /**
+     * @brief The CSR form, with repeated triplets summed in the order given.
+     * @details For SparseSymmetry::Symmetric or Hermitian the triplets must all be in the
+     * upper triangle (col >= row); one below the diagonal is an error. The triplets are sorted
+     * in parallel.
+     */
+    CsrMatrix to_csr(const SparseSymmetry &symmetry = SparseSymmetry::General) const;
+
+   private:
+    cytnx_uint64 _nrows;
+    cytnx_uint64 _ncols;
+    std::vector<cytnx_uint64> _rows;
+    std::vector<cytnx_uint64> _cols;
+    Storage _values;
+  };
+
+  /**
+   * @brief A sparse matrix in compressed sparse row form, with a multithreaded product by
+   * dense vectors and blocks of vectors.
+   *
+   * @details The rows are split once, at construction, into one block per thread with about
+   * the same number of nonzeros each, so matvec() and matmat() stay balanced on matrices whose
+   * rows fill very unevenly. A symmetric or Hermitian matrix may keep only its upper triangle,
+   * which halves the memory and the bytes read per product.
+   *
+   * matvec(x, y) writes into memory the caller holds and is the form to hand to an iterative
+   * eigensolver. Like a Storage, copying a CsrMatrix shares the values. Only CPU Storages are
+   * supported.
+   */
+  class CsrMatrix {
+   public:
+    CsrMatrix();
+
+    /**
+     * @param indptr nrows + 1 offsets into indices and values, from 0 to nnz
+     * @param indices the column of each nonzero, in any order within a row
+     * @param values nnz values of Double, Float, ComplexDouble or ComplexFloat
+     * @param symmetry for Symmetric or Hermitian the matrix must be square and every column
+     * index at least its row
+     */
+    CsrMatrix(const cytnx_uint64 &nrows, const cytnx_uint64 &ncols,
+              const std::vector<cytnx_uint64> &indptr, const std::vector<cytnx_uint64> &indices,
+              const Storage &values, const SparseSymmetry &symmetry = SparseSymmetry::General);
+
+    cytnx_uint64 nrows() const { return _nrows; }
+    cytnx_uint64 ncols() const { return _ncols; }
+    // the stored nonzeros, those of the upper triangle only for a half-stored matrix
+    cytnx_uint64 nnz() const { return _indices.size(); }
+    unsigned int dtype() const { return _values.dtype(); }
+    SparseSymmetry symmetry() const { return _symmetry; }
+    const std::vector<cytnx_uint64> &indptr() const { return _indptr; }
+    const std::vector<cytnx_uint64> &indices() const { return _indices; }
+    const Storage &values() const { return _values; }
+    // the first row of each thread's block, then nrows
+    const std::vector<cytnx_uint64> &row_blocks() const { return _bounds; }
+
+    // y = A x; x has ncols elements, y nrows, both of dtype(), and they must not overlap
+    void matvec(const Storage &x, Storage &y) const;
+    Storage matvec(const Storage &x) const;
+
+    // Y = A X for a rank-2 view X of ncols x k; returns a contiguous nrows x k view
+    StorageView matmat(const StorageView &x) const;
+    // the same into y, a contiguous nrows x k view of dtype(), detached from a shared buffer
+    // first (see StorageView::mutable_data())
+    void matmat(const StorageView &x, StorageView &y) const;
+
+    // the full matrix as a row-major Storage of nrows * ncols elements
+    Storage to_dense() const;
+
+   private:
+    cytnx_uint64 _nrows;
+    cytnx_uint64 _ncols;
+    std::vector<cytnx_uint64> _indptr;
+    std::vector<cytnx_uint64> _indices;
+    Storage _values;
+    SparseSymmetry _symmetry;
+    // the row blocks, and for a half-stored matrix the scatter reach of each
+    std::vector<cytnx_uint64> _bounds;
+    std::vector<cytnx_uint64> _reach;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_SPARSEMATRIX_H_
@@ -0,0 +1,78 @@
+#ifndef CYTNX_SPLITCOMPLEXSTORAGE_H_
+#define CYTNX_SPLITCOMPLEXSTORAGE_H_
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief ComplexDouble or ComplexFloat elements held in split (structure of arrays) layout.
+   *
+   * @details The real parts and the imaginary parts live in two Double (or Float) Storages.
+   * Element-wise products and reductions then run on full vectors of one part with no
+   * shuffles, while the interleaved layout of a Storage is kept for BLAS and LAPACK.
+   * to_interleaved(Storage &) and assign() convert at such a call boundary into memory the
+   * caller already holds, without allocating.
+   *
+   * Like a Storage, copying a SplitComplexStorage shares the planes; use clone() for a deep
+   * copy. Only CPU Storages are supported.
+   */
+  class SplitComplexStorage {
+   public:
+    SplitComplexStorage();
+
+    // size zero elements of dtype ComplexDouble or ComplexFloat
+    explicit SplitComplexStorage(const cytnx_uint64 &size,
+                                 const unsigned int &dtype = Type.ComplexDouble);
+
+    // a split copy of an interleaved ComplexDouble or ComplexFloat Storage
+    static SplitComplexStorage from_interleaved(const Storage &in);
+
+    // a new interleaved Storage of dtype()
+    Storage to_interleaved() const;
+
+    // write the elements interleaved into out, which must have the same size and dtype
+    void to_interleaved(Storage &out) const;
+
+    // overwrite the elements from an interleaved Storage of the same size and dtype
+    void assign(const Storage &in);
+
+    cytnx_uint64 size() const { return _real.size(); }
+    // ComplexDouble or ComplexFloat, Void when empty
+    unsigned int dtype() const { return _dtype; }
+    int device() const { return _real.device(); }
+
+    // the planes of real and imaginary parts, Double or Float
+    const Storage &real() const { return _real; }
+    const Storage &imag() const { return _imag; }
+
+    SplitComplexStorage clone() const;
+
+    // this += rhs
+    void add(const SplitComplexStorage &rhs);
+    // this *= rhs, element-wise
+    void mul(const SplitComplexStorage &rhs);
+    // this *= alpha
+    void scale(const cytnx_complex128 &alpha);
+    // this += alpha * x
+    void axpy(const cytnx_complex128 &alpha, const SplitComplexStorage &x);
+
+    // the sum of the elements
+    cytnx_complex128 sum() const;
+    // the sum of conj(this) * rhs
+    cytnx_complex128 vdot(const SplitComplexStorage &rhs) const;
+    // the 2-norm
+    double norm() const;
+
+   private:
+    Storage _real;
+    Storage _imag;
+    unsigned int _dtype;
+
+    void check_same(const SplitComplexStorage &rhs, const char *op) const;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_SPLITCOMPLEXSTORAGE_H_
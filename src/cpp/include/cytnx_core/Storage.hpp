@@ -0,0 +1,92 @@
+#ifndef CYTNX_STORAGE_H_
+#define CYTNX_STORAGE_H_
+
+#include <memory>
+#include <string>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Type.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief A contiguous, typed memory buffer on a device.
+   *
+   * @details A Storage holds `size()` elements of the type `dtype()` (an id into Type_list) on
+   * `device()`. Copying a Storage is cheap and shares the buffer; use clone() for a deep copy.
+   *
+   * The buffer is either allocated by the Storage itself, or wraps external memory without a
+   * copy (see from_external()), in which case an owner object keeps the memory alive for as long
+   * as any Storage refers to it.
+   */
+  class Storage {
+   public:
+    Storage();
+
+    /**
+     * @brief allocate a new buffer.
+     * @param size the number of elements
+     * @param dtype the data type, see @ref Type
+     * @param device the device, see @ref Device
+     * @param init_zero zero-initialize the elements
+     */
+    explicit Storage(const cytnx_uint64 &size, const unsigned int &dtype = Type.Double,
+                     const int &device = Device.cpu, const bool &init_zero = true);
+
+    /**
+     * @brief wrap external memory without copying.
+     * @param ptr the first element
+     * @param size the number of elements
+     * @param dtype the data type of the elements
+     * @param device the device holding the memory
+     * @param owner keeps the memory alive; its deleter runs when the last Storage referring to
+     * the memory is destroyed
+     */
+    static Storage from_external(void *ptr, const cytnx_uint64 &size, const unsigned int &dtype,
+                                 const int &device, std::shared_ptr<void> owner);
+
+    void *data() const { return _data; }
+
+    template <class T>
+    T *data() const {
+      cytnx_check_msg(Type_class::cy_typeid_v<T> != _dtype,
+                      "[ERROR] data<%s>() called on a Storage of type %s.", Type_names<T>,
+                      Type.getname(_dtype).c_str());
+      return static_cast<T *>(_data);
+    }
+
+    cytnx_uint64 size() const { return _size; }
+    cytnx_uint64 nbytes() const { return _size * Type.typeSize(_dtype); }
+    unsigned int dtype() const { return _dtype; }
+    std::string dtype_str() const { return Type.getname(_dtype); }
+    int device() const { return _device; }
+    std::string device_str() const { return Device.getname(_device); }
+
+    // whether both Storages refer to the same memory
+    bool same_data(const Storage &rhs) const { return _data == rhs._data; }
+
+    // the number of Storages (and views) sharing the memory, 0 for an empty Storage
+    long use_count() const { return _mem.use_count(); }
+
+    // a deep copy on the same device
+    Storage clone() const;
+
+    // a deep copy converted to dtype; complex to real conversions are rejected
+    Storage astype(const unsigned int &dtype) const;
+
+    // assign val, converted to dtype(), to all elements
+    template <class T>
+    void fill(const T &val);
+
+   private:
+    std::shared_ptr<void> _mem;  // owns the memory
+    void *_data;
+    cytnx_uint64 _size;
+    unsigned int _dtype;
+    int _device;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_STORAGE_H_
@@ -0,0 +1,119 @@
+#ifndef CYTNX_STORAGEVIEW_H_
+#define CYTNX_STORAGEVIEW_H_
+
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief A strided, shaped window into a Storage.
+   *
+   * @details A StorageView is a Storage plus an element offset, a shape and per-axis strides in
+   * elements. slice(), permute() and reshape() of a contiguous view only build new metadata
+   * around the same buffer, so they are O(rank) regardless of the number of elements; a copy of
+   * the elements happens only in contiguous(), or in reshape() of a view whose axes cannot be
+   * merged.
+   *
+   * Views share their buffer with copy-on-write semantics: data() reads in place, while
+   * mutable_data() first detaches a private contiguous copy if any other Storage or view still
+   * refers to the buffer. Writing through storage() directly bypasses this.
+   *
+   * A view of a complex type may carry a lazy conjugation, see conj(). Consumers that can apply
+   * it themselves (e.g. gemm with transa = 'C', see linalg::Matmul) read the stored elements
+   * through data(); contiguous(), to_storage() and mutable_data() apply it while copying.
+   *
+   * Copies share the buffer and moves never touch the elements, so views are cheap to pass by
+   * value.
+   */
+  class StorageView {
+   public:
+    StorageView();
+
+    // a 1-D view of all elements of storage
+    explicit StorageView(const Storage &storage);
+
+    // a contiguous view of all elements of storage, product(shape) must equal storage.size()
+    StorageView(const Storage &storage, const std::vector<cytnx_uint64> &shape);
+
+    /**
+     * @brief a view of arbitrary layout.
+     * @param storage the buffer
+     * @param offset the element of storage at index (0, ..., 0)
+     * @param shape the extent of each axis
+     * @param strides the elements between consecutive indices of each axis; every index must
+     * stay inside storage
+     */
+    StorageView(const Storage &storage, const cytnx_uint64 &offset,
+                const std::vector<cytnx_uint64> &shape, const std::vector<cytnx_uint64> &strides);
+
+    const Storage &storage() const { return _storage; }
+    cytnx_uint64 offset() const { return _offset; }
+    const std::vector<cytnx_uint64> &shape() const { return _shape; }
+    const std::vector<cytnx_uint64> &strides() const { return _strides; }
+    cytnx_uint64 rank() const { return _shape.size(); }
+    cytnx_uint64 size() const;
+    unsigned int dtype() const { return _storage.dtype(); }
+    int device() const { return _storage.device(); }
+
+    // whether the elements are laid out row-major without gaps
+    bool is_contiguous() const;
+
+    // whether the elements are the complex conjugates of the stored ones
+    bool is_conj() const { return _conj; }
+
+    // the complex conjugate, sharing the buffer; the same view for a real dtype
+    StorageView conj() const;
+
+    // the elements [start, stop) of axis with the given step, sharing the buffer
+    StorageView slice(const cytnx_uint64 &axis, const cytnx_uint64 &start,
+                      const cytnx_uint64 &stop, const cytnx_uint64 &step = 1) const;
+
+    // axis i of the result is axis axes[i] of this view, sharing the buffer
+    StorageView permute(const std::vector<cytnx_uint64> &axes) const;
+
+    // permute() swapping two axes
+    StorageView transpose(const cytnx_uint64 &a, const cytnx_uint64 &b) const;
+
+    /**
+     * @brief the same elements in row-major order with a new shape.
+     * @details Shares the buffer when the axes being merged or split are contiguous with each
+     * other, which always holds for a contiguous view; copies otherwise.
+     */
+    StorageView reshape(const std::vector<cytnx_uint64> &shape) const;
+
+    // this view if it is contiguous and not conjugated, otherwise a packed copy in a new buffer
+    StorageView contiguous() const;
+
+    // a Storage of the size() elements in row-major order; shares the buffer when the view
+    // covers all of it in order and is not conjugated, copies otherwise
+    Storage to_storage() const;
+
+    // the stored element at index (0, ..., 0), for reading only; not conjugated by is_conj()
+    const void *data() const;
+
+    // the element at index (0, ..., 0), after detaching a private copy if the buffer is shared
+    // or the view is conjugated
+    void *mutable_data();
+
+    // whether the buffer is referred to by anything but this view
+    bool is_shared() const { return _storage.use_count() > 1; }
+
+    std::string str() const;
+
+   private:
+    Storage _storage;
+    cytnx_uint64 _offset;
+    std::vector<cytnx_uint64> _shape;
+    std::vector<cytnx_uint64> _strides;
+    bool _conj;
+
+    StorageView copy_packed() const;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_STORAGEVIEW_H_
@@ -0,0 +1,67 @@
+#ifndef CYTNX_THREADPOOL_H_
+#define CYTNX_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cytnx_core {
+
+  /**
+   * @brief A fixed-size pool of worker threads running submitted tasks in FIFO order.
+   *
+   * @details Meant for coarse-grained tasks (a whole decomposition, a file write, ...) that run
+   * alongside the caller; fine-grained parallelism inside a kernel uses OpenMP as before.
+   *
+   * The process-wide pool returned by global() has `Device.Ncores` workers, overridable by the
+   * environment variable CYTNX_NUM_WORKERS.
+   */
+  class ThreadPool {
+   public:
+    explicit ThreadPool(int nthreads);
+    ~ThreadPool();  // finishes the queued tasks, then joins the workers
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static ThreadPool &global();
+
+    int size() const { return static_cast<int>(_workers.size()); }
+
+    // schedule f() and return a future of its result; exceptions are stored in the future
+    template <class F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F &&f) {
+      using R = std::invoke_result_t<std::decay_t<F>>;
+      auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+      std::future<R> out = task->get_future();
+      enqueue([task]() { (*task)(); });
+      return out;
+    }
+
+    // schedule a task without a future; it must not throw
+    void enqueue(std::function<void()> task);
+
+    // block until the queue is empty and no task is running
+    void wait_idle();
+
+   private:
+    void worker_loop();
+
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _queue;
+    std::mutex _mtx;
+    std::condition_variable _cv_task;
+    std::condition_variable _cv_idle;
+    int _running;
+    bool _stop;
+  };
+
+}  // namespace cytnx_core
+
+#endif  // CYTNX_THREADPOOL_H_
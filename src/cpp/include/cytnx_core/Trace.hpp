@@ -0,0 +1,92 @@
+#ifndef CYTNX_CORE_TRACE_H_
+#define CYTNX_CORE_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Low-overhead tracing of library internals, exported in the Chrome trace format.
+   *
+   * @details Spans are only compiled in when the library is built with UNI_TRACE (CMake option
+   * USE_TRACE); otherwise CYTNX_TRACE_SCOPE expands to nothing. When compiled in, a span costs a
+   * relaxed atomic load while tracing is disabled, and two clock reads and a store into the ring
+   * buffer of the calling thread while enabled; no locks are taken after the first span of a
+   * thread.
+   * \code
+   * void my_kernel(...) {
+   *   CYTNX_TRACE_SCOPE("kernel.my_kernel");  // must be a string literal
+   *   ...
+   * }
+   * trace::enable();
+   * ...
+   * trace::dump_chrome("trace.json");  // open in chrome://tracing or ui.perfetto.dev
+   * \endcode
+   *
+   * The text of a span name before the first '.' is used as its category. Each thread keeps its
+   * most recent ring_capacity spans; when it exits they are merged into the most recent
+   * ring_capacity spans of all finished threads, and its buffer is reused by the next new thread.
+   * Setting the environment variable CYTNX_TRACE=<path> enables tracing at startup and writes
+   * the trace to <path> at exit.
+   */
+  namespace trace {
+
+    // the number of spans each thread keeps
+    constexpr std::uint64_t ring_capacity = 1 << 16;
+
+    // whether spans were compiled in (UNI_TRACE)
+    bool compiled();
+
+    void enable(const bool &on = true);
+    void disable();
+    bool enabled();
+
+    // drop the recorded spans of all threads
+    void clear();
+
+    // the number of recorded spans currently held, over all threads
+    std::uint64_t num_events();
+
+    // the recorded spans as Chrome trace JSON; spans still being recorded may be missed
+    std::string chrome_json();
+    void dump_chrome(const std::string &path);
+
+    /// @cond
+    extern std::atomic<bool> _enabled;
+
+    std::uint64_t now_ns();
+    void record(const char *name, const std::uint64_t &begin_ns, const std::uint64_t &end_ns);
+
+    // RAII span, see CYTNX_TRACE_SCOPE
+    class Span {
+     public:
+      explicit Span(const char *name)
+          : _name(_enabled.load(std::memory_order_relaxed) ? name : nullptr),
+            _begin(_name ? now_ns() : 0) {}
+      ~Span() {
+        if (_name) record(_name, _begin, now_ns());
+      }
+      Span(const Span &) = delete;
+      Span &operator=(const Span &) = delete;
+
+     private:
+      const char *_name;
+      std::uint64_t _begin;
+    };
+    /// @endcond
+
+  }  // namespace trace
+}  // namespace cytnx_core
+
+#define CYTNX_TRACE_CAT_(a, b) a##b
+#define CYTNX_TRACE_CAT(a, b) CYTNX_TRACE_CAT_(a, b)
+#ifdef UNI_TRACE
+  #define CYTNX_TRACE_SCOPE(name) \
+    cytnx_core::trace::Span CYTNX_TRACE_CAT(_cytnx_trace_span_, __LINE__)(name)
+#else
+  #define CYTNX_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif  // CYTNX_CORE_TRACE_H_
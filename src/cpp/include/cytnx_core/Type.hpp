@@ -11,6 +11,7 @@
 #include <variant>
 #include <vector>
 
+#include <cytnx_core/Float16.hpp>
 #include <cytnx_core/errors/cytnx_error.hpp>  // also brings in cuComplex.h
 
 #define MKL_Complex8 std::complex<float>
@@ -40,10 +41,15 @@ namespace cytnx_core {
   typedef int64_t cytnx_int64;
   typedef int32_t cytnx_int32;
   typedef int16_t cytnx_int16;
+  typedef int8_t cytnx_int8;
   typedef size_t cytnx_size_t;
   typedef std::complex<float> cytnx_complex64;
   typedef std::complex<double> cytnx_complex128;
   typedef bool cytnx_bool;
+  // std::complex of a non-standard type is only used as storage and through the float
+  // conversions of its parts
+  typedef std::complex<cytnx_float16> cytnx_complex32;
+  typedef std::complex<cytnx_bfloat16> cytnx_bcomplex32;
 
   namespace internal {
     template <class>
@@ -52,11 +58,19 @@ namespace cytnx_core {
     template <class T>
     struct is_complex_impl<std::complex<T>> : std::true_type {};
 
+    // the 16-bit floating point types, which std::is_floating_point does not know about
+    template <typename T>
+    struct is_half_floating_point_impl
+        : std::bool_constant<std::is_same_v<T, cytnx_float16> ||
+                             std::is_same_v<T, cytnx_bfloat16>> {};
+
     template <typename>
     struct is_complex_floating_point_impl : std::false_type {};
 
     template <typename T>
-    struct is_complex_floating_point_impl<std::complex<T>> : std::is_floating_point<T> {};
+    struct is_complex_floating_point_impl<std::complex<T>>
+        : std::bool_constant<std::is_floating_point_v<T> || is_half_floating_point_impl<T>::value> {
+    };
 
     template <std::size_t V, typename T, typename Tuple>
     constexpr std::size_t index_in_tuple_helper() {
@@ -137,17 +151,21 @@ namespace cytnx_core {
   // list. std::variant works better than std::tuple here since a variant is
   // constrained to only hold each type once, and we have
   // std::variant_alternative_t<n> to get the n'th type, as well as the
-  // variant_index_v helper to get the index of a given type
+  // variant_index_v helper to get the index of a given type.
+  // The types after Bool were added later and are appended so that the ids stored in existing
+  // files keep their meaning; type_promote() handles them explicitly.
   using Type_list =
     std::variant<void, cytnx_complex128, cytnx_complex64, cytnx_double, cytnx_float, cytnx_int64,
-                 cytnx_uint64, cytnx_int32, cytnx_uint32, cytnx_int16, cytnx_uint16, cytnx_bool>;
+                 cytnx_uint64, cytnx_int32, cytnx_uint32, cytnx_int16, cytnx_uint16, cytnx_bool,
+                 cytnx_complex32, cytnx_bcomplex32, cytnx_float16, cytnx_bfloat16, cytnx_int8>;
 
 // For GPU storage, the types are slightly different because CUDA uses their own
-// complex type
+// complex type. The 16-bit types have the layout of __half and __nv_bfloat16.
 #ifdef UNI_GPU
   using Type_list_gpu =
     std::variant<void, cuDoubleComplex, cuComplex, cytnx_double, cytnx_float, cytnx_int64,
-                 cytnx_uint64, cytnx_int32, cytnx_uint32, cytnx_int16, cytnx_uint16, cytnx_bool>;
+                 cytnx_uint64, cytnx_int32, cytnx_uint32, cytnx_int16, cytnx_uint16, cytnx_bool,
+                 cytnx_complex32, cytnx_bcomplex32, cytnx_float16, cytnx_bfloat16, cytnx_int8>;
 #endif
 
   // The number of supported types
@@ -181,6 +199,16 @@ namespace cytnx_core {
   constexpr const char *Type_names<cytnx_uint16> = "Uint16";
   template <>
   constexpr const char *Type_names<cytnx_bool> = "Bool";
+  template <>
+  constexpr const char *Type_names<cytnx_complex32> = "Complex Half (Complex Float16)";
+  template <>
+  constexpr const char *Type_names<cytnx_bcomplex32> = "Complex BFloat16";
+  template <>
+  constexpr const char *Type_names<cytnx_float16> = "Half (Float16)";
+  template <>
+  constexpr const char *Type_names<cytnx_bfloat16> = "BFloat16";
+  template <>
+  constexpr const char *Type_names<cytnx_int8> = "Int8";
 
   // The corresponding Python enumeration name
   template <typename T>
@@ -209,6 +237,16 @@ namespace cytnx_core {
   constexpr const char *Type_enum_name<cytnx_uint16> = "Uint16";
   template <>
   constexpr const char *Type_enum_name<cytnx_bool> = "Bool";
+  template <>
+  constexpr const char *Type_enum_name<cytnx_complex32> = "ComplexHalf";
+  template <>
+  constexpr const char *Type_enum_name<cytnx_bcomplex32> = "ComplexBFloat16";
+  template <>
+  constexpr const char *Type_enum_name<cytnx_float16> = "Half";
+  template <>
+  constexpr const char *Type_enum_name<cytnx_bfloat16> = "BFloat16";
+  template <>
+  constexpr const char *Type_enum_name<cytnx_int8> = "Int8";
 
   struct Type_struct {
     const char *name;  // char* is OK here, it is only ever initialized from a
@@ -231,7 +269,9 @@ namespace cytnx_core {
     static constexpr const char *enum_name = Type_enum_name<T>;
     static constexpr bool is_complex = is_complex_v<T>;
     static constexpr bool is_unsigned = std::is_unsigned_v<T>;
-    static constexpr bool is_float = std::is_floating_point_v<T> || is_complex_floating_point_v<T>;
+    static constexpr bool is_float = std::is_floating_point_v<T> ||
+                                     internal::is_half_floating_point_impl<T>::value ||
+                                     is_complex_floating_point_v<T>;
     static constexpr bool is_int = std::is_integral_v<T> && !std::is_same_v<T, bool>;
     static constexpr std::size_t typeSize = internal::type_size<T>;
 
@@ -279,12 +319,20 @@ namespace cytnx_core {
       Uint32 = cy_typeid_v<cytnx_uint32>,
       Int16 = cy_typeid_v<cytnx_int16>,
       Uint16 = cy_typeid_v<cytnx_uint16>,
-      Bool = cy_typeid_v<cytnx_bool>
+      Bool = cy_typeid_v<cytnx_bool>,
+      ComplexHalf = cy_typeid_v<cytnx_complex32>,
+      ComplexBFloat16 = cy_typeid_v<cytnx_bcomplex32>,
+      Half = cy_typeid_v<cytnx_float16>,
+      BFloat16 = cy_typeid_v<cytnx_bfloat16>,
+      Int8 = cy_typeid_v<cytnx_int8>
     };
 
+    // an internal consistency check, compiled only at CYTNX_CHECK_FULL; validate ids coming from
+    // users with is_valid()
     static constexpr void check_type(unsigned int type_id) {
-      cytnx_error_msg(type_id >= N_Type, "[ERROR] invalid type_id: %s", type_id);
+      cytnx_check_msg(type_id >= N_Type, "[ERROR] invalid type_id: %u", type_id);
     }
+    static constexpr bool is_valid(unsigned int type_id) { return type_id < N_Type; }
 
     // This could be constexpr returning constexpr char*, but there is lots of
     // code that assumes that it returns a std::string and calls
@@ -320,6 +368,11 @@ namespace cytnx_core {
       check_type(type_id);
       return Typeinfos[type_id].is_int;
     }
+    // Half, BFloat16 and their complex pairs
+    static constexpr bool is_half(unsigned int type_id) {
+      return type_id == Half || type_id == BFloat16 || type_id == ComplexHalf ||
+             type_id == ComplexBFloat16;
+    }
 
     template <class T>
     static constexpr unsigned int cy_typeid(const T &rc) {
@@ -328,6 +381,10 @@ namespace cytnx_core {
 
     // Find a common type for typeL and typeR
     static constexpr unsigned int type_promote(unsigned int typeL, unsigned int typeR) {
+      if (is_half(typeL) || is_half(typeR)) return half_promote(typeL, typeR);
+      // Int8 comes after Bool in the list; everything else does not
+      if (typeL == Bool && typeR != Void) return typeR;
+      if (typeR == Bool && typeL != Void) return typeL;
       if (typeL < typeR) {
         if (typeL == 0) return 0;
 
@@ -346,6 +403,25 @@ namespace cytnx_core {
       }
     }
 
+    // type_promote() when either type is a 16-bit float. Integers promote to the 16-bit type;
+    // Half and BFloat16 represent neither one another, so mixing them gives Float (ComplexFloat);
+    // wider floating point types promote as Float (ComplexFloat) would.
+    static constexpr unsigned int half_promote(unsigned int typeL, unsigned int typeR) {
+      if (typeL == Void || typeR == Void) return Void;
+      if (typeL == typeR) return typeL;
+      const unsigned int half = is_half(typeL) ? typeL : typeR;
+      const unsigned int other = is_half(typeL) ? typeR : typeL;
+      const bool complex = is_complex(typeL) || is_complex(typeR);
+      if (!is_float(other)) return half;
+      if (is_half(other)) {
+        const bool bf16 = half == BFloat16 || half == ComplexBFloat16;
+        const bool other_bf16 = other == BFloat16 || other == ComplexBFloat16;
+        if (bf16 != other_bf16) return complex ? ComplexFloat : Float;
+        return bf16 ? ComplexBFloat16 : ComplexHalf;  // one of the two is complex
+      }
+      return type_promote(is_complex(half) ? ComplexFloat : Float, other);
+    }
+
     // type metafunction for type promotion
     template <typename TL, typename TR>
     using type_promote_t =
@@ -393,6 +469,31 @@ namespace cytnx_core {
 #endif
 
   };  // Type_class
+
+  // a value-less stand-in for a type, so that void can be passed to a generic lambda
+  template <typename T>
+  struct type_tag {
+    using type = T;
+  };
+
+  namespace internal {
+    template <std::size_t I, typename Func>
+    decltype(auto) dispatch_type_helper(unsigned int type_id, Func &&f) {
+      if constexpr (I + 1 < N_Type) {
+        if (type_id != I) return dispatch_type_helper<I + 1>(type_id, std::forward<Func>(f));
+      }
+      return f(type_tag<std::variant_alternative_t<I, Type_list>>{});
+    }
+  }  // namespace internal
+
+  // dispatch_type(type_id, f) calls f(type_tag<T>{}) with T the type of id type_id in Type_list,
+  // e.g. dispatch_type(dtype, [&](auto tag) { using T = typename decltype(tag)::type; ... });
+  // f must return the same type for all alternatives.
+  template <typename Func>
+  decltype(auto) dispatch_type(unsigned int type_id, Func &&f) {
+    cytnx_error_msg(!Type_class::is_valid(type_id), "[ERROR] invalid type_id: %u", type_id);
+    return internal::dispatch_type_helper<0>(type_id, std::forward<Func>(f));
+  }
   /// @endcond
 
   /**
@@ -417,6 +518,11 @@ namespace cytnx_core {
    *  Int16        |  short integer type with 16 bits
    *  Uint16       |  undigned short integer with 16 bits
    *  Bool         |  boolean type
+   *  ComplexHalf  |  complex half type with 32 bits
+   *  ComplexBFloat16 | complex bfloat16 type with 32 bits
+   *  Half         |  half float type (IEEE binary16) with 16 bits
+   *  BFloat16     |  bfloat16 type (8-bit exponent, 7-bit mantissa) with 16 bits
+   *  Int8         |  signed char type with 8 bits
    */
 
   constexpr Type_class Type;
@@ -7,7 +7,24 @@
 // error entry header
 #include <cytnx_core/errors/cytnx_error.hpp>
 
+#include <cytnx_core/Autotune.hpp>
+#include <cytnx_core/Counters.hpp>
 #include <cytnx_core/Device.hpp>
+#include <cytnx_core/KrylovExpmv.hpp>
+#include <cytnx_core/LinOp.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/QuantizedStorage.hpp>
+#include <cytnx_core/SparseMatrix.hpp>
+#include <cytnx_core/SplitComplexStorage.hpp>
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/StorageView.hpp>
+#include <cytnx_core/ThreadPool.hpp>
+#include <cytnx_core/Trace.hpp>
 #include <cytnx_core/Type.hpp>
+#include <cytnx_core/io/DeltaCheckpoint.hpp>
+#include <cytnx_core/io/TensorFile.hpp>
+#include <cytnx_core/io/TensorStream.hpp>
+#include <cytnx_core/linalg.hpp>
+#include <cytnx_core/random.hpp>
 
 #endif  // CYTNX_CORE_H_
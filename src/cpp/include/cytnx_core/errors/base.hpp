@@ -1,6 +1,7 @@
 #ifndef CYTNX_CORE_BASE_ERROR_H_
 #define CYTNX_CORE_BASE_ERROR_H_
 
+#include <array>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -8,45 +9,178 @@
 #include <iostream>
 #include <stdarg.h>
 #include <stdexcept>
+#include <string>
 
 #ifdef _MSC_VER
   #define __PRETTY_FUNCTION__ __FUNCTION__
 #endif
 
-#define cytnx_error_msg(is_true, format, ...)                                               \
-  {                                                                                         \
-    if (is_true)                                                                            \
-      error_msg(__PRETTY_FUNCTION__, __FILE__, __LINE__, (is_true), (format), __VA_ARGS__); \
+#if defined(__GNUC__) || defined(__clang__)
+  #define CYTNX_COLD __attribute__((cold, noinline))
+#else
+  #define CYTNX_COLD
+#endif
+
+// Checking levels, chosen at compile time with -DCYTNX_CHECK_LEVEL=<n> (the CMake option
+// CYTNX_CHECK_LEVEL sets it for the library and everything linking it):
+//
+//  - CYTNX_CHECK_FULL (default): every check, including those inside kernels (cytnx_check_msg).
+//  - CYTNX_CHECK_BOUNDARY: the checks at API boundaries (cytnx_error_msg) only.
+//  - CYTNX_CHECK_NONE: no argument validation at all; a violated precondition is undefined
+//    behavior.
+//
+// Failures that do not come from the caller's arguments (I/O, the OS, corrupted files) are
+// reported with cytnx_system_error_msg at every level. So is, with cytnx_input_error_msg, input
+// the code cannot continue past without undefined behavior whatever the level: buffers and
+// DLPack tensors handed over from Python, devices the build does not support, type names.
+#define CYTNX_CHECK_NONE 0
+#define CYTNX_CHECK_BOUNDARY 1
+#define CYTNX_CHECK_FULL 2
+#ifndef CYTNX_CHECK_LEVEL
+  #define CYTNX_CHECK_LEVEL CYTNX_CHECK_FULL
+#endif
+
+namespace cytnx_core {
+
+  /**
+   * @brief the base of the exceptions thrown by cytnx_core.
+   *
+   * @details The raw return addresses of the throwing stack are captured when the exception is
+   * created; they are only symbolized when the trace is printed, with backtrace() or operator<<.
+   * Set the environment variable CYTNX_BACKTRACE=1 to also include the trace in what().
+   *
+   * Derives from std::logic_error, so existing handlers keep catching it.
+   */
+  class Error : public std::logic_error {
+   public:
+    Error(const char *func, const char *file, int line, const std::string &message)
+        : std::logic_error(header(func, file, line, message)),
+          _message(message),
+          _func(func),
+          _file(file),
+          _line(line) {
+      _nframes = ::backtrace(_frames.data(), _frames.size());
+      if (backtrace_in_what()) _what = std::logic_error::what() + ("\n" + backtrace());
+    }
+
+    const char *what() const noexcept override {
+      return _what.empty() ? std::logic_error::what() : _what.c_str();
+    }
+
+    const std::string &message() const { return _message; }
+    const std::string &func() const { return _func; }
+    const std::string &file() const { return _file; }
+    int line() const { return _line; }
+
+    // the stack at the throw, symbolized now
+    std::string backtrace() const {
+      std::string out = "Stack trace:";
+      char **symbols = backtrace_symbols(_frames.data(), _nframes);
+      if (symbols == nullptr) return out + " (unavailable)";
+      for (int i = 0; i < _nframes; i++) out += std::string("\n") + symbols[i];
+      free(symbols);
+      return out;
+    }
+
+   private:
+    static std::string header(const char *func, const char *file, int line,
+                              const std::string &message) {
+      return std::string("\n# Cytnx error occur at ") + func + "\n# error: " + message +
+             "\n# file : " + file + " (" + std::to_string(line) + ")";
+    }
+
+    static bool backtrace_in_what() {
+      static const bool enabled = []() {
+        const char *env = std::getenv("CYTNX_BACKTRACE");
+        return env != nullptr && env[0] != '\0' && std::strcmp(env, "0") != 0;
+      }();
+      return enabled;
+    }
+
+    std::string _message, _func, _file, _what;
+    int _line;
+    std::array<void *, 32> _frames;
+    int _nframes;
+  };
+
+  // a violated precondition: an invalid argument, type or state
+  class CheckError : public Error {
+   public:
+    using Error::Error;
+  };
+
+  // a failure of the environment: I/O, the OS, memory, corrupted input files
+  class SystemFailure : public Error {
+   public:
+    using Error::Error;
+  };
+
+  inline std::ostream &operator<<(std::ostream &os, const Error &e) {
+    return os << e.std::logic_error::what() << "\n" << e.backtrace();
   }
-static inline void error_msg(char const *const func, const char *const file, int const line,
-                             bool is_true, char const *format, ...) {
-  // try {
-  if (is_true) {
-    va_list args;
-    char output_str[1024];
-    char msg[512];
-    va_start(args, format);
-    vsprintf(msg, format, args);
-    sprintf(output_str, "\n# Cytnx error occur at %s\n# error: %s\n# file : %s (%d)", func, msg,
-            file, line);
-    va_end(args);
-    // std::cerr << output_str << std::endl;
-    std::cerr << output_str << std::endl;
-    std::cerr << "Stack trace:" << std::endl;
-    void *array[10];
-    size_t size;
-    size = backtrace(array, 10);
-    char **strings = backtrace_symbols(array, size);
-    for (size_t i = 0; i < size; i++) {
-      std::cerr << strings[i] << std::endl;
+
+  /// @cond
+  namespace internal {
+    // printf-style formatting without a length limit
+    inline std::string vformat(const char *format, va_list args) {
+      va_list copy;
+      va_copy(copy, args);
+      const int n = vsnprintf(nullptr, 0, format, copy);
+      va_end(copy);
+      if (n < 0) return format;
+      std::string out(n, '\0');
+      vsnprintf(&out[0], n + 1, format, args);
+      return out;
     }
-    free(strings);
-    throw std::logic_error(output_str);
+
+    template <class E>
+    [[noreturn]] CYTNX_COLD void raise_error(const char *func, const char *file, int line,
+                                             const char *format, ...) {
+      va_list args;
+      va_start(args, format);
+      std::string msg = vformat(format, args);
+      va_end(args);
+      throw E(func, file, line, msg);
+    }
+  }  // namespace internal
+  /// @endcond
+
+}  // namespace cytnx_core
+
+#define cytnx_system_error_msg(is_true, format, ...)                                      \
+  {                                                                                       \
+    if (is_true)                                                                          \
+      cytnx_core::internal::raise_error<cytnx_core::SystemFailure>(                       \
+        __PRETTY_FUNCTION__, __FILE__, __LINE__, (format), __VA_ARGS__);                  \
   }
-  // } catch (const char *output_msg) {
-  //   std::cerr << output_msg << std::endl;
-  // }
-}
+
+#define cytnx_input_error_msg(is_true, format, ...)                                       \
+  {                                                                                       \
+    if (is_true)                                                                          \
+      cytnx_core::internal::raise_error<cytnx_core::CheckError>(                          \
+        __PRETTY_FUNCTION__, __FILE__, __LINE__, (format), __VA_ARGS__);                  \
+  }
+
+#if CYTNX_CHECK_LEVEL >= CYTNX_CHECK_BOUNDARY
+  #define cytnx_error_msg(is_true, format, ...)                                           \
+    {                                                                                     \
+      if (is_true)                                                                        \
+        cytnx_core::internal::raise_error<cytnx_core::CheckError>(                        \
+          __PRETTY_FUNCTION__, __FILE__, __LINE__, (format), __VA_ARGS__);                \
+    }
+#else
+  #define cytnx_error_msg(is_true, format, ...) \
+    {}
+#endif
+
+// checks inside kernels and accessors, compiled only at CYTNX_CHECK_FULL
+#if CYTNX_CHECK_LEVEL >= CYTNX_CHECK_FULL
+  #define cytnx_check_msg(is_true, format, ...) cytnx_error_msg(is_true, format, __VA_ARGS__)
+#else
+  #define cytnx_check_msg(is_true, format, ...) \
+    {}
+#endif
+
 #define cytnx_warning_msg(is_true, format, ...)                                               \
   {                                                                                           \
     if (is_true)                                                                              \
@@ -56,14 +190,11 @@ static inline void warning_msg(char const *const func, const char *const file, i
                                bool is_true, char const *format, ...) {
   if (is_true) {
     va_list args;
-    char output_str[1024];
-    char msg[512];
     va_start(args, format);
-    vsprintf(msg, format, args);
-    sprintf(output_str, "\n# Cytnx warning occur at %s\n# warning: %s\n# file : %s (%d)", func, msg,
-            file, line);
+    std::string msg = cytnx_core::internal::vformat(format, args);
     va_end(args);
-    std::cerr << output_str << std::endl;
+    std::cerr << "\n# Cytnx warning occur at " << func << "\n# warning: " << msg
+              << "\n# file : " << file << " (" << line << ")" << std::endl;
   }
 }
 
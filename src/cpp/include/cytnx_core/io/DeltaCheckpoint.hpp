@@ -0,0 +1,118 @@
+#ifndef CYTNX_IO_DELTACHECKPOINT_H_
+#define CYTNX_IO_DELTACHECKPOINT_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+#include <cytnx_core/io/TensorFile.hpp>
+
+namespace cytnx_core {
+  namespace io {
+
+    /**
+     * @brief Incremental checkpoints of a set of named buffers in an append-only log.
+     *
+     * @details Buffers are split into fixed-size chunks, and the content hash of every chunk is
+     * kept from the last commit. A commit appends only the chunks whose hash changed (compressed
+     * like tensor streams, see TensorStream.hpp), followed by a commit record. Buffers that were
+     * not staged for a commit keep their previous content. Typical use in a sweep:
+     * \code
+     * io::DeltaCheckpoint ckpt("state.cdl");
+     * for (...) {
+     *   // update some site tensors
+     *   for (auto &site : sites) ckpt.stage(site.name, site.storage, site.shape);
+     *   ckpt.commit();  // writes the changed chunks only
+     * }
+     * auto state = ckpt.restore();  // after a restart
+     * \endcode
+     *
+     * Opening an existing log replays the record headers to rebuild the chunk hashes; records
+     * after the last complete commit (e.g. torn by a crash) are discarded. Once the log is larger
+     * than compact_ratio times the live data, commit() rewrites it with the live chunks only.
+     */
+    class DeltaCheckpoint {
+     public:
+      /**
+       * @param path the log file, created if missing
+       * @param chunk_bytes the chunk size of a new log; an existing log keeps its own
+       * @param compact_ratio compact when the log exceeds this multiple of the live data,
+       * <= 0 to compact only on request
+       */
+      explicit DeltaCheckpoint(const std::string &path,
+                               const cytnx_uint64 &chunk_bytes = 1ULL << 20,
+                               const double &compact_ratio = 4.0);
+      ~DeltaCheckpoint();
+      DeltaCheckpoint(const DeltaCheckpoint &) = delete;
+      DeltaCheckpoint &operator=(const DeltaCheckpoint &) = delete;
+
+      // add a CPU buffer to the next commit; no copy is made, so its content is read by commit()
+      void stage(const std::string &name, const Storage &data,
+                 const std::vector<cytnx_uint64> &shape = {});
+
+      // drop a buffer from the state at the next commit
+      void remove(const std::string &name);
+
+      /**
+       * @brief write the staged changes and make them durable.
+       * @details A compaction due after the commit does not fail it: an error is reported as a
+       * warning, and the compaction is retried at the next commit.
+       * @return the number of bytes appended to the log
+       */
+      cytnx_uint64 commit();
+
+      // the state of the last commit, read from the log
+      std::map<std::string, LoadedTensor> restore() const;
+
+      // rewrite the log with the chunks of the last commit only
+      void compact();
+
+      cytnx_uint64 epoch() const;  // the number of commits so far
+      cytnx_uint64 chunk_bytes() const { return _chunk_bytes; }
+      cytnx_uint64 log_bytes() const;
+      cytnx_uint64 live_bytes() const;  // stored bytes of the chunks of the last commit
+      std::vector<std::string> names() const;  // the buffers of the last commit
+
+      /// @cond
+      struct ChunkRecord {
+        cytnx_uint64 hash;  // of the raw bytes
+        cytnx_uint64 offset;  // of the stored bytes in the log
+        cytnx_uint64 stored_bytes;
+        cytnx_uint32 codec;
+      };
+      struct BufferState {
+        unsigned int dtype;
+        cytnx_uint64 size;
+        std::vector<cytnx_uint64> shape;
+        std::vector<ChunkRecord> chunks;
+      };
+      struct Staged {
+        Storage storage;
+        std::vector<cytnx_uint64> shape;
+        bool removed;
+      };
+      /// @endcond
+
+     private:
+      void replay();
+      void compact_locked();
+      cytnx_uint64 live_bytes_locked() const;
+
+      std::string _path;
+      int _fd;
+      cytnx_uint64 _chunk_bytes;
+      double _compact_ratio;
+      cytnx_uint64 _epoch;
+      cytnx_uint64 _log_bytes;
+      std::map<std::string, BufferState> _state;
+      std::map<std::string, Staged> _staged;
+      mutable std::mutex _mtx;  // serializes the public member functions
+    };
+
+  }  // namespace io
+}  // namespace cytnx_core
+
+#endif  // CYTNX_IO_DELTACHECKPOINT_H_
@@ -0,0 +1,84 @@
+#ifndef CYTNX_IO_TENSORFILE_H_
+#define CYTNX_IO_TENSORFILE_H_
+
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Binary tensor files.
+   *
+   * @details A tensor file holds one Storage and its shape:
+   *
+   *  offset          |  content
+   * -----------------|-----------------------------------------------------------------------
+   *  0               |  magic "CYTNXTF\0"
+   *  8               |  u32 format version, u32 endianness marker 0x01020304
+   *  16              |  u32 dtype (Type_class::Type id), u32 ndim
+   *  24              |  u64 number of elements, u64 chunk size in bytes, u64 number of chunks
+   *  48              |  u64 payload offset
+   *  56              |  u64 shape[ndim], u32 CRC-32C of each payload chunk
+   *  ...             |  u32 CRC-32C of all header bytes before it
+   *  payload offset  |  the elements, 64-byte aligned
+   *
+   * All integers, as well as the payload, are in the byte order of the writing machine; the
+   * marker tells a reader when that differs from its own.
+   *
+   * The loader maps the file into memory and the returned Storage uses the payload in place: no
+   * copy is made and pages are read from disk only when touched. The mapping is private, so
+   * writing to the Storage never changes the file. Files are written to a temporary name and
+   * renamed into place, which keeps Storages loaded from an older version of the file valid.
+   */
+  namespace io {
+
+    const cytnx_uint32 tensor_file_version = 1;
+    const cytnx_uint64 default_chunk_bytes = 4ULL << 20;
+
+    struct TensorFileInfo {
+      cytnx_uint32 version;
+      unsigned int dtype;
+      std::vector<cytnx_uint64> shape;
+      cytnx_uint64 size;  // number of elements
+      cytnx_uint64 chunk_bytes;  // payload bytes covered by one checksum
+      cytnx_uint64 payload_offset;
+      std::vector<cytnx_uint32> checksums;  // CRC-32C of each payload chunk
+    };
+
+    struct LoadedTensor {
+      Storage storage;
+      std::vector<cytnx_uint64> shape;
+    };
+
+    /**
+     * @brief write a CPU Storage and its shape to a tensor file.
+     * @param path the file to create or replace
+     * @param data the elements
+     * @param shape the shape; its product must be data.size(). Empty means {data.size()}.
+     * @param chunk_bytes the payload bytes covered by one checksum
+     */
+    void save_tensor_file(const std::string &path, const Storage &data,
+                          const std::vector<cytnx_uint64> &shape = {},
+                          const cytnx_uint64 &chunk_bytes = default_chunk_bytes);
+
+    // the header of a tensor file, validated against its checksum
+    TensorFileInfo tensor_file_info(const std::string &path);
+
+    /**
+     * @brief map a tensor file into memory.
+     * @param path the file
+     * @param verify check the checksum of every chunk first. This reads the whole payload, so
+     * the load is no longer lazy.
+     */
+    LoadedTensor load_tensor_file(const std::string &path, const bool &verify = false);
+
+    // the indices of the payload chunks whose checksum does not match, empty if the file is intact
+    std::vector<cytnx_uint64> verify_tensor_file(const std::string &path);
+
+  }  // namespace io
+}  // namespace cytnx_core
+
+#endif  // CYTNX_IO_TENSORFILE_H_
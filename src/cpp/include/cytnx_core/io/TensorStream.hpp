@@ -0,0 +1,109 @@
+#ifndef CYTNX_IO_TENSORSTREAM_H_
+#define CYTNX_IO_TENSORSTREAM_H_
+
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+
+  /**
+   * @brief Chunked, compressed tensor streams.
+   *
+   * @details Unlike tensor files (see TensorFile.hpp), which keep the payload as is so that it
+   * can be mapped, a tensor stream splits the payload into fixed-size chunks, each byte-shuffled
+   * by the element size (Type_class::typeSize) and compressed with a built-in LZ codec. Chunks
+   * are compressed in parallel and written by a separate I/O thread, so compression and writing
+   * overlap; this is the format to use on slow (network) file systems.
+   *
+   *  section  |  content
+   * ----------|------------------------------------------------------------------------------
+   *  header   |  magic "CYTNXTS\0", u32 version, u32 endianness marker 0x01020304, u32 dtype,
+   *           |  u32 ndim, u64 number of elements, u64 chunk size in bytes, u32 flags,
+   *           |  u32 reserved, u64 shape[ndim], u32 CRC-32C of the header
+   *  chunks   |  the stored (compressed or raw) chunks, back to back
+   *  index    |  per chunk: u64 file offset, u64 stored bytes, u32 CRC-32C of the raw bytes,
+   *           |  u32 codec (0: raw, 1: LZ)
+   *  footer   |  u64 index offset, u64 number of chunks, u32 CRC-32C of the index,
+   *           |  u32 reserved, magic "CYTNXTSE"
+   *
+   * The index at the end gives random access to every chunk.
+   */
+  namespace io {
+
+    const cytnx_uint32 tensor_stream_version = 1;
+
+    struct StreamOptions {
+      cytnx_uint64 chunk_bytes = 1ULL << 20;  // rounded down to whole elements
+      bool shuffle = true;  // byte-shuffle each chunk before compressing
+      bool compress = true;  // false stores the chunks raw
+      int threads = 0;  // threads compressing / decompressing, 0 for Device.Ncores
+    };
+
+    struct StreamChunk {
+      cytnx_uint64 offset;  // in the file
+      cytnx_uint64 stored_bytes;
+      cytnx_uint32 checksum;  // CRC-32C of the raw bytes
+      cytnx_uint32 codec;  // 0: raw, 1: LZ
+    };
+
+    /**
+     * @brief write a CPU Storage and its shape as a tensor stream.
+     * @param path the file to create or replace
+     * @param data the elements
+     * @param shape the shape; its product must be data.size(). Empty means {data.size()}.
+     * @param options chunking and compression, see StreamOptions
+     */
+    void save_tensor_stream(const std::string &path, const Storage &data,
+                            const std::vector<cytnx_uint64> &shape = {},
+                            const StreamOptions &options = StreamOptions());
+
+    /**
+     * @brief Random access reader of a tensor stream.
+     *
+     * The header and index are read on construction; chunks are read and decompressed on
+     * demand. All read functions are safe to call from several threads at once.
+     */
+    class TensorStreamReader {
+     public:
+      explicit TensorStreamReader(const std::string &path);
+      ~TensorStreamReader();
+      TensorStreamReader(const TensorStreamReader &) = delete;
+      TensorStreamReader &operator=(const TensorStreamReader &) = delete;
+
+      unsigned int dtype() const { return _dtype; }
+      const std::vector<cytnx_uint64> &shape() const { return _shape; }
+      cytnx_uint64 size() const { return _size; }
+      cytnx_uint64 chunk_bytes() const { return _chunk_bytes; }
+      cytnx_uint64 nchunks() const { return _chunks.size(); }
+      const std::vector<StreamChunk> &chunks() const { return _chunks; }
+
+      // the first element and the number of elements of chunk i
+      cytnx_uint64 chunk_begin(const cytnx_uint64 &i) const;
+      cytnx_uint64 chunk_size(const cytnx_uint64 &i) const;
+
+      // the elements of chunk i
+      Storage read_chunk(const cytnx_uint64 &i) const;
+      // decompress chunk i to out, which holds chunk_size(i) elements
+      void read_chunk(const cytnx_uint64 &i, void *out) const;
+
+      // all elements, decompressing the chunks in parallel
+      Storage read(const int &threads = 0) const;
+
+     private:
+      std::string _path;
+      int _fd;
+      unsigned int _dtype;
+      std::vector<cytnx_uint64> _shape;
+      cytnx_uint64 _size;
+      cytnx_uint64 _chunk_bytes;
+      bool _shuffle;
+      std::vector<StreamChunk> _chunks;
+    };
+
+  }  // namespace io
+}  // namespace cytnx_core
+
+#endif  // CYTNX_IO_TENSORSTREAM_H_
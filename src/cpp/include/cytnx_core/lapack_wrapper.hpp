@@ -6,6 +6,8 @@
 #include <complex>
 // #include <complex.h>
 #include <algorithm>
+#include "Counters.hpp"
+#include "Trace.hpp"
 #include "Type.hpp"
 
 #ifdef UNI_MKL
@@ -279,12 +281,18 @@ inline void dgemm(const char *transa, const char *transb, const blas_int *m, con
                   const blas_int *k, const double *alpha, const double *a, const blas_int *lda,
                   const double *b, const blas_int *ldb, const double *beta, double *c,
                   const blas_int *ldc) {
+  CYTNX_TRACE_SCOPE("blas.dgemm");
+  CYTNX_COUNT_OP(Gemm, double, 2.0 * *m * *n * *k,
+                 double(*m) * *k + double(*k) * *n + 2.0 * *m * *n);
   dgemm_(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
 }
 inline void sgemm(const char *transa, const char *transb, const blas_int *m, const blas_int *n,
                   const blas_int *k, const float *alpha, const float *a, const blas_int *lda,
                   const float *b, const blas_int *ldb, const float *beta, float *c,
                   const blas_int *ldc) {
+  CYTNX_TRACE_SCOPE("blas.sgemm");
+  CYTNX_COUNT_OP(Gemm, float, 2.0 * *m * *n * *k,
+                 double(*m) * *k + double(*k) * *n + 2.0 * *m * *n);
   sgemm_(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
 }
 
@@ -293,6 +301,9 @@ inline void zgemm(const char *transa, const char *transb, const blas_int *m, con
                   const std::complex<double> *a, const blas_int *lda, const std::complex<double> *b,
                   const blas_int *ldb, const std::complex<double> *beta, std::complex<double> *c,
                   const blas_int *ldc) {
+  CYTNX_TRACE_SCOPE("blas.zgemm");
+  CYTNX_COUNT_OP(Gemm, std::complex<double>, 2.0 * *m * *n * *k,
+                 double(*m) * *k + double(*k) * *n + 2.0 * *m * *n);
   zgemm_(transa, transb, m, n, k, (const std::complex<double> *)alpha,
          (const std::complex<double> *)a, lda, (const std::complex<double> *)b, ldb,
          (const std::complex<double> *)beta, (std::complex<double> *)c, ldc);
@@ -302,97 +313,113 @@ inline void cgemm(const char *transa, const char *transb, const blas_int *m, con
                   const blas_int *k, const std::complex<float> *alpha, const std::complex<float> *a,
                   const blas_int *lda, const std::complex<float> *b, const blas_int *ldb,
                   const std::complex<float> *beta, std::complex<float> *c, const blas_int *ldc) {
+  CYTNX_TRACE_SCOPE("blas.cgemm");
+  CYTNX_COUNT_OP(Gemm, std::complex<float>, 2.0 * *m * *n * *k,
+                 double(*m) * *k + double(*k) * *n + 2.0 * *m * *n);
   cgemm_(transa, transb, m, n, k, (const std::complex<float> *)alpha,
          (const std::complex<float> *)a, lda, (const std::complex<float> *)b, ldb,
          (const std::complex<float> *)beta, (std::complex<float> *)c, ldc);
 }
 
 inline double dasum(const blas_int *n, const double *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.dasum");
+  CYTNX_COUNT_OP(Asum, double, *n, *n);
   return dasum_(n, x, incx);
 }
 
 inline void dcopy(const blas_int &n, const double *x, const blas_int &incx, double *y,
                   const blas_int &incy) {
+  CYTNX_TRACE_SCOPE("blas.dcopy");
+  CYTNX_COUNT_OP(Copy, double, 0, 2.0 * n);
   dcopy_(&n, x, &incx, y, &incy);
 }
 inline void scopy(const blas_int &n, const float *x, const blas_int &incx, float *y,
                   const blas_int &incy) {
+  CYTNX_TRACE_SCOPE("blas.scopy");
+  CYTNX_COUNT_OP(Copy, float, 0, 2.0 * n);
   scopy_(&n, x, &incx, y, &incy);
 }
 
 inline void daxpy(const blas_int *n, const double *alpha, const double *x, const blas_int *incx,
                   double *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.daxpy");
+  CYTNX_COUNT_OP(Axpy, double, 2.0 * *n, 3.0 * *n);
   daxpy_(n, alpha, x, incx, y, incy);
 }
 inline void saxpy(const blas_int *n, const float *alpha, const float *x, const blas_int *incx,
                   float *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.saxpy");
+  CYTNX_COUNT_OP(Axpy, float, 2.0 * *n, 3.0 * *n);
   saxpy_(n, alpha, x, incx, y, incy);
 }
 
 inline void zaxpy(const blas_int *n, const std::complex<double> *alpha,
                   const std::complex<double> *x, const blas_int *incx, std::complex<double> *y,
                   const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.zaxpy");
+  CYTNX_COUNT_OP(Axpy, std::complex<double>, 2.0 * *n, 3.0 * *n);
   zaxpy_(n, alpha, x, incx, y, incy);
 }
 inline void caxpy(const blas_int *n, const std::complex<float> *alpha, const std::complex<float> *x,
                   const blas_int *incx, std::complex<float> *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.caxpy");
+  CYTNX_COUNT_OP(Axpy, std::complex<float>, 2.0 * *n, 3.0 * *n);
   caxpy_(n, alpha, x, incx, y, incy);
 }
 
 inline double dnrm2(const blas_int *n, const double *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.dnrm2");
+  CYTNX_COUNT_OP(Nrm2, double, 2.0 * *n, *n);
   return dnrm2_(n, x, incx);
 }
 
 inline double dznrm2(const blas_int *n, const std::complex<double> *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.dznrm2");
+  CYTNX_COUNT_OP(Nrm2, std::complex<double>, *n, *n);
   return dznrm2_(n, x, incx);
 }
 
 inline float snrm2(const blas_int *n, const float *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.snrm2");
+  CYTNX_COUNT_OP(Nrm2, float, 2.0 * *n, *n);
   return snrm2_(n, x, incx);
 }
 
 inline float scnrm2(const blas_int *n, const std::complex<float> *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.scnrm2");
+  CYTNX_COUNT_OP(Nrm2, std::complex<float>, *n, *n);
   return scnrm2_(n, x, incx);
 }
 
 inline void dscal(const blas_int *n, const double *a, double *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.dscal");
+  CYTNX_COUNT_OP(Scal, double, *n, 2.0 * *n);
   dscal_(n, a, x, incx);
 }
 inline void sscal(const blas_int *n, const float *a, float *x, const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.sscal");
+  CYTNX_COUNT_OP(Scal, float, *n, 2.0 * *n);
   sscal_(n, a, x, incx);
 }
 inline void zscal(const blas_int *n, const std::complex<double> *a, std::complex<double> *x,
                   const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.zscal");
+  CYTNX_COUNT_OP(Scal, std::complex<double>, *n, 2.0 * *n);
   zscal_(n, a, x, incx);
 }
 inline void cscal(const blas_int *n, const std::complex<float> *a, std::complex<float> *x,
                   const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.cscal");
+  CYTNX_COUNT_OP(Scal, std::complex<float>, *n, 2.0 * *n);
   cscal_(n, a, x, incx);
 }
 inline void zdscal(const blas_int *n, const double *a, std::complex<double> *x,
                    const blas_int *incx) {
+  CYTNX_TRACE_SCOPE("blas.zdscal");
+  CYTNX_COUNT_OP(Scal, std::complex<double>, *n / 2.0, 2.0 * *n);
   zdscal_(n, a, x, incx);
 }
 /*
-inline void dsyev( const char* jobz, const char* uplo, const blas_int* n, double* a,
-             const blas_int* lda, double* w, double* work, const blas_int* lwork,
-             blas_int* info )
-{ dsyev_(  jobz,  uplo,  n,  a, lda, w,  work,  lwork, info ); }
-inline void ssyev( const char* jobz, const char* uplo, const blas_int* n, float* a,
-             const blas_int* lda, float* w, float* work, const blas_int* lwork,
-             blas_int* info )
-{ ssyev_(  jobz,  uplo,  n,  a, lda, w,  work,  lwork, info ); }
-
-inline void cheev( const char* jobz, const char* uplo, const blas_int* n, std::complex<float>* a,
-             const blas_int* lda, float* w, std::complex<float>* work, const blas_int* lwork,
-             const float* rwork, blas_int* info )
-{ cheev_(  jobz,  uplo,  n,  a, lda, w,  work,  lwork, rwork, info ); }
-
-inline void zheev( const char* jobz, const char* uplo, const blas_int* n, std::complex<double>* a,
-             const blas_int* lda, double* w, std::complex<double>* work, const blas_int* lwork,
-             const double* rwork, blas_int* info )
-{ zheev_(  jobz,  uplo,  n,  a, lda, w,  work,  lwork, rwork, info ); }
-
 inline void zgeev( const char* jobvl, const char* jobvr, const blas_int* n, std::complex<double>* a,
     const blas_int* lda, std::complex<double>* w, std::complex<double> *vl, const blas_int *ldvl,
     std::complex<double> *vr, const blas_int *ldvr, std::complex<double> *work, const blas_int*
@@ -411,39 +438,6 @@ inline void cgeev( const char* jobvl, const char* jobvr, const blas_int* n, std:
 
 
 
-inline void dgesvd( const char* jobu, const char* jobvt, const blas_int* m,
-              const blas_int* n, double* a, const blas_int* lda, double* s,
-              double* u, const blas_int* ldu, double* vt, const blas_int* ldvt,
-              double* work, const blas_int* lwork, blas_int* info )
-{
-  dgesvd_( jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt, work, lwork, info );
-}
-
-inline void sgesvd( const char* jobu, const char* jobvt, const blas_int* m,
-              const blas_int* n, float* a, const blas_int* lda, float* s,
-              float* u, const blas_int* ldu, float* vt, const blas_int* ldvt,
-              float* work, const blas_int* lwork, blas_int* info )
-{
-  sgesvd_( jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt, work, lwork, info );
-}
-
-inline void zgesvd( const char* jobu, const char* jobvt, const blas_int* m,
-              const blas_int* n, std::complex<double>* a, const blas_int* lda, double* s,
-              std::complex<double>* u, const blas_int* ldu, std::complex<double>* vt, const
-blas_int* ldvt, std::complex<double>* work, const blas_int* lwork, double* rwork, blas_int* info )
-{
-  zgesvd_( jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt, work, lwork, rwork, info );
-}
-
-inline void cgesvd( const char* jobu, const char* jobvt, const blas_int* m,
-              const blas_int* n, std::complex<float>* a, const blas_int* lda, float* s,
-              std::complex<float>* u, const blas_int* ldu, std::complex<float>* vt, const blas_int*
-ldvt, std::complex<float>* work, const blas_int* lwork, float* rwork, blas_int* info )
-{
-  cgesvd_( jobu, jobvt, m, n, a, lda, s, u, ldu, vt, ldvt, work, lwork, rwork, info );
-}
-
-
 inline void dgesdd( const char* jobz, const blas_int* m, const blas_int* n, double* a,
               const blas_int* lda, double* s, double* u, const blas_int* ldu, double* vt, const
 blas_int* ldvt, double* work, const blas_int* lwork, blas_int* iwork, blas_int* info )
@@ -465,11 +459,15 @@ inline void zgesdd( const char* jobz, const blas_int* m, const blas_int* n,
 inline void sgemv(const char *trans, const blas_int *m, const blas_int *n, const float *alpha,
                   const float *a, const blas_int *lda, const float *x, const blas_int *incx,
                   const float *beta, const float *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.sgemv");
+  CYTNX_COUNT_OP(Gemv, float, 2.0 * *m * *n, double(*m) * *n + *m + *n);
   sgemv_(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
 }
 inline void dgemv(const char *trans, const blas_int *m, const blas_int *n, const double *alpha,
                   const double *a, const blas_int *lda, const double *x, const blas_int *incx,
                   const double *beta, const double *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.dgemv");
+  CYTNX_COUNT_OP(Gemv, double, 2.0 * *m * *n, double(*m) * *n + *m + *n);
   dgemv_(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
 }
 inline void zgemv(const char *trans, const blas_int *m, const blas_int *n,
@@ -477,6 +475,9 @@ inline void zgemv(const char *trans, const blas_int *m, const blas_int *n,
                   const blas_int *lda, const std::complex<double> *x, const blas_int *incx,
                   const std::complex<double> *beta, const std::complex<double> *y,
                   const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.zgemv");
+  CYTNX_COUNT_OP(Gemv, std::complex<double>, 2.0 * *m * *n,
+                 double(*m) * *n + *m + *n);
   zgemv_(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
 }
 inline void cgemv(const char *trans, const blas_int *m, const blas_int *n,
@@ -484,20 +485,29 @@ inline void cgemv(const char *trans, const blas_int *m, const blas_int *n,
                   const blas_int *lda, const std::complex<float> *x, const blas_int *incx,
                   const std::complex<float> *beta, const std::complex<float> *y,
                   const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.cgemv");
+  CYTNX_COUNT_OP(Gemv, std::complex<float>, 2.0 * *m * *n,
+                 double(*m) * *n + *m + *n);
   cgemv_(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
 }
 
 inline double ddot(const blas_int *n, const double *x, const blas_int *incx, const double *y,
                    const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.ddot");
+  CYTNX_COUNT_OP(Dot, double, 2.0 * *n, 2.0 * *n);
   return ddot_(n, x, incx, y, incy);
 }
 inline float sdot(const blas_int *n, const float *x, const blas_int *incx, const float *y,
                   const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.sdot");
+  CYTNX_COUNT_OP(Dot, float, 2.0 * *n, 2.0 * *n);
   return sdot_(n, x, incx, y, incy);
 }
 
 inline void zdotc(std::complex<double> *res, const blas_int *n, const std::complex<double> *x,
                   const blas_int *incx, const std::complex<double> *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.zdotc");
+  CYTNX_COUNT_OP(Dot, std::complex<double>, 2.0 * *n, 2.0 * *n);
   #ifndef FORTRAN_COMPLEX_FUNCTIONS_RETURN_VOID
   *res = zdotc_(n, x, incx, y, incy);
   #else
@@ -506,6 +516,8 @@ inline void zdotc(std::complex<double> *res, const blas_int *n, const std::compl
 }
 inline void zdotu(std::complex<double> *res, const blas_int *n, const std::complex<double> *x,
                   const blas_int *incx, const std::complex<double> *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.zdotu");
+  CYTNX_COUNT_OP(Dot, std::complex<double>, 2.0 * *n, 2.0 * *n);
   #ifndef FORTRAN_COMPLEX_FUNCTIONS_RETURN_VOID
   *res = zdotu_(n, x, incx, y, incy);
   #else
@@ -514,6 +526,8 @@ inline void zdotu(std::complex<double> *res, const blas_int *n, const std::compl
 }
 inline void cdotc(std::complex<float> *res, const blas_int *n, const std::complex<float> *x,
                   const blas_int *incx, const std::complex<float> *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.cdotc");
+  CYTNX_COUNT_OP(Dot, std::complex<float>, 2.0 * *n, 2.0 * *n);
   #ifndef FORTRAN_COMPLEX_FUNCTIONS_RETURN_VOID
   *res = cdotc_(n, x, incx, y, incy);
   #else
@@ -522,6 +536,8 @@ inline void cdotc(std::complex<float> *res, const blas_int *n, const std::comple
 }
 inline void cdotu(std::complex<float> *res, const blas_int *n, const std::complex<float> *x,
                   const blas_int *incx, const std::complex<float> *y, const blas_int *incy) {
+  CYTNX_TRACE_SCOPE("blas.cdotu");
+  CYTNX_COUNT_OP(Dot, std::complex<float>, 2.0 * *n, 2.0 * *n);
   #ifndef FORTRAN_COMPLEX_FUNCTIONS_RETURN_VOID
   *res = cdotu_(n, x, incx, y, incy);
   #else
@@ -529,6 +545,249 @@ inline void cdotu(std::complex<float> *res, const blas_int *n, const std::comple
   #endif
 }
 
+// LAPACK wrappers, through the LAPACKE *_work interface so that no Fortran declarations are
+// needed; the arguments and *info follow the Fortran routines
+
+inline void dgesvd(const char *jobu, const char *jobvt, const blas_int *m, const blas_int *n,
+                   double *a, const blas_int *lda, double *s, double *u, const blas_int *ldu,
+                   double *vt, const blas_int *ldvt, double *work, const blas_int *lwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.dgesvd");
+  CYTNX_COUNT_OP(Gesvd, double, cytnx_core::counters::gesvd_flops(*jobu, *jobvt, *m, *n),
+                 cytnx_core::counters::gesvd_elems(*jobu, *jobvt, *m, *n), *lwork != -1);
+  *info = LAPACKE_dgesvd_work(LAPACK_COL_MAJOR, *jobu, *jobvt, *m, *n, a, *lda, s, u,
+                              *ldu, vt, *ldvt, work, *lwork);
+}
+
+inline void sgesvd(const char *jobu, const char *jobvt, const blas_int *m, const blas_int *n,
+                   float *a, const blas_int *lda, float *s, float *u, const blas_int *ldu,
+                   float *vt, const blas_int *ldvt, float *work, const blas_int *lwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.sgesvd");
+  CYTNX_COUNT_OP(Gesvd, float, cytnx_core::counters::gesvd_flops(*jobu, *jobvt, *m, *n),
+                 cytnx_core::counters::gesvd_elems(*jobu, *jobvt, *m, *n), *lwork != -1);
+  *info = LAPACKE_sgesvd_work(LAPACK_COL_MAJOR, *jobu, *jobvt, *m, *n, a, *lda, s, u,
+                              *ldu, vt, *ldvt, work, *lwork);
+}
+
+inline void zgesvd(const char *jobu, const char *jobvt, const blas_int *m, const blas_int *n,
+                   std::complex<double> *a, const blas_int *lda, double *s,
+                   std::complex<double> *u, const blas_int *ldu, std::complex<double> *vt,
+                   const blas_int *ldvt, std::complex<double> *work, const blas_int *lwork,
+                   double *rwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zgesvd");
+  CYTNX_COUNT_OP(Gesvd, std::complex<double>,
+                 cytnx_core::counters::gesvd_flops(*jobu, *jobvt, *m, *n),
+                 cytnx_core::counters::gesvd_elems(*jobu, *jobvt, *m, *n), *lwork != -1);
+  typedef lapack_complex_double C;
+  *info = LAPACKE_zgesvd_work(LAPACK_COL_MAJOR, *jobu, *jobvt, *m, *n, (C *)a, *lda, s, (C *)u,
+                              *ldu, (C *)vt, *ldvt, (C *)work, *lwork, rwork);
+}
+
+inline void cgesvd(const char *jobu, const char *jobvt, const blas_int *m, const blas_int *n,
+                   std::complex<float> *a, const blas_int *lda, float *s,
+                   std::complex<float> *u, const blas_int *ldu, std::complex<float> *vt,
+                   const blas_int *ldvt, std::complex<float> *work, const blas_int *lwork,
+                   float *rwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.cgesvd");
+  CYTNX_COUNT_OP(Gesvd, std::complex<float>,
+                 cytnx_core::counters::gesvd_flops(*jobu, *jobvt, *m, *n),
+                 cytnx_core::counters::gesvd_elems(*jobu, *jobvt, *m, *n), *lwork != -1);
+  typedef lapack_complex_float C;
+  *info = LAPACKE_cgesvd_work(LAPACK_COL_MAJOR, *jobu, *jobvt, *m, *n, (C *)a, *lda, s, (C *)u,
+                              *ldu, (C *)vt, *ldvt, (C *)work, *lwork, rwork);
+}
+
+inline void dgeqrf(const blas_int *m, const blas_int *n, double *a, const blas_int *lda,
+                   double *tau, double *work, const blas_int *lwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.dgeqrf");
+  CYTNX_COUNT_OP(Geqrf, double, cytnx_core::counters::geqrf_flops(*m, *n), 2.0 * *m * *n,
+                 *lwork != -1);
+  *info = LAPACKE_dgeqrf_work(LAPACK_COL_MAJOR, *m, *n, a, *lda, tau, work, *lwork);
+}
+
+inline void sgeqrf(const blas_int *m, const blas_int *n, float *a, const blas_int *lda,
+                   float *tau, float *work, const blas_int *lwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.sgeqrf");
+  CYTNX_COUNT_OP(Geqrf, float, cytnx_core::counters::geqrf_flops(*m, *n), 2.0 * *m * *n,
+                 *lwork != -1);
+  *info = LAPACKE_sgeqrf_work(LAPACK_COL_MAJOR, *m, *n, a, *lda, tau, work, *lwork);
+}
+
+inline void zgeqrf(const blas_int *m, const blas_int *n, std::complex<double> *a,
+                   const blas_int *lda, std::complex<double> *tau, std::complex<double> *work,
+                   const blas_int *lwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zgeqrf");
+  CYTNX_COUNT_OP(Geqrf, std::complex<double>, cytnx_core::counters::geqrf_flops(*m, *n),
+                 2.0 * *m * *n, *lwork != -1);
+  typedef lapack_complex_double C;
+  *info = LAPACKE_zgeqrf_work(LAPACK_COL_MAJOR, *m, *n, (C *)a, *lda, (C *)tau, (C *)work, *lwork);
+}
+
+inline void cgeqrf(const blas_int *m, const blas_int *n, std::complex<float> *a,
+                   const blas_int *lda, std::complex<float> *tau, std::complex<float> *work,
+                   const blas_int *lwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.cgeqrf");
+  CYTNX_COUNT_OP(Geqrf, std::complex<float>, cytnx_core::counters::geqrf_flops(*m, *n),
+                 2.0 * *m * *n, *lwork != -1);
+  typedef lapack_complex_float C;
+  *info = LAPACKE_cgeqrf_work(LAPACK_COL_MAJOR, *m, *n, (C *)a, *lda, (C *)tau, (C *)work, *lwork);
+}
+
+inline void dgetrf(const blas_int *m, const blas_int *n, double *a, const blas_int *lda,
+                   blas_int *ipiv, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.dgetrf");
+  CYTNX_COUNT_OP(Getrf, double, cytnx_core::counters::getrf_flops(*m, *n), 2.0 * *m * *n);
+  *info = LAPACKE_dgetrf_work(LAPACK_COL_MAJOR, *m, *n, a, *lda, ipiv);
+}
+
+inline void sgetrf(const blas_int *m, const blas_int *n, float *a, const blas_int *lda,
+                   blas_int *ipiv, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.sgetrf");
+  CYTNX_COUNT_OP(Getrf, float, cytnx_core::counters::getrf_flops(*m, *n), 2.0 * *m * *n);
+  *info = LAPACKE_sgetrf_work(LAPACK_COL_MAJOR, *m, *n, a, *lda, ipiv);
+}
+
+inline void zgetrf(const blas_int *m, const blas_int *n, std::complex<double> *a,
+                   const blas_int *lda, blas_int *ipiv, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zgetrf");
+  CYTNX_COUNT_OP(Getrf, std::complex<double>, cytnx_core::counters::getrf_flops(*m, *n),
+                 2.0 * *m * *n);
+  *info = LAPACKE_zgetrf_work(LAPACK_COL_MAJOR, *m, *n, (lapack_complex_double *)a, *lda, ipiv);
+}
+
+inline void cgetrf(const blas_int *m, const blas_int *n, std::complex<float> *a,
+                   const blas_int *lda, blas_int *ipiv, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.cgetrf");
+  CYTNX_COUNT_OP(Getrf, std::complex<float>, cytnx_core::counters::getrf_flops(*m, *n),
+                 2.0 * *m * *n);
+  *info = LAPACKE_cgetrf_work(LAPACK_COL_MAJOR, *m, *n, (lapack_complex_float *)a, *lda, ipiv);
+}
+
+// the inverse from the LU factors of zgetrf; lwork = -1 queries the workspace size into work[0]
+inline void zgetri(const blas_int *n, std::complex<double> *a, const blas_int *lda,
+                   const blas_int *ipiv, std::complex<double> *work, const blas_int *lwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zgetri");
+  CYTNX_COUNT_OP(Getri, std::complex<double>, cytnx_core::counters::getri_flops(*n),
+                 2.0 * *n * *n, *lwork != -1);
+  *info = LAPACKE_zgetri_work(LAPACK_COL_MAJOR, *n, (lapack_complex_double *)a, *lda, ipiv,
+                              (lapack_complex_double *)work, *lwork);
+}
+
+// Hermitian eigensolvers. ?syevd/?heevd (divide and conquer) compute the whole spectrum;
+// ?syevr/?heevr (MRRR) also take range = 'I' or 'V' for an index or value subset, of which they
+// return *m pairs. lwork = liwork (= lrwork) = -1 queries the workspace sizes
+
+inline void dsyevd(const char *jobz, const char *uplo, const blas_int *n, double *a,
+                   const blas_int *lda, double *w, double *work, const blas_int *lwork,
+                   blas_int *iwork, const blas_int *liwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.dsyevd");
+  CYTNX_COUNT_OP(Syevd, double, cytnx_core::counters::syevd_flops(*jobz, *n),
+                 2.0 * *n * *n + *n, *lwork != -1);
+  *info = LAPACKE_dsyevd_work(LAPACK_COL_MAJOR, *jobz, *uplo, *n, a, *lda, w, work, *lwork,
+                              iwork, *liwork);
+}
+
+inline void ssyevd(const char *jobz, const char *uplo, const blas_int *n, float *a,
+                   const blas_int *lda, float *w, float *work, const blas_int *lwork,
+                   blas_int *iwork, const blas_int *liwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.ssyevd");
+  CYTNX_COUNT_OP(Syevd, float, cytnx_core::counters::syevd_flops(*jobz, *n),
+                 2.0 * *n * *n + *n, *lwork != -1);
+  *info = LAPACKE_ssyevd_work(LAPACK_COL_MAJOR, *jobz, *uplo, *n, a, *lda, w, work, *lwork,
+                              iwork, *liwork);
+}
+
+inline void zheevd(const char *jobz, const char *uplo, const blas_int *n,
+                   std::complex<double> *a, const blas_int *lda, double *w,
+                   std::complex<double> *work, const blas_int *lwork, double *rwork,
+                   const blas_int *lrwork, blas_int *iwork, const blas_int *liwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zheevd");
+  CYTNX_COUNT_OP(Syevd, std::complex<double>, cytnx_core::counters::syevd_flops(*jobz, *n),
+                 2.0 * *n * *n + *n, *lwork != -1);
+  typedef lapack_complex_double C;
+  *info = LAPACKE_zheevd_work(LAPACK_COL_MAJOR, *jobz, *uplo, *n, (C *)a, *lda, w, (C *)work,
+                              *lwork, rwork, *lrwork, iwork, *liwork);
+}
+
+inline void cheevd(const char *jobz, const char *uplo, const blas_int *n,
+                   std::complex<float> *a, const blas_int *lda, float *w,
+                   std::complex<float> *work, const blas_int *lwork, float *rwork,
+                   const blas_int *lrwork, blas_int *iwork, const blas_int *liwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.cheevd");
+  CYTNX_COUNT_OP(Syevd, std::complex<float>, cytnx_core::counters::syevd_flops(*jobz, *n),
+                 2.0 * *n * *n + *n, *lwork != -1);
+  typedef lapack_complex_float C;
+  *info = LAPACKE_cheevd_work(LAPACK_COL_MAJOR, *jobz, *uplo, *n, (C *)a, *lda, w, (C *)work,
+                              *lwork, rwork, *lrwork, iwork, *liwork);
+}
+
+// the flops are counted for the iu - il + 1 pairs of range = 'I', and for all n otherwise
+inline void dsyevr(const char *jobz, const char *range, const char *uplo, const blas_int *n,
+                   double *a, const blas_int *lda, const double *vl, const double *vu,
+                   const blas_int *il, const blas_int *iu, const double *abstol, blas_int *m,
+                   double *w, double *z, const blas_int *ldz, blas_int *isuppz, double *work,
+                   const blas_int *lwork, blas_int *iwork, const blas_int *liwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.dsyevr");
+  const double k = *range == 'I' ? *iu - *il + 1 : *n;
+  CYTNX_COUNT_OP(Syevr, double, cytnx_core::counters::syevr_flops(*jobz, *n, k),
+                 double(*n) * *n + *n + (*jobz == 'V' ? *n * k : 0), *lwork != -1);
+  *info = LAPACKE_dsyevr_work(LAPACK_COL_MAJOR, *jobz, *range, *uplo, *n, a, *lda, *vl, *vu, *il,
+                              *iu, *abstol, m, w, z, *ldz, isuppz, work, *lwork, iwork, *liwork);
+}
+
+inline void ssyevr(const char *jobz, const char *range, const char *uplo, const blas_int *n,
+                   float *a, const blas_int *lda, const float *vl, const float *vu,
+                   const blas_int *il, const blas_int *iu, const float *abstol, blas_int *m,
+                   float *w, float *z, const blas_int *ldz, blas_int *isuppz, float *work,
+                   const blas_int *lwork, blas_int *iwork, const blas_int *liwork,
+                   blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.ssyevr");
+  const double k = *range == 'I' ? *iu - *il + 1 : *n;
+  CYTNX_COUNT_OP(Syevr, float, cytnx_core::counters::syevr_flops(*jobz, *n, k),
+                 double(*n) * *n + *n + (*jobz == 'V' ? *n * k : 0), *lwork != -1);
+  *info = LAPACKE_ssyevr_work(LAPACK_COL_MAJOR, *jobz, *range, *uplo, *n, a, *lda, *vl, *vu, *il,
+                              *iu, *abstol, m, w, z, *ldz, isuppz, work, *lwork, iwork, *liwork);
+}
+
+inline void zheevr(const char *jobz, const char *range, const char *uplo, const blas_int *n,
+                   std::complex<double> *a, const blas_int *lda, const double *vl,
+                   const double *vu, const blas_int *il, const blas_int *iu,
+                   const double *abstol, blas_int *m, double *w, std::complex<double> *z,
+                   const blas_int *ldz, blas_int *isuppz, std::complex<double> *work,
+                   const blas_int *lwork, double *rwork, const blas_int *lrwork,
+                   blas_int *iwork, const blas_int *liwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.zheevr");
+  const double k = *range == 'I' ? *iu - *il + 1 : *n;
+  CYTNX_COUNT_OP(Syevr, std::complex<double>, cytnx_core::counters::syevr_flops(*jobz, *n, k),
+                 double(*n) * *n + *n + (*jobz == 'V' ? *n * k : 0), *lwork != -1);
+  typedef lapack_complex_double C;
+  *info = LAPACKE_zheevr_work(LAPACK_COL_MAJOR, *jobz, *range, *uplo, *n, (C *)a, *lda, *vl, *vu,
+                              *il, *iu, *abstol, m, w, (C *)z, *ldz, isuppz, (C *)work, *lwork,
+                              rwork, *lrwork, iwork, *liwork);
+}
+
+inline void cheevr(const char *jobz, const char *range, const char *uplo, const blas_int *n,
+                   std::complex<float> *a, const blas_int *lda, const float *vl,
+                   const float *vu, const blas_int *il, const blas_int *iu, const float *abstol,
+                   blas_int *m, float *w, std::complex<float> *z, const blas_int *ldz,
+                   blas_int *isuppz, std::complex<float> *work, const blas_int *lwork,
+                   float *rwork, const blas_int *lrwork, blas_int *iwork,
+                   const blas_int *liwork, blas_int *info) {
+  CYTNX_TRACE_SCOPE("lapack.cheevr");
+  const double k = *range == 'I' ? *iu - *il + 1 : *n;
+  CYTNX_COUNT_OP(Syevr, std::complex<float>, cytnx_core::counters::syevr_flops(*jobz, *n, k),
+                 double(*n) * *n + *n + (*jobz == 'V' ? *n * k : 0), *lwork != -1);
+  typedef lapack_complex_float C;
+  *info = LAPACKE_cheevr_work(LAPACK_COL_MAJOR, *jobz, *range, *uplo, *n, (C *)a, *lda, *vl, *vu,
+                              *il, *iu, *abstol, m, w, (C *)z, *ldz, isuppz, (C *)work, *lwork,
+                              rwork, *lrwork, iwork, *liwork);
+}
+
 /*
 inline void dstev( const char* jobz, const blas_int* n, const double* d, const double* e, const
 double* z, const blas_int* ldaz, const double* work, blas_int* info )
@@ -542,28 +801,6 @@ float* z, const blas_int* ldaz, const float* work, blas_int* info )
   sstev_( jobz, n, d, e, z, ldaz, work, info );
 }
 
-inline void dgetrf( const blas_int *m, const blas_int *n, const double *a,  const blas_int *lda,
-const blas_int *ipiv, blas_int* info )
-{
-  dgetrf_( m, n, a, lda, ipiv, info );
-}
-inline void sgetrf( const blas_int *m, const blas_int *n, const float *a,  const blas_int *lda,
-const blas_int *ipiv, blas_int* info )
-{
-  sgetrf_( m, n, a, lda, ipiv, info );
-}
-
-inline void zgetrf( const blas_int *m, const blas_int *n, const std::complex<double> *a,  const
-blas_int *lda, const blas_int *ipiv, blas_int* info )
-{
-  zgetrf_(m, n, a, lda, ipiv, info);
-}
-inline void cgetrf( const blas_int *m, const blas_int *n, const std::complex<float> *a,  const
-blas_int *lda, const blas_int *ipiv, blas_int* info )
-{
-  cgetrf_(m, n, a, lda, ipiv, info);
-}
-
 inline void dgetri( const blas_int *n, const double *a,  const blas_int *lda, const blas_int
 *ipiv, const double* work, const blas_int* lwork, blas_int* info )
 {
@@ -574,11 +811,6 @@ inline void sgetri( const blas_int *n, const float *a,  const blas_int *lda, con
 {
   sgetri_(n, a, lda, ipiv, work, lwork, info);
 }
-inline void zgetri( const blas_int *n, const std::complex<double> *a, const blas_int *lda, const
-blas_int *ipiv, const std::complex<double> *work, const blas_int *lwork, blas_int *info )
-{
-  zgetri_(n, a, lda, ipiv, work, lwork, info);
-}
 inline void cgetri( const blas_int *n, const std::complex<float> *a, const blas_int *lda, const
 blas_int *ipiv, const std::complex<float> *work, const blas_int *lwork, blas_int *info )
 {
@@ -641,18 +873,6 @@ blas_int* info )
   dorgql_(m, n, k, a, lda, tau, work, lwork, info );
 }
 
-inline void dgeqrf( const blas_int* m, const blas_int* n, double* a,
-                    const blas_int* lda, double* tau, double* work, const blas_int* lwork,
-blas_int* info )
-{
-  dgeqrf_(m, n, a, lda, tau, work, lwork, info );
-}
-inline void sgeqrf( const blas_int* m, const blas_int* n, float* a,
-                    const blas_int* lda, float* tau, float* work, const blas_int* lwork,
-blas_int* info )
-{
-  sgeqrf_(m, n, a, lda, tau, work, lwork, info );
-}
 inline void dorgqr( const blas_int* m, const blas_int* n, const blas_int* k, double* a,
                     const blas_int* lda, const double* tau, double* work, const blas_int* lwork,
 blas_int* info )
@@ -685,18 +905,6 @@ blas_int* info )
 {
   sorgrq_(m, n, k, a, lda, tau, work, lwork, info );
 }
-inline void zgeqrf( const blas_int* m, const blas_int* n, std::complex<double>* a,
-                    const blas_int* lda, std::complex<double>* tau, std::complex<double>* work,
-const blas_int* lwork, blas_int* info )
-{
-  zgeqrf_(m, n, a, lda, tau, work, lwork, info );
-}
-inline void cgeqrf( const blas_int* m, const blas_int* n, std::complex<float>* a,
-                    const blas_int* lda, std::complex<float>* tau, std::complex<float>* work,
-const blas_int* lwork, blas_int* info )
-{
-  cgeqrf_(m, n, a, lda, tau, work, lwork, info );
-}
 inline void zungqr( const blas_int* m, const blas_int* n, const blas_int* k,
 std::complex<double>* a, const blas_int* lda, const std::complex<double>* tau,
 std::complex<double>* work, const blas_int* lwork, blas_int* info )
@@ -0,0 +1,135 @@
+#ifndef CYTNX_LINALG_H_
+#define CYTNX_LINALG_H_
+
+#include <vector>
+
+#include <cytnx_core/StorageView.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace linalg {
+
+    /**
+     * @brief Eigh() of each block of a block-diagonal matrix, such as the charge sectors of a
+     * symmetric tensor, the blocks decomposed concurrently.
+     *
+     * @details The blocks are independent and usually of very uneven sizes, so a loop over them
+     * on a multithreaded LAPACK leaves most cores idle on the small ones. Instead the blocks are
+     * ordered longest job first (by their flop counts); those that dominate the rest run one at
+     * a time on the multithreaded LAPACK, and the others run concurrently on `Device.Ncores`
+     * threads, each on a single-threaded LAPACK (see utils_internal::block_schedule()). The
+     * concurrent part needs a build with OpenMP (CMake USE_OMP=ON); without it every block runs
+     * in turn on the multithreaded LAPACK.
+     *
+     * @return the result of Eigh(blocks[i], is_V, row_v) for each block i
+     */
+    std::vector<std::vector<StorageView>> BlockEigh(const std::vector<StorageView> &blocks,
+                                                    const bool &is_V = true,
+                                                    const bool &row_v = false);
+
+    // Svd() of each block of a block-diagonal matrix, scheduled as by BlockEigh()
+    std::vector<std::vector<StorageView>> BlockSvd(const std::vector<StorageView> &blocks,
+                                                   const bool &is_UvT = true);
+
+    /**
+     * @brief BlockSvd() truncated globally: the keepdim largest singular values over all the
+     * blocks are kept, with their singular vectors, however they are spread over the blocks.
+     *
+     * @details The kept values are found by a partial sort of the leading keepdim values of
+     * every block, parallel with OpenMP (see utils_internal::truncate_blocks()). Ties are kept
+     * in the order of the blocks.
+     *
+     * @param err also drop the singular values at or below err times the largest one
+     * @return {S, U, vT} (or {S}) for each block, with k_i values kept in block i and
+     * sum(k_i) <= keepdim; U and vT are views of their first k_i columns and rows
+     */
+    std::vector<std::vector<StorageView>> BlockSvdTruncate(const std::vector<StorageView> &blocks,
+                                                           const cytnx_uint64 &keepdim,
+                                                           const double &err = 0,
+                                                           const bool &is_UvT = true);
+
+    /**
+     * @brief The eigendecomposition of a Hermitian (real symmetric) rank-2 view of dtype
+     * Double, Float, ComplexDouble or ComplexFloat.
+     *
+     * @details Only the lower triangle of a is read. The whole spectrum goes to the divide and
+     * conquer drivers ?syevd/?heevd, which are several times faster than ?syev/?heev once
+     * eigenvectors are wanted; the subsets of EighIndex() and EighInterval() go to the MRRR
+     * drivers ?syevr/?heevr when they compute eigenvectors for a small part of the spectrum
+     * (see utils_internal::eigh_driver()).
+     *
+     * @param is_V also return the eigenvectors
+     * @param row_v return the eigenvectors as the rows of the view rather than its columns
+     * @return {e} or {e, V}: the k eigenvalues in ascending order, a rank-1 view of the real
+     * dtype, and V, n x k (or k x n with row_v), with A V = V diag(e). V is a (possibly
+     * transposed and conjugated) view of the LAPACK output rather than a packed copy; Matmul()
+     * takes it in place.
+     */
+    std::vector<StorageView> Eigh(const StorageView &a, const bool &is_V = true,
+                                  const bool &row_v = false);
+
+    // Eigh() for the eigenpairs of indices [il, iu) in ascending order of the eigenvalues
+    std::vector<StorageView> EighIndex(const StorageView &a, const cytnx_uint64 &il,
+                                       const cytnx_uint64 &iu, const bool &is_V = true,
+                                       const bool &row_v = false);
+
+    // Eigh() for the eigenpairs with eigenvalues in the half-open interval (vl, vu]
+    std::vector<StorageView> EighInterval(const StorageView &a, const double &vl,
+                                          const double &vu, const bool &is_V = true,
+                                          const bool &row_v = false);
+
+    /**
+     * @brief The matrix exponential exp(a) of a square rank-2 view of dtype Double or
+     * ComplexDouble, by scaling and squaring a Padé approximant (Higham 2005).
+     * @details For the action exp(t A) v on a vector of a large or sparse A, see KrylovExpmv.
+     * @return a new contiguous n x n view of dtype ComplexDouble
+     */
+    StorageView Expm(const StorageView &a);
+
+    /**
+     * @brief The matrix product a * b of two rank-2 views of the same dtype, Double, Float,
+     * ComplexDouble or ComplexFloat.
+     *
+     * @details Operands go to gemm in place whenever one of their axes has stride 1. A row-major
+     * operand passes as it is, and a column-major one (e.g. `x.transpose(0, 1)`) passes with
+     * transa/transb = 'T', or 'C' when it is also conjugated (`x.transpose(0, 1).conj()`). Only
+     * an operand with no unit-stride axis, or a conjugated row-major one, which BLAS has no flag
+     * for, is packed first.
+     *
+     * @return a new contiguous m x n view
+     */
+    StorageView Matmul(const StorageView &a, const StorageView &b);
+
+    /**
+     * @brief c = alpha * a * b + beta * c.
+     * @details c must not be conjugated and must have stride 1 along one axis; it is written in
+     * place, after detaching it from a shared buffer (see StorageView::mutable_data()). alpha and
+     * beta must be real for a real dtype.
+     */
+    void Matmul(const StorageView &a, const StorageView &b, StorageView &c,
+                const cytnx_complex128 &alpha = 1, const cytnx_complex128 &beta = 0);
+
+    /**
+     * @brief The matrix-vector product a * x, a of rank 2 and x of rank 1, with the same
+     * handling of transposed and conjugated views as Matmul(). x may have any non-zero stride.
+     */
+    StorageView Matvec(const StorageView &a, const StorageView &x);
+
+    // Matvec() written in place into y, a CPU Storage of a.shape()[0] elements of the dtype of a
+    // sharing no memory with a or x
+    void Matvec(const StorageView &a, const StorageView &x, Storage &y);
+
+    /**
+     * @brief The thin singular value decomposition a = U diag(S) vT of a rank-2 view of dtype
+     * Double, Float, ComplexDouble or ComplexFloat, by ?gesvd.
+     *
+     * @param is_UvT also return the singular vectors
+     * @return {S} or {S, U, vT}: the k = min(m, n) singular values in descending order, a
+     * rank-1 view of the real dtype, U, m x k, and vT, k x n, both contiguous
+     */
+    std::vector<StorageView> Svd(const StorageView &a, const bool &is_UvT = true);
+
+  }  // namespace linalg
+}  // namespace cytnx_core
+
+#endif  // CYTNX_LINALG_H_
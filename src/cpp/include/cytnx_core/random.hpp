@@ -0,0 +1,57 @@
+#ifndef CYTNX_RANDOM_H_
+#define CYTNX_RANDOM_H_
+
+#include <random>
+
+#include <cytnx_core/Storage.hpp>
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  /**
+   * @brief Random initialization of Storages with a counter-based generator.
+   *
+   * @details The values come from Philox4x32-10: element i of a fill is a pure function of
+   * (seed, offset + i), computed in parallel and with AVX2 where available. The same seed gives
+   * bitwise the same Storage for any number of threads, and a large buffer can be filled in
+   * pieces, each with the offset of its first element, to the same result. The real and
+   * imaginary parts of a complex element are drawn independently.
+   *
+   * The supported dtypes are the floating point and complex ones, the 16-bit ones included
+   * (their values are drawn in float and rounded). Only CPU Storages are supported.
+   */
+  namespace random {
+
+    /**
+     * @brief Fill s with values uniformly distributed in [low, high). Rounding to the dtype may
+     * give high itself, notably for the 16-bit dtypes.
+     * @param seed the stream; the default draws one from std::random_device
+     * @param offset the position in the stream of the first element
+     */
+    void uniform_(Storage &s, const double &low = 0, const double &high = 1,
+                  const cytnx_uint64 &seed = std::random_device()(),
+                  const cytnx_uint64 &offset = 0);
+
+    /**
+     * @brief Fill s with normally distributed values of the given mean and standard deviation,
+     * for each of the real and imaginary parts of a complex dtype.
+     */
+    void normal_(Storage &s, const double &mean = 0, const double &std = 1,
+                 const cytnx_uint64 &seed = std::random_device()(),
+                 const cytnx_uint64 &offset = 0);
+
+    // a new Storage of `size` elements filled by uniform_()
+    Storage uniform(const cytnx_uint64 &size, const double &low = 0, const double &high = 1,
+                    const unsigned int &dtype = Type.Double,
+                    const cytnx_uint64 &seed = std::random_device()(),
+                    const cytnx_uint64 &offset = 0);
+
+    // a new Storage of `size` elements filled by normal_()
+    Storage normal(const cytnx_uint64 &size, const double &mean = 0, const double &std = 1,
+                   const unsigned int &dtype = Type.Double,
+                   const cytnx_uint64 &seed = std::random_device()(),
+                   const cytnx_uint64 &offset = 0);
+
+  }  // namespace random
+}  // namespace cytnx_core
+
+#endif  // CYTNX_RANDOM_H_
@@ -0,0 +1,94 @@
+#ifndef CYTNX_PYBIND_ASYNC_PY_H_
+#define CYTNX_PYBIND_ASYNC_PY_H_
+
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <pybind11/pybind11.h>
+
+#include <cytnx_core/ThreadPool.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+// Binding conventions for long-running kernels:
+//
+//  - a binding that may run for more than a few milliseconds releases the GIL around the kernel,
+//    either with py::call_guard<py::gil_scoped_release>() when the arguments convert to plain C++
+//    types, or with an explicit py::gil_scoped_release after the Python arguments are unpacked.
+//  - such a binding also gets an `<name>_async` twin built with submit_async(), which runs the
+//    kernel on ThreadPool::global() and returns a concurrent.futures.Future. Use
+//    asyncio.wrap_future() to await it.
+//
+// The kernel passed to submit_async() runs without the GIL, so it must only capture C++ values.
+
+// Hand the exception of a failed task to its Python future, translated the way pybind11 would
+// translate it for a synchronous call. Needs the GIL.
+inline void future_set_exception(const pybind11::object &future, std::exception_ptr eptr) {
+  namespace py = pybind11;
+  py::object runtime_error = py::module_::import("builtins").attr("RuntimeError");
+  // the exception classes registered in main.cpp
+  auto set_error = [&](const char *name, const cytnx_core::Error &e) {
+    future.attr("set_exception")(py::module_::import("cytnx_core._core").attr(name)(e.what()));
+  };
+  try {
+    std::rethrow_exception(eptr);
+  } catch (py::error_already_set &e) {
+    future.attr("set_exception")(e.value());
+  } catch (const py::builtin_exception &e) {
+    e.set_error();
+    py::error_already_set err;
+    future.attr("set_exception")(err.value());
+  } catch (const cytnx_core::CheckError &e) {
+    set_error("CheckError", e);
+  } catch (const cytnx_core::SystemFailure &e) {
+    set_error("SystemFailure", e);
+  } catch (const cytnx_core::Error &e) {
+    set_error("Error", e);
+  } catch (const std::exception &e) {
+    future.attr("set_exception")(runtime_error(e.what()));
+  } catch (...) {
+    future.attr("set_exception")(runtime_error("unknown C++ exception"));
+  }
+}
+
+// Run f() on the global thread pool and return a concurrent.futures.Future of its result. Must be
+// called with the GIL held; the result is converted with py::cast.
+template <class F>
+pybind11::object submit_async(F &&f) {
+  namespace py = pybind11;
+  using R = std::invoke_result_t<std::decay_t<F>>;
+  py::object future = py::module_::import("concurrent.futures").attr("Future")();
+  // owned by the task, only touched with the GIL held
+  auto *handle = new py::object(future);
+  cytnx_core::ThreadPool::global().enqueue([handle, f = std::forward<F>(f)]() mutable {
+    std::exception_ptr eptr;
+    std::conditional_t<std::is_void_v<R>, bool, std::optional<R>> result{};
+    try {
+      if constexpr (std::is_void_v<R>)
+        f();
+      else
+        result.emplace(f());
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+    py::gil_scoped_acquire gil;
+    try {
+      // a future cancelled while pending must not be resolved
+      if (!handle->attr("cancelled")().template cast<bool>()) {
+        if (eptr)
+          future_set_exception(*handle, eptr);
+        else if constexpr (std::is_void_v<R>)
+          handle->attr("set_result")(py::none());
+        else
+          handle->attr("set_result")(py::cast(std::move(*result)));
+      }
+    } catch (py::error_already_set &e) {
+      e.discard_as_unraisable(__func__);
+    }
+    delete handle;
+  });
+  return future;
+}
+
+#endif  // CYTNX_PYBIND_ASYNC_PY_H_
@@ -0,0 +1,197 @@
+#include <cstdint>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace cytnx_core;
+
+// The DLPack ABI (https://github.com/dmlc/dlpack, v0.8, unversioned DLManagedTensor), declared
+// here rather than pulling in dlpack.h since only these few layouts are needed.
+namespace {
+  enum DLDeviceType : int32_t { kDLCPU = 1, kDLCUDA = 2, kDLCUDAHost = 3, kDLCUDAManaged = 13 };
+  enum DLDataTypeCode : uint8_t {
+    kDLInt = 0,
+    kDLUInt = 1,
+    kDLFloat = 2,
+    kDLBfloat = 4,
+    kDLComplex = 5,
+    kDLBool = 6
+  };
+
+  struct DLDevice {
+    int32_t device_type;
+    int32_t device_id;
+  };
+  struct DLDataType {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+  };
+  struct DLTensor {
+    void *data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t *shape;
+    int64_t *strides;
+    uint64_t byte_offset;
+  };
+  struct DLManagedTensor {
+    DLTensor dl_tensor;
+    void *manager_ctx;
+    void (*deleter)(DLManagedTensor *self);
+  };
+
+  // the producer side context: keeps the exported Storage (and so its memory) alive
+  struct ExportContext {
+    Storage storage;
+    int64_t shape[1];
+    int64_t strides[1];
+    DLManagedTensor managed;
+  };
+
+  DLDataType dl_dtype(const unsigned int &dtype) {
+    const uint8_t bits = 8 * Type.typeSize(dtype);
+    if (dtype == Type.BFloat16) return {kDLBfloat, bits, 1};
+    if (Type.is_complex(dtype) && dtype != Type.ComplexBFloat16) return {kDLComplex, bits, 1};
+    if (Type.is_float(dtype) && !Type.is_complex(dtype)) return {kDLFloat, bits, 1};
+    if (dtype == Type.Bool) return {kDLBool, bits, 1};
+    if (Type.is_int(dtype)) return {Type.is_unsigned(dtype) ? kDLUInt : kDLInt, bits, 1};
+    cytnx_input_error_msg(true, "[ERROR] a Storage of type %s cannot be exported via DLPack.",
+                          Type.enum_name(dtype));
+    return {};
+  }
+
+  unsigned int dtype_from_dl(const DLDataType &dt) {
+    for (unsigned int t = 0; t < N_Type; t++) {
+      if (t == Type.Void || t == Type.ComplexBFloat16) continue;
+      DLDataType cand = dl_dtype(t);
+      if (dt.lanes == 1 && cand.code == dt.code && cand.bits == dt.bits) return t;
+    }
+    cytnx_input_error_msg(true,
+                          "[ERROR] DLPack dtype (code=%d, bits=%d, lanes=%d) has no cytnx Type.",
+                          (int)dt.code, (int)dt.bits, (int)dt.lanes);
+    return Type.Void;
+  }
+
+  DLDevice dl_device(const Storage &s) {
+    // GPU Storages are allocated as CUDA managed memory, which is a valid device pointer
+    if (s.device() == Device.cpu) return {kDLCPU, 0};
+    return {kDLCUDA, s.device()};
+  }
+
+  int device_from_dl(const DLDevice &dev) {
+    switch (dev.device_type) {
+      case kDLCPU:
+      case kDLCUDAHost:
+        return Device.cpu;
+      case kDLCUDA:
+      case kDLCUDAManaged:
+#ifdef UNI_GPU
+        return dev.device_id;
+#else
+        cytnx_input_error_msg(true, "[ERROR] DLPack tensor on CUDA device %d, %s", dev.device_id,
+                              "but cytnx_core is built without CUDA.");
+#endif
+      default:
+        cytnx_input_error_msg(true, "[ERROR] unsupported DLPack device type %d.", dev.device_type);
+    }
+    return Device.cpu;
+  }
+
+  void dlpack_capsule_destructor(PyObject *capsule) {
+    // a consumer renamed it to "used_dltensor" and took over the deleter
+    if (PyCapsule_IsValid(capsule, "used_dltensor")) return;
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    auto *managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule, "dltensor"));
+    if (managed == nullptr)
+      PyErr_WriteUnraisable(capsule);
+    else if (managed->deleter)
+      managed->deleter(managed);
+    PyErr_Restore(type, value, traceback);
+  }
+
+  py::object to_dlpack(const Storage &self) {
+    auto *ctx = new ExportContext{self, {(int64_t)self.size()}, {1}, {}};
+#ifdef UNI_GPU
+    // no stream-ordered handoff: make the data visible to whatever stream the consumer uses
+    if (self.device() != Device.cpu) checkCudaErrors(cudaDeviceSynchronize());
+#endif
+    DLTensor &t = ctx->managed.dl_tensor;
+    t.data = self.data();
+    t.device = dl_device(self);
+    t.ndim = 1;
+    t.dtype = dl_dtype(self.dtype());
+    t.shape = ctx->shape;
+    t.strides = ctx->strides;
+    t.byte_offset = 0;
+    ctx->managed.manager_ctx = ctx;
+    ctx->managed.deleter = [](DLManagedTensor *managed) {
+      delete static_cast<ExportContext *>(managed->manager_ctx);
+    };
+    PyObject *capsule = PyCapsule_New(&ctx->managed, "dltensor", dlpack_capsule_destructor);
+    if (capsule == nullptr) {
+      delete ctx;
+      throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::object>(capsule);
+  }
+
+  // Take over a DLPack capsule, or any object implementing __dlpack__, without a copy.
+  Storage from_dlpack(const py::object &obj) {
+    py::object capsule = py::hasattr(obj, "__dlpack__") ? obj.attr("__dlpack__")() : obj;
+    cytnx_input_error_msg(!PyCapsule_IsValid(capsule.ptr(), "dltensor"),
+                          "[ERROR] expect a DLPack capsule that has not been consumed yet.%s",
+                          "\n");
+    auto *managed =
+      static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule.ptr(), "dltensor"));
+    const DLTensor &t = managed->dl_tensor;
+
+    const unsigned int dtype = dtype_from_dl(t.dtype);
+    const int device = device_from_dl(t.device);
+    cytnx_uint64 size = 1;
+    int64_t expect = 1;
+    for (int32_t i = t.ndim - 1; i >= 0; i--) {
+      cytnx_input_error_msg(t.strides != nullptr && t.shape[i] > 1 && t.strides[i] != expect,
+                            "[ERROR] only C-contiguous DLPack tensors can be taken over "
+                            "without a %s",
+                            "copy.");
+      expect *= t.shape[i];
+      size *= t.shape[i];
+    }
+
+    void *ptr = static_cast<char *>(t.data) + t.byte_offset;
+    std::shared_ptr<void> owner(ptr, [managed](void *) {
+      if (managed->deleter) managed->deleter(managed);
+    });
+    PyCapsule_SetName(capsule.ptr(), "used_dltensor");
+    return Storage::from_external(ptr, size, dtype, device, std::move(owner));
+  }
+}  // namespace
+
+void dlpack_binding(py::module &m) {
+  auto storage = py::reinterpret_borrow<py::class_<Storage>>(m.attr("Storage"));
+  storage
+    .def(
+      "__dlpack__",
+      [](const Storage &self, const py::object &stream, const py::kwargs &) {
+        return to_dlpack(self);
+      },
+      py::arg("stream") = py::none())
+    .def("__dlpack_device__",
+         [](const Storage &self) {
+           DLDevice dev = dl_device(self);
+           return py::make_tuple(dev.device_type, dev.device_id);
+         })
+    .def_static("from_dlpack", &from_dlpack, py::arg("obj"),
+                "Take over a DLPack capsule, or an object implementing __dlpack__, without a "
+                "copy.");
+  m.def("from_dlpack", &from_dlpack, py::arg("obj"),
+        "Take over a DLPack capsule, or an object implementing __dlpack__, without a copy.");
+}
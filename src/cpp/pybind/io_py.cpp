@@ -0,0 +1,173 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+#include "async_py.hpp"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace cytnx_core;
+
+void io_binding(py::module &m) {
+  auto mio = m.def_submodule("io");
+  mio.attr("tensor_file_version") = io::tensor_file_version;
+  mio.attr("default_chunk_bytes") = io::default_chunk_bytes;
+
+  py::class_<io::TensorFileInfo>(mio, "TensorFileInfo")
+    .def_readonly("version", &io::TensorFileInfo::version)
+    .def_property_readonly(
+      "dtype",
+      [](const io::TensorFileInfo &self) { return static_cast<Type_class::Type>(self.dtype); })
+    .def_readonly("shape", &io::TensorFileInfo::shape)
+    .def_readonly("size", &io::TensorFileInfo::size)
+    .def_readonly("chunk_bytes", &io::TensorFileInfo::chunk_bytes)
+    .def_readonly("payload_offset", &io::TensorFileInfo::payload_offset)
+    .def_readonly("checksums", &io::TensorFileInfo::checksums)
+    .def("__repr__", [](const io::TensorFileInfo &self) {
+      return "<io.TensorFileInfo v" + std::to_string(self.version) +
+             " dtype=" + std::string(Type.enum_name(self.dtype)) +
+             " size=" + std::to_string(self.size) + ">";
+    });
+
+  mio.def("save", &io::save_tensor_file, py::arg("path"), py::arg("storage"),
+          py::arg("shape") = std::vector<cytnx_uint64>(),
+          py::arg("chunk_bytes") = io::default_chunk_bytes,
+          py::call_guard<py::gil_scoped_release>());
+  mio.def(
+    "save_async",
+    [](const std::string &path, const Storage &storage, const std::vector<cytnx_uint64> &shape,
+       const cytnx_uint64 &chunk_bytes) {
+      return submit_async([=]() { io::save_tensor_file(path, storage, shape, chunk_bytes); });
+    },
+    py::arg("path"), py::arg("storage"), py::arg("shape") = std::vector<cytnx_uint64>(),
+    py::arg("chunk_bytes") = io::default_chunk_bytes);
+
+  // returns (storage, shape); the storage maps the file and is only read from disk when touched
+  auto load = [](const std::string &path, const bool &verify) {
+    io::LoadedTensor t = io::load_tensor_file(path, verify);
+    return std::make_pair(t.storage, t.shape);
+  };
+  mio.def("load", load, py::arg("path"), py::arg("verify") = false,
+          py::call_guard<py::gil_scoped_release>());
+  mio.def(
+    "load_async",
+    [load](const std::string &path, const bool &verify) {
+      return submit_async([=]() { return load(path, verify); });
+    },
+    py::arg("path"), py::arg("verify") = false);
+
+  mio.def("info", &io::tensor_file_info, py::arg("path"),
+          py::call_guard<py::gil_scoped_release>());
+  mio.def("verify", &io::verify_tensor_file, py::arg("path"),
+          py::call_guard<py::gil_scoped_release>());
+
+  // chunked, compressed streams
+  auto make_options = [](const cytnx_uint64 &chunk_bytes, const bool &shuffle,
+                         const bool &compress, const int &threads) {
+    io::StreamOptions options;
+    options.chunk_bytes = chunk_bytes;
+    options.shuffle = shuffle;
+    options.compress = compress;
+    options.threads = threads;
+    return options;
+  };
+  const io::StreamOptions defaults;
+  mio.def(
+    "save_stream",
+    [make_options](const std::string &path, const Storage &storage,
+                   const std::vector<cytnx_uint64> &shape, const cytnx_uint64 &chunk_bytes,
+                   const bool &shuffle, const bool &compress, const int &threads) {
+      io::save_tensor_stream(path, storage, shape,
+                             make_options(chunk_bytes, shuffle, compress, threads));
+    },
+    py::arg("path"), py::arg("storage"), py::arg("shape") = std::vector<cytnx_uint64>(),
+    py::arg("chunk_bytes") = defaults.chunk_bytes, py::arg("shuffle") = defaults.shuffle,
+    py::arg("compress") = defaults.compress, py::arg("threads") = defaults.threads,
+    py::call_guard<py::gil_scoped_release>());
+  mio.def(
+    "save_stream_async",
+    [make_options](const std::string &path, const Storage &storage,
+                   const std::vector<cytnx_uint64> &shape, const cytnx_uint64 &chunk_bytes,
+                   const bool &shuffle, const bool &compress, const int &threads) {
+      io::StreamOptions options = make_options(chunk_bytes, shuffle, compress, threads);
+      return submit_async([=]() { io::save_tensor_stream(path, storage, shape, options); });
+    },
+    py::arg("path"), py::arg("storage"), py::arg("shape") = std::vector<cytnx_uint64>(),
+    py::arg("chunk_bytes") = defaults.chunk_bytes, py::arg("shuffle") = defaults.shuffle,
+    py::arg("compress") = defaults.compress, py::arg("threads") = defaults.threads);
+
+  py::class_<io::StreamChunk>(mio, "StreamChunk")
+    .def_readonly("offset", &io::StreamChunk::offset)
+    .def_readonly("stored_bytes", &io::StreamChunk::stored_bytes)
+    .def_readonly("checksum", &io::StreamChunk::checksum)
+    .def_readonly("codec", &io::StreamChunk::codec);
+
+  py::class_<io::TensorStreamReader>(mio, "StreamReader")
+    .def(py::init<const std::string &>(), py::arg("path"))
+    .def_property_readonly(
+      "dtype",
+      [](const io::TensorStreamReader &self) {
+        return static_cast<Type_class::Type>(self.dtype());
+      })
+    .def_property_readonly("shape", &io::TensorStreamReader::shape)
+    .def_property_readonly("size", &io::TensorStreamReader::size)
+    .def_property_readonly("chunk_bytes", &io::TensorStreamReader::chunk_bytes)
+    .def_property_readonly("chunks", &io::TensorStreamReader::chunks)
+    .def("nchunks", &io::TensorStreamReader::nchunks)
+    .def("__len__", &io::TensorStreamReader::nchunks)
+    .def("chunk_begin", &io::TensorStreamReader::chunk_begin, py::arg("i"))
+    .def("chunk_size", &io::TensorStreamReader::chunk_size, py::arg("i"))
+    .def(
+      "read_chunk",
+      [](const io::TensorStreamReader &self, const cytnx_uint64 &i) { return self.read_chunk(i); },
+      py::arg("i"), py::call_guard<py::gil_scoped_release>())
+    .def("read", &io::TensorStreamReader::read, py::arg("threads") = 0,
+         py::call_guard<py::gil_scoped_release>());
+
+  // returns (storage, shape), decompressing the chunks in parallel
+  auto load_stream = [](const std::string &path, const int &threads) {
+    io::TensorStreamReader reader(path);
+    return std::make_pair(reader.read(threads), reader.shape());
+  };
+  mio.def("load_stream", load_stream, py::arg("path"), py::arg("threads") = 0,
+          py::call_guard<py::gil_scoped_release>());
+  mio.def(
+    "load_stream_async",
+    [load_stream](const std::string &path, const int &threads) {
+      return submit_async([=]() { return load_stream(path, threads); });
+    },
+    py::arg("path"), py::arg("threads") = 0);
+
+  // commit/restore/compact do file I/O and release the GIL; the object serializes its own calls
+  py::class_<io::DeltaCheckpoint>(mio, "DeltaCheckpoint")
+    .def(py::init<const std::string &, const cytnx_uint64 &, const double &>(), py::arg("path"),
+         py::arg("chunk_bytes") = 1ULL << 20, py::arg("compact_ratio") = 4.0)
+    .def("stage", &io::DeltaCheckpoint::stage, py::arg("name"), py::arg("storage"),
+         py::arg("shape") = std::vector<cytnx_uint64>())
+    .def("remove", &io::DeltaCheckpoint::remove, py::arg("name"))
+    .def("commit", &io::DeltaCheckpoint::commit, py::call_guard<py::gil_scoped_release>())
+    .def("restore",
+         [](const io::DeltaCheckpoint &self) {
+           std::map<std::string, io::LoadedTensor> state;
+           {
+             py::gil_scoped_release release;
+             state = self.restore();
+           }
+           // name -> (storage, shape)
+           py::dict out;
+           for (auto &kv : state)
+             out[py::str(kv.first)] = py::make_tuple(kv.second.storage, kv.second.shape);
+           return out;
+         })
+    .def("compact", &io::DeltaCheckpoint::compact, py::call_guard<py::gil_scoped_release>())
+    .def_property_readonly("epoch", &io::DeltaCheckpoint::epoch)
+    .def_property_readonly("chunk_bytes", &io::DeltaCheckpoint::chunk_bytes)
+    .def_property_readonly("log_bytes", &io::DeltaCheckpoint::log_bytes)
+    .def_property_readonly("live_bytes", &io::DeltaCheckpoint::live_bytes)
+    .def("names", &io::DeltaCheckpoint::names);
+}
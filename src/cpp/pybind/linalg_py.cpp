@@ -0,0 +1,43 @@
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+namespace py = pybind11;
+using namespace cytnx_core;
+
+void linalg_binding(py::module &m) {
+  auto mla = m.def_submodule("linalg");
+
+  mla.def("BlockEigh", &linalg::BlockEigh, py::arg("blocks"), py::arg("is_V") = true,
+          py::arg("row_v") = false, py::call_guard<py::gil_scoped_release>());
+  mla.def("BlockSvd", &linalg::BlockSvd, py::arg("blocks"), py::arg("is_UvT") = true,
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("BlockSvdTruncate", &linalg::BlockSvdTruncate, py::arg("blocks"), py::arg("keepdim"),
+          py::arg("err") = 0.0, py::arg("is_UvT") = true,
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("Eigh", &linalg::Eigh, py::arg("a"), py::arg("is_V") = true, py::arg("row_v") = false,
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("EighIndex", &linalg::EighIndex, py::arg("a"), py::arg("il"), py::arg("iu"),
+          py::arg("is_V") = true, py::arg("row_v") = false,
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("EighInterval", &linalg::EighInterval, py::arg("a"), py::arg("vl"), py::arg("vu"),
+          py::arg("is_V") = true, py::arg("row_v") = false,
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("Expm", &linalg::Expm, py::arg("a"), py::call_guard<py::gil_scoped_release>());
+
+  mla.def("Matmul", py::overload_cast<const StorageView &, const StorageView &>(&linalg::Matmul),
+          py::arg("a"), py::arg("b"), py::call_guard<py::gil_scoped_release>());
+  mla.def(
+    "Matmul",
+    [](const StorageView &a, const StorageView &b, StorageView &c, const cytnx_complex128 &alpha,
+       const cytnx_complex128 &beta) { linalg::Matmul(a, b, c, alpha, beta); },
+    py::arg("a"), py::arg("b"), py::arg("c"), py::arg("alpha") = cytnx_complex128(1),
+    py::arg("beta") = cytnx_complex128(0), py::call_guard<py::gil_scoped_release>(),
+    "c = alpha * a * b + beta * c, written in place.");
+  mla.def("Matvec", &linalg::Matvec, py::arg("a"), py::arg("x"),
+          py::call_guard<py::gil_scoped_release>());
+  mla.def("Svd", &linalg::Svd, py::arg("a"), py::arg("is_UvT") = true,
+          py::call_guard<py::gil_scoped_release>());
+}
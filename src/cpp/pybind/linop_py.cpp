@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace cytnx_core;
+
+// The numpy dtype of a cytnx dtype; BFloat16 and the complex 16-bit types have none.
+static py::dtype numpy_dtype(const unsigned int &dtype) {
+  return dispatch_type(dtype, [&](auto tag) -> py::dtype {
+    using T = typename decltype(tag)::type;
+    if constexpr (std::is_same_v<T, cytnx_float16>) {
+      return py::dtype("e");
+    } else if constexpr (std::is_same_v<T, void> ||
+                         Type_class::is_half(Type_class::cy_typeid_v<T>)) {
+      cytnx_input_error_msg(true, "[ERROR] a LinOp of %s has no numpy representation.\n",
+                            Type.enum_name(dtype));
+      return py::dtype();
+    } else {
+      return py::dtype(py::format_descriptor<T>::format());
+    }
+  });
+}
+
+/**
+ * A LinOp applied by a Python callable fn(x, y), where x and y are numpy arrays of shape (nx,)
+ * for matvec() and (nx, k) for matmat(). They share the memory of the operands, x read-only;
+ * fn writes A x into y, or returns it to be copied there. The GIL is taken once per call, so a
+ * block of k vectors costs one Python call, not k.
+ */
+class PyLinOp : public LinOp {
+ public:
+  PyLinOp(py::function fn, const cytnx_uint64 &nx, const unsigned int &dtype)
+      : LinOp(nx, dtype), _fn(std::move(fn)), _npdtype(numpy_dtype(dtype)) {}
+
+  ~PyLinOp() override {
+    // the last reference may go away on a thread without the GIL
+    py::gil_scoped_acquire gil;
+    _fn = py::function();
+    _npdtype = py::dtype();
+  }
+
+ protected:
+  void apply_vec(const Storage &x, Storage &y) const override {
+    py::gil_scoped_acquire gil;
+    const py::ssize_t elem = Type.typeSize(dtype());
+    const std::vector<py::ssize_t> shape = {py::ssize_t(nx())}, strides = {elem};
+    call(py::array(_npdtype, shape, strides, x.data(), py::cast(x)),
+         py::array(_npdtype, shape, strides, y.data(), py::cast(y)));
+  }
+
+  void apply_block(const StorageView &x, StorageView &y) const override {
+    py::gil_scoped_acquire gil;
+    const py::ssize_t elem = Type.typeSize(dtype()), k = x.shape()[1];
+    const std::vector<py::ssize_t> shape = {py::ssize_t(nx()), k}, strides = {k * elem, elem};
+    void *out = y.mutable_data();
+    call(py::array(_npdtype, shape, strides, x.data(), py::cast(x)),
+         py::array(_npdtype, shape, strides, out, py::cast(y)));
+  }
+
+ private:
+  py::function _fn;
+  py::dtype _npdtype;
+
+  void call(py::array x, py::array y) const {
+    x.attr("setflags")("write"_a = false);
+    const py::object ret = _fn(x, y);
+    if (ret.is_none()) return;
+    const py::array r = py::array::ensure(ret);
+    cytnx_input_error_msg(!r || r.ndim() != y.ndim() ||
+                            !std::equal(y.shape(), y.shape() + y.ndim(), r.shape()),
+                          "[ERROR] a LinOp callable returned an array of another shape than %s",
+                          "y.\n");
+    y[py::ellipsis()] = r;
+  }
+};
+
+void linop_binding(py::module &m) {
+  py::class_<LinOp>(m, "LinOp")
+    .def(py::init([](py::function fn, const cytnx_uint64 &nx, const Type_class::Type &dtype) {
+           return static_cast<LinOp *>(new PyLinOp(std::move(fn), nx, dtype));
+         }),
+         py::arg("fn"), py::arg("nx"), py::arg("dtype") = Type_class::Double)
+    .def("nx", &LinOp::nx)
+    .def_property_readonly(
+      "dtype", [](const LinOp &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def("matvec", py::overload_cast<const Storage &>(&LinOp::matvec, py::const_),
+         py::arg("x"), py::call_guard<py::gil_scoped_release>())
+    .def("matvec", py::overload_cast<const Storage &, Storage &>(&LinOp::matvec, py::const_),
+         py::arg("x"), py::arg("y"), py::call_guard<py::gil_scoped_release>())
+    .def("matmat", py::overload_cast<const StorageView &>(&LinOp::matmat, py::const_),
+         py::arg("x"), py::call_guard<py::gil_scoped_release>())
+    .def("matmat",
+         py::overload_cast<const StorageView &, StorageView &>(&LinOp::matmat, py::const_),
+         py::arg("x"), py::arg("y"), py::call_guard<py::gil_scoped_release>())
+    .def("__repr__", [](const LinOp &self) {
+      return "<LinOp nx=" + std::to_string(self.nx()) + " " + Type.enum_name(self.dtype()) +
+             ">";
+    });
+
+  py::class_<DenseLinOp, LinOp>(m, "DenseLinOp")
+    .def(py::init<const StorageView &>(), py::arg("matrix"))
+    .def_property_readonly("matrix", &DenseLinOp::matrix);
+
+  py::class_<SparseLinOp, LinOp>(m, "SparseLinOp")
+    .def(py::init<const CsrMatrix &>(), py::arg("matrix"))
+    .def_property_readonly("matrix", &SparseLinOp::matrix);
+
+  py::class_<KrylovExpmv> pkx(m, "KrylovExpmv");
+  py::class_<KrylovExpmv::Stats>(pkx, "Stats")
+    .def_readonly("steps", &KrylovExpmv::Stats::steps)
+    .def_readonly("rejected", &KrylovExpmv::Stats::rejected)
+    .def_readonly("matvecs", &KrylovExpmv::Stats::matvecs)
+    .def_readonly("error", &KrylovExpmv::Stats::error);
+  // the KrylovExpmv refers to its LinOp, which must stay alive with it
+  pkx
+    .def(py::init<const LinOp &, const cytnx_uint64 &, const double &>(), py::arg("op"),
+         py::arg("krylov_dim") = 30, py::arg("tol") = 1e-12, py::keep_alive<1, 2>())
+    .def_property_readonly("op", &KrylovExpmv::op)
+    .def("krylov_dim", &KrylovExpmv::krylov_dim)
+    .def("tol", &KrylovExpmv::tol)
+    .def("apply", &KrylovExpmv::apply, py::arg("v"), py::arg("t"),
+         py::call_guard<py::gil_scoped_release>(), "v = exp(t A) v in place.")
+    .def_property_readonly("stats", &KrylovExpmv::stats);
+}
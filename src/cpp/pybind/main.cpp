@@ -13,6 +13,8 @@
 #include "complex.h"
 #include <cytnx_core/cytnx_core.hpp>
 
+#include "async_py.hpp"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 using namespace cytnx_core;
@@ -28,21 +30,24 @@ using namespace cytnx_core;
 // void symmetry_binding(py::module &m);
 
 // void generator_binding(py::module &m);
-// void storage_binding(py::module &m);
+void storage_binding(py::module &m);
+void dlpack_binding(py::module &m);
+void io_binding(py::module &m);
+void sparse_binding(py::module &m);
 // void tensor_binding(py::module &m);
 
 // void network_binding(py::module &m);
 
-// class PyLinOp;
-// void linop_binding(py::module &m);
+class PyLinOp;
+void linop_binding(py::module &m);
 
 // class cHclass;
 // void unitensor_binding(py::module &m);
 
-// void linalg_binding(py::module &m);
+void linalg_binding(py::module &m);
 // void algo_binding(py::module &m);
 // void physics_related_binding(py::module &m);
-// void random_binding(py::module &m);
+void random_binding(py::module &m);
 // void tnalgo_binding(py::module &m);
 // void scalar_binding(py::module &m);
 
@@ -53,6 +58,17 @@ PYBIND11_MODULE(_core, m) {
 
   py::add_ostream_redirect(m, "ostream_redirect");
 
+  // cytnx_core exceptions; all are RuntimeErrors
+  auto &error = py::register_exception<cytnx_core::Error>(m, "Error", PyExc_RuntimeError);
+  py::register_exception<cytnx_core::CheckError>(m, "CheckError", error.ptr());
+  py::register_exception<cytnx_core::SystemFailure>(m, "SystemFailure", error.ptr());
+  m.attr("check_level") = CYTNX_CHECK_LEVEL;
+#ifdef UNI_OMP
+  m.attr("openmp") = true;
+#else
+  m.attr("openmp") = false;
+#endif
+
   py::enum_<cytnx_core::Type_class::Type> type_enum(m, "Type");
   for (std::size_t i = 0; i < N_Type; ++i) {
     type_enum.value(Type.enum_name(i), static_cast<Type_class::Type>(i));
@@ -64,10 +80,145 @@ PYBIND11_MODULE(_core, m) {
   mdev.attr("Cuda") = (cytnx_int64)cytnx_core::Device.cuda;
   mdev.attr("Ngpus") = cytnx_core::Device.Ngpus;
   mdev.attr("Ncpus") = cytnx_core::Device.Ncpus;
+  mdev.attr("Cpu_model") = cytnx_core::Device.Cpu_model;
+  mdev.attr("Nsockets") = cytnx_core::Device.Nsockets;
+  mdev.attr("Nnuma") = cytnx_core::Device.Nnuma;
+  mdev.attr("Ncores") = cytnx_core::Device.Ncores;
+  mdev.attr("Nsmt") = cytnx_core::Device.Nsmt;
+  mdev.attr("L1d_size") = cytnx_core::Device.L1d_size;
+  mdev.attr("L2_size") = cytnx_core::Device.L2_size;
+  mdev.attr("L3_size") = cytnx_core::Device.L3_size;
+  mdev.attr("Cacheline_size") = cytnx_core::Device.Cacheline_size;
+  mdev.attr("Simd") = cytnx_core::Device.Simd;
   mdev.def("print_property", []() { cytnx_core::Device.print_property(); });
   mdev.def("getname", [](const int &device_id) -> std::string {
     return cytnx_core::Device.getname(device_id);
   });
+  mdev.def("has_simd", [](const std::string &ext) -> bool {
+    return cytnx_core::Device.has_simd(ext);
+  });
+  mdev.def("cpu_signature", []() -> std::string { return cytnx_core::Device.cpu_signature(); });
+
+  auto mtune = m.def_submodule("autotune");
+  py::class_<cytnx_core::autotune::Entry>(mtune, "Entry")
+    .def_readonly("kernel", &cytnx_core::autotune::Entry::kernel)
+    .def_readonly("block_bytes", &cytnx_core::autotune::Entry::block_bytes)
+    .def_readonly("threads", &cytnx_core::autotune::Entry::threads)
+    .def_readonly("seconds", &cytnx_core::autotune::Entry::seconds)
+    .def("__repr__", [](const cytnx_core::autotune::Entry &e) {
+      return "<autotune.Entry " + e.kernel + ": block_bytes=" + std::to_string(e.block_bytes) +
+             ", threads=" + std::to_string(e.threads) + ">";
+    });
+  mtune.def("cache_path", &cytnx_core::autotune::cache_path);
+  mtune.def("enabled", &cytnx_core::autotune::enabled);
+  mtune.def("entries", &cytnx_core::autotune::entries);
+  mtune.def("tuned_entries", &cytnx_core::autotune::tuned_entries,
+            py::call_guard<py::gil_scoped_release>());
+  mtune.def("prewarm", &cytnx_core::autotune::prewarm, py::arg("force") = false,
+            py::call_guard<py::gil_scoped_release>());
+  mtune.def(
+    "prewarm_async",
+    [](bool force) {
+      return submit_async([force]() { return cytnx_core::autotune::prewarm(force); });
+    },
+    py::arg("force") = false);
+  mtune.def("clear_cache", &cytnx_core::autotune::clear_cache);
+
+  auto mtrace = m.def_submodule("trace");
+  mtrace.attr("ring_capacity") = cytnx_core::trace::ring_capacity;
+  mtrace.def("compiled", &cytnx_core::trace::compiled);
+  mtrace.def("enable", &cytnx_core::trace::enable, py::arg("on") = true);
+  mtrace.def("disable", &cytnx_core::trace::disable);
+  mtrace.def("enabled", &cytnx_core::trace::enabled);
+  mtrace.def("clear", &cytnx_core::trace::clear);
+  mtrace.def("num_events", &cytnx_core::trace::num_events);
+  mtrace.def("chrome_json", &cytnx_core::trace::chrome_json,
+             py::call_guard<py::gil_scoped_release>());
+  mtrace.def("dump", &cytnx_core::trace::dump_chrome, py::arg("path"),
+             py::call_guard<py::gil_scoped_release>());
+
+  auto mcount = m.def_submodule("counters");
+  py::class_<cytnx_core::counters::Entry>(mcount, "Entry")
+    .def_property_readonly(
+      "routine",
+      [](const cytnx_core::counters::Entry &e) {
+        return std::string(cytnx_core::counters::routine_name(e.routine));
+      })
+    .def_readonly("dtype", &cytnx_core::counters::Entry::dtype)
+    .def_readonly("calls", &cytnx_core::counters::Entry::calls)
+    .def_readonly("flops", &cytnx_core::counters::Entry::flops)
+    .def_readonly("bytes", &cytnx_core::counters::Entry::bytes)
+    .def_readonly("seconds", &cytnx_core::counters::Entry::seconds)
+    .def("__repr__", [](const cytnx_core::counters::Entry &e) {
+      return std::string("<counters.Entry ") + cytnx_core::counters::routine_name(e.routine) +
+             " " + cytnx_core::Type_class::enum_name(e.dtype) +
+             ": calls=" + std::to_string(e.calls) + ">";
+    });
+  mcount.def("enable", &cytnx_core::counters::enable, py::arg("on") = true);
+  mcount.def("disable", &cytnx_core::counters::disable);
+  mcount.def("enabled", &cytnx_core::counters::enabled);
+  mcount.def("reset", &cytnx_core::counters::reset);
+  mcount.def("entries", &cytnx_core::counters::entries);
+  mcount.def("report", &cytnx_core::counters::report, py::arg("peak_gflops") = 0,
+             py::arg("peak_gbs") = 0);
+
+  auto mperf = m.def_submodule("perf");
+  // the events as a dict, leaving out those that could not be counted
+  auto perf_counts = [](const cytnx_core::perf::Region &r) {
+    py::dict out;
+    for (unsigned int e = 0; e < cytnx_core::perf::N_Event; e++)
+      if (r.counts[e] >= 0) out[cytnx_core::perf::event_name(e)] = r.counts[e];
+    return out;
+  };
+  py::class_<cytnx_core::perf::Region>(mperf, "Region")
+    .def_readonly("name", &cytnx_core::perf::Region::name)
+    .def_readonly("calls", &cytnx_core::perf::Region::calls)
+    .def_readonly("seconds", &cytnx_core::perf::Region::seconds)
+    .def_property_readonly("counts", perf_counts)
+    .def_property_readonly("ipc",
+                           [](const cytnx_core::perf::Region &r) -> py::object {
+                             const double ipc = r.ipc();
+                             return ipc < 0 ? py::none() : py::cast(ipc);
+                           })
+    .def("__repr__", [](const cytnx_core::perf::Region &r) {
+      return "<perf.Region " + r.name + ": calls=" + std::to_string(r.calls) + ">";
+    });
+  // with perf.scope("name"): ... counts the enclosed Python code as a region
+  struct PerfScope {
+    std::string name;
+    std::unique_ptr<cytnx_core::perf::Scope> scope;
+  };
+  py::class_<PerfScope>(mperf, "scope")
+    .def(py::init([](const std::string &name) { return PerfScope{name, nullptr}; }),
+         py::arg("name"))
+    .def("__enter__",
+         [](PerfScope &s) -> PerfScope & {
+           s.scope.reset(new cytnx_core::perf::Scope(s.name.c_str()));
+           return s;
+         })
+    .def("__exit__", [](PerfScope &s, py::args) { s.scope.reset(); });
+  mperf.def("available", &cytnx_core::perf::available);
+  mperf.def("events", []() {
+    const auto events = cytnx_core::perf::events();
+    py::dict out;
+    for (unsigned int e = 0; e < cytnx_core::perf::N_Event; e++)
+      out[cytnx_core::perf::event_name(e)] = bool(events[e]);
+    return out;
+  });
+  mperf.def("status", &cytnx_core::perf::status);
+  mperf.def("enable", &cytnx_core::perf::enable, py::arg("on") = true);
+  mperf.def("disable", &cytnx_core::perf::disable);
+  mperf.def("enabled", &cytnx_core::perf::enabled);
+  mperf.def("reset", &cytnx_core::perf::reset);
+  mperf.def("regions", &cytnx_core::perf::regions);
+  mperf.def("report", &cytnx_core::perf::report);
+
+  // async tasks resolve their futures with the GIL, so they must finish before finalization
+  py::module_::import("atexit").attr("register")(py::cpp_function(
+    []() { cytnx_core::ThreadPool::global().wait_idle(); },
+    py::call_guard<py::gil_scoped_release>()));
+  m.def("num_workers", []() { return cytnx_core::ThreadPool::global().size(); },
+        "The number of threads of the native pool running the *_async calls.");
 
   // m.def("set_mkl_ilp64", &cytnx_core::set_mkl_ilp64);
   // m.def("get_mkl_code", &cytnx_core::get_mkl_code);
@@ -107,15 +258,18 @@ PYBIND11_MODULE(_core, m) {
 
   // generator_binding(m);
   // scalar_binding(m);
-  // storage_binding(m);
+  storage_binding(m);
+  dlpack_binding(m);
+  io_binding(m);
+  sparse_binding(m);
   // tensor_binding(m);
   // network_binding(m);
-  // linop_binding(m);
+  linop_binding(m);
   // unitensor_binding(m);
-  // linalg_binding(m);
+  linalg_binding(m);
   // algo_binding(m);
   // physics_related_binding(m);
-  // random_binding(m);
+  random_binding(m);
   // tnalgo_binding(m);
   // ncon_binding(m);
 }
@@ -0,0 +1,56 @@
+#include <optional>
+#include <random>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+namespace py = pybind11;
+using namespace cytnx_core;
+
+// a seed of None draws a fresh one at each call, not once when the module is loaded
+static cytnx_uint64 seed_or_device(const std::optional<cytnx_uint64> &seed) {
+  return seed ? *seed : cytnx_uint64(std::random_device()());
+}
+
+void random_binding(py::module &m) {
+  auto mrand = m.def_submodule("random");
+
+  mrand.def(
+    "uniform_",
+    [](Storage &s, const double &low, const double &high,
+       const std::optional<cytnx_uint64> &seed, const cytnx_uint64 &offset) {
+      random::uniform_(s, low, high, seed_or_device(seed), offset);
+    },
+    py::arg("s"), py::arg("low") = 0.0, py::arg("high") = 1.0, py::arg("seed") = py::none(),
+    py::arg("offset") = 0, py::call_guard<py::gil_scoped_release>());
+  mrand.def(
+    "normal_",
+    [](Storage &s, const double &mean, const double &std,
+       const std::optional<cytnx_uint64> &seed, const cytnx_uint64 &offset) {
+      random::normal_(s, mean, std, seed_or_device(seed), offset);
+    },
+    py::arg("s"), py::arg("mean") = 0.0, py::arg("std") = 1.0, py::arg("seed") = py::none(),
+    py::arg("offset") = 0, py::call_guard<py::gil_scoped_release>());
+  mrand.def(
+    "uniform",
+    [](const cytnx_uint64 &size, const double &low, const double &high,
+       const Type_class::Type &dtype, const std::optional<cytnx_uint64> &seed,
+       const cytnx_uint64 &offset) {
+      return random::uniform(size, low, high, dtype, seed_or_device(seed), offset);
+    },
+    py::arg("size"), py::arg("low") = 0.0, py::arg("high") = 1.0,
+    py::arg("dtype") = Type_class::Double, py::arg("seed") = py::none(), py::arg("offset") = 0,
+    py::call_guard<py::gil_scoped_release>());
+  mrand.def(
+    "normal",
+    [](const cytnx_uint64 &size, const double &mean, const double &std,
+       const Type_class::Type &dtype, const std::optional<cytnx_uint64> &seed,
+       const cytnx_uint64 &offset) {
+      return random::normal(size, mean, std, dtype, seed_or_device(seed), offset);
+    },
+    py::arg("size"), py::arg("mean") = 0.0, py::arg("std") = 1.0,
+    py::arg("dtype") = Type_class::Double, py::arg("seed") = py::none(), py::arg("offset") = 0,
+    py::call_guard<py::gil_scoped_release>());
+}
@@ -0,0 +1,67 @@
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+namespace py = pybind11;
+using namespace cytnx_core;
+
+void sparse_binding(py::module &m) {
+  py::enum_<SparseSymmetry>(m, "SparseSymmetry")
+    .value("General", SparseSymmetry::General)
+    .value("Symmetric", SparseSymmetry::Symmetric)
+    .value("Hermitian", SparseSymmetry::Hermitian);
+
+  py::class_<CooMatrix>(m, "CooMatrix")
+    .def(py::init<>())
+    .def(py::init<const cytnx_uint64 &, const cytnx_uint64 &, const std::vector<cytnx_uint64> &,
+                  const std::vector<cytnx_uint64> &, const Storage &>(),
+         py::arg("nrows"), py::arg("ncols"), py::arg("rows"), py::arg("cols"), py::arg("values"))
+    .def_property_readonly("nrows", &CooMatrix::nrows)
+    .def_property_readonly("ncols", &CooMatrix::ncols)
+    .def("nnz", &CooMatrix::nnz)
+    .def_property_readonly(
+      "dtype", [](const CooMatrix &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def_property_readonly("rows", &CooMatrix::rows)
+    .def_property_readonly("cols", &CooMatrix::cols)
+    .def_property_readonly("values", &CooMatrix::values)
+    .def("to_csr", &CooMatrix::to_csr, py::arg("symmetry") = SparseSymmetry::General,
+         py::call_guard<py::gil_scoped_release>())
+    .def("__repr__", [](const CooMatrix &self) {
+      return "<CooMatrix " + std::to_string(self.nrows()) + "x" + std::to_string(self.ncols()) +
+             " nnz=" + std::to_string(self.nnz()) + " " + Type.enum_name(self.dtype()) + ">";
+    });
+
+  py::class_<CsrMatrix>(m, "CsrMatrix")
+    .def(py::init<>())
+    .def(py::init<const cytnx_uint64 &, const cytnx_uint64 &, const std::vector<cytnx_uint64> &,
+                  const std::vector<cytnx_uint64> &, const Storage &, const SparseSymmetry &>(),
+         py::arg("nrows"), py::arg("ncols"), py::arg("indptr"), py::arg("indices"),
+         py::arg("values"), py::arg("symmetry") = SparseSymmetry::General)
+    .def_property_readonly("nrows", &CsrMatrix::nrows)
+    .def_property_readonly("ncols", &CsrMatrix::ncols)
+    .def("nnz", &CsrMatrix::nnz)
+    .def_property_readonly(
+      "dtype", [](const CsrMatrix &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def_property_readonly("symmetry", &CsrMatrix::symmetry)
+    .def_property_readonly("indptr", &CsrMatrix::indptr)
+    .def_property_readonly("indices", &CsrMatrix::indices)
+    .def_property_readonly("values", &CsrMatrix::values)
+    .def("row_blocks", &CsrMatrix::row_blocks)
+    .def("matvec", py::overload_cast<const Storage &>(&CsrMatrix::matvec, py::const_),
+         py::arg("x"), py::call_guard<py::gil_scoped_release>())
+    .def("matvec", py::overload_cast<const Storage &, Storage &>(&CsrMatrix::matvec, py::const_),
+         py::arg("x"), py::arg("y"), py::call_guard<py::gil_scoped_release>())
+    .def("matmat", py::overload_cast<const StorageView &>(&CsrMatrix::matmat, py::const_),
+         py::arg("x"), py::call_guard<py::gil_scoped_release>())
+    .def("matmat",
+         py::overload_cast<const StorageView &, StorageView &>(&CsrMatrix::matmat, py::const_),
+         py::arg("x"), py::arg("y"), py::call_guard<py::gil_scoped_release>())
+    .def("to_dense", &CsrMatrix::to_dense, py::call_guard<py::gil_scoped_release>())
+    .def("__repr__", [](const CsrMatrix &self) {
+      return "<CsrMatrix " + std::to_string(self.nrows()) + "x" + std::to_string(self.ncols()) +
+             " nnz=" + std::to_string(self.nnz()) + " " + Type.enum_name(self.dtype()) + ">";
+    });
+}
@@ -0,0 +1,292 @@
+#include <functional>
+#include <vector>
+
+#include <pybind11/buffer_info.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cytnx_core/cytnx_core.hpp>
+
+#include "async_py.hpp"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace cytnx_core;
+
+// The buffer format of each dtype, empty for Void, BFloat16 and the complex 16-bit types, which
+// numpy has no dtype for.
+static std::string buffer_format(const unsigned int &dtype) {
+  return dispatch_type(dtype, [&](auto tag) -> std::string {
+    using T = typename decltype(tag)::type;
+    if constexpr (std::is_same_v<T, cytnx_float16>) {
+      return "e";
+    } else if constexpr (std::is_same_v<T, void> ||
+                         Type_class::is_half(Type_class::cy_typeid_v<T>)) {
+      return std::string();
+    } else {
+      return py::format_descriptor<T>::format();
+    }
+  });
+}
+
+// The dtype matching a numpy dtype, compared by kind and itemsize so that equivalent format
+// strings (e.g. 'l' and 'q' for int64) map to the same type.
+static unsigned int dtype_from_numpy(const py::dtype &dt) {
+  for (unsigned int t = 0; t < N_Type; t++) {
+    const std::string format = buffer_format(t);
+    if (format.empty()) continue;
+    py::dtype candidate(format);
+    if (candidate.kind() == dt.kind() && candidate.itemsize() == dt.itemsize()) return t;
+  }
+  cytnx_input_error_msg(true, "[ERROR] numpy dtype %s has no matching cytnx Type.",
+                        py::str(dt).cast<std::string>().c_str());
+  return Type.Void;
+}
+
+// Wrap a writable, C-contiguous buffer without a copy. The Py_buffer view is held until the
+// last Storage referring to the memory is gone, which keeps the exporting object alive.
+static Storage storage_from_buffer(const py::buffer &buf) {
+  auto *info = new py::buffer_info(buf.request(true));
+  py::ssize_t expect = info->itemsize;
+  for (py::ssize_t i = info->ndim - 1; i >= 0; i--) {
+    if (info->shape[i] > 1 && info->strides[i] != expect) {
+      delete info;
+      cytnx_input_error_msg(true,
+                            "[ERROR] only C-contiguous buffers can be wrapped without a copy, %s",
+                            "use numpy.ascontiguousarray() first.");
+    }
+    expect *= info->shape[i];
+  }
+  unsigned int dtype;
+  try {
+    dtype = dtype_from_numpy(py::dtype(*info));
+  } catch (...) {
+    delete info;
+    throw;
+  }
+  std::shared_ptr<void> owner(info->ptr, [info](void *) {
+    py::gil_scoped_acquire gil;
+    delete info;
+  });
+  return Storage::from_external(info->ptr, info->size, dtype, Device.cpu, std::move(owner));
+}
+
+static py::buffer_info storage_buffer_info(Storage &self) {
+  cytnx_input_error_msg(self.device() != Device.cpu,
+                        "[ERROR] only CPU Storages expose the buffer protocol, got %s.",
+                        self.device_str().c_str());
+  const std::string format = buffer_format(self.dtype());
+  cytnx_input_error_msg(format.empty(),
+                        "[ERROR] a Storage of type %s has no buffer representation, use astype().",
+                        Type.enum_name(self.dtype()));
+  const py::ssize_t itemsize = Type.typeSize(self.dtype());
+  return py::buffer_info(self.data(), itemsize, format, 1,
+                         {static_cast<py::ssize_t>(self.size())}, {itemsize});
+}
+
+// Unpack the fill value while the GIL is held; the returned kernel runs without it.
+static std::function<void()> fill_kernel(Storage &self, const py::object &val) {
+  if (py::isinstance<py::bool_>(val))
+    return [self, v = val.cast<cytnx_bool>()]() mutable { self.fill(v); };
+  if (py::isinstance<py::int_>(val))
+    return [self, v = val.cast<cytnx_int64>()]() mutable { self.fill(v); };
+  if (py::isinstance<py::float_>(val))
+    return [self, v = val.cast<cytnx_double>()]() mutable { self.fill(v); };
+  return [self, v = val.cast<cytnx_complex128>()]() mutable { self.fill(v); };
+}
+
+void storage_binding(py::module &m) {
+  py::class_<Storage>(m, "Storage", py::buffer_protocol())
+    .def(py::init<>())
+    .def(py::init([](const cytnx_uint64 &size, const Type_class::Type &dtype, const int &device,
+                     const bool &init_zero) { return Storage(size, dtype, device, init_zero); }),
+         py::arg("size"), py::arg("dtype") = Type_class::Double,
+         py::arg("device") = (int)Device.cpu, py::arg("init_zero") = true)
+    .def(py::init(&storage_from_buffer), py::arg("buffer"),
+         "Wrap a writable, C-contiguous buffer (e.g. a numpy array) without a copy.")
+    .def_static("from_numpy", &storage_from_buffer, py::arg("array"),
+                "Wrap a writable, C-contiguous numpy array without a copy.")
+    .def_buffer(&storage_buffer_info)
+    .def(
+      "numpy",
+      [](py::object self) {
+        // a view sharing the memory; the array keeps this Storage alive through its base
+        return py::array(storage_buffer_info(self.cast<Storage &>()), self);
+      },
+      "A numpy view of the elements, sharing the memory.")
+    .def("size", &Storage::size)
+    .def("__len__", &Storage::size)
+    .def("nbytes", &Storage::nbytes)
+    .def_property_readonly(
+      "dtype", [](const Storage &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def("dtype_str", &Storage::dtype_str)
+    .def("device", &Storage::device)
+    .def("device_str", &Storage::device_str)
+    .def("same_data", &Storage::same_data, py::arg("rhs"))
+    .def("use_count", &Storage::use_count)
+    .def("clone", &Storage::clone, py::call_guard<py::gil_scoped_release>())
+    .def(
+      "astype",
+      [](const Storage &self, const Type_class::Type &dtype) { return self.astype(dtype); },
+      py::arg("dtype"), py::call_guard<py::gil_scoped_release>(),
+      "A copy converted to dtype; complex to real conversions are rejected.")
+    .def(
+      "clone_async",
+      [](const Storage &self) { return submit_async([self]() { return self.clone(); }); },
+      "Deep copy on the native thread pool, returns a concurrent.futures.Future.")
+    .def(
+      "fill",
+      [](Storage &self, const py::object &val) {
+        auto kernel = fill_kernel(self, val);
+        py::gil_scoped_release release;
+        kernel();
+      },
+      py::arg("val"))
+    .def(
+      "fill_async",
+      [](Storage &self, const py::object &val) { return submit_async(fill_kernel(self, val)); },
+      py::arg("val"), "fill() on the native thread pool, returns a concurrent.futures.Future.")
+    .def("__repr__", [](const Storage &self) {
+      return "<Storage dtype=" + std::string(Type.enum_name(self.dtype())) +
+             " size=" + std::to_string(self.size()) + " device=" + self.device_str() + ">";
+    });
+
+  py::class_<StorageView>(m, "StorageView")
+    .def(py::init<>())
+    .def(py::init<const Storage &>(), py::arg("storage"))
+    .def(py::init<const Storage &, const std::vector<cytnx_uint64> &>(), py::arg("storage"),
+         py::arg("shape"))
+    .def(py::init<const Storage &, const cytnx_uint64 &, const std::vector<cytnx_uint64> &,
+                  const std::vector<cytnx_uint64> &>(),
+         py::arg("storage"), py::arg("offset"), py::arg("shape"), py::arg("strides"))
+    .def("storage", &StorageView::storage)
+    .def_property_readonly("offset", &StorageView::offset)
+    .def_property_readonly("shape", &StorageView::shape)
+    .def_property_readonly("strides", &StorageView::strides)
+    .def("rank", &StorageView::rank)
+    .def("size", &StorageView::size)
+    .def_property_readonly(
+      "dtype", [](const StorageView &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def("device", &StorageView::device)
+    .def("is_contiguous", &StorageView::is_contiguous)
+    .def("is_shared", &StorageView::is_shared)
+    .def("is_conj", &StorageView::is_conj)
+    .def("conj", &StorageView::conj)
+    .def("slice", &StorageView::slice, py::arg("axis"), py::arg("start"), py::arg("stop"),
+         py::arg("step") = 1)
+    .def("permute", &StorageView::permute, py::arg("axes"))
+    .def("transpose", &StorageView::transpose, py::arg("a"), py::arg("b"))
+    .def("reshape", &StorageView::reshape, py::arg("shape"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("contiguous", &StorageView::contiguous, py::call_guard<py::gil_scoped_release>())
+    .def("to_storage", &StorageView::to_storage, py::call_guard<py::gil_scoped_release>())
+    .def(
+      "numpy",
+      [](py::object self) {
+        // a strided view of the buffer; the array keeps this view alive through its base
+        const StorageView &view = self.cast<const StorageView &>();
+        cytnx_input_error_msg(view.device() != Device.cpu,
+                              "[ERROR] only views of CPU Storages convert to numpy.%s", "\n");
+        // numpy has no lazy conjugate, so a conjugated view converts through a copy
+        if (view.is_conj()) return py::cast(view.contiguous()).attr("numpy")().cast<py::array>();
+        const std::string format = buffer_format(view.dtype());
+        cytnx_input_error_msg(format.empty(),
+                              "[ERROR] a view of type %s has no buffer representation.",
+                              Type.enum_name(view.dtype()));
+        const py::ssize_t itemsize = Type.typeSize(view.dtype());
+        std::vector<py::ssize_t> shape, strides;
+        for (cytnx_uint64 i = 0; i < view.rank(); i++) {
+          shape.push_back(view.shape()[i]);
+          strides.push_back(view.strides()[i] * itemsize);
+        }
+        py::array out(py::buffer_info(const_cast<void *>(view.data()), itemsize, format,
+                                      view.rank(), shape, strides),
+                      self);
+        // the buffer may be shared with other views, which copy-on-write would not protect
+        out.attr("flags").attr("writeable") = false;
+        return out;
+      },
+      "A read-only numpy view of the elements, sharing the memory unless the view is "
+      "conjugated.")
+    .def("__repr__",
+         [](const StorageView &self) { return "<StorageView " + self.str() + ">"; });
+
+  py::class_<SplitComplexStorage>(m, "SplitComplexStorage")
+    .def(py::init<>())
+    .def(py::init([](const cytnx_uint64 &size, const Type_class::Type &dtype) {
+           return SplitComplexStorage(size, dtype);
+         }),
+         py::arg("size"), py::arg("dtype") = Type_class::ComplexDouble)
+    .def_static("from_interleaved", &SplitComplexStorage::from_interleaved, py::arg("storage"),
+                py::call_guard<py::gil_scoped_release>(),
+                "A split copy of a ComplexDouble or ComplexFloat Storage.")
+    .def("to_interleaved", py::overload_cast<>(&SplitComplexStorage::to_interleaved, py::const_),
+         py::call_guard<py::gil_scoped_release>())
+    .def(
+      "to_interleaved",
+      [](const SplitComplexStorage &self, Storage &out) { self.to_interleaved(out); },
+      py::arg("out"), py::call_guard<py::gil_scoped_release>(),
+      "Write the elements interleaved into out, without allocating.")
+    .def("assign", &SplitComplexStorage::assign, py::arg("storage"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("size", &SplitComplexStorage::size)
+    .def("__len__", &SplitComplexStorage::size)
+    .def_property_readonly("dtype",
+                           [](const SplitComplexStorage &self) {
+                             return static_cast<Type_class::Type>(self.dtype());
+                           })
+    .def("device", &SplitComplexStorage::device)
+    .def("real", &SplitComplexStorage::real)
+    .def("imag", &SplitComplexStorage::imag)
+    .def("clone", &SplitComplexStorage::clone, py::call_guard<py::gil_scoped_release>())
+    .def("add", &SplitComplexStorage::add, py::arg("rhs"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("mul", &SplitComplexStorage::mul, py::arg("rhs"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("scale", &SplitComplexStorage::scale, py::arg("alpha"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("axpy", &SplitComplexStorage::axpy, py::arg("alpha"), py::arg("x"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("sum", &SplitComplexStorage::sum, py::call_guard<py::gil_scoped_release>())
+    .def("vdot", &SplitComplexStorage::vdot, py::arg("rhs"),
+         py::call_guard<py::gil_scoped_release>())
+    .def("norm", &SplitComplexStorage::norm, py::call_guard<py::gil_scoped_release>())
+    .def("__repr__", [](const SplitComplexStorage &self) {
+      return "<SplitComplexStorage dtype=" + std::string(Type.enum_name(self.dtype())) +
+             " size=" + std::to_string(self.size()) + ">";
+    });
+
+  py::class_<QuantizationError>(m, "QuantizationError")
+    .def_readonly("max_abs", &QuantizationError::max_abs)
+    .def_readonly("rms", &QuantizationError::rms)
+    .def_readonly("rel_rms", &QuantizationError::rel_rms)
+    .def_readonly("max_value", &QuantizationError::max_value)
+    .def("__repr__",
+         [](const QuantizationError &self) { return "<QuantizationError " + self.str() + ">"; });
+
+  py::class_<QuantizedStorage>(m, "QuantizedStorage")
+    .def(py::init<>())
+    .def_static("quantize", &QuantizedStorage::quantize, py::arg("src"), py::arg("bits") = 8,
+                py::arg("block_size") = 64, py::call_guard<py::gil_scoped_release>(),
+                "Block-scaled int8 (bits=8) or int4 (bits=4) copy of a floating point Storage.")
+    .def("dequantize", &QuantizedStorage::dequantize, py::call_guard<py::gil_scoped_release>())
+    .def("size", &QuantizedStorage::size)
+    .def("__len__", &QuantizedStorage::size)
+    .def_property_readonly(
+      "dtype",
+      [](const QuantizedStorage &self) { return static_cast<Type_class::Type>(self.dtype()); })
+    .def_property_readonly("bits", &QuantizedStorage::bits)
+    .def_property_readonly("block_size", &QuantizedStorage::block_size)
+    .def("nbytes", &QuantizedStorage::nbytes)
+    .def("compression_ratio", &QuantizedStorage::compression_ratio)
+    .def_property_readonly("error", &QuantizedStorage::error)
+    .def("values", &QuantizedStorage::values)
+    .def("scales", &QuantizedStorage::scales)
+    .def("__repr__", [](const QuantizedStorage &self) {
+      return "<QuantizedStorage dtype=" + std::string(Type.enum_name(self.dtype())) +
+             " size=" + std::to_string(self.size()) + " bits=" + std::to_string(self.bits()) +
+             " block_size=" + std::to_string(self.block_size()) + ">";
+    });
+}
@@ -0,0 +1,288 @@
+#include <cytnx_core/Autotune.hpp>
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils_internal/cpu/Blocking_cpu.hpp"
+#include "utils_internal/cpu/Complexmem_cpu.hpp"
+#include "utils_internal/cpu/Fill_cpu.hpp"
+#include "utils_internal/cpu/Permute_cpu.hpp"
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace autotune {
+
+    namespace {
+      const char *const cache_header = "# cytnx_core autotune cache v1";
+
+      // a tunable kernel: which fields of BlockingParams it owns and how to time it
+      struct Tuner {
+        const char *kernel;
+        cytnx_uint64 utils_internal::BlockingParams::*block;
+        // null for a kernel running on the threads of another, which only tunes its block size
+        int utils_internal::BlockingParams::*threads;
+        vector<cytnx_uint64> (*blocks)();  // the candidate block sizes
+        function<void(const utils_internal::BlockingParams &)> run;
+      };
+
+      // large enough to exceed the private caches of all cores, small enough to tune quickly
+      cytnx_uint64 problem_bytes() {
+        cytnx_uint64 bytes = 4 * Device.L2_size * Device.Ncores;
+        return std::min<cytnx_uint64>(std::max<cytnx_uint64>(bytes, 16 << 20), 256 << 20);
+      }
+
+      // benchmark buffers, released once tuning is done
+      vector<cytnx_double> fill_buf, convert_out, permute_in, permute_out;
+      vector<cytnx_complex128> convert_in;
+
+      void release_buffers() {
+        vector<cytnx_double>().swap(fill_buf);
+        vector<cytnx_double>().swap(convert_out);
+        vector<cytnx_double>().swap(permute_in);
+        vector<cytnx_double>().swap(permute_out);
+        vector<cytnx_complex128>().swap(convert_in);
+      }
+
+      vector<cytnx_uint64> distinct(vector<cytnx_uint64> cands) {
+        sort(cands.begin(), cands.end());
+        cands.erase(unique(cands.begin(), cands.end()), cands.end());
+        cands.erase(remove(cands.begin(), cands.end(), 0), cands.end());
+        return cands;
+      }
+
+      vector<cytnx_uint64> chunk_candidates() {
+        return distinct({Device.L1d_size, Device.L2_size / 4, Device.L2_size / 2, Device.L2_size,
+                         2 * Device.L2_size});
+      }
+
+      // a source and a destination tile
+      vector<cytnx_uint64> tile_candidates() {
+        return distinct({Device.L1d_size / 16, Device.L1d_size / 8, Device.L1d_size / 4,
+                         Device.L1d_size / 2, Device.L1d_size, Device.L2_size / 4});
+      }
+
+      const vector<Tuner> &tuners() {
+        static const vector<Tuner> list = {
+          {"fill", &utils_internal::BlockingParams::fill_chunk_bytes,
+           &utils_internal::BlockingParams::fill_threads, chunk_candidates,
+           [](const utils_internal::BlockingParams &params) {
+             fill_buf.resize(problem_bytes() / sizeof(cytnx_double));
+             utils_internal::FillCpu<cytnx_double>(fill_buf.data(), 1.0, fill_buf.size(), params);
+           }},
+          {"convert", &utils_internal::BlockingParams::convert_chunk_bytes,
+           &utils_internal::BlockingParams::convert_threads, chunk_candidates,
+           [](const utils_internal::BlockingParams &params) {
+             convert_in.resize(problem_bytes() / sizeof(cytnx_complex128));
+             convert_out.resize(convert_in.size());
+             utils_internal::Complexmem_cpu_cdtd(convert_out.data(), convert_in.data(),
+                                                 convert_in.size(), true, params);
+           }},
+          // the transpose of a square matrix, the case the tiles are for
+          {"permute", &utils_internal::BlockingParams::permute_tile_bytes, nullptr,
+           tile_candidates,
+           [](const utils_internal::BlockingParams &params) {
+             const cytnx_uint64 n =
+               (cytnx_uint64)std::sqrt(double(problem_bytes() / sizeof(cytnx_double)));
+             permute_in.resize(n * n);
+             permute_out.resize(n * n);
+             utils_internal::StridedCopy_cpu(permute_out.data(), permute_in.data(),
+                                             sizeof(cytnx_double), {n, n}, {1, n}, params);
+           }},
+        };
+        return list;
+      }
+
+      // the thread budget of this process, which can be lower than the one a cache was tuned on
+      int max_threads() {
+#ifdef UNI_OMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+      }
+
+      vector<int> thread_candidates() {
+#ifdef UNI_OMP
+        vector<int> cands = {1, std::max(1, Device.Ncores / 2), Device.Ncores, Device.Ncpus,
+                             omp_get_max_threads()};
+        sort(cands.begin(), cands.end());
+        cands.erase(unique(cands.begin(), cands.end()), cands.end());
+        return cands;
+#else
+        return {1};
+#endif
+      }
+
+      Entry tune(const Tuner &tuner) {
+        utils_internal::BlockingParams params = utils_internal::DeriveBlockingParams();
+        // the permutation kernel runs on convert_threads
+        const int derived = tuner.threads ? params.*tuner.threads : params.convert_threads;
+        Entry best = {tuner.kernel, params.*tuner.block, derived, 1e300};
+        const vector<int> threads_list = tuner.threads ? thread_candidates() : vector<int>{derived};
+        for (int threads : threads_list) {
+          for (cytnx_uint64 block : tuner.blocks()) {
+            params.*tuner.block = block;
+            if (tuner.threads) params.*tuner.threads = threads;
+            tuner.run(params);  // warmup, also pages in the buffers
+            double elapsed = 1e300;
+            for (int rep = 0; rep < 3; rep++) {
+              auto t0 = chrono::steady_clock::now();
+              tuner.run(params);
+              chrono::duration<double> dt = chrono::steady_clock::now() - t0;
+              elapsed = std::min(elapsed, dt.count());
+            }
+            if (elapsed < best.seconds) best = {tuner.kernel, block, threads, elapsed};
+          }
+        }
+        return best;
+      }
+
+      // FNV-1a, only used to name the cache file after the cpu signature
+      string signature_hash(const string &sig) {
+        cytnx_uint64 h = 1469598103934665603ULL;
+        for (unsigned char c : sig) {
+          h ^= c;
+          h *= 1099511628211ULL;
+        }
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+        return string(buf);
+      }
+
+      void make_dirs(const string &path) {
+        for (size_t pos = path.find('/', 1); pos != string::npos; pos = path.find('/', pos + 1))
+          mkdir(path.substr(0, pos).c_str(), 0755);
+      }
+
+      vector<Entry> read_cache(const string &path) {
+        vector<Entry> out;
+        ifstream fin(path);
+        string line;
+        if (!getline(fin, line) || line != cache_header) return out;
+        if (!getline(fin, line) || line != "signature " + Device.cpu_signature()) return out;
+        while (getline(fin, line)) {
+          istringstream iss(line);
+          Entry e;
+          if (iss >> e.kernel >> e.block_bytes >> e.threads >> e.seconds && e.block_bytes > 0 &&
+              e.threads > 0)
+            out.push_back(e);
+        }
+        return out;
+      }
+
+      void write_cache(const string &path, const vector<Entry> &list) {
+        make_dirs(path);
+        // write a temporary file and rename it, so concurrent processes never see a partial file
+        string tmp = path + ".tmp" + to_string(getpid());
+        {
+          ofstream fout(tmp);
+          fout << cache_header << "\n";
+          fout << "signature " << Device.cpu_signature() << "\n";
+          for (const auto &e : list)
+            fout << e.kernel << " " << e.block_bytes << " " << e.threads << " " << e.seconds
+                 << "\n";
+          if (!fout) {
+            cytnx_warning_msg(true, "[WARNING][autotune] cannot write cache file %s\n",
+                              tmp.c_str());
+            remove(tmp.c_str());
+            return;
+          }
+        }
+        if (rename(tmp.c_str(), path.c_str()) != 0) remove(tmp.c_str());
+      }
+
+      void upsert(vector<Entry> &list, const Entry &e) {
+        auto it = find_if(list.begin(), list.end(),
+                          [&](const Entry &x) { return x.kernel == e.kernel; });
+        if (it == list.end())
+          list.push_back(e);
+        else
+          *it = e;
+      }
+
+      // tune the kernels missing from the cache (all of them if force) and persist the result
+      vector<Entry> tune_and_store(bool force) {
+        static mutex mtx;
+        lock_guard<mutex> lock(mtx);
+        string path = cache_path();
+        vector<Entry> list = read_cache(path);
+        bool changed = false;
+        for (const auto &tuner : tuners()) {
+          bool cached = any_of(list.begin(), list.end(),
+                               [&](const Entry &x) { return x.kernel == tuner.kernel; });
+          if (cached && !force) continue;
+          upsert(list, tune(tuner));
+          changed = true;
+        }
+        release_buffers();
+        if (changed) write_cache(path, list);
+        return list;
+      }
+    }  // namespace
+
+    string cache_path() {
+      if (const char *env = getenv("CYTNX_AUTOTUNE_CACHE")) {
+        if (env[0] != '\0') return string(env);
+      }
+      string dir;
+      if (const char *xdg = getenv("XDG_CACHE_HOME"); xdg && xdg[0] != '\0')
+        dir = string(xdg) + "/cytnx_core";
+      else if (const char *home = getenv("HOME"); home && home[0] != '\0')
+        dir = string(home) + "/.cache/cytnx_core";
+      else
+        dir = "/tmp/cytnx_core";
+      return dir + "/autotune-" + signature_hash(Device.cpu_signature()) + ".txt";
+    }
+
+    bool enabled() {
+      const char *env = getenv("CYTNX_AUTOTUNE");
+      if (env == nullptr) return false;
+      string val(env);
+      return val == "1" || val == "on" || val == "ON" || val == "true";
+    }
+
+    vector<Entry> entries() { return read_cache(cache_path()); }
+
+    vector<Entry> tuned_entries() {
+      vector<Entry> list = enabled() ? tune_and_store(false) : entries();
+      // a cached thread count is a winner among the candidates of the tuning run; never apply
+      // more than OMP_NUM_THREADS (or the affinity mask) now allows
+      for (auto &e : list) e.threads = std::min(e.threads, max_threads());
+      return list;
+    }
+
+    vector<Entry> prewarm(bool force) { return tune_and_store(force); }
+
+    void clear_cache() { remove(cache_path().c_str()); }
+
+  }  // namespace autotune
+
+  namespace utils_internal {
+    BlockingParams AutotuneBlockingParams(BlockingParams params) {
+      for (const auto &e : autotune::tuned_entries()) {
+        for (const auto &tuner : autotune::tuners()) {
+          if (e.kernel != tuner.kernel) continue;
+          params.*tuner.block = e.block_bytes;
+          if (tuner.threads) params.*tuner.threads = e.threads;
+        }
+      }
+      return params;
+    }
+  }  // namespace utils_internal
+
+}  // namespace cytnx_core
@@ -0,0 +1,171 @@
+#include <cytnx_core/Counters.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include <cytnx_core/Type.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace counters {
+
+    std::atomic<bool> _enabled(false);
+
+    namespace {
+      const char *const routine_names[N_Routine] = {"gemm",  "gemv",  "axpy",  "dot",
+                                                    "nrm2",  "scal",  "asum",  "copy",
+                                                    "gesvd", "geqrf", "getrf", "getri",
+                                                    "syevd", "syevr"};
+
+      // written by the owning thread only; atomics so that a concurrent report is well defined
+      struct Slot {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> ns{0};
+        std::atomic<double> flops{0};
+        std::atomic<double> bytes{0};
+      };
+
+      struct Totals {
+        std::uint64_t calls = 0, ns = 0;
+        double flops = 0, bytes = 0;
+      };
+
+      struct ThreadCounters {
+        Slot slots[N_Routine][N_Type];
+        Totals base[N_Routine][N_Type];  // the values at the last reset, guarded by the registry
+      };
+
+      // counters outlive their threads, so the work of finished (e.g. OpenMP) threads is kept
+      struct Registry {
+        mutex mtx;
+        vector<unique_ptr<ThreadCounters>> threads;
+      };
+
+      Registry &registry() {
+        // never destroyed: threads may still count during static destruction
+        static Registry *r = new Registry;
+        return *r;
+      }
+
+      ThreadCounters &local_counters() {
+        static thread_local ThreadCounters *counters = nullptr;
+        if (counters == nullptr) {
+          Registry &r = registry();
+          lock_guard<mutex> lock(r.mtx);
+          r.threads.emplace_back(new ThreadCounters);
+          counters = r.threads.back().get();
+        }
+        return *counters;
+      }
+
+      template <class T>
+      void add(std::atomic<T> &a, const T &v) {
+        // only the owning thread writes, so a load and a store do not lose updates
+        a.store(a.load(memory_order_relaxed) + v, memory_order_relaxed);
+      }
+
+      Totals read(const Slot &s) {
+        Totals t;
+        t.calls = s.calls.load(memory_order_relaxed);
+        t.ns = s.ns.load(memory_order_relaxed);
+        t.flops = s.flops.load(memory_order_relaxed);
+        t.bytes = s.bytes.load(memory_order_relaxed);
+        return t;
+      }
+    }  // namespace
+
+    const char *routine_name(const unsigned int &routine) {
+      cytnx_error_msg(routine >= N_Routine, "[ERROR][counters] invalid routine: %u\n", routine);
+      return routine_names[routine];
+    }
+
+    void enable(const bool &on) { _enabled.store(on, memory_order_relaxed); }
+    void disable() { enable(false); }
+    bool enabled() { return _enabled.load(memory_order_relaxed); }
+
+    void record(const unsigned int &routine, const unsigned int &dtype, const double &flops,
+                const double &bytes, const std::uint64_t &ns) {
+      Slot &s = local_counters().slots[routine][dtype];
+      add<std::uint64_t>(s.calls, 1);
+      add(s.ns, ns);
+      add(s.flops, flops);
+      add(s.bytes, bytes);
+    }
+
+    void reset() {
+      Registry &r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      for (auto &t : r.threads)
+        for (unsigned int i = 0; i < N_Routine; i++)
+          for (unsigned int j = 0; j < N_Type; j++) t->base[i][j] = read(t->slots[i][j]);
+    }
+
+    vector<Entry> entries() {
+      Totals sum[N_Routine][N_Type];
+      {
+        Registry &r = registry();
+        lock_guard<mutex> lock(r.mtx);
+        for (auto &t : r.threads)
+          for (unsigned int i = 0; i < N_Routine; i++)
+            for (unsigned int j = 0; j < N_Type; j++) {
+              const Totals now = read(t->slots[i][j]), &base = t->base[i][j];
+              sum[i][j].calls += now.calls - base.calls;
+              sum[i][j].ns += now.ns - base.ns;
+              sum[i][j].flops += now.flops - base.flops;
+              sum[i][j].bytes += now.bytes - base.bytes;
+            }
+      }
+      vector<Entry> out;
+      for (unsigned int i = 0; i < N_Routine; i++)
+        for (unsigned int j = 0; j < N_Type; j++) {
+          const Totals &t = sum[i][j];
+          if (t.calls == 0) continue;
+          out.push_back(Entry{i, j, t.calls, t.flops, t.bytes, t.ns * 1e-9});
+        }
+      return out;
+    }
+
+    string report(const double &peak_gflops, const double &peak_gbs) {
+      const bool roof = peak_gflops > 0 && peak_gbs > 0;
+      string out;
+      char buf[256];
+      snprintf(buf, sizeof(buf), "%-6s %-14s %10s %12s %12s %10s %10s %9s %8s", "op", "dtype",
+               "calls", "GFLOP", "GB", "time[s]", "GFLOP/s", "GB/s", "flop/B");
+      out += buf;
+      out += roof ? "  bound    %roof\n" : "\n";
+
+      Entry total{N_Routine, Type_class::Void, 0, 0, 0, 0};
+      auto row = [&](const Entry &e, const char *op, const char *dtype) {
+        const double gflops = e.seconds > 0 ? e.flops * 1e-9 / e.seconds : 0;
+        const double gbs = e.seconds > 0 ? e.bytes * 1e-9 / e.seconds : 0;
+        const double intensity = e.bytes > 0 ? e.flops / e.bytes : 0;
+        snprintf(buf, sizeof(buf), "%-6s %-14s %10llu %12.4f %12.4f %10.4f %10.2f %9.2f %8.2f",
+                 op, dtype, (unsigned long long)e.calls, e.flops * 1e-9, e.bytes * 1e-9,
+                 e.seconds, gflops, gbs, intensity);
+        out += buf;
+        if (roof) {
+          // the attainable rate at this intensity is min(peak compute, intensity * bandwidth)
+          const double attainable = std::min(peak_gflops, intensity * peak_gbs);
+          const bool compute = intensity * peak_gbs >= peak_gflops;
+          snprintf(buf, sizeof(buf), "  %-7s %7.1f", compute ? "compute" : "memory",
+                   attainable > 0 ? 100 * gflops / attainable : 0.0);
+          out += buf;
+        }
+        out += '\n';
+      };
+      for (const auto &e : entries()) {
+        row(e, routine_names[e.routine], Type_class::enum_name(e.dtype));
+        total.calls += e.calls;
+        total.flops += e.flops;
+        total.bytes += e.bytes;
+        total.seconds += e.seconds;
+      }
+      row(total, "total", "");
+      return out;
+    }
+
+  }  // namespace counters
+}  // namespace cytnx_core
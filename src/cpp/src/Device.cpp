@@ -1,6 +1,21 @@
 #include <cytnx_core/Device.hpp>
 #include <cytnx_core/errors/cytnx_error.hpp>
+#include <algorithm>
+#include <fstream>
+#include <set>
 #include <thread>
+#include <unistd.h>
+
+#ifdef __linux__
+  #include <dirent.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+  #include <cpuid.h>
+#endif
+#if defined(__aarch64__) && defined(__linux__)
+  #include <sys/auxv.h>
+  #include <asm/hwcap.h>
+#endif
 
 #ifdef UNI_OMP
   #include <omp.h>
@@ -9,8 +24,175 @@
 using namespace std;
 namespace cytnx_core {
 
+  namespace {
+    bool read_first_line(const string &path, string &out) {
+      ifstream fin(path);
+      if (!fin) return false;
+      getline(fin, out);
+      return !out.empty();
+    }
+
+    // parse sysfs cache sizes like "48K", "2048K" or "32M"
+    cytnx_uint64 parse_size(const string &str) {
+      cytnx_uint64 val = strtoull(str.c_str(), nullptr, 10);
+      if (str.find('K') != string::npos) return val << 10;
+      if (str.find('M') != string::npos) return val << 20;
+      if (str.find('G') != string::npos) return val << 30;
+      return val;
+    }
+
+    // collect the numeric suffixes of entries named <prefix><N> in a directory
+    vector<int> list_indexed_entries(const string &dir, const string &prefix) {
+      vector<int> ids;
+#ifdef __linux__
+      DIR *dp = opendir(dir.c_str());
+      if (dp == nullptr) return ids;
+      while (struct dirent *ent = readdir(dp)) {
+        string name(ent->d_name);
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+        string num = name.substr(prefix.size());
+        if (!all_of(num.begin(), num.end(), ::isdigit)) continue;
+        ids.push_back(stoi(num));
+      }
+      closedir(dp);
+      sort(ids.begin(), ids.end());
+#endif
+      return ids;
+    }
+
+    void detect_topology(Device_class &dev) {
+      set<int> packages;
+      set<pair<int, int>> cores;
+      for (int cpu : list_indexed_entries("/sys/devices/system/cpu", "cpu")) {
+        string base = "/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/";
+        string pkg, core;
+        if (!read_first_line(base + "physical_package_id", pkg)) continue;
+        if (!read_first_line(base + "core_id", core)) continue;
+        packages.insert(stoi(pkg));
+        cores.insert({stoi(pkg), stoi(core)});
+      }
+      dev.Nsockets = packages.empty() ? 1 : packages.size();
+      dev.Ncores = cores.empty() ? dev.Ncpus : cores.size();
+      dev.Nsmt = max(1, dev.Ncpus / max(1, dev.Ncores));
+      dev.Nnuma = max<int>(1, list_indexed_entries("/sys/devices/system/node", "node").size());
+    }
+
+    void detect_caches(Device_class &dev) {
+      dev.L1d_size = dev.L2_size = dev.L3_size = dev.Cacheline_size = 0;
+      for (int idx : list_indexed_entries("/sys/devices/system/cpu/cpu0/cache", "index")) {
+        string base = "/sys/devices/system/cpu/cpu0/cache/index" + to_string(idx) + "/";
+        string level, type, size, line;
+        if (!read_first_line(base + "level", level) || !read_first_line(base + "type", type) ||
+            !read_first_line(base + "size", size))
+          continue;
+        if (type == "Instruction") continue;
+        cytnx_uint64 bytes = parse_size(size);
+        if (level == "1") dev.L1d_size = bytes;
+        if (level == "2") dev.L2_size = bytes;
+        if (level == "3") dev.L3_size = bytes;
+        if (read_first_line(base + "coherency_line_size", line))
+          dev.Cacheline_size = max<cytnx_uint64>(dev.Cacheline_size, stoull(line));
+      }
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+      // glibc fallback when sysfs is not mounted (e.g. some containers)
+      if (dev.L1d_size == 0) dev.L1d_size = max<long>(0, sysconf(_SC_LEVEL1_DCACHE_SIZE));
+      if (dev.L2_size == 0) dev.L2_size = max<long>(0, sysconf(_SC_LEVEL2_CACHE_SIZE));
+      if (dev.L3_size == 0) dev.L3_size = max<long>(0, sysconf(_SC_LEVEL3_CACHE_SIZE));
+      if (dev.Cacheline_size == 0)
+        dev.Cacheline_size = max<long>(0, sysconf(_SC_LEVEL1_DCACHE_LINESIZE));
+#endif
+      // conservative defaults when nothing could be detected
+      if (dev.L1d_size == 0) dev.L1d_size = 32 << 10;
+      if (dev.L2_size == 0) dev.L2_size = 512 << 10;
+      if (dev.L3_size == 0) dev.L3_size = 8 << 20;
+      if (dev.Cacheline_size == 0) dev.Cacheline_size = 64;
+    }
+
+    void detect_simd(Device_class &dev) {
+#if defined(__x86_64__) || defined(__i386__)
+      unsigned int eax, ebx, ecx, edx;
+      if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return;
+      const unsigned int max_leaf = eax;
+
+      __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+      const unsigned int ecx1 = ecx, edx1 = edx;
+      // the OS must save the extended register state before AVX/AVX-512 can be used
+      unsigned int xcr0 = 0;
+      if (ecx1 & (1u << 27)) {
+        unsigned int xedx;
+        __asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xedx) : "c"(0));
+      }
+      const bool os_avx = (xcr0 & 0x6) == 0x6;
+      const bool os_avx512 = os_avx && (xcr0 & 0xe0) == 0xe0;
+
+      if (edx1 & (1u << 26)) dev.Simd.push_back("sse2");
+      if (ecx1 & (1u << 0)) dev.Simd.push_back("sse3");
+      if (ecx1 & (1u << 9)) dev.Simd.push_back("ssse3");
+      if (ecx1 & (1u << 19)) dev.Simd.push_back("sse4_1");
+      if (ecx1 & (1u << 20)) dev.Simd.push_back("sse4_2");
+      if (os_avx && (ecx1 & (1u << 28))) dev.Simd.push_back("avx");
+      if (os_avx && (ecx1 & (1u << 12))) dev.Simd.push_back("fma");
+      if (os_avx && (ecx1 & (1u << 29))) dev.Simd.push_back("f16c");
+
+      if (max_leaf >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        const unsigned int ebx7 = ebx, ecx7 = ecx, edx7 = edx;
+        if (os_avx && (ebx7 & (1u << 5))) dev.Simd.push_back("avx2");
+        if (os_avx512) {
+          if (ebx7 & (1u << 16)) dev.Simd.push_back("avx512f");
+          if (ebx7 & (1u << 17)) dev.Simd.push_back("avx512dq");
+          if (ebx7 & (1u << 28)) dev.Simd.push_back("avx512cd");
+          if (ebx7 & (1u << 30)) dev.Simd.push_back("avx512bw");
+          if (ebx7 & (1u << 31)) dev.Simd.push_back("avx512vl");
+          if (ecx7 & (1u << 11)) dev.Simd.push_back("avx512_vnni");
+          if (edx7 & (1u << 23)) dev.Simd.push_back("avx512_fp16");
+          __cpuid_count(7, 1, eax, ebx, ecx, edx);
+          if (eax & (1u << 5)) dev.Simd.push_back("avx512_bf16");
+        }
+      }
+#elif defined(__aarch64__) && defined(__linux__)
+      unsigned long hwcap = getauxval(AT_HWCAP);
+      if (hwcap & HWCAP_ASIMD) dev.Simd.push_back("neon");
+  #ifdef HWCAP_SVE
+      if (hwcap & HWCAP_SVE) dev.Simd.push_back("sve");
+  #endif
+#endif
+    }
+
+    string detect_model() {
+#if defined(__x86_64__) || defined(__i386__)
+      unsigned int regs[12];
+      if (__get_cpuid(0x80000000, &regs[0], &regs[1], &regs[2], &regs[3]) &&
+          regs[0] >= 0x80000004) {
+        for (unsigned int i = 0; i < 3; i++)
+          __get_cpuid(0x80000002 + i, &regs[4 * i], &regs[4 * i + 1], &regs[4 * i + 2],
+                      &regs[4 * i + 3]);
+        string brand(reinterpret_cast<char *>(regs), sizeof(regs));
+        brand = brand.substr(0, brand.find('\0'));
+        brand.erase(0, brand.find_first_not_of(' '));
+        if (!brand.empty()) return brand;
+      }
+#endif
+      ifstream fin("/proc/cpuinfo");
+      string line;
+      while (getline(fin, line)) {
+        if (line.compare(0, 10, "model name") == 0 || line.compare(0, 8, "Hardware") == 0) {
+          auto pos = line.find(':');
+          if (pos != string::npos) return line.substr(line.find_first_not_of(' ', pos + 1));
+        }
+      }
+      return string("unknown");
+    }
+  }  // namespace
+
   Device_class::Device_class() : Ngpus(0), Ncpus(std::thread::hardware_concurrency()) {
     // cout << "init_device class!" << endl;
+    if (Ncpus <= 0) Ncpus = 1;
+    Cpu_model = detect_model();
+    detect_topology(*this);
+    detect_caches(*this);
+    detect_simd(*this);
+
 #ifdef UNI_GPU
 
     // get all available gpus
@@ -63,8 +245,34 @@ namespace cytnx_core {
       return string("");
     }
   }
+  bool Device_class::has_simd(const std::string &ext) const {
+    return std::find(Simd.begin(), Simd.end(), ext) != Simd.end();
+  }
+
+  std::string Device_class::cpu_signature() const {
+    string sig = Cpu_model + ";sockets=" + to_string(Nsockets) + ";cores=" + to_string(Ncores) +
+                 ";smt=" + to_string(Nsmt) + ";l1d=" + to_string(L1d_size) +
+                 ";l2=" + to_string(L2_size) + ";l3=" + to_string(L3_size) + ";simd=";
+    for (size_t i = 0; i < Simd.size(); i++) sig += (i ? "," : "") + Simd[i];
+    return sig;
+  }
+
   void Device_class::print_property() {
     char *buffer = (char *)malloc(sizeof(char) * 256);
+    cout << "=== CPU ===" << endl;
+    cout << ": Model          : " << Cpu_model << endl;
+    sprintf(buffer, ": Sockets        : %d\n: NUMA nodes     : %d\n", Nsockets, Nnuma);
+    cout << string(buffer);
+    sprintf(buffer, ": Physical cores : %d (x%d SMT, %d logical)\n", Ncores, Nsmt, Ncpus);
+    cout << string(buffer);
+    sprintf(buffer, ": Cache L1d/L2/L3: %llu KiB / %llu KiB / %llu KiB (line %llu B)\n",
+            (unsigned long long)(L1d_size >> 10), (unsigned long long)(L2_size >> 10),
+            (unsigned long long)(L3_size >> 10), (unsigned long long)Cacheline_size);
+    cout << string(buffer);
+    cout << ": SIMD           :";
+    for (const auto &ext : Simd) cout << " " << ext;
+    cout << endl;
+    cout << "--------------------" << endl;
 #ifdef UNI_GPU
     cout << "=== CUDA support ===" << endl;
     cout << ": Peer PCIE Access:" << endl;
@@ -0,0 +1,202 @@
+#include <cytnx_core/KrylovExpmv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+
+#include "utils_internal/cpu/Expm_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    typedef cytnx_complex128 C;
+
+    // the step-size controls of Expokit: the safety factor, the slack on the error, the retries
+    constexpr double kGamma = 0.9, kDelta = 1.2;
+    constexpr int kMaxReject = 10;
+    // a residual below this fraction of its column of A V is rounding error: the space is
+    // invariant (Expokit's btol); fixed, as a loose tol must not end the Arnoldi process early
+    constexpr double kBreakdownTol = 128 * std::numeric_limits<double>::epsilon();
+
+    // x rounded up to two significant digits, so that the step sizes stay short decimals
+    double round_step(const double &x) {
+      const double s = std::pow(10.0, std::floor(std::log10(x)) - 1);
+      return std::ceil(x / s) * s;
+    }
+  }  // namespace
+
+  KrylovExpmv::KrylovExpmv(const LinOp &op, const cytnx_uint64 &krylov_dim, const double &tol)
+      : _op(&op),
+        _n(op.nx()),
+        _m(std::min(krylov_dim, op.nx())),
+        _tol(tol),
+        _work(new utils_internal::ExpmWork()) {
+    cytnx_error_msg(op.dtype() != Type.Double && op.dtype() != Type.ComplexDouble,
+                    "[ERROR] KrylovExpmv of a LinOp of %s, expect Double or ComplexDouble.\n",
+                    Type.enum_name(op.dtype()));
+    cytnx_error_msg(krylov_dim == 0, "[ERROR] KrylovExpmv with a Krylov space of dimension %s",
+                    "0.\n");
+    cytnx_error_msg(!(tol > 0), "[ERROR] KrylovExpmv with tol %g, expect > 0.\n", tol);
+    const cytnx_uint64 mh = _m + 2;
+    _basis.resize(mh * _n);
+    _h.resize(mh * mh);
+    _f.resize(mh * mh);
+    _g.resize(mh);
+    if (op.dtype() == Type.ComplexDouble) {
+      _x = Storage(_n, Type.ComplexDouble, Device.cpu, false);
+      _y = Storage(_n, Type.ComplexDouble, Device.cpu, false);
+    } else {
+      // a complex vector of n is a row-major n x 2 real block of its real and imaginary parts
+      _xv = StorageView(Storage(2 * _n, Type.Double, Device.cpu, false), {_n, 2});
+      _yv = StorageView(Storage(2 * _n, Type.Double, Device.cpu, false), {_n, 2});
+    }
+  }
+
+  KrylovExpmv::~KrylovExpmv() = default;
+
+  void KrylovExpmv::apply_op(const C *in, C *out) {
+    _stats.matvecs++;
+    if (_op->dtype() == Type.ComplexDouble) {
+      memcpy(_x.data(), in, _n * sizeof(C));
+      _op->matvec(_x, _y);
+      memcpy(out, _y.data(), _n * sizeof(C));
+    } else {
+      memcpy(_xv.mutable_data(), in, _n * sizeof(C));
+      _op->matmat(_xv, _yv);
+      memcpy(out, _yv.data(), _n * sizeof(C));
+    }
+  }
+
+  void KrylovExpmv::apply(Storage &v, const cytnx_complex128 &t) {
+    cytnx_error_msg(v.dtype() != Type.ComplexDouble || v.size() != _n ||
+                      v.device() != Device.cpu,
+                    "[ERROR] KrylovExpmv::apply to %llu %s, expect %llu ComplexDouble on CPU.\n",
+                    (unsigned long long)v.size(), Type.enum_name(v.dtype()),
+                    (unsigned long long)_n);
+    CYTNX_TRACE_SCOPE("krylov.expmv");
+    _stats = Stats();
+    const blas_int n = blas_int(_n), one = 1;
+    C *w = v.data<C>();
+    double beta = _n ? dznrm2(&n, w, &one) : 0;
+    const double t_out = std::abs(t);
+    if (beta == 0 || t_out == 0) return;
+
+    const cytnx_uint64 m = _m, mh = m + 2;
+    const C phase = t / t_out, c_one = 1, c_zero = 0, c_minus = -1;
+    const double tol = _tol * beta;  // absolute from here on
+    const double eps = std::numeric_limits<double>::epsilon();
+    double t_now = 0, t_new = 0, error = 0;
+    bool first = true;
+
+    while (t_now < t_out) {
+      CYTNX_TRACE_SCOPE("krylov.step");
+      // Arnoldi: V_0 = w / beta, h_ij = <V_i, A V_j>, h_{j+1,j} = |residual|
+      C *V = _basis.data();
+      std::fill(_h.begin(), _h.end(), C(0));
+      memcpy(V, w, _n * sizeof(C));
+      const double inv_beta = 1 / beta;
+      zdscal(&n, &inv_beta, V, &one);
+      cytnx_uint64 mb = m;
+      bool breakdown = false;
+      for (cytnx_uint64 j = 0; j < m; j++) {
+        C *p = V + (j + 1) * _n, *h = _h.data() + j * mh;
+        apply_op(V + j * _n, p);
+        const blas_int k = blas_int(j + 1);
+        // classical Gram-Schmidt twice, which keeps the basis orthogonal to working precision
+        for (int pass = 0; pass < 2; pass++) {
+          zgemv("C", &n, &k, &c_one, V, &n, p, &one, &c_zero, _g.data(), &one);
+          zgemv("N", &n, &k, &c_minus, V, &n, _g.data(), &one, &c_one, p, &one);
+          for (cytnx_uint64 i = 0; i <= j; i++) h[i] += _g[i];
+        }
+        const double s = dznrm2(&n, p, &one);
+        double col = s * s;
+        for (cytnx_uint64 i = 0; i <= j; i++) col += std::norm(h[i]);
+        if (s <= kBreakdownTol * std::sqrt(col)) {
+          // A maps the space into itself: the projection is exact
+          breakdown = true;
+          mb = j + 1;
+          break;
+        }
+        h[j + 1] = s;
+        const double inv_s = 1 / s;
+        zdscal(&n, &inv_s, p, &one);
+      }
+
+      if (first) {
+        // the first step from the 1-norm of the projection, which bounds that of A from below
+        double anorm = 0;
+        for (cytnx_uint64 j = 0; j < mb; j++) {
+          double col = 0;
+          for (cytnx_uint64 i = 0; i <= j + 1; i++) col += std::abs(_h[i + j * mh]);
+          anorm = std::max(anorm, col);
+        }
+        if (anorm > 0 && !breakdown) {
+          const double mp = double(m + 1);
+          const double log_fact = mp * (std::log(mp) - 1) + 0.5 * std::log(2 * M_PI * mp);
+          t_new = round_step(std::exp((log_fact + std::log(tol / (4 * beta * anorm))) / m) /
+                             anorm);
+        }
+        first = false;
+      }
+
+      double avnorm = 0;
+      if (!breakdown) {
+        _h[(m + 1) + m * mh] = 1;
+        apply_op(V + m * _n, V + (m + 1) * _n);
+        avnorm = dznrm2(&n, V + (m + 1) * _n, &one);
+      }
+
+      // exp(phase t_step H), shrinking t_step until the local error is within tolerance
+      double t_step = breakdown ? t_out - t_now : std::min(t_out - t_now, t_new);
+      double err = 0, xm = 1.0 / std::max<double>(m, 1);
+      const cytnx_uint64 mx = breakdown ? mb : m + 2;
+      for (int reject = 0;; reject++) {
+        const C scale = phase * t_step;
+        for (cytnx_uint64 j = 0; j < mx; j++)
+          for (cytnx_uint64 i = 0; i < mx; i++) _f[i + j * mx] = scale * _h[i + j * mh];
+        utils_internal::Expm_cpu(_f.data(), _f.data(), blas_int(mx), *_work);
+        if (breakdown) break;
+        // the error of the step from the first two terms the projection leaves out
+        const double p1 = std::abs(_f[m]) * beta, p2 = std::abs(_f[m + 1]) * beta * avnorm;
+        if (p1 > 10 * p2) {
+          err = p2;
+          xm = 1.0 / m;
+        } else if (p1 > p2) {
+          err = p1 * p2 / (p1 - p2);
+          xm = 1.0 / m;
+        } else {
+          err = p1;
+          xm = 1.0 / std::max<double>(m - 1, 1);
+        }
+        if (err <= kDelta * t_step * tol) break;
+        cytnx_system_error_msg(reject == kMaxReject,
+                               "[ERROR] KrylovExpmv: the step size fell to %g without meeting "
+                               "tol; increase krylov_dim or tol.\n",
+                               t_step);
+        t_step = round_step(kGamma * t_step * std::pow(t_step * tol / err, xm));
+        _stats.rejected++;
+      }
+
+      // w = beta V F e_1 over the basis vectors the step used
+      const blas_int k = blas_int(breakdown ? mb : m + 1);
+      const C cb = beta;
+      zgemv("N", &n, &k, &cb, V, &n, _f.data(), &one, &c_zero, w, &one);
+      beta = dznrm2(&n, w, &one);
+      _stats.steps++;
+      err = std::max(err, eps * beta);
+      error += err;
+      t_now += t_step;
+      if (breakdown) break;
+      t_new = round_step(kGamma * t_step * std::pow(t_step * tol / err, xm));
+    }
+    _stats.error = error / (tol / _tol);
+  }
+
+}  // namespace cytnx_core
@@ -0,0 +1,136 @@
+#include <cytnx_core/LinOp.hpp>
+
+#include <cstring>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/linalg.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    // The LinOp whose default apply_vec() or apply_block() is running on this thread; each
+    // default calls the other, so meeting the same LinOp again means it overrides neither.
+    thread_local const LinOp *in_default_vec = nullptr;
+    thread_local const LinOp *in_default_block = nullptr;
+
+    struct DefaultScope {
+      const LinOp *&slot;
+      const LinOp *saved;
+      DefaultScope(const LinOp *&slot, const LinOp *op) : slot(slot), saved(slot) { slot = op; }
+      ~DefaultScope() { slot = saved; }
+    };
+  }  // namespace
+
+  LinOp::LinOp(const cytnx_uint64 &nx, const unsigned int &dtype) : _nx(nx), _dtype(dtype) {
+    cytnx_error_msg(dtype == Type.Void || dtype >= N_Type, "[ERROR] LinOp of dtype %d.\n",
+                    (int)dtype);
+  }
+
+  void LinOp::matvec(const Storage &x, Storage &y) const {
+    cytnx_error_msg(x.dtype() != _dtype || y.dtype() != _dtype || x.size() != _nx ||
+                      y.size() != _nx,
+                    "[ERROR] matvec of a LinOp of %llu %s with %llu %s into %llu %s.\n",
+                    (unsigned long long)_nx, Type.enum_name(_dtype), (unsigned long long)x.size(),
+                    Type.enum_name(x.dtype()), (unsigned long long)y.size(),
+                    Type.enum_name(y.dtype()));
+    cytnx_error_msg(x.device() != Device.cpu || y.device() != Device.cpu,
+                    "[ERROR] matvec of GPU Storages is not supported.%s", "\n");
+    cytnx_error_msg(_nx && x.same_data(y), "[ERROR] matvec with x and y in the same %s",
+                    "memory.\n");
+    if (_nx == 0) return;
+    CYTNX_TRACE_SCOPE("linop.matvec");
+    apply_vec(x, y);
+  }
+
+  Storage LinOp::matvec(const Storage &x) const {
+    Storage y(_nx, _dtype, Device.cpu, false);
+    matvec(x, y);
+    return y;
+  }
+
+  void LinOp::matmat(const StorageView &x, StorageView &y) const {
+    cytnx_error_msg(x.rank() != 2 || x.shape()[0] != _nx || x.dtype() != _dtype,
+                    "[ERROR] matmat of a LinOp of %llu %s with a view of %s.\n",
+                    (unsigned long long)_nx, Type.enum_name(_dtype), x.str().c_str());
+    const cytnx_uint64 k = x.shape()[1];
+    cytnx_error_msg(y.rank() != 2 || y.shape()[0] != _nx || y.shape()[1] != k ||
+                      y.dtype() != _dtype || !y.is_contiguous() || y.is_conj(),
+                    "[ERROR] matmat into a view of %s, expect a contiguous %llux%llu %s.\n",
+                    y.str().c_str(), (unsigned long long)_nx, (unsigned long long)k,
+                    Type.enum_name(_dtype));
+    cytnx_error_msg(x.device() != Device.cpu || y.device() != Device.cpu,
+                    "[ERROR] matmat of GPU views is not supported.%s", "\n");
+    if (_nx == 0 || k == 0) return;
+    CYTNX_TRACE_SCOPE("linop.matmat");
+    // detach y here, so apply_block() writes into memory nothing else sees
+    y.mutable_data();
+    apply_block(x.contiguous(), y);
+  }
+
+  StorageView LinOp::matmat(const StorageView &x) const {
+    cytnx_error_msg(x.rank() != 2, "[ERROR] matmat with a rank-%d view, expect 2.\n",
+                    (int)x.rank());
+    StorageView y(Storage(_nx * x.shape()[1], _dtype, Device.cpu, false), {_nx, x.shape()[1]});
+    matmat(x, y);
+    return y;
+  }
+
+  void LinOp::apply_vec(const Storage &x, Storage &y) const {
+    cytnx_error_msg(in_default_block == this,
+                    "[ERROR] a LinOp must override apply_vec() or apply_block().%s", "\n");
+    DefaultScope scope(in_default_vec, this);
+    // a block of one column; y is filled through a copy, as a view of it would be shared
+    StorageView out(Storage(_nx, _dtype, Device.cpu, false), {_nx, 1});
+    apply_block(StorageView(x, {_nx, 1}), out);
+    memcpy(y.data(), out.data(), _nx * Type.typeSize(_dtype));
+  }
+
+  void LinOp::apply_block(const StorageView &x, StorageView &y) const {
+    cytnx_error_msg(in_default_vec == this,
+                    "[ERROR] a LinOp must override apply_vec() or apply_block().%s", "\n");
+    DefaultScope scope(in_default_block, this);
+    // column by column: gather the column of x, apply, scatter into the column of y
+    const cytnx_uint64 k = x.shape()[1], elem = Type.typeSize(_dtype);
+    const char *px = static_cast<const char *>(x.data());
+    char *py = static_cast<char *>(y.mutable_data());
+    Storage xi(_nx, _dtype, Device.cpu, false), yi(_nx, _dtype, Device.cpu, false);
+    char *bx = static_cast<char *>(xi.data()), *by = static_cast<char *>(yi.data());
+    for (cytnx_uint64 c = 0; c < k; c++) {
+      for (cytnx_uint64 r = 0; r < _nx; r++) memcpy(bx + r * elem, px + (r * k + c) * elem, elem);
+      apply_vec(xi, yi);
+      for (cytnx_uint64 r = 0; r < _nx; r++) memcpy(py + (r * k + c) * elem, by + r * elem, elem);
+    }
+  }
+
+  DenseLinOp::DenseLinOp(const StorageView &matrix)
+      : LinOp(matrix.rank() == 2 ? matrix.shape()[0] : 0, matrix.dtype()), _matrix(matrix) {
+    cytnx_error_msg(matrix.rank() != 2 || matrix.shape()[0] != matrix.shape()[1],
+                    "[ERROR] DenseLinOp of a view of %s, expect a square matrix.\n",
+                    matrix.str().c_str());
+  }
+
+  void DenseLinOp::apply_vec(const Storage &x, Storage &y) const {
+    // gemv straight from x into y: an iterative solver calls this once per iteration
+    linalg::Matvec(_matrix, StorageView(x), y);
+  }
+
+  void DenseLinOp::apply_block(const StorageView &x, StorageView &y) const {
+    linalg::Matmul(_matrix, x, y);
+  }
+
+  SparseLinOp::SparseLinOp(const CsrMatrix &matrix)
+      : LinOp(matrix.nrows(), matrix.dtype()), _matrix(matrix) {
+    cytnx_error_msg(matrix.nrows() != matrix.ncols(),
+                    "[ERROR] SparseLinOp of a %llux%llu matrix, expect a square one.\n",
+                    (unsigned long long)matrix.nrows(), (unsigned long long)matrix.ncols());
+  }
+
+  void SparseLinOp::apply_vec(const Storage &x, Storage &y) const { _matrix.matvec(x, y); }
+
+  void SparseLinOp::apply_block(const StorageView &x, StorageView &y) const {
+    _matrix.matmat(x, y);
+  }
+
+}  // namespace cytnx_core
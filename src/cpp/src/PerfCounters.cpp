@@ -0,0 +1,276 @@
+#include <cytnx_core/PerfCounters.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace perf {
+
+    std::atomic<bool> _enabled(false);
+
+    namespace {
+      const char *const event_names[N_Event] = {
+        "cycles", "instructions", "cache_references", "cache_misses",
+        "dtlb_misses", "branch_misses", "page_faults"};
+
+#ifdef __linux__
+      struct EventSpec {
+        std::uint32_t type;
+        std::uint64_t config;
+      };
+      const EventSpec event_specs[N_Event] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}};
+#endif
+
+      // the counter group of the calling thread; events that cannot be opened are left out
+      struct Group {
+        int leader = -1;
+        int slot[N_Event];  // the position of each event in a group read, -1 if missing
+        int size = 0;
+        string error;  // why the first missing event could not be opened
+        vector<int> fds;
+
+        Group() {
+          for (unsigned int e = 0; e < N_Event; e++) slot[e] = -1;
+#ifdef __linux__
+          for (unsigned int e = 0; e < N_Event; e++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = event_specs[e].type;
+            attr.config = event_specs[e].config;
+            attr.read_format =
+              PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.exclude_kernel = 1;  // allowed up to perf_event_paranoid = 2
+            attr.exclude_hv = 1;
+            // this thread, any cpu
+            const int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+            if (fd < 0) {
+              if (error.empty()) error = string(event_names[e]) + ": " + strerror(errno);
+              continue;
+            }
+            if (leader < 0) leader = fd;
+            fds.push_back(fd);
+            slot[e] = size++;
+          }
+#else
+          error = "perf_event_open is only available on Linux";
+#endif
+        }
+        ~Group() {
+#ifdef __linux__
+          for (int fd : fds) close(fd);
+#endif
+        }
+        Group(const Group &) = delete;
+        Group &operator=(const Group &) = delete;
+
+        // the current counts, scaled for multiplexing; -1 for missing events
+        void read(std::array<double, N_Event> &counts) const {
+          counts.fill(-1);
+#ifdef __linux__
+          if (size == 0) return;
+          // nr, time_enabled, time_running, then one value per event
+          std::uint64_t buf[3 + N_Event];
+          if (::read(leader, buf, sizeof(buf)) < (ssize_t)(3 + size) * 8) return;
+          const double scale = buf[2] > 0 ? double(buf[1]) / buf[2] : 0;
+          for (unsigned int e = 0; e < N_Event; e++)
+            if (slot[e] >= 0) counts[e] = buf[3 + slot[e]] * scale;
+#endif
+        }
+      };
+
+      struct Totals {
+        std::uint64_t calls = 0, ns = 0;
+        std::array<double, N_Event> counts;
+        Totals() { counts.fill(-1); }
+        void add(const std::array<double, N_Event> &c) {
+          for (unsigned int e = 0; e < N_Event; e++)
+            if (c[e] >= 0) counts[e] = std::max(counts[e], 0.0) + c[e];
+        }
+      };
+
+      // the region totals of one thread; the owner and readers take the mutex, which is
+      // uncontended on the hot path
+      struct ThreadTotals {
+        mutex mtx;
+        map<string, Totals> regions;
+      };
+
+      // totals outlive their threads, so the regions of finished (e.g. OpenMP) threads are kept
+      struct Registry {
+        mutex mtx;
+        vector<shared_ptr<ThreadTotals>> threads;
+      };
+
+      Registry &registry() {
+        // never destroyed: threads may still count during static destruction
+        static Registry *r = new Registry;
+        return *r;
+      }
+
+      struct ThreadState {
+        Group group;
+        shared_ptr<ThreadTotals> totals = make_shared<ThreadTotals>();
+        ThreadState() {
+          Registry &r = registry();
+          lock_guard<mutex> lock(r.mtx);
+          r.threads.push_back(totals);
+        }
+      };
+
+      // opened on the first region of a thread; the group is closed when the thread exits
+      ThreadState &local_state() {
+        static thread_local ThreadState state;
+        return state;
+      }
+
+      struct Probe {
+        std::array<bool, N_Event> events;
+        string status;
+        Probe() {
+          const Group g;
+          string missing;
+          for (unsigned int e = 0; e < N_Event; e++) {
+            events[e] = g.slot[e] >= 0;
+            if (!events[e]) missing += string(missing.empty() ? "" : ", ") + event_names[e];
+          }
+          if (missing.empty()) return;
+          status = "missing events: " + missing + " (" + g.error + ")";
+          ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+          int level;
+          if (paranoid >> level)
+            status += "; perf_event_paranoid = " + to_string(level);
+        }
+      };
+
+      const Probe &probe() {
+        static const Probe p;
+        return p;
+      }
+    }  // namespace
+
+    const char *event_name(const unsigned int &event) {
+      cytnx_error_msg(event >= N_Event, "[ERROR][perf] invalid event: %u\n", event);
+      return event_names[event];
+    }
+
+    bool available() {
+      for (bool e : probe().events)
+        if (e) return true;
+      return false;
+    }
+    std::array<bool, N_Event> events() { return probe().events; }
+    string status() { return probe().status.empty() ? "ok" : probe().status; }
+
+    void enable(const bool &on) { _enabled.store(on, memory_order_relaxed); }
+    void disable() { enable(false); }
+    bool enabled() { return _enabled.load(memory_order_relaxed); }
+
+    void begin(Sample &s) {
+      local_state().group.read(s.counts);
+      s.ns = trace::now_ns();
+    }
+
+    void end(const char *name, const Sample &begin) {
+      const std::uint64_t ns = trace::now_ns();
+      ThreadState &state = local_state();
+      std::array<double, N_Event> counts;
+      state.group.read(counts);
+      for (unsigned int e = 0; e < N_Event; e++)
+        counts[e] = counts[e] >= 0 && begin.counts[e] >= 0 ? counts[e] - begin.counts[e] : -1;
+
+      lock_guard<mutex> lock(state.totals->mtx);
+      Totals &t = state.totals->regions[name];
+      t.calls++;
+      t.ns += ns - begin.ns;
+      t.add(counts);
+    }
+
+    void reset() {
+      Registry &r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      for (auto &t : r.threads) {
+        lock_guard<mutex> thread_lock(t->mtx);
+        t->regions.clear();
+      }
+    }
+
+    vector<Region> regions() {
+      map<string, Totals> sum;
+      {
+        Registry &r = registry();
+        lock_guard<mutex> lock(r.mtx);
+        for (auto &t : r.threads) {
+          lock_guard<mutex> thread_lock(t->mtx);
+          for (const auto &it : t->regions) {
+            Totals &s = sum[it.first];
+            s.calls += it.second.calls;
+            s.ns += it.second.ns;
+            s.add(it.second.counts);
+          }
+        }
+      }
+      vector<Region> out;
+      for (const auto &it : sum)
+        out.push_back(Region{it.first, it.second.calls, it.second.ns * 1e-9, it.second.counts});
+      return out;
+    }
+
+    string report() {
+      string out;
+      char buf[256];
+      snprintf(buf, sizeof(buf), "%-24s %10s %10s %6s %8s %9s %9s %9s %10s\n", "region", "calls",
+               "time[s]", "IPC", "miss%", "LLC/kI", "dTLB/kI", "br/kI", "faults");
+      out += buf;
+      // a value, or "-" when the events it needs are missing
+      auto cell = [&](const double &v, const char *format) {
+        if (v < 0) return string("-");
+        snprintf(buf, sizeof(buf), format, v);
+        return string(buf);
+      };
+      for (const auto &r : regions()) {
+        const auto &c = r.counts;
+        auto per_kinst = [&](const unsigned int &e) {
+          return c[e] >= 0 && c[Instructions] > 0 ? 1000 * c[e] / c[Instructions] : -1;
+        };
+        const double miss_rate =
+          c[CacheMisses] >= 0 && c[CacheReferences] > 0 ? 100 * c[CacheMisses] / c[CacheReferences]
+                                                        : -1;
+        const string ipc = cell(r.ipc(), "%.2f"), miss = cell(miss_rate, "%.1f"),
+                     llc = cell(per_kinst(CacheMisses), "%.2f"),
+                     tlb = cell(per_kinst(DTLBMisses), "%.2f"),
+                     br = cell(per_kinst(BranchMisses), "%.2f"),
+                     faults = cell(c[PageFaults], "%.0f");
+        snprintf(buf, sizeof(buf), "%-24s %10llu %10.4f %6s %8s %9s %9s %9s %10s\n",
+                 r.name.c_str(), (unsigned long long)r.calls, r.seconds, ipc.c_str(), miss.c_str(),
+                 llc.c_str(), tlb.c_str(), br.c_str(), faults.c_str());
+        out += buf;
+      }
+      return out;
+    }
+
+  }  // namespace perf
+}  // namespace cytnx_core
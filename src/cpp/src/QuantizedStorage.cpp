@@ -0,0 +1,95 @@
+#include <cytnx_core/QuantizedStorage.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Quantize_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    // the real type whose values make up one element of dtype
+    unsigned int real_dtype(const unsigned int &dtype) {
+      switch (dtype) {
+        case Type.ComplexDouble:
+          return Type.Double;
+        case Type.ComplexFloat:
+          return Type.Float;
+        case Type.ComplexHalf:
+          return Type.Half;
+        case Type.ComplexBFloat16:
+          return Type.BFloat16;
+        default:
+          return dtype;
+      }
+    }
+  }  // namespace
+
+  string QuantizationError::str() const {
+    char buf[160];
+    snprintf(buf, sizeof(buf), "max_abs=%.3g rms=%.3g rel_rms=%.3g max_value=%.3g", max_abs, rms,
+             rel_rms, max_value);
+    return buf;
+  }
+
+  QuantizedStorage::QuantizedStorage()
+      : _size(0), _dtype(Type.Void), _bits(8), _block(64), _error{0, 0, 0, 0} {}
+
+  QuantizedStorage QuantizedStorage::quantize(const Storage &src, const int &bits,
+                                              const cytnx_uint64 &block_size) {
+    CYTNX_TRACE_SCOPE("storage.quantize");
+    cytnx_error_msg(src.device() != Device.cpu,
+                    "[ERROR] quantize() of a GPU Storage is not supported.%s", "\n");
+    cytnx_error_msg(src.dtype() == Type.Void || !Type.is_float(src.dtype()),
+                    "[ERROR] quantize() of a %s Storage, expect a floating point type.\n",
+                    Type.enum_name(src.dtype()));
+    cytnx_error_msg(bits != 8 && bits != 4, "[ERROR] quantize() to %d bits, expect 8 or 4.\n",
+                    bits);
+    cytnx_error_msg(block_size == 0 || (bits == 4 && block_size % 2),
+                    "[ERROR] invalid block_size %llu for %d bits.\n",
+                    (unsigned long long)block_size, bits);
+
+    QuantizedStorage out;
+    out._size = src.size();
+    out._dtype = src.dtype();
+    out._bits = bits;
+    out._block = block_size;
+    const cytnx_uint64 n = Type.is_complex(src.dtype()) ? 2 * src.size() : src.size();
+    const cytnx_uint64 nblocks = (n + block_size - 1) / block_size;
+    out._values = Storage(bits == 8 ? n : (n + 1) / 2, Type.Int8, Device.cpu, false);
+    out._scales = Storage(nblocks, Type.Float, Device.cpu, false);
+    if (n == 0) return out;
+
+    utils_internal::QuantizeStats stats;
+    utils_internal::Quantize_cpu(out._values.data<cytnx_int8>(),
+                                 out._scales.data<cytnx_float>(), src.data(),
+                                 real_dtype(src.dtype()), n, block_size, bits, &stats);
+    out._error.max_abs = stats.max_err;
+    out._error.rms = std::sqrt(stats.sq_err / n);
+    out._error.rel_rms = stats.sq_ref > 0 ? std::sqrt(stats.sq_err / stats.sq_ref) : 0;
+    out._error.max_value = stats.max_abs;
+    return out;
+  }
+
+  Storage QuantizedStorage::dequantize() const {
+    CYTNX_TRACE_SCOPE("storage.dequantize");
+    cytnx_error_msg(_dtype == Type.Void, "[ERROR] dequantize() of an empty QuantizedStorage.%s",
+                    "\n");
+    Storage out(_size, _dtype, Device.cpu, false);
+    const cytnx_uint64 n = Type.is_complex(_dtype) ? 2 * _size : _size;
+    if (n == 0) return out;
+    utils_internal::Dequantize_cpu(out.data(), real_dtype(_dtype), _values.data<cytnx_int8>(),
+                                   _scales.data<cytnx_float>(), n, _block, _bits);
+    return out;
+  }
+
+  double QuantizedStorage::compression_ratio() const {
+    const cytnx_uint64 bytes = nbytes();
+    return bytes ? double(_size * Type.typeSize(_dtype)) / bytes : 0;
+  }
+
+}  // namespace cytnx_core
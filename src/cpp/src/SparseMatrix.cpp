@@ -0,0 +1,210 @@
+#include <cytnx_core/SparseMatrix.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Sparse_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    bool sparse_dtype(const unsigned int &dtype) {
+      return dtype == Type.Double || dtype == Type.Float || dtype == Type.ComplexDouble ||
+             dtype == Type.ComplexFloat;
+    }
+
+    // run fn with a null pointer of the element type of a sparse dtype
+    template <class Fn>
+    void with_sparse_type(const unsigned int &dtype, const Fn &fn) {
+      if (dtype == Type.Double) return fn((cytnx_double *)nullptr);
+      if (dtype == Type.Float) return fn((cytnx_float *)nullptr);
+      if (dtype == Type.ComplexDouble) return fn((cytnx_complex128 *)nullptr);
+      return fn((cytnx_complex64 *)nullptr);
+    }
+
+    void check_values(const Storage &values, const cytnx_uint64 &nnz, const char *what) {
+      cytnx_error_msg(values.device() != Device.cpu,
+                      "[ERROR] %s with values on a GPU is not supported.\n", what);
+      cytnx_error_msg(!sparse_dtype(values.dtype()),
+                      "[ERROR] %s of %s, expect Double, Float, ComplexDouble or ComplexFloat.\n",
+                      what, Type.enum_name(values.dtype()));
+      cytnx_error_msg(values.size() != nnz, "[ERROR] %s with %llu indices and %llu values.\n",
+                      what, (unsigned long long)nnz, (unsigned long long)values.size());
+    }
+  }  // namespace
+
+  CooMatrix::CooMatrix() : _nrows(0), _ncols(0), _values(0, Type.Double) {}
+
+  CooMatrix::CooMatrix(const cytnx_uint64 &nrows, const cytnx_uint64 &ncols,
+                       const vector<cytnx_uint64> &rows, const vector<cytnx_uint64> &cols,
+                       const Storage &values)
+      : _nrows(nrows), _ncols(ncols), _rows(rows), _cols(cols), _values(values) {
+    cytnx_error_msg(rows.size() != cols.size(),
+                    "[ERROR] CooMatrix with %llu rows and %llu cols.\n",
+                    (unsigned long long)rows.size(), (unsigned long long)cols.size());
+    check_values(values, rows.size(), "CooMatrix");
+    for (cytnx_uint64 i = 0; i < rows.size(); i++)
+      cytnx_error_msg(rows[i] >= nrows || cols[i] >= ncols,
+                      "[ERROR] CooMatrix entry (%llu, %llu) of a %llux%llu matrix.\n",
+                      (unsigned long long)rows[i], (unsigned long long)cols[i],
+                      (unsigned long long)nrows, (unsigned long long)ncols);
+  }
+
+  CsrMatrix CooMatrix::to_csr(const SparseSymmetry &symmetry) const {
+    CYTNX_TRACE_SCOPE("sparse.to_csr");
+    const bool upper = symmetry != SparseSymmetry::General;
+    cytnx_error_msg(upper && _nrows != _ncols,
+                    "[ERROR] a symmetric or Hermitian CsrMatrix of a %llux%llu matrix.\n",
+                    (unsigned long long)_nrows, (unsigned long long)_ncols);
+    // a triplet below the diagonal may be meant to mirror one above or to repeat it, so
+    // neither dropping nor mirroring it is safe
+    for (cytnx_uint64 i = 0; upper && i < nnz(); i++)
+      cytnx_error_msg(_cols[i] < _rows[i],
+                      "[ERROR] a symmetric or Hermitian CsrMatrix from the entry (%llu, %llu) "
+                      "below the diagonal, expect the upper triangle only.\n",
+                      (unsigned long long)_rows[i], (unsigned long long)_cols[i]);
+    vector<cytnx_uint64> indptr(_nrows + 1), indices(nnz());
+    Storage values(nnz(), dtype(), Device.cpu, false);
+    cytnx_uint64 n = 0;
+    with_sparse_type(dtype(), [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      n = utils_internal::CooToCsr_cpu(indptr.data(), indices.data(), values.data<T>(),
+                                       _rows.data(), _cols.data(), _values.data<T>(), nnz(),
+                                       _nrows, upper);
+    });
+    // repeats leave the tail unused
+    indices.resize(n);
+    if (n < values.size()) {
+      Storage packed(n, dtype(), Device.cpu, false);
+      if (n) memcpy(packed.data(), values.data(), n * Type.typeSize(dtype()));
+      values = packed;
+    }
+    return CsrMatrix(_nrows, _ncols, indptr, indices, values, symmetry);
+  }
+
+  CsrMatrix::CsrMatrix()
+      : _nrows(0),
+        _ncols(0),
+        _indptr{0},
+        _values(0, Type.Double),
+        _symmetry(SparseSymmetry::General),
+        _bounds{0, 0} {}
+
+  CsrMatrix::CsrMatrix(const cytnx_uint64 &nrows, const cytnx_uint64 &ncols,
+                       const vector<cytnx_uint64> &indptr, const vector<cytnx_uint64> &indices,
+                       const Storage &values, const SparseSymmetry &symmetry)
+      : _nrows(nrows),
+        _ncols(ncols),
+        _indptr(indptr),
+        _indices(indices),
+        _values(values),
+        _symmetry(symmetry) {
+    const bool half = symmetry != SparseSymmetry::General;
+    cytnx_error_msg(indptr.size() != nrows + 1 || indptr[0] != 0 ||
+                      indptr[nrows] != indices.size(),
+                    "[ERROR] CsrMatrix of %llu rows and %llu nonzeros with %llu offsets.\n",
+                    (unsigned long long)nrows, (unsigned long long)indices.size(),
+                    (unsigned long long)indptr.size());
+    check_values(values, indices.size(), "CsrMatrix");
+    cytnx_error_msg(half && nrows != ncols,
+                    "[ERROR] a symmetric or Hermitian CsrMatrix of a %llux%llu matrix.\n",
+                    (unsigned long long)nrows, (unsigned long long)ncols);
+    for (cytnx_uint64 i = 0; i < nrows; i++) {
+      cytnx_error_msg(indptr[i] > indptr[i + 1],
+                      "[ERROR] CsrMatrix offsets decrease at row %llu.\n", (unsigned long long)i);
+      for (cytnx_uint64 e = indptr[i]; e < indptr[i + 1]; e++)
+        cytnx_error_msg(indices[e] >= ncols || (half && indices[e] < i),
+                        "[ERROR] CsrMatrix entry (%llu, %llu) of a %llux%llu%s matrix.\n",
+                        (unsigned long long)i, (unsigned long long)indices[e],
+                        (unsigned long long)nrows, (unsigned long long)ncols,
+                        half ? " upper-triangular" : "");
+    }
+    utils_internal::CsrPartition part = utils_internal::PartitionCsr_cpu(
+      _indptr.data(), _indices.data(), nrows, utils_internal::GetBlockingParams().convert_threads,
+      half);
+    _bounds = std::move(part.bounds);
+    _reach = std::move(part.reach);
+  }
+
+  void CsrMatrix::matvec(const Storage &x, Storage &y) const {
+    cytnx_error_msg(x.dtype() != dtype() || y.dtype() != dtype() || x.size() != _ncols ||
+                      y.size() != _nrows,
+                    "[ERROR] matvec of a %llux%llu %s matrix with %llu %s into %llu %s.\n",
+                    (unsigned long long)_nrows, (unsigned long long)_ncols,
+                    Type.enum_name(dtype()), (unsigned long long)x.size(),
+                    Type.enum_name(x.dtype()), (unsigned long long)y.size(),
+                    Type.enum_name(y.dtype()));
+    cytnx_error_msg(x.device() != Device.cpu || y.device() != Device.cpu,
+                    "[ERROR] matvec of GPU Storages is not supported.%s", "\n");
+    cytnx_error_msg(_nrows && x.same_data(y), "[ERROR] matvec with x and y in the same %s",
+                    "memory.\n");
+    if (_nrows == 0) return;
+    with_sparse_type(dtype(), [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SpMM_cpu(y.data<T>(), x.data<T>(), 1, _indptr.data(), _indices.data(),
+                               _values.data<T>(), int(_symmetry), {_bounds, _reach});
+    });
+  }
+
+  Storage CsrMatrix::matvec(const Storage &x) const {
+    Storage y(_nrows, dtype(), Device.cpu, false);
+    matvec(x, y);
+    return y;
+  }
+
+  StorageView CsrMatrix::matmat(const StorageView &x) const {
+    cytnx_error_msg(x.rank() != 2, "[ERROR] matmat with a rank-%d view, expect 2.\n",
+                    (int)x.rank());
+    StorageView y(Storage(_nrows * x.shape()[1], dtype(), Device.cpu, false),
+                  {_nrows, x.shape()[1]});
+    matmat(x, y);
+    return y;
+  }
+
+  void CsrMatrix::matmat(const StorageView &x, StorageView &y) const {
+    cytnx_error_msg(x.rank() != 2 || x.shape()[0] != _ncols || x.dtype() != dtype(),
+                    "[ERROR] matmat of a %llux%llu %s matrix with a rank-%d %s view.\n",
+                    (unsigned long long)_nrows, (unsigned long long)_ncols,
+                    Type.enum_name(dtype()), (int)x.rank(), Type.enum_name(x.dtype()));
+    const cytnx_uint64 k = x.shape()[1];
+    cytnx_error_msg(y.rank() != 2 || y.shape()[0] != _nrows || y.shape()[1] != k ||
+                      y.dtype() != dtype() || !y.is_contiguous() || y.is_conj(),
+                    "[ERROR] matmat into a view of %s, expect a contiguous %llux%llu %s.\n",
+                    y.str().c_str(), (unsigned long long)_nrows, (unsigned long long)k,
+                    Type.enum_name(dtype()));
+    if (_nrows == 0 || k == 0) return;
+    const StorageView xc = x.contiguous();
+    void *py = y.mutable_data();
+    with_sparse_type(dtype(), [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SpMM_cpu(static_cast<T *>(py), static_cast<const T *>(xc.data()), k,
+                               _indptr.data(), _indices.data(), _values.data<T>(),
+                               int(_symmetry), {_bounds, _reach});
+    });
+  }
+
+  Storage CsrMatrix::to_dense() const {
+    Storage out(_nrows * _ncols, dtype(), Device.cpu, true);
+    with_sparse_type(dtype(), [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      T *a = out.data<T>();
+      const T *v = _values.data<T>();
+      for (cytnx_uint64 i = 0; i < _nrows; i++)
+        for (cytnx_uint64 e = _indptr[i]; e < _indptr[i + 1]; e++) {
+          const cytnx_uint64 j = _indices[e];
+          a[i * _ncols + j] += v[e];
+          if (_symmetry == SparseSymmetry::General || j == i) continue;
+          if constexpr (is_complex_v<T>)
+            a[j * _ncols + i] += _symmetry == SparseSymmetry::Hermitian ? std::conj(v[e]) : v[e];
+          else
+            a[j * _ncols + i] += v[e];
+        }
+    });
+    return out;
+  }
+
+}  // namespace cytnx_core
@@ -0,0 +1,169 @@
+#include <cytnx_core/SplitComplexStorage.hpp>
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/SplitComplex_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    // run fn with a null pointer of the real type of dtype, ComplexDouble or ComplexFloat
+    template <class Fn>
+    auto with_real_type(const unsigned int &dtype, const Fn &fn) {
+      if (dtype == Type.ComplexFloat) return fn((cytnx_float *)nullptr);
+      return fn((cytnx_double *)nullptr);
+    }
+  }  // namespace
+
+  SplitComplexStorage::SplitComplexStorage() : _dtype(Type.Void) {}
+
+  SplitComplexStorage::SplitComplexStorage(const cytnx_uint64 &size, const unsigned int &dtype)
+      : _dtype(dtype) {
+    cytnx_error_msg(dtype != Type.ComplexDouble && dtype != Type.ComplexFloat,
+                    "[ERROR] split-complex layout of %s, expect ComplexDouble or ComplexFloat.\n",
+                    Type.enum_name(dtype));
+    const unsigned int real = dtype == Type.ComplexFloat ? Type.Float : Type.Double;
+    _real = Storage(size, real);
+    _imag = Storage(size, real);
+  }
+
+  SplitComplexStorage SplitComplexStorage::from_interleaved(const Storage &in) {
+    CYTNX_TRACE_SCOPE("storage.from_interleaved");
+    cytnx_error_msg(in.device() != Device.cpu,
+                    "[ERROR] split-complex layout of a GPU Storage is not supported.%s", "\n");
+    cytnx_error_msg(in.dtype() != Type.ComplexDouble && in.dtype() != Type.ComplexFloat,
+                    "[ERROR] split-complex layout of %s, expect ComplexDouble or ComplexFloat.\n",
+                    Type.enum_name(in.dtype()));
+    SplitComplexStorage out;
+    out._dtype = in.dtype();
+    const unsigned int real = in.dtype() == Type.ComplexFloat ? Type.Float : Type.Double;
+    out._real = Storage(in.size(), real, Device.cpu, false);
+    out._imag = Storage(in.size(), real, Device.cpu, false);
+    out.assign(in);
+    return out;
+  }
+
+  Storage SplitComplexStorage::to_interleaved() const {
+    cytnx_error_msg(_dtype == Type.Void, "[ERROR] to_interleaved() of an empty %s",
+                    "SplitComplexStorage.\n");
+    Storage out(size(), _dtype, Device.cpu, false);
+    to_interleaved(out);
+    return out;
+  }
+
+  void SplitComplexStorage::to_interleaved(Storage &out) const {
+    cytnx_error_msg(out.dtype() != _dtype || out.size() != size() || out.device() != Device.cpu,
+                    "[ERROR] to_interleaved() into a Storage of %llu %s, expect %llu %s.\n",
+                    (unsigned long long)out.size(), Type.enum_name(out.dtype()),
+                    (unsigned long long)size(), Type.enum_name(_dtype));
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::Interleave_cpu(static_cast<complex<T> *>(out.data()), _real.data<T>(),
+                                     _imag.data<T>(), size());
+    });
+  }
+
+  void SplitComplexStorage::assign(const Storage &in) {
+    cytnx_error_msg(in.dtype() != _dtype || in.size() != size() || in.device() != Device.cpu,
+                    "[ERROR] assign() of a Storage of %llu %s, expect %llu %s.\n",
+                    (unsigned long long)in.size(), Type.enum_name(in.dtype()),
+                    (unsigned long long)size(), Type.enum_name(_dtype));
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::Deinterleave_cpu(_real.data<T>(), _imag.data<T>(),
+                                       static_cast<const complex<T> *>(in.data()), size());
+    });
+  }
+
+  SplitComplexStorage SplitComplexStorage::clone() const {
+    SplitComplexStorage out;
+    out._real = _real.clone();
+    out._imag = _imag.clone();
+    out._dtype = _dtype;
+    return out;
+  }
+
+  void SplitComplexStorage::check_same(const SplitComplexStorage &rhs, const char *op) const {
+    cytnx_error_msg(rhs._dtype != _dtype || rhs.size() != size(),
+                    "[ERROR] %s() of %llu %s and %llu %s, expect the same size and dtype.\n", op,
+                    (unsigned long long)size(), Type.enum_name(_dtype),
+                    (unsigned long long)rhs.size(), Type.enum_name(rhs._dtype));
+  }
+
+  void SplitComplexStorage::add(const SplitComplexStorage &rhs) {
+    check_same(rhs, "add");
+    if (_dtype == Type.Void) return;
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SplitAdd_cpu(_real.data<T>(), _imag.data<T>(), _real.data<T>(),
+                                   _imag.data<T>(), rhs._real.data<T>(), rhs._imag.data<T>(),
+                                   size());
+    });
+  }
+
+  void SplitComplexStorage::mul(const SplitComplexStorage &rhs) {
+    check_same(rhs, "mul");
+    if (_dtype == Type.Void) return;
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SplitMul_cpu(_real.data<T>(), _imag.data<T>(), _real.data<T>(),
+                                   _imag.data<T>(), rhs._real.data<T>(), rhs._imag.data<T>(),
+                                   size());
+    });
+  }
+
+  void SplitComplexStorage::scale(const cytnx_complex128 &alpha) {
+    if (_dtype == Type.Void) return;
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SplitScal_cpu(_real.data<T>(), _imag.data<T>(),
+                                    complex<T>(alpha.real(), alpha.imag()), size());
+    });
+  }
+
+  void SplitComplexStorage::axpy(const cytnx_complex128 &alpha, const SplitComplexStorage &x) {
+    check_same(x, "axpy");
+    if (_dtype == Type.Void) return;
+    with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      utils_internal::SplitAxpy_cpu(_real.data<T>(), _imag.data<T>(),
+                                    complex<T>(alpha.real(), alpha.imag()), x._real.data<T>(),
+                                    x._imag.data<T>(), size());
+    });
+  }
+
+  cytnx_complex128 SplitComplexStorage::sum() const {
+    if (_dtype == Type.Void) return 0;
+    return with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      return cytnx_complex128(utils_internal::SplitSum_cpu(_real.data<T>(), _imag.data<T>(),
+                                                           size()));
+    });
+  }
+
+  cytnx_complex128 SplitComplexStorage::vdot(const SplitComplexStorage &rhs) const {
+    check_same(rhs, "vdot");
+    if (_dtype == Type.Void) return 0;
+    return with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      return cytnx_complex128(utils_internal::SplitVdot_cpu(
+        _real.data<T>(), _imag.data<T>(), rhs._real.data<T>(), rhs._imag.data<T>(), size()));
+    });
+  }
+
+  double SplitComplexStorage::norm() const {
+    if (_dtype == Type.Void) return 0;
+    return with_real_type(_dtype, [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      return std::sqrt(double(utils_internal::SplitNorm2_cpu(_real.data<T>(), _imag.data<T>(),
+                                                             size())));
+    });
+  }
+
+}  // namespace cytnx_core
@@ -0,0 +1,138 @@
+#include <cytnx_core/Storage.hpp>
+
+#include <cstring>
+
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Alloc_cpu.hpp"
+#include "utils_internal/cpu/Convert_cpu.hpp"
+#include "utils_internal/cpu/Fill_cpu.hpp"
+#ifdef UNI_GPU
+  #include "utils_internal/gpu/cuAlloc_gpu.hpp"
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+
+  namespace {
+    // convert a fill value to the element type of the Storage
+    template <class DType, class T>
+    DType value_cast(const T &val) {
+      if constexpr (is_complex_v<T> && !is_complex_v<DType>) {
+        cytnx_error_msg(val.imag() != 0,
+                        "[ERROR] cannot assign a complex value to a real Storage.%s", "\n");
+        return static_cast<DType>(val.real());
+      } else if constexpr (is_complex_v<T> && is_complex_v<DType>) {
+        using V = typename DType::value_type;
+        return DType(static_cast<V>(val.real()), static_cast<V>(val.imag()));
+      } else if constexpr (is_complex_v<DType>) {
+        using V = typename DType::value_type;
+        return DType(static_cast<V>(val), 0);
+      } else {
+        return static_cast<DType>(val);
+      }
+    }
+  }  // namespace
+
+  Storage::Storage() : _data(nullptr), _size(0), _dtype(Type.Void), _device(Device.cpu) {}
+
+  Storage::Storage(const cytnx_uint64 &size, const unsigned int &dtype, const int &device,
+                   const bool &init_zero)
+      : _data(nullptr), _size(size), _dtype(dtype), _device(device) {
+    cytnx_error_msg(!Type.is_valid(dtype), "[ERROR] invalid type_id: %u\n", dtype);
+    cytnx_error_msg(dtype == Type.Void, "[ERROR] cannot allocate a Storage of type Void.%s", "\n");
+    const cytnx_uint64 typesize = Type.typeSize(dtype);
+    if (device == Device.cpu) {
+      _data = init_zero ? utils_internal::Calloc_cpu(size, typesize)
+                        : utils_internal::Malloc_cpu(size * typesize);
+      _mem = shared_ptr<void>(_data, free);
+    } else {
+#ifdef UNI_GPU
+      cytnx_error_msg(device < 0 || device >= Device.Ngpus, "[ERROR] invalid device id: %d\n",
+                      device);
+      checkCudaErrors(cudaSetDevice(device));
+      _data = init_zero ? utils_internal::cuCalloc_gpu(size, typesize)
+                        : utils_internal::cuMalloc_gpu(size * typesize);
+      _mem = shared_ptr<void>(_data, [](void *ptr) { cudaFree(ptr); });
+#else
+      cytnx_input_error_msg(true,
+                            "[ERROR] invalid device id: %d, cytnx_core is built without CUDA.\n",
+                            device);
+#endif
+    }
+  }
+
+  Storage Storage::from_external(void *ptr, const cytnx_uint64 &size, const unsigned int &dtype,
+                                 const int &device, std::shared_ptr<void> owner) {
+    cytnx_error_msg(!Type.is_valid(dtype), "[ERROR] invalid type_id: %u\n", dtype);
+    cytnx_error_msg(dtype == Type.Void && size > 0,
+                    "[ERROR] cannot wrap memory as a Storage of type Void.%s", "\n");
+    Storage out;
+    out._mem = std::move(owner);
+    out._data = ptr;
+    out._size = size;
+    out._dtype = dtype;
+    out._device = device;
+    return out;
+  }
+
+  Storage Storage::clone() const {
+    CYTNX_TRACE_SCOPE("storage.clone");
+    CYTNX_PERF_SCOPE("storage.clone");
+    if (_dtype == Type.Void) return Storage();
+    Storage out(_size, _dtype, _device, false);
+    if (_device == Device.cpu) {
+      memcpy(out._data, _data, nbytes());
+    } else {
+#ifdef UNI_GPU
+      checkCudaErrors(cudaMemcpy(out._data, _data, nbytes(), cudaMemcpyDeviceToDevice));
+#endif
+    }
+    return out;
+  }
+
+  Storage Storage::astype(const unsigned int &dtype) const {
+    CYTNX_TRACE_SCOPE("storage.astype");
+    cytnx_error_msg(!Type.is_valid(dtype), "[ERROR] invalid type_id: %u\n", dtype);
+    cytnx_error_msg(_device != Device.cpu,
+                    "[ERROR] astype() on a GPU Storage is not supported.%s", "\n");
+    if (dtype == _dtype) return clone();
+    Storage out(_size, dtype, _device, false);
+    utils_internal::Astype_cpu(out._data, dtype, _data, _dtype, _size);
+    return out;
+  }
+
+  template <class T>
+  void Storage::fill(const T &val) {
+    cytnx_error_msg(_device != Device.cpu, "[ERROR] fill() on a GPU Storage is not supported.%s",
+                    "\n");
+    dispatch_type(_dtype, [&](auto tag) {
+      using DType = typename decltype(tag)::type;
+      if constexpr (std::is_same_v<DType, void>) {
+        cytnx_error_msg(true, "[ERROR] cannot fill a Storage of type Void.%s", "\n");
+      } else {
+        utils_internal::FillCpu<DType>(_data, value_cast<DType>(val), _size);
+      }
+    });
+  }
+
+  template void Storage::fill<cytnx_complex128>(const cytnx_complex128 &);
+  template void Storage::fill<cytnx_complex64>(const cytnx_complex64 &);
+  template void Storage::fill<cytnx_double>(const cytnx_double &);
+  template void Storage::fill<cytnx_float>(const cytnx_float &);
+  template void Storage::fill<cytnx_int64>(const cytnx_int64 &);
+  template void Storage::fill<cytnx_uint64>(const cytnx_uint64 &);
+  template void Storage::fill<cytnx_int32>(const cytnx_int32 &);
+  template void Storage::fill<cytnx_uint32>(const cytnx_uint32 &);
+  template void Storage::fill<cytnx_int16>(const cytnx_int16 &);
+  template void Storage::fill<cytnx_uint16>(const cytnx_uint16 &);
+  template void Storage::fill<cytnx_bool>(const cytnx_bool &);
+  template void Storage::fill<cytnx_complex32>(const cytnx_complex32 &);
+  template void Storage::fill<cytnx_bcomplex32>(const cytnx_bcomplex32 &);
+  template void Storage::fill<cytnx_float16>(const cytnx_float16 &);
+  template void Storage::fill<cytnx_bfloat16>(const cytnx_bfloat16 &);
+  template void Storage::fill<cytnx_int8>(const cytnx_int8 &);
+
+}  // namespace cytnx_core
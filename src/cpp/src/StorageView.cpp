@@ -0,0 +1,239 @@
+#include <cytnx_core/StorageView.hpp>
+
+#include <type_traits>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Permute_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+
+  // passing views and Storages around must never copy the elements
+  static_assert(std::is_nothrow_move_constructible_v<Storage> &&
+                  std::is_nothrow_move_assignable_v<Storage>,
+                "Storage must be cheap to move");
+  static_assert(std::is_nothrow_move_constructible_v<StorageView> &&
+                  std::is_nothrow_move_assignable_v<StorageView>,
+                "StorageView must be cheap to move");
+
+  namespace {
+    vector<cytnx_uint64> row_major_strides(const vector<cytnx_uint64> &shape) {
+      vector<cytnx_uint64> strides(shape.size());
+      cytnx_uint64 s = 1;
+      for (cytnx_uint64 i = shape.size(); i-- > 0;) {
+        strides[i] = s;
+        s *= shape[i];
+      }
+      return strides;
+    }
+
+    cytnx_uint64 product(const vector<cytnx_uint64> &shape) {
+      cytnx_uint64 n = 1;
+      for (auto s : shape) n *= s;
+      return n;
+    }
+
+    string join(const vector<cytnx_uint64> &v) {
+      string out = "(";
+      for (cytnx_uint64 i = 0; i < v.size(); i++) {
+        if (i) out += ", ";
+        out += to_string(v[i]);
+      }
+      if (v.size() == 1) out += ",";
+      return out + ")";
+    }
+
+    // The strides of a reshape that keeps the elements in place, or false when an axis being
+    // merged is not contiguous with the next one. Follows numpy's _attempt_nocopy_reshape.
+    bool nocopy_strides(const vector<cytnx_uint64> &shape, const vector<cytnx_uint64> &strides,
+                        const vector<cytnx_uint64> &newshape, vector<cytnx_uint64> &newstrides) {
+      vector<cytnx_uint64> od, os;
+      for (cytnx_uint64 i = 0; i < shape.size(); i++) {
+        if (shape[i] == 1) continue;
+        od.push_back(shape[i]);
+        os.push_back(strides[i]);
+      }
+      newstrides.assign(newshape.size(), 1);
+      cytnx_uint64 oi = 0, oj = 1, ni = 0, nj = 1;
+      while (ni < newshape.size() && oi < od.size()) {
+        cytnx_uint64 np = newshape[ni], op = od[oi];
+        while (np != op) {
+          if (np < op)
+            np *= newshape[nj++];
+          else
+            op *= od[oj++];
+        }
+        for (cytnx_uint64 ok = oi; ok + 1 < oj; ok++)
+          if (os[ok] != od[ok + 1] * os[ok + 1]) return false;
+        newstrides[nj - 1] = os[oj - 1];
+        for (cytnx_uint64 nk = nj - 1; nk > ni; nk--)
+          newstrides[nk - 1] = newstrides[nk] * newshape[nk];
+        ni = nj++;
+        oi = oj++;
+      }
+      return true;
+    }
+
+    // negate the imaginary parts of a complex Storage by flipping their sign bits, which works
+    // for every floating point type
+    void conj_inplace(Storage &buf) {
+      const cytnx_uint64 half = Type.typeSize(buf.dtype()) / 2;
+      auto flip = [&](auto *p) {
+        using U = std::remove_pointer_t<decltype(p)>;
+        const U sign = U(1) << (8 * sizeof(U) - 1);
+        for (cytnx_uint64 i = 0; i < buf.size(); i++) p[2 * i + 1] ^= sign;
+      };
+      if (half == 8) flip(static_cast<cytnx_uint64 *>(buf.data()));
+      if (half == 4) flip(static_cast<cytnx_uint32 *>(buf.data()));
+      if (half == 2) flip(static_cast<cytnx_uint16 *>(buf.data()));
+    }
+  }  // namespace
+
+  StorageView::StorageView() : _offset(0), _conj(false) {}
+
+  StorageView::StorageView(const Storage &storage)
+      : _storage(storage), _offset(0), _shape{storage.size()}, _strides{1}, _conj(false) {}
+
+  StorageView::StorageView(const Storage &storage, const vector<cytnx_uint64> &shape)
+      : _storage(storage),
+        _offset(0),
+        _shape(shape),
+        _strides(row_major_strides(shape)),
+        _conj(false) {
+    cytnx_error_msg(product(shape) != storage.size(),
+                    "[ERROR] a view of shape %s needs %llu elements, the Storage has %llu.\n",
+                    join(shape).c_str(), (unsigned long long)product(shape),
+                    (unsigned long long)storage.size());
+  }
+
+  StorageView::StorageView(const Storage &storage, const cytnx_uint64 &offset,
+                           const vector<cytnx_uint64> &shape, const vector<cytnx_uint64> &strides)
+      : _storage(storage), _offset(offset), _shape(shape), _strides(strides), _conj(false) {
+    cytnx_error_msg(shape.size() != strides.size(),
+                    "[ERROR] a view of rank %d with %d strides.\n", (int)shape.size(),
+                    (int)strides.size());
+    if (product(shape) == 0) return;
+    cytnx_uint64 last = offset;
+    for (cytnx_uint64 i = 0; i < shape.size(); i++) last += (shape[i] - 1) * strides[i];
+    cytnx_error_msg(last >= storage.size(),
+                    "[ERROR] a view reaching element %llu of a Storage of %llu elements.\n",
+                    (unsigned long long)last, (unsigned long long)storage.size());
+  }
+
+  cytnx_uint64 StorageView::size() const { return product(_shape); }
+
+  bool StorageView::is_contiguous() const {
+    cytnx_uint64 expect = 1;
+    for (cytnx_uint64 i = _shape.size(); i-- > 0;) {
+      if (_shape[i] != 1 && _strides[i] != expect) return false;
+      expect *= _shape[i];
+    }
+    return true;
+  }
+
+  StorageView StorageView::conj() const {
+    StorageView out(*this);
+    if (Type.is_complex(dtype())) out._conj = !_conj;
+    return out;
+  }
+
+  StorageView StorageView::slice(const cytnx_uint64 &axis, const cytnx_uint64 &start,
+                                 const cytnx_uint64 &stop, const cytnx_uint64 &step) const {
+    cytnx_error_msg(axis >= rank(), "[ERROR] slice of axis %llu of a rank-%llu view.\n",
+                    (unsigned long long)axis, (unsigned long long)rank());
+    cytnx_error_msg(step == 0, "[ERROR] slice with step 0.%s", "\n");
+    cytnx_error_msg(start > stop || stop > _shape[axis],
+                    "[ERROR] slice [%llu, %llu) of an axis of extent %llu.\n",
+                    (unsigned long long)start, (unsigned long long)stop,
+                    (unsigned long long)_shape[axis]);
+    StorageView out(*this);
+    out._shape[axis] = (stop - start + step - 1) / step;
+    out._strides[axis] = _strides[axis] * step;
+    if (out._shape[axis]) out._offset += start * _strides[axis];
+    return out;
+  }
+
+  StorageView StorageView::permute(const vector<cytnx_uint64> &axes) const {
+    cytnx_error_msg(axes.size() != rank(), "[ERROR] permute with %d axes of a rank-%d view.\n",
+                    (int)axes.size(), (int)rank());
+    vector<bool> seen(rank(), false);
+    StorageView out(*this);
+    for (cytnx_uint64 i = 0; i < axes.size(); i++) {
+      cytnx_error_msg(axes[i] >= rank() || seen[axes[i]],
+                      "[ERROR] permute axes %s are not a permutation.\n", join(axes).c_str());
+      seen[axes[i]] = true;
+      out._shape[i] = _shape[axes[i]];
+      out._strides[i] = _strides[axes[i]];
+    }
+    return out;
+  }
+
+  StorageView StorageView::transpose(const cytnx_uint64 &a, const cytnx_uint64 &b) const {
+    cytnx_error_msg(a >= rank() || b >= rank(),
+                    "[ERROR] transpose of axes %llu and %llu of a rank-%llu view.\n",
+                    (unsigned long long)a, (unsigned long long)b, (unsigned long long)rank());
+    vector<cytnx_uint64> axes(rank());
+    for (cytnx_uint64 i = 0; i < rank(); i++) axes[i] = i;
+    std::swap(axes[a], axes[b]);
+    return permute(axes);
+  }
+
+  StorageView StorageView::reshape(const vector<cytnx_uint64> &shape) const {
+    cytnx_error_msg(product(shape) != size(),
+                    "[ERROR] cannot reshape %llu elements to shape %s.\n",
+                    (unsigned long long)size(), join(shape).c_str());
+    StorageView out(*this);
+    out._shape = shape;
+    if (size() == 0) {
+      out._strides = row_major_strides(shape);
+      return out;
+    }
+    if (nocopy_strides(_shape, _strides, shape, out._strides)) return out;
+    CYTNX_TRACE_SCOPE("view.reshape_copy");
+    return copy_packed().reshape(shape);
+  }
+
+  StorageView StorageView::contiguous() const {
+    if (is_contiguous() && !_conj) return *this;
+    return copy_packed();
+  }
+
+  Storage StorageView::to_storage() const {
+    if (_offset == 0 && size() == _storage.size() && is_contiguous() && !_conj) return _storage;
+    return copy_packed()._storage;
+  }
+
+  const void *StorageView::data() const {
+    if (_storage.dtype() == Type.Void) return nullptr;
+    return static_cast<const char *>(_storage.data()) + _offset * Type.typeSize(dtype());
+  }
+
+  void *StorageView::mutable_data() {
+    if (is_shared() || _conj) {
+      CYTNX_TRACE_SCOPE("view.copy_on_write");
+      *this = copy_packed();
+    }
+    return const_cast<void *>(data());
+  }
+
+  string StorageView::str() const {
+    return "dtype=" + string(Type.enum_name(dtype())) + " shape=" + join(_shape) +
+           " strides=" + join(_strides) + " offset=" + to_string(_offset) + (_conj ? " conj" : "");
+  }
+
+  StorageView StorageView::copy_packed() const {
+    CYTNX_TRACE_SCOPE("view.copy_packed");
+    cytnx_error_msg(_storage.dtype() == Type.Void, "[ERROR] copy of an empty view.%s", "\n");
+    cytnx_error_msg(device() != Device.cpu,
+                    "[ERROR] copying a view of a GPU Storage is not supported.%s", "\n");
+    Storage buf(size(), dtype(), device(), false);
+    if (buf.size())
+      utils_internal::StridedCopy_cpu(buf.data(), data(), Type.typeSize(dtype()), _shape,
+                                      _strides);
+    if (_conj) conj_inplace(buf);
+    return StorageView(buf, _shape);
+  }
+
+}  // namespace cytnx_core
@@ -0,0 +1,76 @@
+#include <cytnx_core/ThreadPool.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+
+  ThreadPool::ThreadPool(int nthreads) : _running(0), _stop(false) {
+    cytnx_error_msg(nthreads < 1, "[ERROR] a ThreadPool needs at least one thread, got %d.\n",
+                    nthreads);
+    _workers.reserve(nthreads);
+    for (int i = 0; i < nthreads; i++) _workers.emplace_back([this]() { worker_loop(); });
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      lock_guard<mutex> lock(_mtx);
+      _stop = true;
+    }
+    _cv_task.notify_all();
+    for (auto &w : _workers) w.join();
+  }
+
+  ThreadPool &ThreadPool::global() {
+    static ThreadPool pool([]() {
+      if (const char *env = getenv("CYTNX_NUM_WORKERS")) {
+        int n = atoi(env);
+        if (n > 0) return n;
+      }
+      return std::max(1, Device.Ncores);
+    }());
+    return pool;
+  }
+
+  void ThreadPool::enqueue(function<void()> task) {
+    {
+      lock_guard<mutex> lock(_mtx);
+      cytnx_error_msg(_stop, "[ERROR] cannot submit to a ThreadPool that is shutting down.%s",
+                      "\n");
+      _queue.push_back(std::move(task));
+    }
+    _cv_task.notify_one();
+  }
+
+  void ThreadPool::wait_idle() {
+    unique_lock<mutex> lock(_mtx);
+    _cv_idle.wait(lock, [this]() { return _queue.empty() && _running == 0; });
+  }
+
+  void ThreadPool::worker_loop() {
+    while (true) {
+      function<void()> task;
+      {
+        unique_lock<mutex> lock(_mtx);
+        _cv_task.wait(lock, [this]() { return _stop || !_queue.empty(); });
+        if (_queue.empty()) return;  // stopping, and nothing left to do
+        task = std::move(_queue.front());
+        _queue.pop_front();
+        _running++;
+      }
+      task();
+      task = nullptr;  // release the captures before reporting idle
+      {
+        lock_guard<mutex> lock(_mtx);
+        _running--;
+        if (_queue.empty() && _running == 0) _cv_idle.notify_all();
+      }
+    }
+  }
+
+}  // namespace cytnx_core
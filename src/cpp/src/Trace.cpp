@@ -0,0 +1,274 @@
+#include <cytnx_core/Trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace trace {
+
+    std::atomic<bool> _enabled(false);
+
+    namespace {
+      static_assert((ring_capacity & (ring_capacity - 1)) == 0,
+                    "ring_capacity must be a power of two");
+
+      // written by the owning thread only; atomics so that a concurrent dump is well defined
+      struct Event {
+        std::atomic<const char *> name;
+        std::atomic<std::uint64_t> begin_ns;
+        std::atomic<std::uint64_t> end_ns;
+      };
+
+      struct ThreadBuffer {
+        std::unique_ptr<Event[]> events{new Event[ring_capacity]};
+        std::atomic<std::uint64_t> head{0};  // the number of spans recorded so far
+        std::atomic<std::uint64_t> first{0};  // spans before this one were cleared
+        int tid = 0;
+      };
+
+      struct Snapshot {
+        int tid;
+        const char *name;
+        std::uint64_t begin_ns, end_ns;
+      };
+
+      // the buffer of a finished thread goes back to a free list for the next new thread; its
+      // spans move to `retired`, which keeps the most recent ring_capacity of them over all
+      // finished (e.g. OpenMP or Python) threads, so that thread churn does not grow memory
+      struct Registry {
+        mutex mtx;
+        vector<shared_ptr<ThreadBuffer>> buffers;
+        vector<ThreadBuffer *> free;
+        deque<Snapshot> retired;
+      };
+
+      Registry &registry() {
+        // never destroyed: threads may still record during static destruction
+        static Registry *r = new Registry;
+        return *r;
+      }
+
+      void snapshot(const ThreadBuffer &b, vector<Snapshot> &out);
+
+      // trivially destructible: a thread_local with a destructor costs a guard on every access
+      thread_local ThreadBuffer *t_buffer = nullptr;
+      thread_local bool t_released = false;
+
+      void release_thread() {
+        if (t_buffer == nullptr) return;
+        ThreadBuffer *b = t_buffer;
+        t_buffer = nullptr;
+        t_released = true;  // spans recorded by later thread_local destructors are dropped
+        vector<Snapshot> spans;
+        snapshot(*b, spans);
+        Registry &r = registry();
+        lock_guard<mutex> lock(r.mtx);
+        r.retired.insert(r.retired.end(), spans.begin(), spans.end());
+        if (r.retired.size() > ring_capacity)
+          r.retired.erase(r.retired.begin(), r.retired.end() - ring_capacity);
+        b->first.store(b->head.load(memory_order_relaxed), memory_order_relaxed);
+        r.free.push_back(b);
+      }
+
+      // constructed on the first span of a thread only, so the fast path never touches it
+      struct Releaser {
+        ~Releaser() { release_thread(); }
+      };
+
+      ThreadBuffer *register_thread() {
+        static thread_local Releaser releaser;
+        Registry &r = registry();
+        lock_guard<mutex> lock(r.mtx);
+        if (!r.free.empty()) {
+          ThreadBuffer *b = r.free.back();
+          r.free.pop_back();
+          return b;
+        }
+        auto b = make_shared<ThreadBuffer>();
+        b->tid = r.buffers.size();
+        r.buffers.push_back(b);
+        return b.get();
+      }
+
+      ThreadBuffer *local_buffer() {
+        if (t_buffer == nullptr && !t_released) t_buffer = register_thread();
+        return t_buffer;
+      }
+
+      // the spans held by b; slots overwritten while copying are dropped
+      void snapshot(const ThreadBuffer &b, vector<Snapshot> &out) {
+        const std::uint64_t head = b.head.load(memory_order_acquire);
+        std::uint64_t first = std::max(b.first.load(memory_order_relaxed),
+                                       head > ring_capacity ? head - ring_capacity : 0);
+        const size_t start = out.size();
+        for (std::uint64_t i = first; i < head; i++) {
+          const Event &e = b.events[i & (ring_capacity - 1)];
+          out.push_back(Snapshot{b.tid, e.name.load(memory_order_relaxed),
+                                 e.begin_ns.load(memory_order_relaxed),
+                                 e.end_ns.load(memory_order_relaxed)});
+        }
+        // the slot of span h is rewritten while span h + ring_capacity is recorded
+        const std::uint64_t now = b.head.load(memory_order_acquire);
+        if (now + 1 > first + ring_capacity) {
+          const std::uint64_t valid = now + 1 - ring_capacity;
+          const size_t drop = std::min<std::uint64_t>(valid - first, head - first);
+          out.erase(out.begin() + start, out.begin() + start + drop);
+        }
+      }
+
+      void append_json_string(string &out, const char *s) {
+        out += '"';
+        for (; *s; s++) {
+          const char c = *s;
+          if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+          } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+          } else {
+            out += c;
+          }
+        }
+        out += '"';
+      }
+
+      // CYTNX_TRACE=<path>: trace the whole run
+      struct EnvTrace {
+        string path;
+        EnvTrace() {
+          const char *env = getenv("CYTNX_TRACE");
+          if (env == nullptr || env[0] == '\0') return;
+          path = env;
+          enable();
+          atexit([]() {
+            try {
+              dump_chrome(env_trace().path);
+            } catch (const std::exception &e) {
+              fprintf(stderr, "%s\n", e.what());
+            }
+          });
+        }
+        static EnvTrace &env_trace();
+      };
+      EnvTrace &EnvTrace::env_trace() {
+        static EnvTrace t;
+        return t;
+      }
+      const EnvTrace &env_trace_init = EnvTrace::env_trace();
+    }  // namespace
+
+    bool compiled() {
+#ifdef UNI_TRACE
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    void enable(const bool &on) { _enabled.store(on, memory_order_relaxed); }
+    void disable() { enable(false); }
+    bool enabled() { return _enabled.load(memory_order_relaxed); }
+
+    std::uint64_t now_ns() {
+      static const auto epoch = chrono::steady_clock::now();
+      return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch)
+        .count();
+    }
+
+    void record(const char *name, const std::uint64_t &begin_ns, const std::uint64_t &end_ns) {
+      ThreadBuffer *buffer = local_buffer();
+      if (buffer == nullptr) return;
+      ThreadBuffer &b = *buffer;
+      const std::uint64_t h = b.head.load(memory_order_relaxed);
+      Event &e = b.events[h & (ring_capacity - 1)];
+      e.name.store(name, memory_order_relaxed);
+      e.begin_ns.store(begin_ns, memory_order_relaxed);
+      e.end_ns.store(end_ns, memory_order_relaxed);
+      b.head.store(h + 1, memory_order_release);
+    }
+
+    void clear() {
+      Registry &r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      for (auto &b : r.buffers) b->first.store(b->head.load(memory_order_acquire));
+      r.retired.clear();
+    }
+
+    std::uint64_t num_events() {
+      Registry &r = registry();
+      lock_guard<mutex> lock(r.mtx);
+      std::uint64_t total = r.retired.size();
+      for (auto &b : r.buffers) {
+        const std::uint64_t head = b->head.load(memory_order_acquire);
+        const std::uint64_t first = b->first.load(memory_order_relaxed);
+        total += std::min<std::uint64_t>(head - std::min(first, head), ring_capacity);
+      }
+      return total;
+    }
+
+    string chrome_json() {
+      vector<shared_ptr<ThreadBuffer>> buffers;
+      vector<Snapshot> spans;
+      {
+        Registry &r = registry();
+        lock_guard<mutex> lock(r.mtx);
+        buffers = r.buffers;
+        spans.assign(r.retired.begin(), r.retired.end());
+      }
+      for (auto &b : buffers) snapshot(*b, spans);
+
+      const int pid = getpid();
+      string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+      char buf[128];
+      bool first = true;
+      for (auto &b : buffers) {
+        snprintf(buf, sizeof(buf),
+                 "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                 "\"args\":{\"name\":\"thread %d\"}}",
+                 first ? "" : ",", pid, b->tid, b->tid);
+        out += buf;
+        first = false;
+      }
+      for (const auto &s : spans) {
+        if (s.name == nullptr) continue;
+        out += first ? "\n{\"name\":" : ",\n{\"name\":";
+        first = false;
+        append_json_string(out, s.name);
+        // the category is the prefix before the first '.'
+        const char *dot = strchr(s.name, '.');
+        out += ",\"cat\":";
+        append_json_string(out, dot ? string(s.name, dot).c_str() : "cytnx");
+        snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                 s.begin_ns * 1e-3, (s.end_ns - s.begin_ns) * 1e-3, pid, s.tid);
+        out += buf;
+      }
+      out += "\n]}\n";
+      return out;
+    }
+
+    void dump_chrome(const string &path) {
+      const string json = chrome_json();
+      ofstream f(path, ios::binary | ios::trunc);
+      cytnx_system_error_msg(!f, "[ERROR][trace] cannot open %s for writing.\n", path.c_str());
+      f.write(json.data(), json.size());
+      f.close();
+      cytnx_system_error_msg(!f, "[ERROR][trace] cannot write %s.\n", path.c_str());
+    }
+
+  }  // namespace trace
+}  // namespace cytnx_core
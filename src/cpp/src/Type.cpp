@@ -49,7 +49,7 @@ namespace cytnx_core {
 
     auto i = std::find(c_typenames.begin(), c_typenames.end(), c_name);
     if (i == c_typenames.end()) {
-      cytnx_error_msg(true, "[ERROR] typename is not a cytnx type: %s", c_name.c_str());
+      cytnx_input_error_msg(true, "[ERROR] typename is not a cytnx type: %s", c_name.c_str());
       return 0;
     }
     return i - c_typenames.begin();
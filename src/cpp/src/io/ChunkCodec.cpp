@@ -0,0 +1,66 @@
+#include "io/ChunkCodec.hpp"
+
+#include "io/FileUtils.hpp"
+#include "utils_internal/cpu/Compress_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace io {
+    namespace internal {
+
+      void encode_chunk(EncodedChunk &out, const char *src, const cytnx_uint64 &len,
+                        const cytnx_uint64 &elem_bytes, const bool &shuffle,
+                        const bool &compress) {
+        out.ptr = src;
+        out.bytes = len;
+        out.codec = codec_raw;
+        if (!compress) return;
+
+        const char *input = src;
+        thread_local vector<char> shuffled;
+        if (shuffle) {
+          shuffled.resize(len);
+          utils_internal::Shuffle_cpu(shuffled.data(), src, len, elem_bytes);
+          input = shuffled.data();
+        }
+        // only keep the compressed form if it is smaller
+        out.buf.resize(len);
+        cytnx_uint64 stored = utils_internal::LzCompress_cpu(out.buf.data(), len, input, len);
+        if (stored == 0) {
+          vector<char>().swap(out.buf);
+          return;
+        }
+        out.buf.resize(stored);
+        out.ptr = out.buf.data();
+        out.bytes = stored;
+        out.codec = codec_lz;
+      }
+
+      bool read_chunk(int fd, const string &path, const cytnx_uint64 &offset,
+                      const cytnx_uint64 &stored_bytes, const cytnx_uint32 &codec, char *dst,
+                      const cytnx_uint64 &raw_bytes, const cytnx_uint64 &elem_bytes,
+                      const bool &shuffle) {
+        if (codec == codec_raw) {
+          if (stored_bytes != raw_bytes) return false;
+          read_all(fd, dst, raw_bytes, offset, path);
+          return true;
+        }
+        if (codec != codec_lz) return false;
+        thread_local vector<char> stored, shuffled;
+        stored.resize(stored_bytes);
+        read_all(fd, stored.data(), stored_bytes, offset, path);
+        char *target = dst;
+        if (shuffle) {
+          shuffled.resize(raw_bytes);
+          target = shuffled.data();
+        }
+        if (!utils_internal::LzDecompress_cpu(target, raw_bytes, stored.data(), stored_bytes))
+          return false;
+        if (shuffle) utils_internal::Unshuffle_cpu(dst, target, raw_bytes, elem_bytes);
+        return true;
+      }
+
+    }  // namespace internal
+  }  // namespace io
+}  // namespace cytnx_core
@@ -0,0 +1,45 @@
+#ifndef CYTNX_IO_CHUNKCODEC_H_
+#define CYTNX_IO_CHUNKCODEC_H_
+
+#include <string>
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+
+// the chunk encoding shared by tensor streams and delta checkpoints
+namespace cytnx_core {
+  namespace io {
+    namespace internal {
+
+      const cytnx_uint32 codec_raw = 0;
+      const cytnx_uint32 codec_lz = 1;
+
+      // a chunk as stored: either compressed into buf, or pointing at the raw source bytes
+      struct EncodedChunk {
+        std::vector<char> buf;
+        const char *ptr;
+        cytnx_uint64 bytes;
+        cytnx_uint32 codec;
+      };
+
+      /**
+       * @brief encode len raw bytes: byte-shuffle by elem_bytes (if shuffle) and LZ-compress
+       * (if compress), falling back to the raw bytes when that does not shrink them.
+       */
+      void encode_chunk(EncodedChunk &out, const char *src, const cytnx_uint64 &len,
+                        const cytnx_uint64 &elem_bytes, const bool &shuffle, const bool &compress);
+
+      /**
+       * @brief read a stored chunk from fd at offset and decode it into dst.
+       * @return false if the stored bytes are malformed
+       */
+      bool read_chunk(int fd, const std::string &path, const cytnx_uint64 &offset,
+                      const cytnx_uint64 &stored_bytes, const cytnx_uint32 &codec, char *dst,
+                      const cytnx_uint64 &raw_bytes, const cytnx_uint64 &elem_bytes,
+                      const bool &shuffle);
+
+    }  // namespace internal
+  }  // namespace io
+}  // namespace cytnx_core
+
+#endif  // CYTNX_IO_CHUNKCODEC_H_
@@ -0,0 +1,536 @@
+#include <cytnx_core/io/DeltaCheckpoint.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#include "io/ChunkCodec.hpp"
+#include "io/FileUtils.hpp"
+#include "utils_internal/cpu/Blocking_cpu.hpp"
+#include "utils_internal/cpu/Checksum_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace io {
+
+    using namespace internal;
+
+    namespace {
+      const char delta_magic[8] = {'C', 'Y', 'T', 'N', 'X', 'D', 'L', '\0'};
+      const cytnx_uint32 delta_version = 1;
+      const cytnx_uint64 file_header_bytes = 32;
+      const cytnx_uint64 record_header_bytes = 24;
+      const cytnx_uint64 max_meta_bytes = 1ULL << 20;
+      const cytnx_uint64 max_chunk_bytes = 1ULL << 30;
+
+      // record types; a record is a header, then meta bytes, then data bytes
+      enum RecordType : cytnx_uint32 {
+        record_meta = 1,  // name, dtype, ndim, size, shape
+        record_chunk = 2,  // name, chunk index, content hash, codec; data: the stored bytes
+        record_remove = 3,  // name
+        record_commit = 4,  // epoch
+      };
+
+      void put_name(vector<char> &buf, const string &name) {
+        put<cytnx_uint32>(buf, name.size());
+        buf.insert(buf.end(), name.begin(), name.end());
+      }
+
+      bool get_name(const char *&p, const char *end, string &name) {
+        if (end - p < 4) return false;
+        cytnx_uint32 len = get<cytnx_uint32>(p);
+        if (static_cast<cytnx_uint64>(end - p) < len) return false;
+        name.assign(p, len);
+        p += len;
+        return true;
+      }
+
+      // elements per chunk; chunks always hold whole elements
+      cytnx_uint64 chunk_elems(const cytnx_uint64 &chunk_bytes, const unsigned int &dtype) {
+        return utils_internal::BlockElems(chunk_bytes, Type.typeSize(dtype));
+      }
+
+      cytnx_uint64 num_chunks(const cytnx_uint64 &size, const cytnx_uint64 &elems) {
+        return (size + elems - 1) / elems;
+      }
+
+      // appends records at the end of the log, tracking the write position
+      struct RecordWriter {
+        int fd;
+        const string &path;
+        cytnx_uint64 pos;
+
+        // returns the offset of the data bytes
+        cytnx_uint64 append(RecordType type, const vector<char> &meta, const char *data = nullptr,
+                            cytnx_uint64 data_bytes = 0) {
+          vector<char> rec;
+          rec.reserve(record_header_bytes + meta.size());
+          put<cytnx_uint32>(rec, type);
+          put<cytnx_uint32>(rec, meta.size());
+          put<cytnx_uint64>(rec, data_bytes);
+          cytnx_uint32 crc = utils_internal::Crc32c_cpu(rec.data(), rec.size());
+          crc = utils_internal::Crc32c_cpu(meta.data(), meta.size(), crc);
+          put<cytnx_uint32>(rec, crc);
+          put<cytnx_uint32>(rec, 0);
+          rec.insert(rec.end(), meta.begin(), meta.end());
+          write_all(fd, rec.data(), rec.size(), path);
+          pos += rec.size();
+          cytnx_uint64 data_offset = pos;
+          if (data_bytes > 0) write_all(fd, data, data_bytes, path);
+          pos += data_bytes;
+          return data_offset;
+        }
+      };
+
+      vector<char> meta_record(const string &name, const DeltaCheckpoint::BufferState &b) {
+        vector<char> meta;
+        put_name(meta, name);
+        put<cytnx_uint32>(meta, b.dtype);
+        put<cytnx_uint32>(meta, b.shape.size());
+        put<cytnx_uint64>(meta, b.size);
+        for (auto d : b.shape) put<cytnx_uint64>(meta, d);
+        return meta;
+      }
+
+      vector<char> chunk_record(const string &name, const cytnx_uint64 &index,
+                                const DeltaCheckpoint::ChunkRecord &c) {
+        vector<char> meta;
+        put_name(meta, name);
+        put<cytnx_uint64>(meta, index);
+        put<cytnx_uint64>(meta, c.hash);
+        put<cytnx_uint32>(meta, c.codec);
+        return meta;
+      }
+
+      vector<char> commit_record(const cytnx_uint64 &epoch) {
+        vector<char> meta;
+        put<cytnx_uint64>(meta, epoch);
+        return meta;
+      }
+
+      void sync(int fd, const string &path) {
+        cytnx_system_error_msg(fdatasync(fd) != 0, "[ERROR][io] cannot sync %s: %s\n", path.c_str(),
+                               strerror(errno));
+      }
+    }  // namespace
+
+    DeltaCheckpoint::DeltaCheckpoint(const string &path, const cytnx_uint64 &chunk_bytes,
+                                     const double &compact_ratio)
+        : _path(path),
+          _fd(-1),
+          _chunk_bytes(chunk_bytes),
+          _compact_ratio(compact_ratio),
+          _epoch(0),
+          _log_bytes(0) {
+      cytnx_error_msg(chunk_bytes == 0 || chunk_bytes > max_chunk_bytes,
+                      "[ERROR][io] chunk_bytes must be in [1, %llu].\n",
+                      (unsigned long long)max_chunk_bytes);
+      FileDescriptor file(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644));
+      cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot open %s: %s\n", path.c_str(),
+                             strerror(errno));
+      // a log has a single writer
+      cytnx_system_error_msg(flock(file.fd, LOCK_EX | LOCK_NB) != 0,
+                             "[ERROR][io] %s is in use by another DeltaCheckpoint.\n",
+                             path.c_str());
+      _fd = file.fd;
+      file.fd = -1;
+      try {
+        replay();
+      } catch (...) {
+        close(_fd);
+        throw;
+      }
+    }
+
+    DeltaCheckpoint::~DeltaCheckpoint() {
+      if (_fd >= 0) close(_fd);
+    }
+
+    void DeltaCheckpoint::replay() {
+      struct stat st;
+      cytnx_system_error_msg(fstat(_fd, &st) != 0, "[ERROR][io] cannot stat %s: %s\n",
+                             _path.c_str(), strerror(errno));
+      const cytnx_uint64 file_bytes = st.st_size;
+
+      if (file_bytes < file_header_bytes) {
+        // a new (or empty) log
+        vector<char> header;
+        header.insert(header.end(), delta_magic, delta_magic + 8);
+        put<cytnx_uint32>(header, delta_version);
+        put<cytnx_uint32>(header, endian_marker);
+        put<cytnx_uint64>(header, _chunk_bytes);
+        put<cytnx_uint32>(header, 0);
+        put<cytnx_uint32>(header, utils_internal::Crc32c_cpu(header.data(), header.size()));
+        cytnx_system_error_msg(ftruncate(_fd, 0) != 0, "[ERROR][io] cannot truncate %s: %s\n",
+                               _path.c_str(), strerror(errno));
+        cytnx_system_error_msg(lseek(_fd, 0, SEEK_SET) != 0, "[ERROR][io] cannot seek %s: %s\n",
+                               _path.c_str(), strerror(errno));
+        write_all(_fd, header.data(), header.size(), _path);
+        sync(_fd, _path);
+        // the log may have just been created
+        sync_dir(_path);
+        _log_bytes = file_header_bytes;
+        return;
+      }
+
+      vector<char> header(file_header_bytes);
+      read_all(_fd, header.data(), file_header_bytes, 0, _path);
+      cytnx_system_error_msg(memcmp(header.data(), delta_magic, 8) != 0,
+                             "[ERROR][io] %s is not a delta checkpoint log.\n", _path.c_str());
+      const char *p = header.data() + 8;
+      cytnx_uint32 version = get<cytnx_uint32>(p);
+      cytnx_system_error_msg(get<cytnx_uint32>(p) != endian_marker,
+                             "[ERROR][io] %s was written on a machine of different byte order.\n",
+                             _path.c_str());
+      cytnx_system_error_msg(version == 0 || version > delta_version,
+                             "[ERROR][io] %s has format version %u, this build reads up to %u.\n",
+                             _path.c_str(), version, delta_version);
+      _chunk_bytes = get<cytnx_uint64>(p);
+      get<cytnx_uint32>(p);
+      const cytnx_uint32 header_crc = get<cytnx_uint32>(p);
+      cytnx_system_error_msg(header_crc != utils_internal::Crc32c_cpu(header.data(), 28) ||
+                               _chunk_bytes == 0 || _chunk_bytes > max_chunk_bytes,
+                             "[ERROR][io] %s has a corrupted header.\n", _path.c_str());
+
+      // apply the records to a pending state, which becomes current at each commit record
+      map<string, BufferState> pending;
+      cytnx_uint64 pos = file_header_bytes, committed_end = pos;
+      vector<char> rec(record_header_bytes), meta;
+      while (pos + record_header_bytes <= file_bytes) {
+        read_all(_fd, rec.data(), record_header_bytes, pos, _path);
+        const char *q = rec.data();
+        cytnx_uint32 type = get<cytnx_uint32>(q);
+        cytnx_uint32 meta_bytes = get<cytnx_uint32>(q);
+        cytnx_uint64 data_bytes = get<cytnx_uint64>(q);
+        cytnx_uint32 crc = get<cytnx_uint32>(q);
+        if (meta_bytes > max_meta_bytes || data_bytes > file_bytes ||
+            pos + record_header_bytes + meta_bytes + data_bytes > file_bytes)
+          break;  // torn tail
+        meta.resize(meta_bytes);
+        read_all(_fd, meta.data(), meta_bytes, pos + record_header_bytes, _path);
+        if (crc != utils_internal::Crc32c_cpu(meta.data(), meta_bytes,
+                                              utils_internal::Crc32c_cpu(rec.data(), 16)))
+          break;
+
+        const char *m = meta.data(), *mend = meta.data() + meta_bytes;
+        const cytnx_uint64 data_offset = pos + record_header_bytes + meta_bytes;
+        string name;
+        bool ok = true;
+        if (type == record_meta) {
+          ok = get_name(m, mend, name) && mend - m >= 16;
+          if (ok) {
+            unsigned int dtype = get<cytnx_uint32>(m);
+            cytnx_uint32 ndim = get<cytnx_uint32>(m);
+            cytnx_uint64 size = get<cytnx_uint64>(m);
+            ok = dtype != Type.Void && dtype < N_Type &&
+                 static_cast<cytnx_uint64>(mend - m) == 8ULL * ndim;
+            if (ok) {
+              BufferState &b = pending[name];
+              if (b.chunks.empty() || b.dtype != dtype || b.size != size)
+                b.chunks.assign(num_chunks(size, chunk_elems(_chunk_bytes, dtype)), ChunkRecord{});
+              b.dtype = dtype;
+              b.size = size;
+              b.shape.resize(ndim);
+              for (auto &d : b.shape) d = get<cytnx_uint64>(m);
+            }
+          }
+        } else if (type == record_chunk) {
+          ok = get_name(m, mend, name) && mend - m == 20 && pending.count(name);
+          if (ok) {
+            cytnx_uint64 index = get<cytnx_uint64>(m);
+            BufferState &b = pending[name];
+            ok = index < b.chunks.size();
+            if (ok) {
+              ChunkRecord &c = b.chunks[index];
+              c.hash = get<cytnx_uint64>(m);
+              c.codec = get<cytnx_uint32>(m);
+              c.offset = data_offset;
+              c.stored_bytes = data_bytes;
+            }
+          }
+        } else if (type == record_remove) {
+          ok = get_name(m, mend, name);
+          if (ok) pending.erase(name);
+        } else if (type == record_commit) {
+          ok = meta_bytes == 8;
+          if (ok) {
+            _epoch = get<cytnx_uint64>(m);
+            _state = pending;
+            committed_end = data_offset + data_bytes;
+          }
+        } else {
+          ok = false;
+        }
+        if (!ok) break;
+        pos = data_offset + data_bytes;
+      }
+
+      // drop whatever follows the last complete commit
+      if (committed_end < file_bytes) {
+        cytnx_warning_msg(true, "[WARNING][io] %s: discarding %llu bytes after the last commit.\n",
+                          _path.c_str(), (unsigned long long)(file_bytes - committed_end));
+        cytnx_system_error_msg(ftruncate(_fd, committed_end) != 0,
+                               "[ERROR][io] cannot truncate %s: %s\n", _path.c_str(),
+                               strerror(errno));
+      }
+      _log_bytes = committed_end;
+    }
+
+    void DeltaCheckpoint::stage(const string &name, const Storage &data,
+                                const vector<cytnx_uint64> &shape) {
+      cytnx_error_msg(data.device() != Device.cpu,
+                      "[ERROR][io] only CPU Storages can be checkpointed, got %s.\n",
+                      data.device_str().c_str());
+      cytnx_error_msg(data.dtype() == Type.Void, "[ERROR][io] cannot checkpoint a Void Storage.%s",
+                      "\n");
+      cytnx_error_msg(name.empty(), "[ERROR][io] buffer names cannot be empty.%s", "\n");
+      lock_guard<mutex> lock(_mtx);
+      _staged[name] = Staged{data, checked_shape(shape, data.size()), false};
+    }
+
+    void DeltaCheckpoint::remove(const string &name) {
+      lock_guard<mutex> lock(_mtx);
+      _staged[name] = Staged{Storage(), {}, true};
+    }
+
+    cytnx_uint64 DeltaCheckpoint::commit() {
+      CYTNX_TRACE_SCOPE("io.checkpoint_commit");
+      lock_guard<mutex> lock(_mtx);
+      const cytnx_uint64 start = _log_bytes;
+      cytnx_system_error_msg(lseek(_fd, start, SEEK_SET) != (off_t)start,
+                             "[ERROR][io] cannot seek %s: %s\n", _path.c_str(), strerror(errno));
+      RecordWriter writer{_fd, _path, start};
+      map<string, BufferState> next = _state;
+      const int threads = std::max(1, Device.Ncores);
+      try {
+        for (const auto &kv : _staged) {
+          const string &name = kv.first;
+          const Staged &st = kv.second;
+          if (st.removed) {
+            if (next.erase(name)) {
+              vector<char> meta;
+              put_name(meta, name);
+              writer.append(record_remove, meta);
+            }
+            continue;
+          }
+
+          const unsigned int dtype = st.storage.dtype();
+          const cytnx_uint64 elem_bytes = Type.typeSize(dtype);
+          const cytnx_uint64 elems = chunk_elems(_chunk_bytes, dtype);
+          const cytnx_uint64 nchunks = num_chunks(st.storage.size(), elems);
+          auto it = next.find(name);
+          const bool relayout =
+            it == next.end() || it->second.dtype != dtype || it->second.size != st.storage.size();
+          BufferState &b = next[name];
+          if (relayout || b.shape != st.shape) {
+            if (relayout) b.chunks.assign(nchunks, ChunkRecord{});
+            b.dtype = dtype;
+            b.size = st.storage.size();
+            b.shape = st.shape;
+            writer.append(record_meta, meta_record(name, b));
+          }
+
+          // find the chunks whose content changed since the last commit
+          const char *src = static_cast<const char *>(st.storage.data());
+          const cytnx_uint64 nbytes = st.storage.nbytes();
+          vector<cytnx_uint64> hashes(nchunks);
+#pragma omp parallel for schedule(static) num_threads(threads)
+          for (cytnx_int64 i = 0; i < (cytnx_int64)nchunks; i++) {
+            const cytnx_uint64 begin = i * elems * elem_bytes;
+            hashes[i] = utils_internal::Hash64_cpu(
+              src + begin, std::min(elems * elem_bytes, nbytes - begin));
+          }
+          vector<cytnx_uint64> dirty;
+          for (cytnx_uint64 i = 0; i < nchunks; i++)
+            if (b.chunks[i].offset == 0 || b.chunks[i].hash != hashes[i]) dirty.push_back(i);
+
+          // encode the dirty chunks in parallel batches and append them in order
+          const cytnx_uint64 batch_chunks = 2 * threads;
+          for (cytnx_uint64 first = 0; first < dirty.size(); first += batch_chunks) {
+            const cytnx_uint64 count = std::min<cytnx_uint64>(batch_chunks, dirty.size() - first);
+            vector<EncodedChunk> batch(count);
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+            for (cytnx_int64 j = 0; j < (cytnx_int64)count; j++) {
+              const cytnx_uint64 begin = dirty[first + j] * elems * elem_bytes;
+              encode_chunk(batch[j], src + begin, std::min(elems * elem_bytes, nbytes - begin),
+                           elem_bytes, true, true);
+            }
+            for (cytnx_uint64 j = 0; j < count; j++) {
+              const cytnx_uint64 i = dirty[first + j];
+              ChunkRecord c{hashes[i], 0, batch[j].bytes, batch[j].codec};
+              c.offset = writer.append(record_chunk, chunk_record(name, i, c), batch[j].ptr,
+                                       batch[j].bytes);
+              b.chunks[i] = c;
+            }
+          }
+        }
+        // the data must be durable before the commit record that makes it visible
+        sync(_fd, _path);
+        writer.append(record_commit, commit_record(_epoch + 1));
+        sync(_fd, _path);
+      } catch (...) {
+        // roll back to the last commit
+        if (ftruncate(_fd, start) != 0) {
+          cytnx_warning_msg(true, "[WARNING][io] cannot roll back %s: %s\n", _path.c_str(),
+                            strerror(errno));
+        }
+        throw;
+      }
+
+      _state = std::move(next);
+      _epoch++;
+      _log_bytes = writer.pos;
+      _staged.clear();
+      const cytnx_uint64 appended = _log_bytes - start;
+      if (_compact_ratio > 0 &&
+          _log_bytes > _compact_ratio * std::max<cytnx_uint64>(live_bytes_locked(), _chunk_bytes)) {
+        // the commit is durable already; a failed compaction leaves the log valid and is
+        // retried at the next commit
+        try {
+          compact_locked();
+        } catch (const std::exception &e) {
+          cytnx_warning_msg(true, "[WARNING][io] cannot compact %s, deferred: %s\n",
+                            _path.c_str(), e.what());
+        }
+      }
+      return appended;
+    }
+
+    map<string, LoadedTensor> DeltaCheckpoint::restore() const {
+      CYTNX_TRACE_SCOPE("io.checkpoint_restore");
+      lock_guard<mutex> lock(_mtx);
+      map<string, LoadedTensor> out;
+      // every (buffer, chunk) of the last commit, read in parallel
+      vector<pair<const string *, cytnx_uint64>> tasks;
+      for (const auto &kv : _state) {
+        const BufferState &b = kv.second;
+        LoadedTensor &t = out[kv.first];
+        t.storage = Storage(b.size, b.dtype, Device.cpu, false);
+        t.shape = b.shape;
+        for (cytnx_uint64 i = 0; i < b.chunks.size(); i++) tasks.emplace_back(&kv.first, i);
+      }
+      exception_ptr error;
+      mutex error_mtx;
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(1, Device.Ncores))
+      for (cytnx_int64 k = 0; k < (cytnx_int64)tasks.size(); k++) {
+        // exceptions must not leave the parallel region
+        try {
+          const string &name = *tasks[k].first;
+          const cytnx_uint64 i = tasks[k].second;
+          const BufferState &b = _state.at(name);
+          const ChunkRecord &c = b.chunks[i];
+          const cytnx_uint64 elem_bytes = Type.typeSize(b.dtype);
+          const cytnx_uint64 elems = chunk_elems(_chunk_bytes, b.dtype);
+          const cytnx_uint64 raw_bytes = std::min(elems, b.size - i * elems) * elem_bytes;
+          char *dst = static_cast<char *>(out.at(name).storage.data()) + i * elems * elem_bytes;
+          cytnx_system_error_msg(c.offset == 0,
+                                 "[ERROR][io] %s: chunk %llu of %s was never written.\n",
+                                 _path.c_str(), (unsigned long long)i, name.c_str());
+          bool ok = read_chunk(_fd, _path, c.offset, c.stored_bytes, c.codec, dst, raw_bytes,
+                               elem_bytes, true);
+          cytnx_system_error_msg(!ok || utils_internal::Hash64_cpu(dst, raw_bytes) != c.hash,
+                                 "[ERROR][io] %s: chunk %llu of %s is corrupted.\n", _path.c_str(),
+                                 (unsigned long long)i, name.c_str());
+        } catch (...) {
+          lock_guard<mutex> lock(error_mtx);
+          if (!error) error = current_exception();
+        }
+      }
+      if (error) rethrow_exception(error);
+      return out;
+    }
+
+    void DeltaCheckpoint::compact() {
+      lock_guard<mutex> lock(_mtx);
+      compact_locked();
+    }
+
+    void DeltaCheckpoint::compact_locked() {
+      CYTNX_TRACE_SCOPE("io.checkpoint_compact");
+      string tmp = _path + ".tmp" + to_string(getpid());
+      FileDescriptor file(open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+      cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot create %s: %s\n", tmp.c_str(),
+                             strerror(errno));
+      map<string, BufferState> next = _state;
+      cytnx_uint64 end = 0;
+      try {
+        // the file header is copied as is
+        vector<char> header(file_header_bytes);
+        read_all(_fd, header.data(), file_header_bytes, 0, _path);
+        write_all(file.fd, header.data(), header.size(), tmp);
+        RecordWriter writer{file.fd, tmp, file_header_bytes};
+        vector<char> data;
+        for (auto &kv : next) {
+          writer.append(record_meta, meta_record(kv.first, kv.second));
+          for (cytnx_uint64 i = 0; i < kv.second.chunks.size(); i++) {
+            ChunkRecord &c = kv.second.chunks[i];
+            data.resize(c.stored_bytes);
+            read_all(_fd, data.data(), c.stored_bytes, c.offset, _path);
+            c.offset = writer.append(record_chunk, chunk_record(kv.first, i, c), data.data(),
+                                     c.stored_bytes);
+          }
+        }
+        writer.append(record_commit, commit_record(_epoch));
+        sync(file.fd, tmp);
+        cytnx_system_error_msg(flock(file.fd, LOCK_EX | LOCK_NB) != 0,
+                               "[ERROR][io] cannot lock %s.\n", tmp.c_str());
+        cytnx_system_error_msg(rename(tmp.c_str(), _path.c_str()) != 0,
+                               "[ERROR][io] cannot rename %s to %s: %s\n", tmp.c_str(),
+                               _path.c_str(), strerror(errno));
+        end = writer.pos;
+      } catch (...) {
+        unlink(tmp.c_str());
+        throw;
+      }
+      close(_fd);
+      _fd = file.fd;
+      file.fd = -1;
+      _state = std::move(next);
+      _log_bytes = end;
+      // until the rename is durable, a crash brings back the old log, without the commits
+      // appended from now on
+      sync_dir(_path);
+    }
+
+    cytnx_uint64 DeltaCheckpoint::epoch() const {
+      lock_guard<mutex> lock(_mtx);
+      return _epoch;
+    }
+
+    cytnx_uint64 DeltaCheckpoint::log_bytes() const {
+      lock_guard<mutex> lock(_mtx);
+      return _log_bytes;
+    }
+
+    cytnx_uint64 DeltaCheckpoint::live_bytes() const {
+      lock_guard<mutex> lock(_mtx);
+      return live_bytes_locked();
+    }
+
+    cytnx_uint64 DeltaCheckpoint::live_bytes_locked() const {
+      cytnx_uint64 total = 0;
+      for (const auto &kv : _state)
+        for (const auto &c : kv.second.chunks) total += c.stored_bytes;
+      return total;
+    }
+
+    vector<string> DeltaCheckpoint::names() const {
+      lock_guard<mutex> lock(_mtx);
+      vector<string> out;
+      for (const auto &kv : _state) out.push_back(kv.first);
+      return out;
+    }
+
+  }  // namespace io
+}  // namespace cytnx_core
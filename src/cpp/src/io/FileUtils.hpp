@@ -0,0 +1,128 @@
+#ifndef CYTNX_IO_FILEUTILS_H_
+#define CYTNX_IO_FILEUTILS_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/Type.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+// helpers shared by the file formats in cytnx_core/io
+namespace cytnx_core {
+  namespace io {
+    namespace internal {
+
+      // written in the byte order of the writer; reads back differently on the other order
+      const cytnx_uint32 endian_marker = 0x01020304u;
+
+      template <class T>
+      void put(std::vector<char> &buf, const T &val) {
+        const char *p = reinterpret_cast<const char *>(&val);
+        buf.insert(buf.end(), p, p + sizeof(T));
+      }
+
+      template <class T>
+      T get(const char *&p) {
+        T val;
+        std::memcpy(&val, p, sizeof(T));
+        p += sizeof(T);
+        return val;
+      }
+
+      // closes the descriptor on every exit path
+      struct FileDescriptor {
+        int fd;
+        explicit FileDescriptor(int fd) : fd(fd) {}
+        ~FileDescriptor() {
+          if (fd >= 0) close(fd);
+        }
+        FileDescriptor(const FileDescriptor &) = delete;
+        FileDescriptor &operator=(const FileDescriptor &) = delete;
+      };
+
+      inline void write_all(int fd, const char *p, cytnx_uint64 n, const std::string &path) {
+        while (n > 0) {
+          ssize_t w = write(fd, p, std::min<cytnx_uint64>(n, 1ULL << 30));
+          if (w < 0 && errno == EINTR) continue;
+          cytnx_system_error_msg(w < 0, "[ERROR][io] cannot write %s: %s\n", path.c_str(),
+                                 strerror(errno));
+          p += w;
+          n -= w;
+        }
+      }
+
+      inline void read_all(int fd, char *p, cytnx_uint64 n, cytnx_uint64 offset,
+                           const std::string &path) {
+        while (n > 0) {
+          ssize_t r = pread(fd, p, n, offset);
+          if (r < 0 && errno == EINTR) continue;
+          cytnx_system_error_msg(r < 0, "[ERROR][io] cannot read %s: %s\n", path.c_str(),
+                                 strerror(errno));
+          cytnx_system_error_msg(r == 0, "[ERROR][io] %s is truncated.\n", path.c_str());
+          p += r;
+          n -= r;
+          offset += r;
+        }
+      }
+
+      /**
+       * @brief Sync the directory holding path, so that a file created or renamed there
+       * survives a crash under that name.
+       */
+      inline void sync_dir(const std::string &path) {
+        CYTNX_TRACE_SCOPE("io.sync_dir");
+        const size_t slash = path.rfind('/');
+        const std::string dir =
+          slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        FileDescriptor d(open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        cytnx_system_error_msg(d.fd < 0, "[ERROR][io] cannot open %s: %s\n", dir.c_str(),
+                               strerror(errno));
+        // a file system that cannot sync a directory reports EINVAL
+        cytnx_system_error_msg(fsync(d.fd) != 0 && errno != EINVAL,
+                               "[ERROR][io] cannot sync %s: %s\n", dir.c_str(), strerror(errno));
+      }
+
+      /**
+       * @brief Replace path by the temporary file tmp, written through file, which is closed.
+       *
+       * The file is synced before the rename and its directory after it, so that after a crash
+       * or power loss path holds either its old content or the whole new file.
+       */
+      inline void commit_file(FileDescriptor &file, const std::string &tmp,
+                              const std::string &path) {
+        int fd = file.fd;
+        file.fd = -1;
+        const bool synced = fsync(fd) == 0;
+        const int sync_errno = errno;
+        const bool closed = close(fd) == 0;
+        cytnx_system_error_msg(!synced || !closed, "[ERROR][io] cannot write %s: %s\n",
+                               tmp.c_str(), strerror(synced ? errno : sync_errno));
+        cytnx_system_error_msg(rename(tmp.c_str(), path.c_str()) != 0,
+                               "[ERROR][io] cannot rename %s to %s: %s\n", tmp.c_str(),
+                               path.c_str(), strerror(errno));
+        sync_dir(path);
+      }
+
+      // the product of the shape, or {size} for an empty shape, checked against size
+      inline std::vector<cytnx_uint64> checked_shape(const std::vector<cytnx_uint64> &shape,
+                                                     const cytnx_uint64 &size) {
+        std::vector<cytnx_uint64> dims = shape.empty() ? std::vector<cytnx_uint64>{size} : shape;
+        cytnx_uint64 prod = 1;
+        for (auto d : dims) prod *= d;
+        cytnx_error_msg(prod != size,
+                        "[ERROR][io] the shape has %llu elements but the Storage has %llu.\n",
+                        (unsigned long long)prod, (unsigned long long)size);
+        return dims;
+      }
+
+    }  // namespace internal
+  }  // namespace io
+}  // namespace cytnx_core
+
+#endif  // CYTNX_IO_FILEUTILS_H_
@@ -0,0 +1,225 @@
+#include <cytnx_core/io/TensorFile.hpp>
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#include "io/FileUtils.hpp"
+#include "utils_internal/cpu/Checksum_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace io {
+
+    using namespace internal;
+
+    namespace {
+      const char tensor_file_magic[8] = {'C', 'Y', 'T', 'N', 'X', 'T', 'F', '\0'};
+      const cytnx_uint64 fixed_header_bytes = 56;
+      const cytnx_uint64 payload_alignment = 64;
+      const cytnx_uint32 max_ndim = 64;
+
+      cytnx_uint64 num_chunks(const cytnx_uint64 &nbytes, const cytnx_uint64 &chunk_bytes) {
+        return (nbytes + chunk_bytes - 1) / chunk_bytes;
+      }
+
+      vector<cytnx_uint32> chunk_checksums(const char *payload, const cytnx_uint64 &nbytes,
+                                           const cytnx_uint64 &chunk_bytes) {
+        vector<cytnx_uint32> out(num_chunks(nbytes, chunk_bytes));
+#pragma omp parallel for schedule(dynamic)
+        for (cytnx_int64 i = 0; i < (cytnx_int64)out.size(); i++) {
+          cytnx_uint64 begin = i * chunk_bytes;
+          cytnx_uint64 len = std::min(chunk_bytes, nbytes - begin);
+          out[i] = utils_internal::Crc32c_cpu(payload + begin, len);
+        }
+        return out;
+      }
+
+      TensorFileInfo read_header(int fd, const string &path, const cytnx_uint64 &file_bytes) {
+        cytnx_system_error_msg(file_bytes < fixed_header_bytes,
+                               "[ERROR][io] %s is not a tensor file (too short).\n", path.c_str());
+        vector<char> head(fixed_header_bytes);
+        read_all(fd, head.data(), fixed_header_bytes, 0, path);
+        cytnx_system_error_msg(memcmp(head.data(), tensor_file_magic, 8) != 0,
+                               "[ERROR][io] %s is not a tensor file (bad magic).\n", path.c_str());
+
+        TensorFileInfo info;
+        const char *p = head.data() + 8;
+        info.version = get<cytnx_uint32>(p);
+        cytnx_uint32 marker = get<cytnx_uint32>(p);
+        cytnx_system_error_msg(marker != endian_marker,
+                               "[ERROR][io] %s was written on a machine of different byte order.\n",
+                               path.c_str());
+        cytnx_system_error_msg(info.version == 0 || info.version > tensor_file_version,
+                               "[ERROR][io] %s has format version %u, this build reads up to %u.\n",
+                               path.c_str(), info.version, tensor_file_version);
+        info.dtype = get<cytnx_uint32>(p);
+        cytnx_uint32 ndim = get<cytnx_uint32>(p);
+        info.size = get<cytnx_uint64>(p);
+        info.chunk_bytes = get<cytnx_uint64>(p);
+        cytnx_uint64 nchunks = get<cytnx_uint64>(p);
+        info.payload_offset = get<cytnx_uint64>(p);
+
+        cytnx_system_error_msg(info.dtype == Type.Void || info.dtype >= N_Type,
+                               "[ERROR][io] %s has an invalid dtype id %u.\n", path.c_str(),
+                               info.dtype);
+        cytnx_system_error_msg(ndim > max_ndim || info.chunk_bytes == 0,
+                               "[ERROR][io] %s has a corrupted header.\n", path.c_str());
+        const cytnx_uint64 nbytes = info.size * Type.typeSize(info.dtype);
+        cytnx_system_error_msg(nchunks != num_chunks(nbytes, info.chunk_bytes),
+                               "[ERROR][io] %s has a corrupted header.\n", path.c_str());
+
+        const cytnx_uint64 header_bytes = fixed_header_bytes + 8 * ndim + 4 * nchunks + 4;
+        cytnx_system_error_msg(header_bytes > info.payload_offset ||
+                                 info.payload_offset % payload_alignment != 0 ||
+                                 info.payload_offset + nbytes > file_bytes,
+                               "[ERROR][io] %s is truncated or has a corrupted header.\n",
+                               path.c_str());
+        head.resize(header_bytes);
+        read_all(fd, head.data() + fixed_header_bytes, header_bytes - fixed_header_bytes,
+                 fixed_header_bytes, path);
+
+        p = head.data() + fixed_header_bytes;
+        info.shape.resize(ndim);
+        for (auto &d : info.shape) d = get<cytnx_uint64>(p);
+        info.checksums.resize(nchunks);
+        for (auto &c : info.checksums) c = get<cytnx_uint32>(p);
+        cytnx_uint32 header_crc = get<cytnx_uint32>(p);
+        cytnx_system_error_msg(
+          header_crc != utils_internal::Crc32c_cpu(head.data(), header_bytes - 4),
+          "[ERROR][io] %s has a corrupted header (checksum mismatch).\n", path.c_str());
+
+        cytnx_uint64 prod = 1;
+        for (auto d : info.shape) prod *= d;
+        cytnx_system_error_msg(prod != info.size,
+                               "[ERROR][io] %s: shape does not match the size.\n", path.c_str());
+        return info;
+      }
+
+      // map the whole file privately; the Storage owns the mapping
+      LoadedTensor map_file(const string &path, TensorFileInfo &info) {
+        FileDescriptor file(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot open %s: %s\n", path.c_str(),
+                               strerror(errno));
+        struct stat st;
+        cytnx_system_error_msg(fstat(file.fd, &st) != 0, "[ERROR][io] cannot stat %s: %s\n",
+                               path.c_str(), strerror(errno));
+        const cytnx_uint64 file_bytes = st.st_size;
+        info = read_header(file.fd, path, file_bytes);
+
+        LoadedTensor out;
+        out.shape = info.shape;
+        if (info.size == 0) {
+          out.storage = Storage::from_external(nullptr, 0, info.dtype, Device.cpu, nullptr);
+          return out;
+        }
+        void *base = mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, file.fd, 0);
+        cytnx_system_error_msg(base == MAP_FAILED, "[ERROR][io] cannot map %s: %s\n", path.c_str(),
+                               strerror(errno));
+        shared_ptr<void> owner(base, [file_bytes](void *p) { munmap(p, file_bytes); });
+        out.storage = Storage::from_external(static_cast<char *>(base) + info.payload_offset,
+                                             info.size, info.dtype, Device.cpu, std::move(owner));
+        return out;
+      }
+
+      vector<cytnx_uint64> bad_chunks(const LoadedTensor &t, const TensorFileInfo &info) {
+        vector<cytnx_uint32> sums = chunk_checksums(static_cast<const char *>(t.storage.data()),
+                                                    t.storage.nbytes(), info.chunk_bytes);
+        vector<cytnx_uint64> out;
+        for (cytnx_uint64 i = 0; i < sums.size(); i++)
+          if (sums[i] != info.checksums[i]) out.push_back(i);
+        return out;
+      }
+    }  // namespace
+
+    void save_tensor_file(const string &path, const Storage &data,
+                          const vector<cytnx_uint64> &shape, const cytnx_uint64 &chunk_bytes) {
+      CYTNX_TRACE_SCOPE("io.save_tensor_file");
+      cytnx_error_msg(data.device() != Device.cpu,
+                      "[ERROR][io] only CPU Storages can be saved, got %s.\n",
+                      data.device_str().c_str());
+      cytnx_error_msg(data.dtype() == Type.Void, "[ERROR][io] cannot save a Void Storage.%s",
+                      "\n");
+      cytnx_error_msg(chunk_bytes == 0, "[ERROR][io] chunk_bytes must be positive.%s", "\n");
+      vector<cytnx_uint64> dims = checked_shape(shape, data.size());
+      cytnx_error_msg(dims.size() > max_ndim, "[ERROR][io] at most %u dimensions are supported.\n",
+                      max_ndim);
+
+      const char *payload = static_cast<const char *>(data.data());
+      const cytnx_uint64 nbytes = data.nbytes();
+      vector<cytnx_uint32> sums = chunk_checksums(payload, nbytes, chunk_bytes);
+
+      vector<char> header;
+      header.insert(header.end(), tensor_file_magic, tensor_file_magic + 8);
+      put<cytnx_uint32>(header, tensor_file_version);
+      put<cytnx_uint32>(header, endian_marker);
+      put<cytnx_uint32>(header, data.dtype());
+      put<cytnx_uint32>(header, dims.size());
+      put<cytnx_uint64>(header, data.size());
+      put<cytnx_uint64>(header, chunk_bytes);
+      put<cytnx_uint64>(header, sums.size());
+      const cytnx_uint64 header_bytes = fixed_header_bytes + 8 * dims.size() + 4 * sums.size() + 4;
+      const cytnx_uint64 payload_offset =
+        (header_bytes + payload_alignment - 1) / payload_alignment * payload_alignment;
+      put<cytnx_uint64>(header, payload_offset);
+      for (auto d : dims) put<cytnx_uint64>(header, d);
+      for (auto c : sums) put<cytnx_uint32>(header, c);
+      put<cytnx_uint32>(header, utils_internal::Crc32c_cpu(header.data(), header.size()));
+      header.resize(payload_offset, '\0');
+
+      // write a temporary file, sync it and rename it, so a crash never leaves a partial file
+      // behind
+      string tmp = path + ".tmp" + to_string(getpid());
+      try {
+        FileDescriptor file(open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+        cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot create %s: %s\n", tmp.c_str(),
+                               strerror(errno));
+        write_all(file.fd, header.data(), header.size(), tmp);
+        write_all(file.fd, payload, nbytes, tmp);
+        commit_file(file, tmp, path);
+      } catch (...) {
+        unlink(tmp.c_str());
+        throw;
+      }
+    }
+
+    TensorFileInfo tensor_file_info(const string &path) {
+      FileDescriptor file(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+      cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot open %s: %s\n", path.c_str(),
+                             strerror(errno));
+      struct stat st;
+      cytnx_system_error_msg(fstat(file.fd, &st) != 0, "[ERROR][io] cannot stat %s: %s\n",
+                             path.c_str(), strerror(errno));
+      return read_header(file.fd, path, st.st_size);
+    }
+
+    LoadedTensor load_tensor_file(const string &path, const bool &verify) {
+      CYTNX_TRACE_SCOPE("io.load_tensor_file");
+      TensorFileInfo info;
+      LoadedTensor out = map_file(path, info);
+      if (verify) {
+        vector<cytnx_uint64> bad = bad_chunks(out, info);
+        cytnx_system_error_msg(!bad.empty(),
+                               "[ERROR][io] %s is corrupted: %llu chunk(s) fail the checksum, "
+                               "the first at byte %llu of the payload.\n",
+                               path.c_str(), (unsigned long long)bad.size(),
+                               (unsigned long long)(bad[0] * info.chunk_bytes));
+      }
+      return out;
+    }
+
+    vector<cytnx_uint64> verify_tensor_file(const string &path) {
+      CYTNX_TRACE_SCOPE("io.verify_tensor_file");
+      TensorFileInfo info;
+      LoadedTensor t = map_file(path, info);
+      return bad_chunks(t, info);
+    }
+
+  }  // namespace io
+}  // namespace cytnx_core
@@ -0,0 +1,361 @@
+#include <cytnx_core/io/TensorStream.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#include "io/ChunkCodec.hpp"
+#include "io/FileUtils.hpp"
+#include "utils_internal/cpu/Checksum_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace io {
+
+    using namespace internal;
+
+    namespace {
+      const char stream_magic[8] = {'C', 'Y', 'T', 'N', 'X', 'T', 'S', '\0'};
+      const char stream_end_magic[8] = {'C', 'Y', 'T', 'N', 'X', 'T', 'S', 'E'};
+      const cytnx_uint64 fixed_header_bytes = 48;
+      const cytnx_uint64 index_entry_bytes = 24;
+      const cytnx_uint64 footer_bytes = 32;
+      const cytnx_uint64 max_chunk_bytes = 1ULL << 30;
+      const cytnx_uint32 max_ndim = 64;
+      const cytnx_uint32 flag_shuffle = 1;
+
+      int resolve_threads(const int &threads) {
+        return threads > 0 ? threads : std::max(1, Device.Ncores);
+      }
+
+      struct StoredChunk {
+        EncodedChunk data;
+        cytnx_uint32 checksum;  // of the raw bytes
+      };
+
+      // the compressed batches waiting for the writer thread; push() blocks when it is full
+      class BatchQueue {
+       public:
+        explicit BatchQueue(size_t capacity) : _capacity(capacity), _closed(false) {}
+
+        void push(vector<StoredChunk> &&batch) {
+          unique_lock<mutex> lock(_mtx);
+          _cv_space.wait(lock, [this]() { return _closed || _queue.size() < _capacity; });
+          if (_closed) return;
+          _queue.push_back(std::move(batch));
+          _cv_data.notify_one();
+        }
+
+        // false once the queue is closed and drained
+        bool pop(vector<StoredChunk> &batch) {
+          unique_lock<mutex> lock(_mtx);
+          _cv_data.wait(lock, [this]() { return _closed || !_queue.empty(); });
+          if (_queue.empty()) return false;
+          batch = std::move(_queue.front());
+          _queue.pop_front();
+          _cv_space.notify_one();
+          return true;
+        }
+
+        void close() {
+          lock_guard<mutex> lock(_mtx);
+          _closed = true;
+          _cv_data.notify_all();
+          _cv_space.notify_all();
+        }
+
+        bool closed() {
+          lock_guard<mutex> lock(_mtx);
+          return _closed;
+        }
+
+       private:
+        size_t _capacity;
+        bool _closed;
+        deque<vector<StoredChunk>> _queue;
+        mutex _mtx;
+        condition_variable _cv_data, _cv_space;
+      };
+
+      // closes the queue and joins the writer thread on every exit path, so that an exception
+      // thrown while compressing never destroys a joinable std::thread (std::terminate)
+      struct WriterJoin {
+        BatchQueue &queue;
+        thread &writer;
+        ~WriterJoin() {
+          queue.close();
+          if (writer.joinable()) writer.join();
+        }
+      };
+    }  // namespace
+
+    void save_tensor_stream(const string &path, const Storage &data,
+                            const vector<cytnx_uint64> &shape, const StreamOptions &options) {
+      CYTNX_TRACE_SCOPE("io.save_tensor_stream");
+      cytnx_error_msg(data.device() != Device.cpu,
+                      "[ERROR][io] only CPU Storages can be saved, got %s.\n",
+                      data.device_str().c_str());
+      cytnx_error_msg(data.dtype() == Type.Void, "[ERROR][io] cannot save a Void Storage.%s",
+                      "\n");
+      cytnx_error_msg(options.chunk_bytes == 0 || options.chunk_bytes > max_chunk_bytes,
+                      "[ERROR][io] chunk_bytes must be in [1, %llu].\n",
+                      (unsigned long long)max_chunk_bytes);
+      vector<cytnx_uint64> dims = checked_shape(shape, data.size());
+      cytnx_error_msg(dims.size() > max_ndim, "[ERROR][io] at most %u dimensions are supported.\n",
+                      max_ndim);
+
+      const cytnx_uint64 elem_bytes = Type.typeSize(data.dtype());
+      const cytnx_uint64 chunk_bytes =
+        std::max(elem_bytes, options.chunk_bytes / elem_bytes * elem_bytes);
+      const cytnx_uint64 nbytes = data.nbytes();
+      const cytnx_uint64 nchunks = (nbytes + chunk_bytes - 1) / chunk_bytes;
+      const char *payload = static_cast<const char *>(data.data());
+      const int threads = resolve_threads(options.threads);
+
+      vector<char> header;
+      header.insert(header.end(), stream_magic, stream_magic + 8);
+      put<cytnx_uint32>(header, tensor_stream_version);
+      put<cytnx_uint32>(header, endian_marker);
+      put<cytnx_uint32>(header, data.dtype());
+      put<cytnx_uint32>(header, dims.size());
+      put<cytnx_uint64>(header, data.size());
+      put<cytnx_uint64>(header, chunk_bytes);
+      put<cytnx_uint32>(header, options.shuffle ? flag_shuffle : 0);
+      put<cytnx_uint32>(header, 0);
+      for (auto d : dims) put<cytnx_uint64>(header, d);
+      put<cytnx_uint32>(header, utils_internal::Crc32c_cpu(header.data(), header.size()));
+
+      // write a temporary file, sync it and rename it, so a crash never leaves a partial file
+      // behind
+      string tmp = path + ".tmp" + to_string(getpid());
+      try {
+        FileDescriptor file(open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+        cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot create %s: %s\n", tmp.c_str(),
+                               strerror(errno));
+        write_all(file.fd, header.data(), header.size(), tmp);
+
+        // the writer thread writes batch k while the workers compress batch k + 1
+        vector<char> index;
+        index.reserve(nchunks * index_entry_bytes);
+        cytnx_uint64 offset = header.size();
+        exception_ptr write_error;
+        BatchQueue queue(2);
+        thread writer([&]() {
+          vector<StoredChunk> batch;
+          while (queue.pop(batch)) {
+            try {
+              for (const auto &c : batch) {
+                write_all(file.fd, c.data.ptr, c.data.bytes, tmp);
+                put<cytnx_uint64>(index, offset);
+                put<cytnx_uint64>(index, c.data.bytes);
+                put<cytnx_uint32>(index, c.checksum);
+                put<cytnx_uint32>(index, c.data.codec);
+                offset += c.data.bytes;
+              }
+            } catch (...) {
+              write_error = current_exception();
+              queue.close();
+              return;
+            }
+          }
+        });
+        WriterJoin join{queue, writer};
+
+        const cytnx_uint64 batch_chunks = 2 * threads;
+        for (cytnx_uint64 first = 0; first < nchunks && !queue.closed(); first += batch_chunks) {
+          const cytnx_uint64 count = std::min(batch_chunks, nchunks - first);
+          vector<StoredChunk> batch(count);
+          exception_ptr encode_error;
+          mutex error_mtx;
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+          for (cytnx_int64 j = 0; j < (cytnx_int64)count; j++) {
+            // exceptions must not leave the parallel region
+            try {
+              const cytnx_uint64 begin = (first + j) * chunk_bytes;
+              const cytnx_uint64 len = std::min(chunk_bytes, nbytes - begin);
+              batch[j].checksum = utils_internal::Crc32c_cpu(payload + begin, len);
+              encode_chunk(batch[j].data, payload + begin, len, elem_bytes, options.shuffle,
+                           options.compress);
+            } catch (...) {
+              lock_guard<mutex> lock(error_mtx);
+              if (!encode_error) encode_error = current_exception();
+            }
+          }
+          if (encode_error) rethrow_exception(encode_error);
+          queue.push(std::move(batch));
+        }
+        queue.close();
+        writer.join();
+        if (write_error) rethrow_exception(write_error);
+
+        vector<char> footer;
+        put<cytnx_uint64>(footer, offset);
+        put<cytnx_uint64>(footer, nchunks);
+        put<cytnx_uint32>(footer, utils_internal::Crc32c_cpu(index.data(), index.size()));
+        put<cytnx_uint32>(footer, 0);
+        footer.insert(footer.end(), stream_end_magic, stream_end_magic + 8);
+        write_all(file.fd, index.data(), index.size(), tmp);
+        write_all(file.fd, footer.data(), footer.size(), tmp);
+        commit_file(file, tmp, path);
+      } catch (...) {
+        unlink(tmp.c_str());
+        throw;
+      }
+    }
+
+    TensorStreamReader::TensorStreamReader(const string &path) : _path(path), _fd(-1) {
+      FileDescriptor file(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+      cytnx_system_error_msg(file.fd < 0, "[ERROR][io] cannot open %s: %s\n", path.c_str(),
+                             strerror(errno));
+      struct stat st;
+      cytnx_system_error_msg(fstat(file.fd, &st) != 0, "[ERROR][io] cannot stat %s: %s\n",
+                             path.c_str(), strerror(errno));
+      const cytnx_uint64 file_bytes = st.st_size;
+      cytnx_system_error_msg(file_bytes < fixed_header_bytes + footer_bytes,
+                             "[ERROR][io] %s is not a tensor stream (too short).\n", path.c_str());
+
+      vector<char> head(fixed_header_bytes);
+      read_all(file.fd, head.data(), fixed_header_bytes, 0, path);
+      cytnx_system_error_msg(memcmp(head.data(), stream_magic, 8) != 0,
+                             "[ERROR][io] %s is not a tensor stream (bad magic).\n", path.c_str());
+      const char *p = head.data() + 8;
+      cytnx_uint32 version = get<cytnx_uint32>(p);
+      cytnx_system_error_msg(get<cytnx_uint32>(p) != endian_marker,
+                             "[ERROR][io] %s was written on a machine of different byte order.\n",
+                             path.c_str());
+      cytnx_system_error_msg(version == 0 || version > tensor_stream_version,
+                             "[ERROR][io] %s has format version %u, this build reads up to %u.\n",
+                             path.c_str(), version, tensor_stream_version);
+      _dtype = get<cytnx_uint32>(p);
+      cytnx_uint32 ndim = get<cytnx_uint32>(p);
+      _size = get<cytnx_uint64>(p);
+      _chunk_bytes = get<cytnx_uint64>(p);
+      _shuffle = get<cytnx_uint32>(p) & flag_shuffle;
+      cytnx_system_error_msg(_dtype == Type.Void || _dtype >= N_Type || ndim > max_ndim ||
+                               _chunk_bytes == 0 || _chunk_bytes > max_chunk_bytes ||
+                               _chunk_bytes % Type.typeSize(_dtype) != 0,
+                             "[ERROR][io] %s has a corrupted header.\n", path.c_str());
+
+      const cytnx_uint64 header_bytes = fixed_header_bytes + 8 * ndim + 4;
+      cytnx_system_error_msg(header_bytes + footer_bytes > file_bytes,
+                             "[ERROR][io] %s is truncated.\n", path.c_str());
+      head.resize(header_bytes);
+      read_all(file.fd, head.data() + fixed_header_bytes, header_bytes - fixed_header_bytes,
+               fixed_header_bytes, path);
+      p = head.data() + fixed_header_bytes;
+      _shape.resize(ndim);
+      for (auto &d : _shape) d = get<cytnx_uint64>(p);
+      const cytnx_uint32 header_crc = get<cytnx_uint32>(p);
+      cytnx_system_error_msg(
+        header_crc != utils_internal::Crc32c_cpu(head.data(), header_bytes - 4),
+        "[ERROR][io] %s has a corrupted header (checksum mismatch).\n", path.c_str());
+      cytnx_uint64 prod = 1;
+      for (auto d : _shape) prod *= d;
+      cytnx_system_error_msg(prod != _size, "[ERROR][io] %s: shape does not match the size.\n",
+                             path.c_str());
+
+      vector<char> footer(footer_bytes);
+      read_all(file.fd, footer.data(), footer_bytes, file_bytes - footer_bytes, path);
+      cytnx_system_error_msg(memcmp(footer.data() + 24, stream_end_magic, 8) != 0,
+                             "[ERROR][io] %s is truncated (no index).\n", path.c_str());
+      p = footer.data();
+      const cytnx_uint64 index_offset = get<cytnx_uint64>(p);
+      const cytnx_uint64 nchunks = get<cytnx_uint64>(p);
+      const cytnx_uint32 index_crc = get<cytnx_uint32>(p);
+      const cytnx_uint64 nbytes = _size * Type.typeSize(_dtype);
+      const cytnx_uint64 index_end = index_offset + nchunks * index_entry_bytes + footer_bytes;
+      cytnx_system_error_msg(nchunks != (nbytes + _chunk_bytes - 1) / _chunk_bytes ||
+                               index_offset < header_bytes || index_end != file_bytes,
+                             "[ERROR][io] %s has a corrupted index.\n", path.c_str());
+
+      vector<char> index(nchunks * index_entry_bytes);
+      read_all(file.fd, index.data(), index.size(), index_offset, path);
+      cytnx_system_error_msg(index_crc != utils_internal::Crc32c_cpu(index.data(), index.size()),
+                             "[ERROR][io] %s has a corrupted index (checksum mismatch).\n",
+                             path.c_str());
+      p = index.data();
+      _chunks.resize(nchunks);
+      for (auto &c : _chunks) {
+        c.offset = get<cytnx_uint64>(p);
+        c.stored_bytes = get<cytnx_uint64>(p);
+        c.checksum = get<cytnx_uint32>(p);
+        c.codec = get<cytnx_uint32>(p);
+        cytnx_system_error_msg(c.offset < header_bytes ||
+                                 c.offset + c.stored_bytes > index_offset || c.codec > codec_lz,
+                               "[ERROR][io] %s has a corrupted index.\n", path.c_str());
+      }
+      _fd = file.fd;
+      file.fd = -1;
+    }
+
+    TensorStreamReader::~TensorStreamReader() {
+      if (_fd >= 0) close(_fd);
+    }
+
+    cytnx_uint64 TensorStreamReader::chunk_begin(const cytnx_uint64 &i) const {
+      return i * (_chunk_bytes / Type.typeSize(_dtype));
+    }
+
+    cytnx_uint64 TensorStreamReader::chunk_size(const cytnx_uint64 &i) const {
+      cytnx_error_msg(i >= _chunks.size(), "[ERROR][io] chunk %llu out of range [0, %llu).\n",
+                      (unsigned long long)i, (unsigned long long)_chunks.size());
+      return std::min(_chunk_bytes / Type.typeSize(_dtype), _size - chunk_begin(i));
+    }
+
+    void TensorStreamReader::read_chunk(const cytnx_uint64 &i, void *out) const {
+      CYTNX_TRACE_SCOPE("io.read_stream_chunk");
+      const cytnx_uint64 elem_bytes = Type.typeSize(_dtype);
+      const cytnx_uint64 raw_bytes = chunk_size(i) * elem_bytes;
+      const StreamChunk &c = _chunks[i];
+      char *dst = static_cast<char *>(out);
+      const bool ok = internal::read_chunk(_fd, _path, c.offset, c.stored_bytes, c.codec, dst,
+                                           raw_bytes, elem_bytes, _shuffle);
+      cytnx_system_error_msg(!ok, "[ERROR][io] %s: chunk %llu is corrupted.\n", _path.c_str(),
+                             (unsigned long long)i);
+      cytnx_system_error_msg(utils_internal::Crc32c_cpu(dst, raw_bytes) != c.checksum,
+                             "[ERROR][io] %s: chunk %llu fails the checksum.\n", _path.c_str(),
+                             (unsigned long long)i);
+    }
+
+    Storage TensorStreamReader::read_chunk(const cytnx_uint64 &i) const {
+      Storage out(chunk_size(i), _dtype, Device.cpu, false);
+      read_chunk(i, out.data());
+      return out;
+    }
+
+    // threads is only read by the OpenMP pragma
+    Storage TensorStreamReader::read([[maybe_unused]] const int &threads) const {
+      CYTNX_TRACE_SCOPE("io.read_stream");
+      Storage out(_size, _dtype, Device.cpu, false);
+      char *dst = static_cast<char *>(out.data());
+      const cytnx_uint64 elem_bytes = Type.typeSize(_dtype);
+      exception_ptr error;
+      mutex error_mtx;
+#pragma omp parallel for schedule(dynamic) num_threads(resolve_threads(threads))
+      for (cytnx_int64 i = 0; i < (cytnx_int64)_chunks.size(); i++) {
+        // exceptions must not leave the parallel region
+        try {
+          read_chunk(i, dst + chunk_begin(i) * elem_bytes);
+        } catch (...) {
+          lock_guard<mutex> lock(error_mtx);
+          if (!error) error = current_exception();
+        }
+      }
+      if (error) rethrow_exception(error);
+      return out;
+    }
+
+  }  // namespace io
+}  // namespace cytnx_core
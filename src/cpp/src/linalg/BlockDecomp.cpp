@@ -0,0 +1,99 @@
+#include <cytnx_core/linalg.hpp>
+
+#include <algorithm>
+
+#include <cytnx_core/Counters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/BlockDecomp_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace linalg {
+
+    namespace {
+      // the blocks must be matrices of one dtype, so that their values can be compared
+      void check_blocks(const vector<StorageView> &blocks, const bool &square, const char *name) {
+        for (cytnx_uint64 b = 0; b < blocks.size(); b++) {
+          const StorageView &x = blocks[b];
+          cytnx_error_msg(x.rank() != 2 || (square && x.shape()[0] != x.shape()[1]),
+                          "[ERROR] %s of a block %llu of rank %d, expect a%s matrix.\n", name,
+                          (unsigned long long)b, (int)x.rank(), square ? " square" : "");
+          cytnx_error_msg(x.dtype() != blocks[0].dtype(),
+                          "[ERROR] %s of blocks of %s and %s, expect a single dtype.\n", name,
+                          Type.enum_name(blocks[0].dtype()), Type.enum_name(x.dtype()));
+        }
+      }
+
+      vector<vector<StorageView>> block_svd(const vector<StorageView> &blocks,
+                                            const bool &is_UvT, const char *name) {
+        check_blocks(blocks, false, name);
+        const char job = is_UvT ? 'S' : 'N';
+        vector<double> costs(blocks.size());
+        for (cytnx_uint64 b = 0; b < blocks.size(); b++)
+          costs[b] =
+            counters::gesvd_flops(job, job, double(blocks[b].shape()[0]), blocks[b].shape()[1]);
+        vector<vector<StorageView>> out(blocks.size());
+        utils_internal::run_blocks(
+          costs, [&](const cytnx_uint64 &b) { out[b] = Svd(blocks[b], is_UvT); }, Device.Ncores);
+        return out;
+      }
+
+      template <class R>
+      vector<cytnx_uint64> keep_counts(const vector<vector<StorageView>> &svds,
+                                       const cytnx_uint64 &keepdim, const double &err) {
+        vector<const R *> values(svds.size());
+        vector<cytnx_uint64> sizes(svds.size());
+        R largest = 0;
+        for (cytnx_uint64 b = 0; b < svds.size(); b++) {
+          values[b] = static_cast<const R *>(svds[b][0].data());
+          sizes[b] = svds[b][0].size();
+          if (sizes[b]) largest = std::max(largest, values[b][0]);
+        }
+        // err = 0 keeps zero singular values too
+        const R cutoff = err > 0 ? R(err * largest) : R(-1);
+        return utils_internal::truncate_blocks<R>(values, sizes, keepdim, cutoff, Device.Ncores);
+      }
+    }  // namespace
+
+    vector<vector<StorageView>> BlockSvd(const vector<StorageView> &blocks, const bool &is_UvT) {
+      CYTNX_TRACE_SCOPE("linalg.block_svd");
+      return block_svd(blocks, is_UvT, "BlockSvd");
+    }
+
+    vector<vector<StorageView>> BlockSvdTruncate(const vector<StorageView> &blocks,
+                                                 const cytnx_uint64 &keepdim, const double &err,
+                                                 const bool &is_UvT) {
+      CYTNX_TRACE_SCOPE("linalg.block_svd");
+      cytnx_error_msg(err < 0, "[ERROR] BlockSvdTruncate with err %g, expect >= 0.\n", err);
+      vector<vector<StorageView>> out = block_svd(blocks, is_UvT, "BlockSvdTruncate");
+      if (out.empty()) return out;
+      const vector<cytnx_uint64> kept = out[0][0].dtype() == Type.Double
+                                          ? keep_counts<cytnx_double>(out, keepdim, err)
+                                          : keep_counts<cytnx_float>(out, keepdim, err);
+      for (cytnx_uint64 b = 0; b < out.size(); b++) {
+        out[b][0] = out[b][0].slice(0, 0, kept[b]);
+        if (!is_UvT) continue;
+        out[b][1] = out[b][1].slice(1, 0, kept[b]);
+        out[b][2] = out[b][2].slice(0, 0, kept[b]);
+      }
+      return out;
+    }
+
+    vector<vector<StorageView>> BlockEigh(const vector<StorageView> &blocks, const bool &is_V,
+                                          const bool &row_v) {
+      CYTNX_TRACE_SCOPE("linalg.block_eigh");
+      check_blocks(blocks, true, "BlockEigh");
+      vector<double> costs(blocks.size());
+      for (cytnx_uint64 b = 0; b < blocks.size(); b++)
+        costs[b] = counters::syevd_flops(is_V ? 'V' : 'N', double(blocks[b].shape()[0]));
+      vector<vector<StorageView>> out(blocks.size());
+      utils_internal::run_blocks(
+        costs, [&](const cytnx_uint64 &b) { out[b] = Eigh(blocks[b], is_V, row_v); },
+        Device.Ncores);
+      return out;
+    }
+
+  }  // namespace linalg
+}  // namespace cytnx_core
@@ -0,0 +1,106 @@
+#include <cytnx_core/linalg.hpp>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Eigh_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace linalg {
+
+    namespace {
+      using utils_internal::EighDriver;
+      using utils_internal::EighRange;
+
+      vector<StorageView> eigh(const StorageView &a, const EighRange &range, const bool &is_V,
+                               const bool &row_v, const char *name) {
+        const unsigned int dtype = a.dtype();
+        cytnx_error_msg(dtype != Type.Double && dtype != Type.Float &&
+                          dtype != Type.ComplexDouble && dtype != Type.ComplexFloat,
+                        "[ERROR] %s of %s, expect Double, Float, ComplexDouble or ComplexFloat.\n",
+                        name, Type.enum_name(dtype));
+        cytnx_error_msg(a.device() != Device.cpu, "[ERROR] %s of a GPU view is not supported.\n",
+                        name);
+        cytnx_error_msg(a.rank() != 2 || a.shape()[0] != a.shape()[1],
+                        "[ERROR] %s of a view of rank %d, expect a square matrix.\n", name,
+                        (int)a.rank());
+        const cytnx_uint64 n = a.shape()[0];
+        cytnx_error_msg(range.range == 'I' && cytnx_uint64(range.iu) > n,
+                        "[ERROR] %s of eigenpairs up to %llu of a %llux%llu matrix.\n", name,
+                        (unsigned long long)range.iu, (unsigned long long)n,
+                        (unsigned long long)n);
+
+        // LAPACK destroys its input: a private row-major copy, which it reads as column-major,
+        // so it sees a^T = conj(a) and reads its upper triangle, the lower one of a
+        Storage buf = a.contiguous().to_storage();
+        if (buf.use_count() > 1) buf = buf.clone();
+        const bool real = dtype == Type.Double || dtype == Type.Float;
+        const unsigned int real_dtype = dtype == Type.ComplexDouble  ? Type.Double
+                                        : dtype == Type.ComplexFloat ? Type.Float
+                                                                     : dtype;
+        Storage w(n, real_dtype, Device.cpu, false), z;
+        const EighDriver driver = utils_internal::eigh_driver(blas_int(n), range, is_V);
+        if (is_V && driver == EighDriver::Mrrr)
+          z = Storage(n * (range.range == 'I' ? cytnx_uint64(range.iu - range.il) : n), dtype,
+                      Device.cpu, false);
+
+        utils_internal::EighResult res{driver, 0, 0};
+        const auto run = [&](auto *tag) {
+          using T = std::remove_pointer_t<decltype(tag)>;
+          using R = utils_internal::eigh_real_t<T>;
+          res = utils_internal::Eigh_cpu<T>(buf.data<T>(), blas_int(n), range, is_V,
+                                            w.data<R>(), z.size() ? z.data<T>() : nullptr,
+                                            driver);
+        };
+        if (dtype == Type.Double)
+          run((cytnx_double *)nullptr);
+        else if (dtype == Type.Float)
+          run((cytnx_float *)nullptr);
+        else if (dtype == Type.ComplexDouble)
+          run((cytnx_complex128 *)nullptr);
+        else
+          run((cytnx_complex64 *)nullptr);
+
+        const cytnx_uint64 first = res.first, k = res.count;
+        vector<StorageView> out = {StorageView(w, first, {k}, {1})};
+        if (!is_V) return out;
+        // the column-major n x k eigenvectors of conj(a) are the rows of a row-major k x n view
+        StorageView v(res.driver == EighDriver::Mrrr ? z : buf, first * n, {k, n}, {n, 1});
+        if (!real) v = v.conj();
+        out.push_back(row_v ? v : v.transpose(0, 1));
+        return out;
+      }
+    }  // namespace
+
+    vector<StorageView> Eigh(const StorageView &a, const bool &is_V, const bool &row_v) {
+      CYTNX_TRACE_SCOPE("linalg.eigh");
+      return eigh(a, EighRange(), is_V, row_v, "Eigh");
+    }
+
+    vector<StorageView> EighIndex(const StorageView &a, const cytnx_uint64 &il,
+                                  const cytnx_uint64 &iu, const bool &is_V, const bool &row_v) {
+      CYTNX_TRACE_SCOPE("linalg.eigh");
+      cytnx_error_msg(il > iu, "[ERROR] EighIndex of the indices [%llu, %llu), expect il <= iu.\n",
+                      (unsigned long long)il, (unsigned long long)iu);
+      EighRange range;
+      range.range = 'I';
+      range.il = blas_int(il);
+      range.iu = blas_int(iu);
+      return eigh(a, range, is_V, row_v, "EighIndex");
+    }
+
+    vector<StorageView> EighInterval(const StorageView &a, const double &vl, const double &vu,
+                                     const bool &is_V, const bool &row_v) {
+      CYTNX_TRACE_SCOPE("linalg.eigh");
+      cytnx_error_msg(!(vl < vu), "[ERROR] EighInterval of the empty interval (%g, %g].\n", vl,
+                      vu);
+      EighRange range;
+      range.range = 'V';
+      range.vl = vl;
+      range.vu = vu;
+      return eigh(a, range, is_V, row_v, "EighInterval");
+    }
+
+  }  // namespace linalg
+}  // namespace cytnx_core
@@ -0,0 +1,33 @@
+#include <cytnx_core/linalg.hpp>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Expm_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace linalg {
+
+    StorageView Expm(const StorageView &a) {
+      CYTNX_TRACE_SCOPE("linalg.expm");
+      cytnx_error_msg(a.dtype() != Type.Double && a.dtype() != Type.ComplexDouble,
+                      "[ERROR] Expm of %s, expect Double or ComplexDouble.\n",
+                      Type.enum_name(a.dtype()));
+      cytnx_error_msg(a.device() != Device.cpu, "[ERROR] Expm of a GPU view is not supported.%s",
+                      "\n");
+      cytnx_error_msg(a.rank() != 2 || a.shape()[0] != a.shape()[1],
+                      "[ERROR] Expm of a view of rank %d, expect a square matrix.\n",
+                      (int)a.rank());
+      const cytnx_uint64 n = a.shape()[0];
+      Storage in = a.to_storage();
+      if (in.dtype() != Type.ComplexDouble) in = in.astype(Type.ComplexDouble);
+      StorageView out(Storage(n * n, Type.ComplexDouble, Device.cpu, false), {n, n});
+      utils_internal::ExpmWork work;
+      utils_internal::Expm_cpu(static_cast<cytnx_complex128 *>(out.mutable_data()),
+                               in.data<cytnx_complex128>(), blas_int(n), work);
+      return out;
+    }
+
+  }  // namespace linalg
+}  // namespace cytnx_core
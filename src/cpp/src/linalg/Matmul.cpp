@@ -0,0 +1,223 @@
+#include <cytnx_core/linalg.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace linalg {
+
+    namespace {
+      // A rank-2 operand as column-major BLAS sees it: op(stored) with op from `trans`.
+      struct Operand {
+        StorageView view;  // keeps a packed copy alive
+        char trans;
+        blas_int ld;
+      };
+
+      bool blas_dtype(const unsigned int &dtype) {
+        return dtype == Type.Double || dtype == Type.Float || dtype == Type.ComplexDouble ||
+               dtype == Type.ComplexFloat;
+      }
+
+      /**
+       * The operand x (p x q) for a call that needs op(stored) == x, or x^T when `transposed`.
+       *
+       * A row-major x is a column-major x^T with ld = the row stride, a column-major x is itself
+       * with ld = the column stride. Extents of 1 leave the matching stride free.
+       */
+      Operand operand(const StorageView &x, const bool &transposed) {
+        const cytnx_uint64 p = x.shape()[0], q = x.shape()[1];
+        const cytnx_uint64 rs = x.strides()[0], cs = x.strides()[1];
+        const cytnx_uint64 p1 = std::max<cytnx_uint64>(p, 1), q1 = std::max<cytnx_uint64>(q, 1);
+        const bool row_major = (q <= 1 || cs == 1) && (p <= 1 || rs >= q1);
+        const bool col_major = (p <= 1 || rs == 1) && (q <= 1 || cs >= p1);
+        // a row-major x stores x^T, so it needs no op exactly when x^T is wanted
+        if (row_major && !(transposed && x.is_conj())) {
+          const blas_int ld = blas_int(p <= 1 ? q1 : rs);
+          if (transposed) return {x, 'N', ld};
+          return {x, x.is_conj() ? 'C' : 'T', ld};
+        }
+        if (col_major && !(!transposed && x.is_conj())) {
+          const blas_int ld = blas_int(q <= 1 ? p1 : cs);
+          if (!transposed) return {x, 'N', ld};
+          return {x, x.is_conj() ? 'C' : 'T', ld};
+        }
+        // no unit stride, or a conjugation without a transpose to carry it
+        CYTNX_TRACE_SCOPE("linalg.pack_operand");
+        const StorageView packed = x.contiguous();
+        return {packed, transposed ? 'N' : 'T', blas_int(q1)};
+      }
+
+      template <class T>
+      void gemm(const char &ta, const char &tb, const blas_int &m, const blas_int &n,
+                const blas_int &k, const T &alpha, const void *a, const blas_int &lda,
+                const void *b, const blas_int &ldb, const T &beta, void *c, const blas_int &ldc) {
+        const T *pa = static_cast<const T *>(a), *pb = static_cast<const T *>(b);
+        T *pc = static_cast<T *>(c);
+        if constexpr (std::is_same_v<T, cytnx_double>)
+          dgemm(&ta, &tb, &m, &n, &k, &alpha, pa, &lda, pb, &ldb, &beta, pc, &ldc);
+        else if constexpr (std::is_same_v<T, cytnx_float>)
+          sgemm(&ta, &tb, &m, &n, &k, &alpha, pa, &lda, pb, &ldb, &beta, pc, &ldc);
+        else if constexpr (std::is_same_v<T, cytnx_complex128>)
+          zgemm(&ta, &tb, &m, &n, &k, &alpha, pa, &lda, pb, &ldb, &beta, pc, &ldc);
+        else
+          cgemm(&ta, &tb, &m, &n, &k, &alpha, pa, &lda, pb, &ldb, &beta, pc, &ldc);
+      }
+
+      template <class T>
+      void gemv(const char &ta, const blas_int &m, const blas_int &n, const T &alpha,
+                const void *a, const blas_int &lda, const void *x, const blas_int &incx,
+                const T &beta, void *y) {
+        const T *pa = static_cast<const T *>(a), *px = static_cast<const T *>(x);
+        T *py = static_cast<T *>(y);
+        const blas_int one = 1;
+        if constexpr (std::is_same_v<T, cytnx_double>)
+          dgemv(&ta, &m, &n, &alpha, pa, &lda, px, &incx, &beta, py, &one);
+        else if constexpr (std::is_same_v<T, cytnx_float>)
+          sgemv(&ta, &m, &n, &alpha, pa, &lda, px, &incx, &beta, py, &one);
+        else if constexpr (std::is_same_v<T, cytnx_complex128>)
+          zgemv(&ta, &m, &n, &alpha, pa, &lda, px, &incx, &beta, py, &one);
+        else
+          cgemv(&ta, &m, &n, &alpha, pa, &lda, px, &incx, &beta, py, &one);
+      }
+
+      // run fn with a null pointer of the element type of a BLAS dtype
+      template <class Fn>
+      void with_blas_type(const unsigned int &dtype, const Fn &fn) {
+        if (dtype == Type.Double) return fn((cytnx_double *)nullptr);
+        if (dtype == Type.Float) return fn((cytnx_float *)nullptr);
+        if (dtype == Type.ComplexDouble) return fn((cytnx_complex128 *)nullptr);
+        return fn((cytnx_complex64 *)nullptr);
+      }
+
+      template <class T>
+      T scalar_cast(const cytnx_complex128 &v, const char *name) {
+        if constexpr (is_complex_v<T>) {
+          return T(v.real(), v.imag());
+        } else {
+          cytnx_error_msg(v.imag() != 0, "[ERROR] complex %s for a real Matmul.\n", name);
+          return T(v.real());
+        }
+      }
+
+      void check_operands(const StorageView &a, const StorageView &b, const char *op) {
+        cytnx_error_msg(a.dtype() != b.dtype() || !blas_dtype(a.dtype()),
+                        "[ERROR] %s of %s and %s, expect the same of Double, Float, "
+                        "ComplexDouble or ComplexFloat.\n",
+                        op, Type.enum_name(a.dtype()), Type.enum_name(b.dtype()));
+        cytnx_error_msg(a.device() != Device.cpu || b.device() != Device.cpu,
+                        "[ERROR] %s of GPU views is not supported.\n", op);
+      }
+    }  // namespace
+
+    void Matmul(const StorageView &a, const StorageView &b, StorageView &c,
+                const cytnx_complex128 &alpha, const cytnx_complex128 &beta) {
+      CYTNX_TRACE_SCOPE("linalg.matmul");
+      check_operands(a, b, "Matmul");
+      cytnx_error_msg(a.rank() != 2 || b.rank() != 2 || c.rank() != 2,
+                      "[ERROR] Matmul of views of rank %d, %d into %d, expect 2.\n",
+                      (int)a.rank(), (int)b.rank(), (int)c.rank());
+      const cytnx_uint64 m = a.shape()[0], k = a.shape()[1], n = b.shape()[1];
+      cytnx_error_msg(b.shape()[0] != k || c.shape()[0] != m || c.shape()[1] != n,
+                      "[ERROR] Matmul of %llux%llu and %llux%llu into %llux%llu.\n",
+                      (unsigned long long)m, (unsigned long long)k,
+                      (unsigned long long)b.shape()[0], (unsigned long long)n,
+                      (unsigned long long)c.shape()[0], (unsigned long long)c.shape()[1]);
+      cytnx_error_msg(c.dtype() != a.dtype() || c.is_conj(),
+                      "[ERROR] Matmul into a %s%s view, expect a plain %s one.\n",
+                      c.is_conj() ? "conjugated " : "", Type.enum_name(c.dtype()),
+                      Type.enum_name(a.dtype()));
+      if (m == 0 || n == 0) return;
+      void *pc = c.mutable_data();
+      const cytnx_uint64 rs = c.strides()[0], cs = c.strides()[1];
+      const bool c_row = (n <= 1 || cs == 1) && (m <= 1 || rs >= n);
+      // only read by the check, compiled out at CYTNX_CHECK_LEVEL=none
+      [[maybe_unused]] const bool c_col = (m <= 1 || rs == 1) && (n <= 1 || cs >= m);
+      cytnx_error_msg(!c_row && !c_col,
+                      "[ERROR] Matmul into a view without a unit stride, use contiguous().%s",
+                      "\n");
+
+      with_blas_type(a.dtype(), [&](auto *tag) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        const T al = scalar_cast<T>(alpha, "alpha"), be = scalar_cast<T>(beta, "beta");
+        if (c_row) {
+          // a row-major c is a column-major c^T = b^T a^T
+          const Operand ob = operand(b, true), oa = operand(a, true);
+          const blas_int ldc = blas_int(m <= 1 ? std::max<cytnx_uint64>(n, 1) : rs);
+          gemm<T>(ob.trans, oa.trans, n, m, k, al, ob.view.data(), ob.ld, oa.view.data(), oa.ld,
+                  be, pc, ldc);
+        } else {
+          const Operand oa = operand(a, false), ob = operand(b, false);
+          const blas_int ldc = blas_int(n <= 1 ? std::max<cytnx_uint64>(m, 1) : cs);
+          gemm<T>(oa.trans, ob.trans, m, n, k, al, oa.view.data(), oa.ld, ob.view.data(), ob.ld,
+                  be, pc, ldc);
+        }
+      });
+    }
+
+    StorageView Matmul(const StorageView &a, const StorageView &b) {
+      check_operands(a, b, "Matmul");
+      cytnx_error_msg(a.rank() != 2 || b.rank() != 2,
+                      "[ERROR] Matmul of views of rank %d and %d, expect 2.\n", (int)a.rank(),
+                      (int)b.rank());
+      const cytnx_uint64 m = a.shape()[0], n = b.shape()[1];
+      StorageView c(Storage(m * n, a.dtype(), Device.cpu, true), {m, n});
+      Matmul(a, b, c);
+      return c;
+    }
+
+    void Matvec(const StorageView &a, const StorageView &x, Storage &y) {
+      CYTNX_TRACE_SCOPE("linalg.matvec");
+      check_operands(a, x, "Matvec");
+      cytnx_error_msg(a.rank() != 2 || x.rank() != 1,
+                      "[ERROR] Matvec of views of rank %d and %d, expect 2 and 1.\n",
+                      (int)a.rank(), (int)x.rank());
+      const cytnx_uint64 m = a.shape()[0], n = a.shape()[1];
+      cytnx_error_msg(x.shape()[0] != n, "[ERROR] Matvec of %llux%llu and %llu.\n",
+                      (unsigned long long)m, (unsigned long long)n,
+                      (unsigned long long)x.shape()[0]);
+      cytnx_error_msg(y.dtype() != a.dtype() || y.size() != m || y.device() != Device.cpu,
+                      "[ERROR] Matvec into a Storage of %llu %s, expect %llu %s on the CPU.\n",
+                      (unsigned long long)y.size(), Type.enum_name(y.dtype()),
+                      (unsigned long long)m, Type.enum_name(a.dtype()));
+      cytnx_error_msg(m && (a.storage().same_data(y) || x.storage().same_data(y)),
+                      "[ERROR] Matvec into the memory of one of its operands.%s", "\n");
+      if (m == 0) return;
+      if (n == 0) {
+        // gemv returns without touching y
+        memset(y.data(), 0, m * Type.typeSize(y.dtype()));
+        return;
+      }
+      // x goes in place with its stride unless it is conjugated
+      const bool pack_x = x.is_conj() || (n > 1 && x.strides()[0] == 0);
+      const StorageView xv = pack_x ? x.contiguous() : x;
+      const blas_int incx = blas_int(n > 1 ? xv.strides()[0] : 1);
+      // the stored matrix is column-major with op(stored) = a
+      const Operand oa = operand(a, false);
+      with_blas_type(a.dtype(), [&](auto *tag) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        // gemv takes the stored shape, (n x m) when it applies a transpose
+        const blas_int rows = oa.trans == 'N' ? m : n, cols = oa.trans == 'N' ? n : m;
+        gemv<T>(oa.trans, rows, cols, T(1), oa.view.data(), oa.ld, xv.data(), incx, T(0),
+                y.data());
+      });
+    }
+
+    StorageView Matvec(const StorageView &a, const StorageView &x) {
+      check_operands(a, x, "Matvec");
+      cytnx_error_msg(a.rank() != 2 || x.rank() != 1,
+                      "[ERROR] Matvec of views of rank %d and %d, expect 2 and 1.\n",
+                      (int)a.rank(), (int)x.rank());
+      const cytnx_uint64 m = a.shape()[0];
+      Storage y(m, a.dtype(), Device.cpu, false);
+      Matvec(a, x, y);
+      return StorageView(y, {m});
+    }
+
+  }  // namespace linalg
+}  // namespace cytnx_core
@@ -0,0 +1,64 @@
+#include <cytnx_core/linalg.hpp>
+
+#include <algorithm>
+
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Svd_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace linalg {
+
+    vector<StorageView> Svd(const StorageView &a, const bool &is_UvT) {
+      CYTNX_TRACE_SCOPE("linalg.svd");
+      const unsigned int dtype = a.dtype();
+      cytnx_error_msg(dtype != Type.Double && dtype != Type.Float &&
+                        dtype != Type.ComplexDouble && dtype != Type.ComplexFloat,
+                      "[ERROR] Svd of %s, expect Double, Float, ComplexDouble or ComplexFloat.\n",
+                      Type.enum_name(dtype));
+      cytnx_error_msg(a.device() != Device.cpu, "[ERROR] Svd of a GPU view is not supported.%s",
+                      "\n");
+      cytnx_error_msg(a.rank() != 2, "[ERROR] Svd of a view of rank %d, expect a matrix.\n",
+                      (int)a.rank());
+      const cytnx_uint64 m = a.shape()[0], n = a.shape()[1], k = std::min(m, n);
+
+      // LAPACK destroys its input: a private row-major copy, which it reads as the column-major
+      // n x m matrix a^T = u s vt, so that a = vt^T s u^T: vt is U and u is vT, both row-major
+      Storage buf = a.contiguous().to_storage();
+      if (buf.use_count() > 1) buf = buf.clone();
+      const unsigned int real_dtype = dtype == Type.ComplexDouble  ? Type.Double
+                                      : dtype == Type.ComplexFloat ? Type.Float
+                                                                   : dtype;
+      Storage s(k, real_dtype, Device.cpu, false), u, vt;
+      if (is_UvT) {
+        u = Storage(m * k, dtype, Device.cpu, false);
+        vt = Storage(k * n, dtype, Device.cpu, false);
+      }
+
+      const auto run = [&](auto *tag) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        using R = utils_internal::svd_real_t<T>;
+        utils_internal::Svd_cpu<T>(buf.data<T>(), blas_int(n), blas_int(m), is_UvT, s.data<R>(),
+                                   is_UvT ? vt.data<T>() : nullptr,
+                                   is_UvT ? u.data<T>() : nullptr);
+      };
+      if (dtype == Type.Double)
+        run((cytnx_double *)nullptr);
+      else if (dtype == Type.Float)
+        run((cytnx_float *)nullptr);
+      else if (dtype == Type.ComplexDouble)
+        run((cytnx_complex128 *)nullptr);
+      else
+        run((cytnx_complex64 *)nullptr);
+
+      vector<StorageView> out = {StorageView(s)};
+      if (!is_UvT) return out;
+      out.push_back(StorageView(u, {m, k}));
+      out.push_back(StorageView(vt, {k, n}));
+      return out;
+    }
+
+  }  // namespace linalg
+}  // namespace cytnx_core
@@ -0,0 +1,76 @@
+#include <cytnx_core/random.hpp>
+
+#include <cmath>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#include "utils_internal/cpu/Random_cpu.hpp"
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace random {
+
+    namespace {
+      // calls f(T *data) for the floating point or complex dtype of s
+      template <class Func>
+      void dispatch_float(Storage &s, const char *name, Func &&f) {
+        cytnx_error_msg(s.device() != Device.cpu,
+                        "[ERROR] random::%s of a GPU Storage is not supported.\n", name);
+        dispatch_type(s.dtype(), [&](auto tag) {
+          using T = typename decltype(tag)::type;
+          if constexpr (std::is_same_v<T, void>) {
+            cytnx_error_msg(true, "[ERROR] random::%s of a Storage of Void.\n", name);
+          } else if constexpr (Type_struct_t<T>::is_float) {
+            if (s.size()) f(s.data<T>());
+          } else {
+            cytnx_error_msg(true,
+                            "[ERROR] random::%s of a Storage of %s, expect a floating point or "
+                            "complex dtype.\n",
+                            name, Type.enum_name(s.dtype()));
+          }
+        });
+      }
+    }  // namespace
+
+    void uniform_(Storage &s, const double &low, const double &high, const cytnx_uint64 &seed,
+                  const cytnx_uint64 &offset) {
+      cytnx_error_msg(!(std::isfinite(low) && std::isfinite(high) && low <= high),
+                      "[ERROR] random::uniform_ in [%g, %g), expect finite bounds low <= high.\n",
+                      low, high);
+      CYTNX_TRACE_SCOPE("random.uniform");
+      dispatch_float(s, "uniform_", [&](auto *data) {
+        utils_internal::Uniform_cpu(data, s.size(), low, high, seed, offset);
+      });
+    }
+
+    void normal_(Storage &s, const double &mean, const double &std, const cytnx_uint64 &seed,
+                 const cytnx_uint64 &offset) {
+      cytnx_error_msg(!(std::isfinite(mean) && std::isfinite(std) && std >= 0),
+                      "[ERROR] random::normal_ of mean %g and standard deviation %g.\n", mean,
+                      std);
+      CYTNX_TRACE_SCOPE("random.normal");
+      dispatch_float(s, "normal_", [&](auto *data) {
+        utils_internal::Normal_cpu(data, s.size(), mean, std, seed, offset);
+      });
+    }
+
+    Storage uniform(const cytnx_uint64 &size, const double &low, const double &high,
+                    const unsigned int &dtype, const cytnx_uint64 &seed,
+                    const cytnx_uint64 &offset) {
+      Storage s(size, dtype, Device.cpu, false);
+      uniform_(s, low, high, seed, offset);
+      return s;
+    }
+
+    Storage normal(const cytnx_uint64 &size, const double &mean, const double &std,
+                   const unsigned int &dtype, const cytnx_uint64 &seed,
+                   const cytnx_uint64 &offset) {
+      Storage s(size, dtype, Device.cpu, false);
+      normal_(s, mean, std, seed, offset);
+      return s;
+    }
+
+  }  // namespace random
+}  // namespace cytnx_core
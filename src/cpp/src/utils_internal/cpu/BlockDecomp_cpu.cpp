@@ -0,0 +1,201 @@
+#include "BlockDecomp_cpu.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+#include <cytnx_core/Trace.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+#ifdef UNI_MKL
+  #include <mkl.h>
+#else
+// OpenBLAS exports these, and scipy_openblas64 (the wheel's default BLAS) the same under a
+// prefix and suffix; weak so that other BLAS libraries still link
+extern "C" int openblas_get_num_threads(void) __attribute__((weak));
+extern "C" void openblas_set_num_threads(int) __attribute__((weak));
+extern "C" int scipy_openblas_get_num_threads64_(void) __attribute__((weak));
+extern "C" void scipy_openblas_set_num_threads64_(int) __attribute__((weak));
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // a LAPACK call of fewer flops (about a 200 x 200 SVD) gains little from more threads
+      constexpr double kMinThreadedFlops = 2e8;
+      // fewer candidate values than this are selected on one thread
+      constexpr cytnx_uint64 kMinParallelSelect = 1 << 16;
+
+      // the number of BLAS threads set for its lifetime; a no-op for a BLAS it cannot control
+      class BlasThreads {
+       public:
+        explicit BlasThreads(const int &n) : _old(get()) {
+          if (_old > 0) set(n);
+        }
+        ~BlasThreads() {
+          if (_old > 0) set(_old);
+        }
+
+       private:
+        int _old;
+
+        static int get() {
+#ifdef UNI_MKL
+          return mkl_get_max_threads();
+#else
+          if (openblas_get_num_threads && openblas_set_num_threads)
+            return openblas_get_num_threads();
+          if (scipy_openblas_get_num_threads64_ && scipy_openblas_set_num_threads64_)
+            return scipy_openblas_get_num_threads64_();
+          return 0;
+#endif
+        }
+        static void set(const int &n) {
+#ifdef UNI_MKL
+          mkl_set_num_threads(n);
+#else
+          if (openblas_set_num_threads)
+            openblas_set_num_threads(n);
+          else
+            scipy_openblas_set_num_threads64_(n);
+#endif
+        }
+      };
+
+      // the threads the blocks can be spread over: one without OpenMP, where the blocks are
+      // better left to the multithreaded BLAS one at a time
+      int omp_threads(const int &threads) {
+#ifdef UNI_OMP
+        return std::max(threads, 1);
+#else
+        (void)threads;
+        return 1;
+#endif
+      }
+    }  // namespace
+
+    BlockSchedule block_schedule(const vector<double> &costs, const int &threads) {
+      BlockSchedule out;
+      vector<cytnx_uint64> order(costs.size());
+      std::iota(order.begin(), order.end(), cytnx_uint64(0));
+      std::stable_sort(order.begin(), order.end(),
+                       [&](const cytnx_uint64 &i, const cytnx_uint64 &j) {
+                         return costs[i] > costs[j];
+                       });
+      if (threads <= 1) {
+        out.large = order;
+        return out;
+      }
+      // a job is measured against the jobs not yet taken out as large, so that a mid-sized
+      // job left behind by a dominant one is not run single-threaded
+      double rest = std::accumulate(costs.begin(), costs.end(), 0.0);
+      cytnx_uint64 j = 0;
+      for (; j < order.size(); j++) {
+        const double c = costs[order[j]];
+        if (c * threads < rest || c < kMinThreadedFlops) break;
+        out.large.push_back(order[j]);
+        rest -= c;
+      }
+      out.small.assign(order.begin() + j, order.end());
+      return out;
+    }
+
+    void run_blocks(const vector<double> &costs, const function<void(const cytnx_uint64 &)> &job,
+                    const int &threads) {
+      CYTNX_TRACE_SCOPE("kernel.block_decomp");
+      const int spread = omp_threads(threads);
+      const BlockSchedule sched = block_schedule(costs, spread);
+      for (const cytnx_uint64 &i : sched.large) job(i);
+      const cytnx_uint64 n = sched.small.size();
+      const int nt = int(std::min<cytnx_uint64>(spread, n));
+      if (nt <= 1) {
+        for (const cytnx_uint64 &i : sched.small) job(i);
+        return;
+      }
+
+      BlasThreads single(1);
+      exception_ptr error;
+      mutex mtx;
+      // dynamic scheduling over the jobs in descending order is the greedy LPT list schedule
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nt)
+      for (cytnx_uint64 j = 0; j < n; j++) {
+        try {
+          job(sched.small[j]);
+        } catch (...) {
+          lock_guard<mutex> lock(mtx);
+          if (!error) error = current_exception();
+        }
+      }
+      if (error) rethrow_exception(error);
+    }
+
+    template <class R>
+    vector<cytnx_uint64> truncate_blocks(const vector<const R *> &values,
+                                         const vector<cytnx_uint64> &sizes,
+                                         const cytnx_uint64 &keep, const R &cutoff,
+                                         const int &threads) {
+      CYTNX_TRACE_SCOPE("kernel.truncate_blocks");
+      const cytnx_uint64 nb = sizes.size();
+      vector<cytnx_uint64> kept(nb, 0), offsets(nb + 1, 0);
+      for (cytnx_uint64 b = 0; b < nb; b++) offsets[b + 1] = offsets[b] + sizes[b];
+      const cytnx_uint64 total = offsets[nb];
+      if (keep == 0 || total == 0) return kept;
+
+      // a value and its position over all blocks; larger values first, then earlier positions
+      typedef pair<R, cytnx_uint64> Entry;
+      const auto before = [](const Entry &x, const Entry &y) {
+        return x.first > y.first || (x.first == y.first && x.second < y.second);
+      };
+      const auto select = [&](vector<Entry> &c) {
+        if (c.size() <= keep) return;
+        std::nth_element(c.begin(), c.begin() + keep, c.end(), before);
+        c.resize(keep);
+      };
+
+      const int parts = total >= kMinParallelSelect ? omp_threads(threads) : 1;
+      vector<vector<Entry>> cands(parts);
+#pragma omp parallel for schedule(static, 1) if (parts > 1) num_threads(parts)
+      for (int p = 0; p < parts; p++) {
+        const cytnx_uint64 lo = total * p / parts, hi = total * (p + 1) / parts;
+        vector<Entry> &c = cands[p];
+        // from the block holding position lo
+        cytnx_uint64 b = std::upper_bound(offsets.begin(), offsets.end(), lo) - offsets.begin() - 1;
+        for (; b < nb && offsets[b] < hi; b++) {
+          // a block is descending: only its leading `keep` values above cutoff can be kept
+          const cytnx_uint64 end = std::min(hi, offsets[b] + std::min(sizes[b], keep));
+          for (cytnx_uint64 i = std::max(lo, offsets[b]); i < end; i++) {
+            const R v = values[b][i - offsets[b]];
+            if (!(v > cutoff)) break;
+            c.emplace_back(v, i);
+          }
+        }
+        select(c);
+      }
+
+      vector<Entry> merged = std::move(cands[0]);
+      for (int p = 1; p < parts; p++) merged.insert(merged.end(), cands[p].begin(), cands[p].end());
+      select(merged);
+      // a selection of the largest values takes a prefix of each descending block
+      for (const Entry &e : merged)
+        kept[std::upper_bound(offsets.begin(), offsets.end(), e.second) - offsets.begin() - 1]++;
+      return kept;
+    }
+
+#define CYTNX_TRUNCATE_BLOCKS_INSTANTIATE(R)                                                    \
+  template vector<cytnx_uint64> truncate_blocks<R>(const vector<const R *> &,                   \
+                                                   const vector<cytnx_uint64> &,                \
+                                                   const cytnx_uint64 &, const R &, const int &);
+    CYTNX_TRUNCATE_BLOCKS_INSTANTIATE(cytnx_double)
+    CYTNX_TRUNCATE_BLOCKS_INSTANTIATE(cytnx_float)
+#undef CYTNX_TRUNCATE_BLOCKS_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
@@ -0,0 +1,64 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKDECOMP_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKDECOMP_CPU_H_
+
+#include <functional>
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    // how run_blocks() runs independent jobs, given as indices into their costs
+    struct BlockSchedule {
+      std::vector<cytnx_uint64> large;  // one at a time, on the multithreaded BLAS
+      std::vector<cytnx_uint64> small;  // concurrently, each on a single-threaded BLAS
+    };
+
+    /**
+     * @brief The schedule of jobs of the given costs (in flops) over `threads` threads, both
+     * lists longest job first.
+     *
+     * A job is large when it alone is at least an even share of the total, so that no
+     * concurrent schedule could balance it, and big enough for a multithreaded LAPACK call to
+     * pay off. The small jobs are then spread over the threads by greedy list scheduling in
+     * this order (longest processing time first), which finishes within 4/3 of the optimal
+     * makespan. With one thread every job is large.
+     */
+    BlockSchedule block_schedule(const std::vector<double> &costs, const int &threads);
+
+    /**
+     * @brief job(i) for every i < costs.size(), as block_schedule() lays them out: the large
+     * jobs first, then the small ones.
+     *
+     * The BLAS library (OpenBLAS, scipy_openblas64 or MKL) is set to one thread while the small
+     * jobs run, and restored after. The jobs must be independent and thread-safe; the first
+     * exception thrown by one is rethrown once all have finished. Without OpenMP (USE_OMP=OFF)
+     * the jobs are scheduled as for one thread: all are large and run in turn on the BLAS
+     * threads.
+     */
+    void run_blocks(const std::vector<double> &costs,
+                    const std::function<void(const cytnx_uint64 &)> &job, const int &threads);
+
+    /**
+     * @brief The global truncation of a block-diagonal decomposition: how many of the leading
+     * values of each block to keep so that the `keep` largest values over all blocks, among
+     * those above `cutoff`, are kept.
+     *
+     * The values of each block must be in descending order (singular values). The candidates
+     * are selected by a parallel partial sort: each of up to `threads` chunks (one without
+     * OpenMP) keeps its own `keep` largest, and the merged candidates are selected once more.
+     * Ties are broken by the block, then the position, so that the result is deterministic.
+     *
+     * @return the number of values kept in each block
+     */
+    template <class R>
+    std::vector<cytnx_uint64> truncate_blocks(const std::vector<const R *> &values,
+                                              const std::vector<cytnx_uint64> &sizes,
+                                              const cytnx_uint64 &keep, const R &cutoff,
+                                              const int &threads);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKDECOMP_CPU_H_
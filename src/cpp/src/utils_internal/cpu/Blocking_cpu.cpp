@@ -0,0 +1,39 @@
+#include "Blocking_cpu.hpp"
+
+#include <cytnx_core/Device.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    BlockingParams DeriveBlockingParams() {
+      BlockingParams params;
+      // the threads of an OpenMP region, so that OMP_NUM_THREADS is honoured
+#ifdef UNI_OMP
+      const int threads = omp_get_max_threads();
+#else
+      const int threads = 1;
+#endif
+      // a streaming store keeps half of L2 for the hardware prefetcher and the stack
+      params.fill_chunk_bytes = Device.L2_size / 2;
+      params.fill_threads = threads;
+      // conversions stream one input and one output array through L2
+      params.convert_chunk_bytes = Device.L2_size / 2;
+      params.convert_threads = threads;
+      // the source tile and the destination tile together occupy half of L1d
+      params.permute_tile_bytes = Device.L1d_size / 4;
+      return params;
+    }
+
+    const BlockingParams &GetBlockingParams() {
+      static const BlockingParams params = AutotuneBlockingParams(DeriveBlockingParams());
+      return params;
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
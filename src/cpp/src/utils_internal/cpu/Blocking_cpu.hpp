@@ -0,0 +1,47 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKING_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKING_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Blocking parameters of the CPU kernels.
+     *
+     * The defaults are derived from the cache sizes discovered by `Device` (see
+     * Device_class::L1d_size and Device_class::L2_size), so that a chunk handed to one thread
+     * stays resident in its private caches, and the thread counts from omp_get_max_threads().
+     * GetBlockingParams() then overrides them with the winners cached by the autotuner (see
+     * cytnx_core/Autotune.hpp).
+     */
+    struct BlockingParams {
+      cytnx_uint64 fill_chunk_bytes;  // bytes written per scheduling chunk of FillCpu
+      int fill_threads;
+      cytnx_uint64 convert_chunk_bytes;  // bytes read + written per chunk of conversion kernels
+      int convert_threads;
+      cytnx_uint64 permute_tile_bytes;  // bytes of one square tile of the permutation kernel
+    };
+
+    // the parameters derived from the detected hardware only
+    BlockingParams DeriveBlockingParams();
+
+    // override the tunable fields of params by the autotuned winners (defined in Autotune.cpp)
+    BlockingParams AutotuneBlockingParams(BlockingParams params);
+
+    // the parameters in effect: derived, then overridden by the autotune cache
+    const BlockingParams &GetBlockingParams();
+
+    /**
+     * @brief The number of elements of `elem_bytes` bytes fitting in `chunk_bytes`, at least 1.
+     */
+    inline cytnx_uint64 BlockElems(const cytnx_uint64 &chunk_bytes,
+                                   const cytnx_uint64 &elem_bytes) {
+      cytnx_uint64 n = chunk_bytes / (elem_bytes ? elem_bytes : 1);
+      return n ? n : 1;
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_BLOCKING_CPU_H_
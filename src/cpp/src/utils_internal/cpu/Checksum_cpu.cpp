@@ -0,0 +1,130 @@
+#include "Checksum_cpu.hpp"
+
+#include <array>
+#include <cstring>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #include <nmmintrin.h>
+  #define CYTNX_HAS_SSE42_PATH
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      const cytnx_uint32 crc32c_poly = 0x82F63B78u;  // reflected Castagnoli polynomial
+
+      const array<cytnx_uint32, 256> &crc32c_table() {
+        static const array<cytnx_uint32, 256> table = []() {
+          array<cytnx_uint32, 256> t{};
+          for (cytnx_uint32 i = 0; i < 256; i++) {
+            cytnx_uint32 c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? (c >> 1) ^ crc32c_poly : c >> 1;
+            t[i] = c;
+          }
+          return t;
+        }();
+        return table;
+      }
+
+      cytnx_uint32 crc32c_table_impl(const unsigned char *p, cytnx_uint64 n, cytnx_uint32 crc) {
+        const auto &table = crc32c_table();
+        for (cytnx_uint64 i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        return crc;
+      }
+
+#ifdef CYTNX_HAS_SSE42_PATH
+      __attribute__((target("sse4.2"))) cytnx_uint32 crc32c_sse42_impl(const unsigned char *p,
+                                                                      cytnx_uint64 n,
+                                                                      cytnx_uint32 crc) {
+        cytnx_uint64 c = crc;
+        for (; n >= 8; n -= 8, p += 8) {
+          cytnx_uint64 word;
+          memcpy(&word, p, 8);
+          c = _mm_crc32_u64(c, word);
+        }
+        cytnx_uint32 c32 = static_cast<cytnx_uint32>(c);
+        for (; n > 0; n--, p++) c32 = _mm_crc32_u8(c32, *p);
+        return c32;
+      }
+#endif
+
+      const cytnx_uint64 xxh_p1 = 11400714785074694791ULL;
+      const cytnx_uint64 xxh_p2 = 14029467366897019727ULL;
+      const cytnx_uint64 xxh_p3 = 1609587929392839161ULL;
+      const cytnx_uint64 xxh_p4 = 9650029242287828579ULL;
+      const cytnx_uint64 xxh_p5 = 2870177450012600261ULL;
+
+      inline cytnx_uint64 rotl64(cytnx_uint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+      inline cytnx_uint64 read64(const unsigned char *p) {
+        cytnx_uint64 v;
+        memcpy(&v, p, 8);
+        return v;
+      }
+
+      inline cytnx_uint64 xxh_round(cytnx_uint64 acc, cytnx_uint64 input) {
+        return rotl64(acc + input * xxh_p2, 31) * xxh_p1;
+      }
+
+      inline cytnx_uint64 xxh_merge(cytnx_uint64 acc, cytnx_uint64 val) {
+        return (acc ^ xxh_round(0, val)) * xxh_p1 + xxh_p4;
+      }
+    }  // namespace
+
+    cytnx_uint32 Crc32c_cpu(const void *data, const cytnx_uint64 &bytes, cytnx_uint32 crc) {
+      CYTNX_TRACE_SCOPE("kernel.crc32c");
+      CYTNX_PERF_SCOPE("kernel.crc32c");
+      const auto *p = static_cast<const unsigned char *>(data);
+      crc = ~crc;
+#ifdef CYTNX_HAS_SSE42_PATH
+      static const bool use_sse42 = Device.has_simd("sse4_2");
+      if (use_sse42) return ~crc32c_sse42_impl(p, bytes, crc);
+#endif
+      return ~crc32c_table_impl(p, bytes, crc);
+    }
+
+    cytnx_uint64 Hash64_cpu(const void *data, const cytnx_uint64 &bytes, cytnx_uint64 seed) {
+      CYTNX_TRACE_SCOPE("kernel.hash64");
+      CYTNX_PERF_SCOPE("kernel.hash64");
+      const auto *p = static_cast<const unsigned char *>(data);
+      const unsigned char *end = p + bytes;
+      cytnx_uint64 h;
+      if (bytes >= 32) {
+        cytnx_uint64 v1 = seed + xxh_p1 + xxh_p2, v2 = seed + xxh_p2, v3 = seed, v4 = seed - xxh_p1;
+        for (; p + 32 <= end; p += 32) {
+          v1 = xxh_round(v1, read64(p));
+          v2 = xxh_round(v2, read64(p + 8));
+          v3 = xxh_round(v3, read64(p + 16));
+          v4 = xxh_round(v4, read64(p + 24));
+        }
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh_merge(xxh_merge(xxh_merge(xxh_merge(h, v1), v2), v3), v4);
+      } else {
+        h = seed + xxh_p5;
+      }
+      h += bytes;
+      for (; p + 8 <= end; p += 8) h = rotl64(h ^ xxh_round(0, read64(p)), 27) * xxh_p1 + xxh_p4;
+      if (p + 4 <= end) {
+        cytnx_uint32 w;
+        memcpy(&w, p, 4);
+        h = rotl64(h ^ (w * xxh_p1), 23) * xxh_p2 + xxh_p3;
+        p += 4;
+      }
+      for (; p < end; p++) h = rotl64(h ^ (*p * xxh_p5), 11) * xxh_p1;
+      h ^= h >> 33;
+      h *= xxh_p2;
+      h ^= h >> 29;
+      h *= xxh_p3;
+      h ^= h >> 32;
+      return h;
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
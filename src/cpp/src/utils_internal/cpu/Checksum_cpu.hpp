@@ -0,0 +1,32 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_CHECKSUM_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_CHECKSUM_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief CRC-32C (Castagnoli) of a byte range.
+     *
+     * @param data the first byte
+     * @param bytes the number of bytes
+     * @param crc the checksum of the preceding bytes, to checksum a range piecewise
+     *
+     * Uses the SSE4.2 crc32 instruction when `Device` reports "sse4_2", a table otherwise; both
+     * give the same result.
+     */
+    cytnx_uint32 Crc32c_cpu(const void *data, const cytnx_uint64 &bytes, cytnx_uint32 crc = 0);
+
+    /**
+     * @brief 64-bit content hash (XXH64) of a byte range.
+     *
+     * Much faster than a cryptographic hash and with far fewer collisions than a CRC, meant for
+     * detecting which chunks of a buffer changed.
+     */
+    cytnx_uint64 Hash64_cpu(const void *data, const cytnx_uint64 &bytes, cytnx_uint64 seed = 0);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_CHECKSUM_CPU_H_
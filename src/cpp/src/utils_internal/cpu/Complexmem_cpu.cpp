@@ -1,5 +1,7 @@
 #include "Complexmem_cpu.hpp"
 
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
 #include <cytnx_core/lapack_wrapper.hpp>
 #include <cytnx_core/errors/cytnx_error.hpp>
 
@@ -21,16 +23,27 @@ namespace cytnx_core {
   namespace utils_internal {
 
     void Complexmem_cpu_cdtd(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real) {
+      Complexmem_cpu_cdtd(out, in, Nelem, get_real, GetBlockingParams());
+    }
+    void Complexmem_cpu_cdtd(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real,
+                             const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.complexmem_cdtd");
+      CYTNX_PERF_SCOPE("kernel.complexmem_cdtd");
       cytnx_double *des = static_cast<cytnx_double *>(out);
       cytnx_complex128 *src = static_cast<cytnx_complex128 *>(in);
+      // only read by the OpenMP pragmas
+      [[maybe_unused]] const cytnx_uint64 chunk =
+        BlockElems(params.convert_chunk_bytes, sizeof(cytnx_double) + sizeof(cytnx_complex128));
 
       if (get_real) {
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(static, chunk) if (Nelem > chunk) \
+  num_threads(params.convert_threads)
         for (cytnx_uint64 n = 0; n < Nelem; n++) {
           des[n] = src[n].real();
         }
       } else {
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(static, chunk) if (Nelem > chunk) \
+  num_threads(params.convert_threads)
         for (cytnx_uint64 n = 0; n < Nelem; n++) {
           des[n] = src[n].imag();
         }
@@ -38,16 +51,27 @@ namespace cytnx_core {
     }
 
     void Complexmem_cpu_cftf(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real) {
+      Complexmem_cpu_cftf(out, in, Nelem, get_real, GetBlockingParams());
+    }
+    void Complexmem_cpu_cftf(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real,
+                             const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.complexmem_cftf");
+      CYTNX_PERF_SCOPE("kernel.complexmem_cftf");
       cytnx_float *des = static_cast<cytnx_float *>(out);
       cytnx_complex64 *src = static_cast<cytnx_complex64 *>(in);
+      // only read by the OpenMP pragmas
+      [[maybe_unused]] const cytnx_uint64 chunk =
+        BlockElems(params.convert_chunk_bytes, sizeof(cytnx_float) + sizeof(cytnx_complex64));
 
       if (get_real) {
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(static, chunk) if (Nelem > chunk) \
+  num_threads(params.convert_threads)
         for (cytnx_uint64 n = 0; n < Nelem; n++) {
           des[n] = src[n].real();
         }
       } else {
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(static, chunk) if (Nelem > chunk) \
+  num_threads(params.convert_threads)
         for (cytnx_uint64 n = 0; n < Nelem; n++) {
           des[n] = src[n].imag();
         }
@@ -56,6 +80,8 @@ namespace cytnx_core {
 
     void ComplexMatrix_from_real_cd(void *out, void *in, const cytnx_uint64 &m,
                                     const cytnx_uint64 &n, const bool real_part) {
+      CYTNX_TRACE_SCOPE("kernel.complex_from_real_cd");
+      CYTNX_PERF_SCOPE("kernel.complex_from_real_cd");
       if (real_part)
         LAPACKE_zlacp2(LAPACK_ROW_MAJOR, 'A', m, n, (double *)in, n, (__Cpt_dbl)out, n);
       else
@@ -64,6 +90,8 @@ namespace cytnx_core {
     }
     void ComplexMatrix_from_real_cf(void *out, void *in, const cytnx_uint64 &m,
                                     const cytnx_uint64 &n, const bool real_part) {
+      CYTNX_TRACE_SCOPE("kernel.complex_from_real_cf");
+      CYTNX_PERF_SCOPE("kernel.complex_from_real_cf");
       if (real_part)
         LAPACKE_clacp2(LAPACK_ROW_MAJOR, 'A', m, n, (float *)in, n, (__Cpt_flt)out, n);
       else
@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <climits>
 #include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
 
 namespace cytnx_core {
   namespace utils_internal {
@@ -13,6 +14,12 @@ namespace cytnx_core {
     void Complexmem_cpu_cdtd(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real);
     void Complexmem_cpu_cftf(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real);
 
+    // same as above with explicit blocking, used by the autotuner to time candidates
+    void Complexmem_cpu_cdtd(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real,
+                             const BlockingParams &params);
+    void Complexmem_cpu_cftf(void *out, void *in, const cytnx_uint64 &Nelem, const bool get_real,
+                             const BlockingParams &params);
+
     void ComplexMatrix_from_real_cd(void *out, void *in, const cytnx_uint64 &m,
                                     const cytnx_uint64 &n, const bool real_part);
 
@@ -0,0 +1,172 @@
+#include "Compress_cpu.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    void Shuffle_cpu(char *dst, const char *src, const cytnx_uint64 &bytes,
+                     const cytnx_uint64 &elem_bytes) {
+      CYTNX_TRACE_SCOPE("kernel.shuffle");
+      CYTNX_PERF_SCOPE("kernel.shuffle");
+      if (elem_bytes <= 1) {
+        memcpy(dst, src, bytes);
+        return;
+      }
+      const cytnx_uint64 n = bytes / elem_bytes;
+      for (cytnx_uint64 i = 0; i < n; i++)
+        for (cytnx_uint64 j = 0; j < elem_bytes; j++) dst[j * n + i] = src[i * elem_bytes + j];
+      memcpy(dst + n * elem_bytes, src + n * elem_bytes, bytes - n * elem_bytes);
+    }
+
+    void Unshuffle_cpu(char *dst, const char *src, const cytnx_uint64 &bytes,
+                       const cytnx_uint64 &elem_bytes) {
+      CYTNX_TRACE_SCOPE("kernel.unshuffle");
+      CYTNX_PERF_SCOPE("kernel.unshuffle");
+      if (elem_bytes <= 1) {
+        memcpy(dst, src, bytes);
+        return;
+      }
+      const cytnx_uint64 n = bytes / elem_bytes;
+      for (cytnx_uint64 i = 0; i < n; i++)
+        for (cytnx_uint64 j = 0; j < elem_bytes; j++) dst[i * elem_bytes + j] = src[j * n + i];
+      memcpy(dst + n * elem_bytes, src + n * elem_bytes, bytes - n * elem_bytes);
+    }
+
+    namespace {
+      const int hash_log = 16;
+      const cytnx_uint64 min_match = 4;
+      const cytnx_uint64 max_offset = 65535;
+      const cytnx_uint64 last_literals = 5;  // the last bytes are always literals
+      const cytnx_uint64 match_limit = 12;  // no match starts within this many bytes of the end
+
+      inline cytnx_uint32 read32(const char *p) {
+        cytnx_uint32 v;
+        memcpy(&v, p, 4);
+        return v;
+      }
+
+      inline cytnx_uint32 hash32(cytnx_uint32 v) { return (v * 2654435761u) >> (32 - hash_log); }
+
+      // append a length in 255-continuation form, returns false on overflow
+      inline bool put_length(char *dst, cytnx_uint64 cap, cytnx_uint64 &op, cytnx_uint64 len) {
+        for (; len >= 255; len -= 255) {
+          if (op >= cap) return false;
+          dst[op++] = static_cast<char>(255);
+        }
+        if (op >= cap) return false;
+        dst[op++] = static_cast<char>(len);
+        return true;
+      }
+
+      inline bool get_length(const unsigned char *src, cytnx_uint64 n, cytnx_uint64 &ip,
+                             cytnx_uint64 &len) {
+        unsigned char b;
+        do {
+          if (ip >= n) return false;
+          b = src[ip++];
+          len += b;
+        } while (b == 255);
+        return true;
+      }
+
+      // emit literals [lit, lit + nlit) followed by a match, or only literals if mlen == 0
+      bool put_sequence(char *dst, cytnx_uint64 cap, cytnx_uint64 &op, const char *lit,
+                        cytnx_uint64 nlit, cytnx_uint64 offset, cytnx_uint64 mlen) {
+        if (op >= cap) return false;
+        cytnx_uint64 token_pos = op++;
+        unsigned char token = static_cast<unsigned char>((nlit >= 15 ? 15 : nlit) << 4);
+        if (nlit >= 15 && !put_length(dst, cap, op, nlit - 15)) return false;
+        if (op + nlit > cap) return false;
+        memcpy(dst + op, lit, nlit);
+        op += nlit;
+        if (mlen > 0) {
+          if (op + 2 > cap) return false;
+          dst[op++] = static_cast<char>(offset & 0xFF);
+          dst[op++] = static_cast<char>(offset >> 8);
+          cytnx_uint64 ml = mlen - min_match;
+          token |= static_cast<unsigned char>(ml >= 15 ? 15 : ml);
+          if (ml >= 15 && !put_length(dst, cap, op, ml - 15)) return false;
+        }
+        dst[token_pos] = static_cast<char>(token);
+        return true;
+      }
+    }  // namespace
+
+    cytnx_uint64 LzCompress_cpu(char *dst, const cytnx_uint64 &dst_capacity, const char *src,
+                                const cytnx_uint64 &bytes) {
+      CYTNX_TRACE_SCOPE("kernel.lz_compress");
+      CYTNX_PERF_SCOPE("kernel.lz_compress");
+      // positions + 1 of the last occurrence of each hashed 4-byte sequence, 0 if none
+      thread_local vector<cytnx_uint32> table;
+      table.assign(1u << hash_log, 0);
+
+      cytnx_uint64 op = 0, ip = 0, anchor = 0;
+      if (bytes > match_limit) {
+        const cytnx_uint64 limit = bytes - match_limit;
+        while (ip < limit) {
+          cytnx_uint32 seq = read32(src + ip);
+          cytnx_uint32 h = hash32(seq);
+          cytnx_uint64 ref = table[h];
+          table[h] = static_cast<cytnx_uint32>(ip + 1);
+          if (ref == 0 || ip + 1 - ref > max_offset || read32(src + ref - 1) != seq) {
+            // skip faster through incompressible data
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+          }
+          ref -= 1;
+          cytnx_uint64 mlen = min_match;
+          while (ip + mlen < bytes - last_literals && src[ref + mlen] == src[ip + mlen]) mlen++;
+          if (!put_sequence(dst, dst_capacity, op, src + anchor, ip - anchor, ip - ref, mlen))
+            return 0;
+          ip += mlen;
+          anchor = ip;
+        }
+      }
+      if (!put_sequence(dst, dst_capacity, op, src + anchor, bytes - anchor, 0, 0)) return 0;
+      return op;
+    }
+
+    bool LzDecompress_cpu(char *dst, const cytnx_uint64 &raw_bytes, const char *src,
+                          const cytnx_uint64 &bytes) {
+      CYTNX_TRACE_SCOPE("kernel.lz_decompress");
+      CYTNX_PERF_SCOPE("kernel.lz_decompress");
+      const auto *in = reinterpret_cast<const unsigned char *>(src);
+      cytnx_uint64 ip = 0, op = 0;
+      while (ip < bytes) {
+        unsigned char token = in[ip++];
+        cytnx_uint64 nlit = token >> 4;
+        if (nlit == 15 && !get_length(in, bytes, ip, nlit)) return false;
+        if (ip + nlit > bytes || op + nlit > raw_bytes) return false;
+        memcpy(dst + op, src + ip, nlit);
+        ip += nlit;
+        op += nlit;
+        if (ip == bytes) break;  // the last sequence has no match
+
+        if (ip + 2 > bytes) return false;
+        cytnx_uint64 offset = in[ip] | (static_cast<cytnx_uint64>(in[ip + 1]) << 8);
+        ip += 2;
+        cytnx_uint64 mlen = token & 15;
+        if (mlen == 15 && !get_length(in, bytes, ip, mlen)) return false;
+        mlen += min_match;
+        if (offset == 0 || offset > op || op + mlen > raw_bytes) return false;
+        const char *ref = dst + op - offset;
+        if (offset >= mlen) {
+          memcpy(dst + op, ref, mlen);
+        } else {
+          // overlapping match: repeats the last `offset` bytes
+          for (cytnx_uint64 k = 0; k < mlen; k++) dst[op + k] = ref[k];
+        }
+        op += mlen;
+      }
+      return op == raw_bytes;
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
@@ -0,0 +1,45 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_COMPRESS_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_COMPRESS_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Byte shuffle filter: group byte j of every element together.
+     *
+     * dst[j * n + i] = src[i * elem_bytes + j] for the n = bytes / elem_bytes whole elements; a
+     * trailing partial element is copied as is. Numeric data compresses much better shuffled,
+     * since the high-order bytes of neighbouring elements are mostly equal.
+     */
+    void Shuffle_cpu(char *dst, const char *src, const cytnx_uint64 &bytes,
+                     const cytnx_uint64 &elem_bytes);
+
+    // the inverse of Shuffle_cpu()
+    void Unshuffle_cpu(char *dst, const char *src, const cytnx_uint64 &bytes,
+                       const cytnx_uint64 &elem_bytes);
+
+    // the largest output of LzCompress_cpu() for an input of `bytes` bytes
+    inline cytnx_uint64 LzCompressBound(const cytnx_uint64 &bytes) {
+      return bytes + bytes / 255 + 16;
+    }
+
+    /**
+     * @brief A fast LZ77 codec (LZ4-like sequences of literals and 16-bit offset matches).
+     * @return the compressed size, or 0 if it would exceed dst_capacity
+     */
+    cytnx_uint64 LzCompress_cpu(char *dst, const cytnx_uint64 &dst_capacity, const char *src,
+                                const cytnx_uint64 &bytes);
+
+    /**
+     * @brief decompress the output of LzCompress_cpu().
+     * @return whether the input is well formed and decompresses to exactly raw_bytes bytes
+     */
+    bool LzDecompress_cpu(char *dst, const cytnx_uint64 &raw_bytes, const char *src,
+                          const cytnx_uint64 &bytes);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_COMPRESS_CPU_H_
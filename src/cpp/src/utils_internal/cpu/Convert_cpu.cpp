@@ -0,0 +1,371 @@
+#include "Convert_cpu.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #include <immintrin.h>
+  #define CYTNX_HAS_X86_CONVERT_PATH
+  #if (defined(__clang__) && __clang_major__ >= 9) || (!defined(__clang__) && __GNUC__ >= 10)
+    #define CYTNX_HAS_AVX512BF16_PATH
+  #endif
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // elements widened at a time by the reductions; even, so that complex parts stay aligned
+      const cytnx_uint64 reduce_buf = 256;
+
+      typedef void (*ToFloatFn)(cytnx_float *, const cytnx_uint16 *, cytnx_uint64);
+      typedef void (*FromFloatFn)(cytnx_uint16 *, const cytnx_float *, cytnx_uint64);
+
+      void half_to_float_scalar(cytnx_float *out, const cytnx_uint16 *in, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) out[i] = internal::half_bits_to_float(in[i]);
+      }
+      void float_to_half_scalar(cytnx_uint16 *out, const cytnx_float *in, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) out[i] = internal::float_to_half_bits(in[i]);
+      }
+      void bfloat16_to_float_scalar(cytnx_float *out, const cytnx_uint16 *in, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) out[i] = internal::bfloat16_bits_to_float(in[i]);
+      }
+      void float_to_bfloat16_scalar(cytnx_uint16 *out, const cytnx_float *in, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) out[i] = internal::float_to_bfloat16_bits(in[i]);
+      }
+
+#ifdef CYTNX_HAS_X86_CONVERT_PATH
+      __attribute__((target("avx,f16c"))) void half_to_float_f16c(cytnx_float *out,
+                                                                  const cytnx_uint16 *in,
+                                                                  cytnx_uint64 n) {
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= n; i += 8) {
+          const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+          _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+        }
+        half_to_float_scalar(out + i, in + i, n - i);
+      }
+
+      __attribute__((target("avx,f16c"))) void float_to_half_f16c(cytnx_uint16 *out,
+                                                                  const cytnx_float *in,
+                                                                  cytnx_uint64 n) {
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= n; i += 8) {
+          const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+        }
+        float_to_half_scalar(out + i, in + i, n - i);
+      }
+
+      __attribute__((target("avx2"))) void bfloat16_to_float_avx2(cytnx_float *out,
+                                                                   const cytnx_uint16 *in,
+                                                                   cytnx_uint64 n) {
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= n; i += 8) {
+          const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+          const __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(b), 16);
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), x);
+        }
+        bfloat16_to_float_scalar(out + i, in + i, n - i);
+      }
+
+      // the rounding of float_to_bfloat16_bits, eight lanes at a time
+      __attribute__((target("avx2"))) void float_to_bfloat16_avx2(cytnx_uint16 *out,
+                                                                  const cytnx_float *in,
+                                                                  cytnx_uint64 n) {
+        const __m256i one = _mm256_set1_epi32(1), bias = _mm256_set1_epi32(0x7fff);
+        const __m256i quiet = _mm256_set1_epi32(0x00400000);
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= n; i += 8) {
+          const __m256 f = _mm256_loadu_ps(in + i);
+          const __m256i x = _mm256_castps_si256(f);
+          const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+          __m256i r = _mm256_add_epi32(x, _mm256_add_epi32(bias, lsb));
+          const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+          r = _mm256_srli_epi32(_mm256_blendv_epi8(r, _mm256_or_si256(x, quiet), nan), 16);
+          // pack the 32-bit lanes to 16 bits; packus works within 128-bit halves
+          const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0xd8);
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_castsi256_si128(packed));
+        }
+        float_to_bfloat16_scalar(out + i, in + i, n - i);
+      }
+#endif
+
+#ifdef CYTNX_HAS_AVX512BF16_PATH
+      __attribute__((target("avx512f,avx512bf16"))) void float_to_bfloat16_avx512(
+        cytnx_uint16 *out, const cytnx_float *in, cytnx_uint64 n) {
+        cytnx_uint64 i = 0;
+        for (; i + 16 <= n; i += 16) {
+          const __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+          memcpy(out + i, &b, sizeof(b));
+        }
+        float_to_bfloat16_scalar(out + i, in + i, n - i);
+      }
+#endif
+
+      ToFloatFn half_to_float_fn() {
+#ifdef CYTNX_HAS_X86_CONVERT_PATH
+        static const bool use_f16c = Device.has_simd("f16c");
+        if (use_f16c) return half_to_float_f16c;
+#endif
+        return half_to_float_scalar;
+      }
+      FromFloatFn float_to_half_fn() {
+#ifdef CYTNX_HAS_X86_CONVERT_PATH
+        static const bool use_f16c = Device.has_simd("f16c");
+        if (use_f16c) return float_to_half_f16c;
+#endif
+        return float_to_half_scalar;
+      }
+      ToFloatFn bfloat16_to_float_fn() {
+#ifdef CYTNX_HAS_X86_CONVERT_PATH
+        static const bool use_avx2 = Device.has_simd("avx2");
+        if (use_avx2) return bfloat16_to_float_avx2;
+#endif
+        return bfloat16_to_float_scalar;
+      }
+      FromFloatFn float_to_bfloat16_fn() {
+#ifdef CYTNX_HAS_AVX512BF16_PATH
+        static const bool use_avx512 = Device.has_simd("avx512_bf16");
+        if (use_avx512) return float_to_bfloat16_avx512;
+#endif
+#ifdef CYTNX_HAS_X86_CONVERT_PATH
+        static const bool use_avx2 = Device.has_simd("avx2");
+        if (use_avx2) return float_to_bfloat16_avx2;
+#endif
+        return float_to_bfloat16_scalar;
+      }
+
+      ToFloatFn to_float_fn(const cytnx_float16 *) { return half_to_float_fn(); }
+      ToFloatFn to_float_fn(const cytnx_bfloat16 *) { return bfloat16_to_float_fn(); }
+
+      // run fn(begin, count) over chunks of n elements moving elem_bytes each
+      template <class Fn>
+      void for_chunks(const cytnx_uint64 &n, const cytnx_uint64 &elem_bytes,
+                      const BlockingParams &params, const Fn &fn) {
+        const cytnx_uint64 chunk = BlockElems(params.convert_chunk_bytes, elem_bytes);
+        const cytnx_uint64 nchunks = (n + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+        for (cytnx_uint64 c = 0; c < nchunks; c++) {
+          const cytnx_uint64 begin = c * chunk;
+          fn(begin, std::min(chunk, n - begin));
+        }
+      }
+
+      // the partial sums of blocks of n 16-bit values (or products of a and b), at even and odd
+      // positions separately; the blocks are added up in order so that the result does not
+      // depend on the number of threads
+      template <class T>
+      void reduce(const T *a, const T *b, const cytnx_uint64 &n, float &even, float &odd) {
+        const ToFloatFn to_float = to_float_fn(a);
+        const BlockingParams &params = GetBlockingParams();
+        const cytnx_uint64 chunk =
+          std::max(reduce_buf, BlockElems(params.convert_chunk_bytes, 2 * sizeof(cytnx_float)) /
+                                 reduce_buf * reduce_buf);
+        const cytnx_uint64 nchunks = (n + chunk - 1) / chunk;
+        vector<float> partial(2 * nchunks, 0);
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+        for (cytnx_uint64 c = 0; c < nchunks; c++) {
+          float abuf[reduce_buf], bbuf[reduce_buf];
+          float lanes[8] = {};
+          const cytnx_uint64 end = std::min(n, (c + 1) * chunk);
+          for (cytnx_uint64 i = c * chunk; i < end; i += reduce_buf) {
+            const cytnx_uint64 m = std::min(reduce_buf, end - i);
+            to_float(abuf, reinterpret_cast<const cytnx_uint16 *>(a + i), m);
+            if (b) {
+              to_float(bbuf, reinterpret_cast<const cytnx_uint16 *>(b + i), m);
+              for (cytnx_uint64 j = 0; j < m; j++) abuf[j] *= bbuf[j];
+            }
+            // i is even, so the parity of j is the parity of the position
+            cytnx_uint64 j = 0;
+            for (; j + 8 <= m; j += 8)
+              for (int k = 0; k < 8; k++) lanes[k] += abuf[j + k];
+            for (; j < m; j++) lanes[j % 8] += abuf[j];
+          }
+          partial[2 * c] = (lanes[0] + lanes[2]) + (lanes[4] + lanes[6]);
+          partial[2 * c + 1] = (lanes[1] + lanes[3]) + (lanes[5] + lanes[7]);
+        }
+        even = odd = 0;
+        for (cytnx_uint64 c = 0; c < nchunks; c++) {
+          even += partial[2 * c];
+          odd += partial[2 * c + 1];
+        }
+      }
+
+      // float for the 16-bit types, the value itself otherwise
+      template <class T>
+      auto widen(const T &v) {
+        if constexpr (internal::is_half_floating_point_impl<T>::value)
+          return static_cast<cytnx_float>(v);
+        else
+          return v;
+      }
+
+      template <class To, class From>
+      To convert_value(const From &v) {
+        if constexpr (is_complex_v<To>) {
+          using V = typename To::value_type;
+          if constexpr (is_complex_v<From>)
+            return To(static_cast<V>(widen(v.real())), static_cast<V>(widen(v.imag())));
+          else
+            return To(static_cast<V>(widen(v)), V(0.0f));
+        } else if constexpr (is_complex_v<From>) {
+          return static_cast<To>(widen(v.real()));  // rejected by Astype_cpu before the loop
+        } else {
+          return static_cast<To>(widen(v));
+        }
+      }
+    }  // namespace
+
+    void HalfToFloat_cpu(cytnx_float *out, const cytnx_float16 *in, const cytnx_uint64 &n) {
+      HalfToFloat_cpu(out, in, n, GetBlockingParams());
+    }
+    void HalfToFloat_cpu(cytnx_float *out, const cytnx_float16 *in, const cytnx_uint64 &n,
+                         const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.half_to_float");
+      CYTNX_PERF_SCOPE("kernel.half_to_float");
+      const ToFloatFn fn = half_to_float_fn();
+      const auto *src = reinterpret_cast<const cytnx_uint16 *>(in);
+      for_chunks(n, sizeof(cytnx_float) + sizeof(cytnx_float16), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(out + i, src + i, m); });
+    }
+
+    void FloatToHalf_cpu(cytnx_float16 *out, const cytnx_float *in, const cytnx_uint64 &n) {
+      FloatToHalf_cpu(out, in, n, GetBlockingParams());
+    }
+    void FloatToHalf_cpu(cytnx_float16 *out, const cytnx_float *in, const cytnx_uint64 &n,
+                         const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.float_to_half");
+      CYTNX_PERF_SCOPE("kernel.float_to_half");
+      const FromFloatFn fn = float_to_half_fn();
+      auto *des = reinterpret_cast<cytnx_uint16 *>(out);
+      for_chunks(n, sizeof(cytnx_float) + sizeof(cytnx_float16), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(des + i, in + i, m); });
+    }
+
+    void BFloat16ToFloat_cpu(cytnx_float *out, const cytnx_bfloat16 *in, const cytnx_uint64 &n) {
+      BFloat16ToFloat_cpu(out, in, n, GetBlockingParams());
+    }
+    void BFloat16ToFloat_cpu(cytnx_float *out, const cytnx_bfloat16 *in, const cytnx_uint64 &n,
+                             const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.bfloat16_to_float");
+      CYTNX_PERF_SCOPE("kernel.bfloat16_to_float");
+      const ToFloatFn fn = bfloat16_to_float_fn();
+      const auto *src = reinterpret_cast<const cytnx_uint16 *>(in);
+      for_chunks(n, sizeof(cytnx_float) + sizeof(cytnx_bfloat16), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(out + i, src + i, m); });
+    }
+
+    void FloatToBFloat16_cpu(cytnx_bfloat16 *out, const cytnx_float *in, const cytnx_uint64 &n) {
+      FloatToBFloat16_cpu(out, in, n, GetBlockingParams());
+    }
+    void FloatToBFloat16_cpu(cytnx_bfloat16 *out, const cytnx_float *in, const cytnx_uint64 &n,
+                             const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.float_to_bfloat16");
+      CYTNX_PERF_SCOPE("kernel.float_to_bfloat16");
+      const FromFloatFn fn = float_to_bfloat16_fn();
+      auto *des = reinterpret_cast<cytnx_uint16 *>(out);
+      for_chunks(n, sizeof(cytnx_float) + sizeof(cytnx_bfloat16), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(des + i, in + i, m); });
+    }
+
+    cytnx_float Sum_cpu(const cytnx_float16 *in, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.sum_half");
+      float even, odd;
+      reduce<cytnx_float16>(in, nullptr, n, even, odd);
+      return even + odd;
+    }
+    cytnx_float Sum_cpu(const cytnx_bfloat16 *in, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.sum_bfloat16");
+      float even, odd;
+      reduce<cytnx_bfloat16>(in, nullptr, n, even, odd);
+      return even + odd;
+    }
+    cytnx_complex64 Sum_cpu(const cytnx_complex32 *in, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.sum_half");
+      float re, im;
+      reduce<cytnx_float16>(reinterpret_cast<const cytnx_float16 *>(in), nullptr, 2 * n, re, im);
+      return cytnx_complex64(re, im);
+    }
+    cytnx_complex64 Sum_cpu(const cytnx_bcomplex32 *in, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.sum_bfloat16");
+      float re, im;
+      reduce<cytnx_bfloat16>(reinterpret_cast<const cytnx_bfloat16 *>(in), nullptr, 2 * n, re,
+                             im);
+      return cytnx_complex64(re, im);
+    }
+
+    cytnx_float Dot_cpu(const cytnx_float16 *a, const cytnx_float16 *b, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.dot_half");
+      float even, odd;
+      reduce<cytnx_float16>(a, b, n, even, odd);
+      return even + odd;
+    }
+    cytnx_float Dot_cpu(const cytnx_bfloat16 *a, const cytnx_bfloat16 *b,
+                        const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.dot_bfloat16");
+      float even, odd;
+      reduce<cytnx_bfloat16>(a, b, n, even, odd);
+      return even + odd;
+    }
+
+    void Astype_cpu(void *out, const unsigned int &out_dtype, const void *in,
+                    const unsigned int &in_dtype, const cytnx_uint64 &n) {
+      cytnx_error_msg(in_dtype == Type.Void || out_dtype == Type.Void,
+                      "[ERROR] cannot convert from or to Void.%s", "\n");
+      cytnx_error_msg(Type.is_complex(in_dtype) && !Type.is_complex(out_dtype),
+                      "[ERROR] cannot convert %s to the real type %s.\n",
+                      Type.enum_name(in_dtype), Type.enum_name(out_dtype));
+
+      // the vectorized pairs; complex arrays convert as twice as many real elements
+      const cytnx_uint64 reals = Type.is_complex(in_dtype) ? 2 * n : n;
+      const bool from_float = in_dtype == Type.Float || in_dtype == Type.ComplexFloat;
+      const bool to_float = out_dtype == Type.Float || out_dtype == Type.ComplexFloat;
+      if (Type.is_complex(in_dtype) == Type.is_complex(out_dtype)) {
+        if (from_float && (out_dtype == Type.Half || out_dtype == Type.ComplexHalf))
+          return FloatToHalf_cpu(static_cast<cytnx_float16 *>(out),
+                                 static_cast<const cytnx_float *>(in), reals);
+        if (from_float && (out_dtype == Type.BFloat16 || out_dtype == Type.ComplexBFloat16))
+          return FloatToBFloat16_cpu(static_cast<cytnx_bfloat16 *>(out),
+                                     static_cast<const cytnx_float *>(in), reals);
+        if (to_float && (in_dtype == Type.Half || in_dtype == Type.ComplexHalf))
+          return HalfToFloat_cpu(static_cast<cytnx_float *>(out),
+                                 static_cast<const cytnx_float16 *>(in), reals);
+        if (to_float && (in_dtype == Type.BFloat16 || in_dtype == Type.ComplexBFloat16))
+          return BFloat16ToFloat_cpu(static_cast<cytnx_float *>(out),
+                                     static_cast<const cytnx_bfloat16 *>(in), reals);
+      }
+
+      CYTNX_TRACE_SCOPE("kernel.astype");
+      CYTNX_PERF_SCOPE("kernel.astype");
+      dispatch_type(in_dtype, [&](auto in_tag) {
+        using From = typename decltype(in_tag)::type;
+        dispatch_type(out_dtype, [&](auto out_tag) {
+          using To = typename decltype(out_tag)::type;
+          if constexpr (!std::is_same_v<From, void> && !std::is_same_v<To, void>) {
+            const From *src = static_cast<const From *>(in);
+            To *des = static_cast<To *>(out);
+            for_chunks(n, sizeof(From) + sizeof(To), GetBlockingParams(),
+                       [&](cytnx_uint64 i, cytnx_uint64 m) {
+                         for (cytnx_uint64 k = i; k < i + m; k++)
+                           des[k] = convert_value<To>(src[k]);
+                       });
+          }
+        });
+      });
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
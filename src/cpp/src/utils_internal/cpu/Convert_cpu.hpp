@@ -0,0 +1,62 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_CONVERT_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_CONVERT_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Convert between float and the 16-bit floating point types, rounding to nearest
+     * even.
+     *
+     * Uses F16C for Half, AVX2 and AVX512-BF16 for BFloat16 when the CPU has them, and is
+     * parallelized in chunks of `params.convert_chunk_bytes` over `params.convert_threads`
+     * threads. A complex array of n elements converts as 2n real ones.
+     *
+     * The AVX512-BF16 path flushes subnormal floats to zero, like the instruction does.
+     */
+    void HalfToFloat_cpu(cytnx_float *out, const cytnx_float16 *in, const cytnx_uint64 &n);
+    void FloatToHalf_cpu(cytnx_float16 *out, const cytnx_float *in, const cytnx_uint64 &n);
+    void BFloat16ToFloat_cpu(cytnx_float *out, const cytnx_bfloat16 *in, const cytnx_uint64 &n);
+    void FloatToBFloat16_cpu(cytnx_bfloat16 *out, const cytnx_float *in, const cytnx_uint64 &n);
+
+    // same as above with explicit blocking
+    void HalfToFloat_cpu(cytnx_float *out, const cytnx_float16 *in, const cytnx_uint64 &n,
+                         const BlockingParams &params);
+    void FloatToHalf_cpu(cytnx_float16 *out, const cytnx_float *in, const cytnx_uint64 &n,
+                         const BlockingParams &params);
+    void BFloat16ToFloat_cpu(cytnx_float *out, const cytnx_bfloat16 *in, const cytnx_uint64 &n,
+                             const BlockingParams &params);
+    void FloatToBFloat16_cpu(cytnx_bfloat16 *out, const cytnx_float *in, const cytnx_uint64 &n,
+                             const BlockingParams &params);
+
+    /**
+     * @brief Sums and dot products of 16-bit floating point arrays, accumulated in float.
+     *
+     * Blocks of the inputs are widened with the conversion kernels above and summed in float, so
+     * the result does not suffer from the 8 (BFloat16) or 11 (Half) bits of the inputs.
+     */
+    cytnx_float Sum_cpu(const cytnx_float16 *in, const cytnx_uint64 &n);
+    cytnx_float Sum_cpu(const cytnx_bfloat16 *in, const cytnx_uint64 &n);
+    cytnx_complex64 Sum_cpu(const cytnx_complex32 *in, const cytnx_uint64 &n);
+    cytnx_complex64 Sum_cpu(const cytnx_bcomplex32 *in, const cytnx_uint64 &n);
+    cytnx_float Dot_cpu(const cytnx_float16 *a, const cytnx_float16 *b, const cytnx_uint64 &n);
+    cytnx_float Dot_cpu(const cytnx_bfloat16 *a, const cytnx_bfloat16 *b,
+                        const cytnx_uint64 &n);
+
+    /**
+     * @brief Convert n elements of type `in_dtype` to `out_dtype`.
+     *
+     * Conversions between Float (ComplexFloat) and the 16-bit types use the kernels above; any
+     * other pair converts element by element, going through float for the 16-bit types.
+     * Complex to real conversions are rejected.
+     */
+    void Astype_cpu(void *out, const unsigned int &out_dtype, const void *in,
+                    const unsigned int &in_dtype, const cytnx_uint64 &n);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_CONVERT_CPU_H_
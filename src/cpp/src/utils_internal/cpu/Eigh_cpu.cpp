@@ -0,0 +1,142 @@
+#include "Eigh_cpu.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // MRRR computes the eigenvectors of a subset of up to n / kMrrrShare pairs
+      constexpr blas_int kMrrrShare = 5;
+
+      // a workspace size returned by a query
+      template <class T>
+      blas_int query_size(const T &q) {
+        return std::max<blas_int>(1, blas_int(std::real(q)));
+      }
+
+      // ?syevd/?heevd on the upper triangle, the vectors overwriting a
+      template <class T>
+      blas_int syevd(const char &jobz, const blas_int &n, T *a, eigh_real_t<T> *w) {
+        typedef eigh_real_t<T> R;
+        // the real drivers leave the rwork size unset
+        blas_int lwork = -1, lrwork = -1, liwork = -1, iq = 0, info;
+        T q = 0;
+        R rq = 0;
+        const auto call = [&](T *work, R *rwork, blas_int *iwork) {
+          if constexpr (std::is_same_v<T, cytnx_double>)
+            dsyevd(&jobz, "U", &n, a, &n, w, work, &lwork, iwork, &liwork, &info);
+          else if constexpr (std::is_same_v<T, cytnx_float>)
+            ssyevd(&jobz, "U", &n, a, &n, w, work, &lwork, iwork, &liwork, &info);
+          else if constexpr (std::is_same_v<T, cytnx_complex128>)
+            zheevd(&jobz, "U", &n, a, &n, w, work, &lwork, rwork, &lrwork, iwork, &liwork,
+                   &info);
+          else
+            cheevd(&jobz, "U", &n, a, &n, w, work, &lwork, rwork, &lrwork, iwork, &liwork,
+                   &info);
+        };
+        call(&q, &rq, &iq);
+        lwork = query_size(q);
+        lrwork = query_size(rq);
+        liwork = query_size(iq);
+        vector<T> work(lwork);
+        vector<R> rwork(is_complex_v<T> ? lrwork : 0);
+        vector<blas_int> iwork(liwork);
+        call(work.data(), rwork.data(), iwork.data());
+        return info;
+      }
+
+      // ?syevr/?heevr on the upper triangle, m pairs into w and z
+      template <class T>
+      blas_int syevr(const char &jobz, const EighRange &range, const blas_int &n, T *a,
+                     blas_int &m, eigh_real_t<T> *w, T *z) {
+        typedef eigh_real_t<T> R;
+        const R vl = R(range.vl), vu = R(range.vu), abstol = 0;
+        const blas_int il = range.il + 1, iu = range.iu;  // 1-based, inclusive
+        const blas_int cap = range.range == 'I' ? iu - il + 1 : n;
+        vector<blas_int> isuppz(2 * size_t(std::max<blas_int>(cap, 1)));
+        // the real drivers leave the rwork size unset
+        blas_int lwork = -1, lrwork = -1, liwork = -1, iq = 0, info;
+        T q = 0;
+        R rq = 0;
+        const auto call = [&](T *work, R *rwork, blas_int *iwork) {
+          if constexpr (std::is_same_v<T, cytnx_double>)
+            dsyevr(&jobz, &range.range, "U", &n, a, &n, &vl, &vu, &il, &iu, &abstol, &m, w, z,
+                   &n, isuppz.data(), work, &lwork, iwork, &liwork, &info);
+          else if constexpr (std::is_same_v<T, cytnx_float>)
+            ssyevr(&jobz, &range.range, "U", &n, a, &n, &vl, &vu, &il, &iu, &abstol, &m, w, z,
+                   &n, isuppz.data(), work, &lwork, iwork, &liwork, &info);
+          else if constexpr (std::is_same_v<T, cytnx_complex128>)
+            zheevr(&jobz, &range.range, "U", &n, a, &n, &vl, &vu, &il, &iu, &abstol, &m, w, z,
+                   &n, isuppz.data(), work, &lwork, rwork, &lrwork, iwork, &liwork, &info);
+          else
+            cheevr(&jobz, &range.range, "U", &n, a, &n, &vl, &vu, &il, &iu, &abstol, &m, w, z,
+                   &n, isuppz.data(), work, &lwork, rwork, &lrwork, iwork, &liwork, &info);
+        };
+        call(&q, &rq, &iq);
+        lwork = query_size(q);
+        lrwork = query_size(rq);
+        liwork = query_size(iq);
+        vector<T> work(lwork);
+        vector<R> rwork(is_complex_v<T> ? lrwork : 0);
+        vector<blas_int> iwork(liwork);
+        call(work.data(), rwork.data(), iwork.data());
+        return info;
+      }
+    }  // namespace
+
+    EighDriver eigh_driver(const blas_int &n, const EighRange &range, const bool &vectors) {
+      if (!vectors || range.range == 'A') return EighDriver::DivideConquer;
+      if (range.range == 'V') return EighDriver::Mrrr;
+      return (range.iu - range.il) * kMrrrShare <= n ? EighDriver::Mrrr
+                                                     : EighDriver::DivideConquer;
+    }
+
+    template <class T>
+    EighResult Eigh_cpu(T *a, const blas_int &n, const EighRange &range, const bool &vectors,
+                        eigh_real_t<T> *w, T *z, const EighDriver &driver) {
+      CYTNX_TRACE_SCOPE("kernel.eigh");
+      const EighDriver drv =
+        driver == EighDriver::Auto ? eigh_driver(n, range, vectors) : driver;
+      if (n == 0 || (range.range == 'I' && range.il >= range.iu)) return {drv, 0, 0};
+      const char jobz = vectors ? 'V' : 'N';
+      if (drv == EighDriver::Mrrr) {
+        blas_int m = 0;
+        const blas_int info = syevr(jobz, range, n, a, m, w, z);
+        cytnx_system_error_msg(info != 0, "[ERROR] eigh: ?syevr/?heevr failed (info %d).\n",
+                               int(info));
+        return {drv, 0, m};
+      }
+
+      const blas_int info = syevd(jobz, n, a, w);
+      cytnx_system_error_msg(info != 0, "[ERROR] eigh: ?syevd/?heevd failed (info %d).\n",
+                             int(info));
+      if (range.range == 'I') return {drv, range.il, range.iu - range.il};
+      if (range.range == 'V') {
+        // the same half-open interval (vl, vu] as ?syevr
+        const eigh_real_t<T> vl = eigh_real_t<T>(range.vl), vu = eigh_real_t<T>(range.vu);
+        const blas_int first = blas_int(std::upper_bound(w, w + n, vl) - w);
+        const blas_int last = blas_int(std::upper_bound(w, w + n, vu) - w);
+        return {drv, first, std::max<blas_int>(last - first, 0)};
+      }
+      return {drv, 0, n};
+    }
+
+#define CYTNX_EIGH_INSTANTIATE(T)                                                               \
+  template EighResult Eigh_cpu<T>(T *, const blas_int &, const EighRange &, const bool &,       \
+                                  eigh_real_t<T> *, T *, const EighDriver &);
+    CYTNX_EIGH_INSTANTIATE(cytnx_double)
+    CYTNX_EIGH_INSTANTIATE(cytnx_float)
+    CYTNX_EIGH_INSTANTIATE(cytnx_complex128)
+    CYTNX_EIGH_INSTANTIATE(cytnx_complex64)
+#undef CYTNX_EIGH_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
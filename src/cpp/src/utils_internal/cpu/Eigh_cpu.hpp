@@ -0,0 +1,66 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_EIGH_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_EIGH_CPU_H_
+
+#include <complex>
+#include <utility>
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    // the real type of the eigenvalues of a T matrix
+    template <class T>
+    using eigh_real_t = decltype(std::real(std::declval<T>()));
+
+    // the LAPACK drivers of Eigh_cpu()
+    enum class EighDriver : int {
+      Auto,
+      DivideConquer,  // ?syevd/?heevd: the whole spectrum, the subset taken afterwards
+      Mrrr            // ?syevr/?heevr: only the requested pairs
+    };
+
+    // which eigenpairs to compute, as the range argument of ?syevr
+    struct EighRange {
+      char range = 'A';  // 'A' all, 'I' those of indices [il, iu), 'V' those in (vl, vu]
+      blas_int il = 0, iu = 0;  // 0-based, in ascending order of the eigenvalues
+      double vl = 0, vu = 0;
+    };
+
+    /**
+     * @brief The driver Auto picks for the range of an n x n matrix.
+     *
+     * The reduction to tridiagonal form dominates unless all eigenvectors are wanted, so for
+     * eigenvalues alone the whole spectrum (by the root-free QR of ?syevd) is as cheap as any
+     * subset. For eigenvectors, MRRR back-transforms only the requested ones, which pays off
+     * for up to about a fifth of the spectrum; beyond that divide and conquer is faster (as
+     * measured with OpenBLAS on n = 64 ... 1024). A value range has an unknown count and goes
+     * to MRRR.
+     */
+    EighDriver eigh_driver(const blas_int &n, const EighRange &range, const bool &vectors);
+
+    // the pairs found: eigenvalues w[first, first + count), ascending, and the vectors in the
+    // same columns of a (DivideConquer) or of z (Mrrr)
+    struct EighResult {
+      EighDriver driver;
+      blas_int first, count;
+    };
+
+    /**
+     * @brief The eigenvalues, and with `vectors` the eigenvectors, of the Hermitian n x n
+     * matrix a, column-major, of which only the upper triangle is read (the lower one of the
+     * row-major matrix).
+     *
+     * a is destroyed; w holds n elements. z is only used by the Mrrr driver, which needs it to
+     * hold n x (the number of requested pairs, n for a value range) elements apart from a; the
+     * DivideConquer driver leaves the vectors in a. Thread-safe, the workspace is allocated per
+     * call.
+     */
+    template <class T>
+    EighResult Eigh_cpu(T *a, const blas_int &n, const EighRange &range, const bool &vectors,
+                        eigh_real_t<T> *w, T *z, const EighDriver &driver = EighDriver::Auto);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_EIGH_CPU_H_
@@ -0,0 +1,169 @@
+#include "Expm_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      typedef cytnx_complex128 C;
+
+      // the largest 1-norm each Padé degree handles to double precision (Higham 2005, Table 2.3)
+      constexpr int kDegrees[] = {3, 5, 7, 9};
+      constexpr double kTheta[] = {1.495585217958292e-2, 2.539398330063230e-1,
+                                   9.504178996162932e-1, 2.097847961257068e0};
+      constexpr double kTheta13 = 5.371920351148152;
+
+      // the coefficients b_0 ... b_m of the degree-m approximant
+      const double *pade_coefficients(const int &m) {
+        static const double b3[] = {120, 60, 12, 1};
+        static const double b5[] = {30240, 15120, 3360, 420, 30, 1};
+        static const double b7[] = {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1};
+        static const double b9[] = {17643225600., 8821612800., 2075673600., 302702400.,
+                                    30270240.,    2162160.,    110880.,     3960.,
+                                    90.,          1.};
+        static const double b13[] = {64764752532480000., 32382376266240000., 7771770303897600.,
+                                     1187353796428800.,  129060195264000.,   10559470521600.,
+                                     670442572800.,      33522128640.,       1323241920.,
+                                     40840800.,          960960.,            16380.,
+                                     182.,               1.};
+        switch (m) {
+          case 3:
+            return b3;
+          case 5:
+            return b5;
+          case 7:
+            return b7;
+          case 9:
+            return b9;
+          default:
+            return b13;
+        }
+      }
+
+      // the larger of the 1- and infinity-norms, so that either layout is bounded
+      double norm_bound(const C *a, const blas_int &n) {
+        double col = 0, row = 0;
+        for (blas_int j = 0; j < n; j++) {
+          double sc = 0, sr = 0;
+          for (blas_int i = 0; i < n; i++) {
+            sc += std::abs(a[i + size_t(j) * n]);
+            sr += std::abs(a[j + size_t(i) * n]);
+          }
+          col = std::max(col, sc);
+          row = std::max(row, sr);
+        }
+        return std::max(col, row);
+      }
+
+      void gemm(const blas_int &n, const C *a, const C *b, C *c) {
+        const C one = 1, zero = 0;
+        zgemm("N", "N", &n, &n, &n, &one, a, &n, b, &n, &zero, c, &n);
+      }
+
+      // c = sum_k w[k] * p[k] over the given matrices, plus w_id on the diagonal
+      void combine(C *c, const blas_int &n, const double &w_id, const C *const *p,
+                   const double *w, const int &count) {
+        const size_t nn = size_t(n) * n;
+        for (size_t e = 0; e < nn; e++) {
+          C s = 0;
+          for (int k = 0; k < count; k++) s += w[k] * p[k][e];
+          c[e] = s;
+        }
+        for (blas_int i = 0; i < n; i++) c[i + size_t(i) * n] += w_id;
+      }
+    }  // namespace
+
+    void Expm_cpu(C *out, const C *a, const blas_int &n, ExpmWork &work) {
+      CYTNX_TRACE_SCOPE("kernel.expm");
+      if (n == 0) return;
+      const size_t nn = size_t(n) * n;
+      work.buf.resize(7 * nn);
+      work.ipiv.resize(n);
+      C *as = work.buf.data(), *a2 = as + nn, *a4 = a2 + nn, *a6 = a4 + nn, *u = a6 + nn,
+        *v = u + nn, *t = v + nn;
+
+      const double norm = norm_bound(a, n);
+      int m = 13, s = 0;
+      for (int d = 0; d < 4; d++) {
+        if (norm <= kTheta[d]) {
+          m = kDegrees[d];
+          break;
+        }
+      }
+      if (m == 13 && norm > kTheta13) s = int(std::ceil(std::log2(norm / kTheta13)));
+      const double scale = std::ldexp(1.0, -s);
+      for (size_t e = 0; e < nn; e++) as[e] = a[e] * scale;
+      const double *b = pade_coefficients(m);
+
+      // u = as * (odd part), v = even part, both polynomials in a2 = as^2
+      gemm(n, as, as, a2);
+      if (m >= 5) gemm(n, a2, a2, a4);
+      if (m >= 7) gemm(n, a2, a4, a6);
+      if (m <= 9) {
+        const C *p[] = {a2, a4, a6, nullptr};
+        if (m == 9) {
+          gemm(n, a4, a4, t);
+          p[3] = t;
+        }
+        const int count = (m - 1) / 2;
+        double wu[4], wv[4];
+        for (int k = 0; k < count; k++) {
+          wu[k] = b[2 * k + 3];
+          wv[k] = b[2 * k + 2];
+        }
+        combine(v, n, b[0], p, wv, count);
+        combine(u, n, b[1], p, wu, count);
+        std::memcpy(t, u, nn * sizeof(C));
+        gemm(n, as, t, u);
+      } else {
+        const C *p[] = {a2, a4, a6};
+        const double wu_hi[] = {b[9], b[11], b[13]}, wv_hi[] = {b[8], b[10], b[12]};
+        const double wu_lo[] = {b[3], b[5], b[7]}, wv_lo[] = {b[2], b[4], b[6]};
+        // u = as * (a6 * (b13 a6 + b11 a4 + b9 a2) + b7 a6 + b5 a4 + b3 a2 + b1 I)
+        combine(t, n, 0, p, wu_hi, 3);
+        gemm(n, a6, t, u);
+        combine(t, n, b[1], p, wu_lo, 3);
+        for (size_t e = 0; e < nn; e++) t[e] += u[e];
+        gemm(n, as, t, u);
+        // v = a6 * (b12 a6 + b10 a4 + b8 a2) + b6 a6 + b4 a4 + b2 a2 + b0 I
+        combine(t, n, 0, p, wv_hi, 3);
+        gemm(n, a6, t, v);
+        combine(t, n, b[0], p, wv_lo, 3);
+        for (size_t e = 0; e < nn; e++) v[e] += t[e];
+      }
+
+      // r = (v - u)^-1 (v + u)
+      for (size_t e = 0; e < nn; e++) {
+        t[e] = v[e] - u[e];
+        v[e] += u[e];
+      }
+      blas_int info;
+      zgetrf(&n, &n, t, &n, work.ipiv.data(), &info);
+      cytnx_system_error_msg(info != 0,
+                             "[ERROR] expm: the Padé denominator is singular (info %d).\n",
+                             int(info));
+      // u is free by now and holds n^2 >= n elements of workspace
+      const blas_int lwork = blas_int(nn);
+      zgetri(&n, t, &n, work.ipiv.data(), u, &lwork, &info);
+      cytnx_system_error_msg(info != 0, "[ERROR] expm: zgetri failed (info %d).\n", int(info));
+      gemm(n, t, v, s % 2 ? a2 : out);
+
+      // square s times, alternating between out and a2 so that the last square lands in out
+      C *src = s % 2 ? a2 : out, *dst = s % 2 ? out : a2;
+      for (int k = 0; k < s; k++) {
+        gemm(n, src, src, dst);
+        std::swap(src, dst);
+      }
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
@@ -0,0 +1,32 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_EXPM_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_EXPM_CPU_H_
+
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    // the scratch of Expm_cpu(), kept between calls so that repeated ones do not allocate
+    struct ExpmWork {
+      std::vector<cytnx_complex128> buf;
+      std::vector<blas_int> ipiv;
+    };
+
+    /**
+     * @brief out = exp(a) for a dense n x n complex matrix.
+     *
+     * The diagonal Padé approximant of degree 3, 5, 7, 9 or 13, the lowest whose backward error
+     * stays below double precision at the 1-norm of a, is applied after scaling a by 2^-s and
+     * squared s times (Higham, SIAM J. Matrix Anal. Appl. 26, 2005). The products go to zgemm,
+     * the denominator to zgetrf and zgetri. a and out may alias; exp commutes with the
+     * transpose, so the row- or column-major layout does not matter.
+     */
+    void Expm_cpu(cytnx_complex128 *out, const cytnx_complex128 *a, const blas_int &n,
+                  ExpmWork &work);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_EXPM_CPU_H_
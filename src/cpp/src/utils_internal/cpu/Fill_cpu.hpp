@@ -1,7 +1,10 @@
 #ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_FILL_CPU_H_
 #define CYTNX_BACKEND_UTILS_INTERNAL_CPU_FILL_CPU_H_
 
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
 #include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
 
 #ifdef UNI_OMP
   #include <omp.h>
@@ -15,22 +18,34 @@ namespace cytnx_core {
      * `first`.
      *
      * This function act the same as `std::fill_n`. The execution will be parallelized when OMP is
-     * enabled.
+     * enabled, in chunks of `params.fill_chunk_bytes` over `params.fill_threads` threads.
      *
      * @tparam DType the data type of the elements in the range
      *
      * @param first the beginning of the range
      * @param value the value to be assigned
      * @param count the number of elements to modify
+     * @param params the blocking parameters, see GetBlockingParams()
      */
     template <typename DType>
-    void FillCpu(void *first, const DType &value, cytnx_uint64 count) {
+    void FillCpu(void *first, const DType &value, cytnx_uint64 count,
+                 const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.fill");
+      CYTNX_PERF_SCOPE("kernel.fill");
       DType *typed_first = reinterpret_cast<DType *>(first);
-#pragma omp parallel for schedule(static)
+      // only read by the OpenMP pragma
+      [[maybe_unused]] const cytnx_uint64 chunk =
+        BlockElems(params.fill_chunk_bytes, sizeof(DType));
+#pragma omp parallel for schedule(static, chunk) if (count > chunk) num_threads(params.fill_threads)
       for (cytnx_uint64 i = 0; i < count; i++) {
         typed_first[i] = value;
       }
     }
+
+    template <typename DType>
+    void FillCpu(void *first, const DType &value, cytnx_uint64 count) {
+      FillCpu(first, value, count, GetBlockingParams());
+    }
   }  // namespace utils_internal
 }  // namespace cytnx_core
 
@@ -0,0 +1,202 @@
+#include "Permute_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // an element copied as raw bytes; alignment 1, so any address is valid
+      template <cytnx_uint64 N>
+      struct Elem {
+        unsigned char b[N];
+      };
+
+      // the copy after dropping axes of extent 1 and merging axes contiguous in both layouts
+      struct Layout {
+        vector<cytnx_uint64> shape;
+        vector<cytnx_uint64> sstr;  // source strides
+        vector<cytnx_uint64> dstr;  // destination (row-major) strides
+      };
+
+      Layout merge_axes(const vector<cytnx_uint64> &shape, const vector<cytnx_uint64> &strides) {
+        Layout out;
+        for (cytnx_uint64 i = 0; i < shape.size(); i++) {
+          if (shape[i] == 1) continue;
+          if (!out.shape.empty() && out.sstr.back() == strides[i] * shape[i]) {
+            out.shape.back() *= shape[i];
+            out.sstr.back() = strides[i];
+          } else {
+            out.shape.push_back(shape[i]);
+            out.sstr.push_back(strides[i]);
+          }
+        }
+        out.dstr.resize(out.shape.size());
+        cytnx_uint64 s = 1;
+        for (cytnx_uint64 i = out.shape.size(); i-- > 0;) {
+          out.dstr[i] = s;
+          s *= out.shape[i];
+        }
+        return out;
+      }
+
+      // the source offset of the row-major index `r` over the first `naxes` axes
+      cytnx_uint64 row_offset(const Layout &l, const cytnx_uint64 &naxes, cytnx_uint64 r,
+                              cytnx_uint64 *idx) {
+        cytnx_uint64 off = 0;
+        for (cytnx_uint64 ax = naxes; ax-- > 0;) {
+          idx[ax] = r % l.shape[ax];
+          r /= l.shape[ax];
+          off += idx[ax] * l.sstr[ax];
+        }
+        return off;
+      }
+
+      // copy row by row along the last axis; a contiguous source row is a single memcpy
+      template <class E>
+      void copy_rows(E *dst, const E *src, const Layout &l, const BlockingParams &params) {
+        const cytnx_uint64 rank = l.shape.size();
+        const cytnx_uint64 len = l.shape[rank - 1];
+        const cytnx_uint64 step = l.sstr[rank - 1];
+        cytnx_uint64 nrows = 1;
+        for (cytnx_uint64 i = 0; i + 1 < rank; i++) nrows *= l.shape[i];
+        const cytnx_uint64 chunk = BlockElems(params.convert_chunk_bytes, 2 * len * sizeof(E));
+        const cytnx_int64 nchunks = (nrows + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+        for (cytnx_int64 c = 0; c < nchunks; c++) {
+          const cytnx_uint64 r0 = c * chunk;
+          const cytnx_uint64 r1 = std::min(nrows, r0 + chunk);
+          vector<cytnx_uint64> idx(rank);
+          cytnx_uint64 off = row_offset(l, rank - 1, r0, idx.data());
+          for (cytnx_uint64 r = r0; r < r1; r++) {
+            E *d = dst + r * len;
+            if (step == 1) {
+              memcpy(d, src + off, len * sizeof(E));
+            } else {
+              const E *s = src + off;
+              for (cytnx_uint64 j = 0; j < len; j++) d[j] = s[j * step];
+            }
+            // advance the odometer over the outer axes
+            for (cytnx_uint64 ax = rank - 1; ax-- > 0;) {
+              off += l.sstr[ax];
+              if (++idx[ax] < l.shape[ax]) break;
+              off -= l.shape[ax] * l.sstr[ax];
+              idx[ax] = 0;
+            }
+          }
+        }
+      }
+
+      // the last axis is strided and axis `a` has stride 1: copy square tiles of the (a, last)
+      // plane, reading columns of the source tile and writing rows of the destination tile
+      template <class E>
+      void copy_tiles(E *dst, const E *src, const Layout &l, const cytnx_uint64 &a,
+                      const BlockingParams &params) {
+        const cytnx_uint64 rank = l.shape.size();
+        const cytnx_uint64 k = rank - 1;
+        const cytnx_uint64 tile = std::max<cytnx_uint64>(
+          1, (cytnx_uint64)std::sqrt(double(BlockElems(params.permute_tile_bytes, sizeof(E)))));
+        const cytnx_uint64 ti = (l.shape[a] + tile - 1) / tile;
+        const cytnx_uint64 tj = (l.shape[k] + tile - 1) / tile;
+        // the outer axes are all but a and k
+        Layout outer;
+        for (cytnx_uint64 ax = 0; ax < k; ax++) {
+          if (ax == a) continue;
+          outer.shape.push_back(l.shape[ax]);
+          outer.sstr.push_back(l.sstr[ax]);
+          outer.dstr.push_back(l.dstr[ax]);
+        }
+        cytnx_uint64 nouter = 1;
+        for (auto s : outer.shape) nouter *= s;
+        const cytnx_int64 nitems = nouter * ti * tj;
+        const cytnx_uint64 dstr_a = l.dstr[a];
+        const cytnx_uint64 sstr_k = l.sstr[k];
+#pragma omp parallel for schedule(static) if (nitems > 1) num_threads(params.convert_threads)
+        for (cytnx_int64 item = 0; item < nitems; item++) {
+          cytnx_uint64 r = item;
+          const cytnx_uint64 j0 = (r % tj) * tile;
+          r /= tj;
+          const cytnx_uint64 i0 = (r % ti) * tile;
+          r /= ti;
+          cytnx_uint64 soff = 0, doff = 0;
+          for (cytnx_uint64 ax = outer.shape.size(); ax-- > 0;) {
+            const cytnx_uint64 x = r % outer.shape[ax];
+            r /= outer.shape[ax];
+            soff += x * outer.sstr[ax];
+            doff += x * outer.dstr[ax];
+          }
+          const cytnx_uint64 i1 = std::min(l.shape[a], i0 + tile);
+          const cytnx_uint64 j1 = std::min(l.shape[k], j0 + tile);
+          for (cytnx_uint64 i = i0; i < i1; i++) {
+            E *d = dst + doff + i * dstr_a;
+            const E *s = src + soff + i;
+            for (cytnx_uint64 j = j0; j < j1; j++) d[j] = s[j * sstr_k];
+          }
+        }
+      }
+
+      template <class E>
+      void strided_copy(void *dst, const void *src, const Layout &l,
+                        const BlockingParams &params) {
+        E *d = static_cast<E *>(dst);
+        const E *s = static_cast<const E *>(src);
+        const cytnx_uint64 rank = l.shape.size();
+        if (rank == 0) {
+          d[0] = s[0];
+          return;
+        }
+        if (l.sstr[rank - 1] != 1) {
+          for (cytnx_uint64 a = 0; a + 1 < rank; a++)
+            if (l.sstr[a] == 1) return copy_tiles(d, s, l, a, params);
+        }
+        copy_rows(d, s, l, params);
+      }
+    }  // namespace
+
+    void StridedCopy_cpu(void *dst, const void *src, const cytnx_uint64 &elem_bytes,
+                         const vector<cytnx_uint64> &shape, const vector<cytnx_uint64> &strides,
+                         const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.strided_copy");
+      CYTNX_PERF_SCOPE("kernel.strided_copy");
+      cytnx_error_msg(shape.size() != strides.size(),
+                      "[ERROR] StridedCopy_cpu got %d extents and %d strides.\n",
+                      (int)shape.size(), (int)strides.size());
+      for (auto s : shape)
+        if (s == 0) return;
+      const Layout l = merge_axes(shape, strides);
+      switch (elem_bytes) {
+        case 1:
+          return strided_copy<Elem<1>>(dst, src, l, params);
+        case 2:
+          return strided_copy<Elem<2>>(dst, src, l, params);
+        case 4:
+          return strided_copy<Elem<4>>(dst, src, l, params);
+        case 8:
+          return strided_copy<Elem<8>>(dst, src, l, params);
+        case 16:
+          return strided_copy<Elem<16>>(dst, src, l, params);
+        default:
+          cytnx_error_msg(true, "[ERROR] StridedCopy_cpu of %llu-byte elements.\n",
+                          (unsigned long long)elem_bytes);
+      }
+    }
+
+    void StridedCopy_cpu(void *dst, const void *src, const cytnx_uint64 &elem_bytes,
+                         const vector<cytnx_uint64> &shape, const vector<cytnx_uint64> &strides) {
+      StridedCopy_cpu(dst, src, elem_bytes, shape, strides, GetBlockingParams());
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
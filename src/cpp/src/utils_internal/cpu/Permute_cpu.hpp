@@ -0,0 +1,35 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_PERMUTE_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_PERMUTE_CPU_H_
+
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Gather a strided array into contiguous (row-major) memory.
+     *
+     * `src` is the first element of an array of `shape`, whose axis i advances `strides[i]`
+     * elements of `elem_bytes` bytes. Axes that are contiguous in both layouts are merged first,
+     * so a view that only slices copies whole rows with memcpy. When the last axis of `src` is
+     * strided but another axis has stride 1 (a transpose), the copy walks square tiles of
+     * `params.permute_tile_bytes` bytes, so that the source and destination tiles stay in L1.
+     *
+     * Rows or tiles are spread over `params.convert_threads` threads.
+     */
+    void StridedCopy_cpu(void *dst, const void *src, const cytnx_uint64 &elem_bytes,
+                         const std::vector<cytnx_uint64> &shape,
+                         const std::vector<cytnx_uint64> &strides);
+
+    // same as above with explicit blocking
+    void StridedCopy_cpu(void *dst, const void *src, const cytnx_uint64 &elem_bytes,
+                         const std::vector<cytnx_uint64> &shape,
+                         const std::vector<cytnx_uint64> &strides, const BlockingParams &params);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_PERMUTE_CPU_H_
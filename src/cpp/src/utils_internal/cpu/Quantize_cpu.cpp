@@ -0,0 +1,283 @@
+#include "Quantize_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+
+#include "Blocking_cpu.hpp"
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #include <immintrin.h>
+  #define CYTNX_HAS_AVX2_QUANTIZE_PATH
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      struct BlockStats {
+        float sq_err = 0, sq_ref = 0, max_err = 0;
+      };
+
+      // NaN if x holds a NaN or an inf: max() drops NaNs, so they are summed up as x * 0
+      float amax_scalar(const float *x, cytnx_uint64 m) {
+        float amax = 0, nonfinite = 0;
+        for (cytnx_uint64 i = 0; i < m; i++) {
+          amax = std::max(amax, std::fabs(x[i]));
+          nonfinite += x[i] * 0;
+        }
+        return amax + nonfinite;
+      }
+
+      // codes of x with the given scale; rounds to nearest even like cvtps_epi32
+      void codes_scalar(cytnx_int8 *codes, const float *x, cytnx_uint64 m, const float &scale,
+                        const float &inv, const float &qmax, BlockStats &st) {
+        for (cytnx_uint64 i = 0; i < m; i++) {
+          const float q = std::min(qmax, std::max(-qmax, std::nearbyint(x[i] * inv)));
+          codes[i] = cytnx_int8(q);
+          const float e = x[i] - q * scale;
+          st.sq_err += e * e;
+          st.sq_ref += x[i] * x[i];
+          st.max_err = std::max(st.max_err, std::fabs(e));
+        }
+      }
+
+      void decode_scalar(float *out, const cytnx_int8 *codes, cytnx_uint64 m,
+                         const float &scale) {
+        for (cytnx_uint64 i = 0; i < m; i++) out[i] = codes[i] * scale;
+      }
+
+#ifdef CYTNX_HAS_AVX2_QUANTIZE_PATH
+      __attribute__((target("avx2"))) float hmax(__m256 v) {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+      }
+      __attribute__((target("avx2"))) float hsum(__m256 v) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return _mm_cvtss_f32(s);
+      }
+
+      __attribute__((target("avx2"))) float amax_avx2(const float *x, cytnx_uint64 m) {
+        const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        const __m256 zero = _mm256_setzero_ps();
+        __m256 amax = zero, nonfinite = zero;
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= m; i += 8) {
+          const __m256 v = _mm256_loadu_ps(x + i);
+          amax = _mm256_max_ps(amax, _mm256_and_ps(v, abs_mask));
+          nonfinite = _mm256_add_ps(nonfinite, _mm256_mul_ps(v, zero));
+        }
+        return std::max(hmax(amax), amax_scalar(x + i, m - i)) + hsum(nonfinite);
+      }
+
+      __attribute__((target("avx2"))) void codes_avx2(cytnx_int8 *codes, const float *x,
+                                                      cytnx_uint64 m, const float &scale,
+                                                      const float &inv, const float &qmax,
+                                                      BlockStats &st) {
+        const __m256 vscale = _mm256_set1_ps(scale), vinv = _mm256_set1_ps(inv);
+        const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        const __m256i hi = _mm256_set1_epi32(int(qmax)), lo = _mm256_set1_epi32(-int(qmax));
+        __m256 sq_err = _mm256_setzero_ps(), sq_ref = _mm256_setzero_ps();
+        __m256 max_err = _mm256_setzero_ps();
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= m; i += 8) {
+          const __m256 v = _mm256_loadu_ps(x + i);
+          __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(v, vinv));
+          q = _mm256_max_epi32(lo, _mm256_min_epi32(hi, q));
+          const __m256 e = _mm256_sub_ps(v, _mm256_mul_ps(_mm256_cvtepi32_ps(q), vscale));
+          sq_err = _mm256_add_ps(sq_err, _mm256_mul_ps(e, e));
+          sq_ref = _mm256_add_ps(sq_ref, _mm256_mul_ps(v, v));
+          max_err = _mm256_max_ps(max_err, _mm256_and_ps(e, abs_mask));
+          // 8 x int32 -> 8 x int8; the packs work within 128-bit halves
+          const __m256i q16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(q, q), 0xd8);
+          const __m128i q8 = _mm_packs_epi16(_mm256_castsi256_si128(q16), _mm_setzero_si128());
+          _mm_storel_epi64(reinterpret_cast<__m128i *>(codes + i), q8);
+        }
+        st.sq_err += hsum(sq_err);
+        st.sq_ref += hsum(sq_ref);
+        st.max_err = std::max(st.max_err, hmax(max_err));
+        codes_scalar(codes + i, x + i, m - i, scale, inv, qmax, st);
+      }
+
+      __attribute__((target("avx2"))) void decode_avx2(float *out, const cytnx_int8 *codes,
+                                                       cytnx_uint64 m, const float &scale) {
+        const __m256 vscale = _mm256_set1_ps(scale);
+        cytnx_uint64 i = 0;
+        for (; i + 8 <= m; i += 8) {
+          const __m128i c = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(codes + i));
+          const __m256 v = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(c));
+          _mm256_storeu_ps(out + i, _mm256_mul_ps(v, vscale));
+        }
+        decode_scalar(out + i, codes + i, m - i, scale);
+      }
+#endif
+
+      struct Kernels {
+        float (*amax)(const float *, cytnx_uint64);
+        void (*codes)(cytnx_int8 *, const float *, cytnx_uint64, const float &, const float &,
+                      const float &, BlockStats &);
+        void (*decode)(float *, const cytnx_int8 *, cytnx_uint64, const float &);
+      };
+
+      const Kernels &kernels() {
+        static const Kernels k = []() {
+#ifdef CYTNX_HAS_AVX2_QUANTIZE_PATH
+          if (Device.has_simd("avx2")) return Kernels{amax_avx2, codes_avx2, decode_avx2};
+#endif
+          return Kernels{amax_scalar, codes_scalar, decode_scalar};
+        }();
+        return k;
+      }
+
+      // two 4-bit codes per byte, the first in the low nibble
+      void pack4(cytnx_int8 *q, const cytnx_int8 *codes, cytnx_uint64 m) {
+        cytnx_uint64 i = 0;
+        for (; i + 2 <= m; i += 2) q[i / 2] = cytnx_int8((codes[i] & 0xf) | (codes[i + 1] << 4));
+        if (i < m) q[i / 2] = cytnx_int8(codes[i] & 0xf);
+      }
+      void unpack4(cytnx_int8 *codes, const cytnx_int8 *q, cytnx_uint64 m) {
+        // shift the low nibble to the top, then back with sign extension
+        cytnx_uint64 i = 0;
+        for (; i + 2 <= m; i += 2) {
+          codes[i] = cytnx_int8(cytnx_int8(q[i / 2] << 4) >> 4);
+          codes[i + 1] = cytnx_int8(q[i / 2] >> 4);
+        }
+        if (i < m) codes[i] = cytnx_int8(cytnx_int8(q[i / 2] << 4) >> 4);
+      }
+
+      void check_args(const unsigned int &dtype, const cytnx_uint64 &block, const int &bits) {
+        cytnx_error_msg(bits != 8 && bits != 4, "[ERROR] quantization to %d bits, expect 8 or 4.\n",
+                        bits);
+        cytnx_error_msg(block == 0 || (bits == 4 && block % 2),
+                        "[ERROR] invalid quantization block of %llu values%s.\n",
+                        (unsigned long long)block, bits == 4 ? " (must be even for 4 bits)" : "");
+        cytnx_error_msg(!Type.is_float(dtype) || Type.is_complex(dtype),
+                        "[ERROR] quantization of %s values, expect a real floating point type.\n",
+                        Type.enum_name(dtype));
+      }
+    }  // namespace
+
+    void Quantize_cpu(cytnx_int8 *q, cytnx_float *scales, const void *in,
+                      const unsigned int &dtype, const cytnx_uint64 &n,
+                      const cytnx_uint64 &block, const int &bits, QuantizeStats *stats) {
+      CYTNX_TRACE_SCOPE("kernel.quantize");
+      CYTNX_PERF_SCOPE("kernel.quantize");
+      check_args(dtype, block, bits);
+      const Kernels &k = kernels();
+      const float qmax = bits == 8 ? 127 : 7;
+      const BlockingParams &params = GetBlockingParams();
+      const cytnx_uint64 nblocks = (n + block - 1) / block;
+
+      double sq_err = 0, sq_ref = 0, max_err = 0, max_abs = 0;
+      cytnx_uint64 nonfinite = 0;
+      dispatch_type(dtype, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        if constexpr (std::is_floating_point_v<T> ||
+                      internal::is_half_floating_point_impl<T>::value) {
+          const T *src = static_cast<const T *>(in);
+          const cytnx_uint64 per_chunk = BlockElems(params.convert_chunk_bytes,
+                                                    block * (sizeof(T) + 1));
+          const cytnx_uint64 nchunks = (nblocks + per_chunk - 1) / per_chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads) \
+  reduction(+ : sq_err, sq_ref, nonfinite) reduction(max : max_err, max_abs)
+          for (cytnx_uint64 c = 0; c < nchunks; c++) {
+            vector<float> buf(std::is_same_v<T, cytnx_float> ? 0 : block);
+            vector<cytnx_int8> codes(bits == 4 ? block : 0);
+            const cytnx_uint64 end = std::min(nblocks, (c + 1) * per_chunk);
+            for (cytnx_uint64 b = c * per_chunk; b < end; b++) {
+              const cytnx_uint64 begin = b * block, m = std::min(block, n - begin);
+              const float *x;
+              if constexpr (std::is_same_v<T, cytnx_float>) {
+                x = src + begin;
+              } else {
+                for (cytnx_uint64 i = 0; i < m; i++) buf[i] = static_cast<float>(src[begin + i]);
+                x = buf.data();
+              }
+              const float amax = k.amax(x, m);
+              // a NaN or inf, also from a double beyond float range, has no finite scale; the
+              // error is raised after the parallel loop
+              if (!std::isfinite(amax)) {
+                scales[b] = 0;
+                nonfinite++;
+                continue;
+              }
+              // a tiny amax makes scale 0 or subnormal, and 1 / scale infinite; such a block
+              // is coded as zeros
+              const float scale = amax / qmax;
+              const float inv = scale >= std::numeric_limits<float>::min() ? 1 / scale : 0;
+              BlockStats st;
+              k.codes(bits == 8 ? q + begin : codes.data(), x, m, scale, inv, qmax, st);
+              if (bits == 4) pack4(q + begin / 2, codes.data(), m);
+              scales[b] = scale;
+              sq_err += st.sq_err;
+              sq_ref += st.sq_ref;
+              max_err = std::max(max_err, double(st.max_err));
+              max_abs = std::max(max_abs, double(amax));
+            }
+          }
+        }
+      });
+      cytnx_input_error_msg(nonfinite > 0,
+                            "[ERROR] quantization of %llu block(s) holding NaN, inf or a value "
+                            "beyond the float range.\n",
+                            (unsigned long long)nonfinite);
+      if (stats) *stats = {sq_err, sq_ref, max_err, max_abs};
+    }
+
+    void Dequantize_cpu(void *out, const unsigned int &dtype, const cytnx_int8 *q,
+                        const cytnx_float *scales, const cytnx_uint64 &n,
+                        const cytnx_uint64 &block, const int &bits) {
+      CYTNX_TRACE_SCOPE("kernel.dequantize");
+      CYTNX_PERF_SCOPE("kernel.dequantize");
+      check_args(dtype, block, bits);
+      const Kernels &k = kernels();
+      const BlockingParams &params = GetBlockingParams();
+      const cytnx_uint64 nblocks = (n + block - 1) / block;
+
+      dispatch_type(dtype, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        if constexpr (std::is_floating_point_v<T> ||
+                      internal::is_half_floating_point_impl<T>::value) {
+          T *des = static_cast<T *>(out);
+          const cytnx_uint64 per_chunk = BlockElems(params.convert_chunk_bytes,
+                                                    block * (sizeof(T) + 1));
+          const cytnx_uint64 nchunks = (nblocks + per_chunk - 1) / per_chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+          for (cytnx_uint64 c = 0; c < nchunks; c++) {
+            vector<float> buf(std::is_same_v<T, cytnx_float> ? 0 : block);
+            vector<cytnx_int8> codes(bits == 4 ? block : 0);
+            const cytnx_uint64 end = std::min(nblocks, (c + 1) * per_chunk);
+            for (cytnx_uint64 b = c * per_chunk; b < end; b++) {
+              const cytnx_uint64 begin = b * block, m = std::min(block, n - begin);
+              if (bits == 4) unpack4(codes.data(), q + begin / 2, m);
+              const cytnx_int8 *src = bits == 8 ? q + begin : codes.data();
+              if constexpr (std::is_same_v<T, cytnx_float>) {
+                k.decode(des + begin, src, m, scales[b]);
+              } else {
+                k.decode(buf.data(), src, m, scales[b]);
+                for (cytnx_uint64 i = 0; i < m; i++) des[begin + i] = static_cast<T>(buf[i]);
+              }
+            }
+          }
+        }
+      });
+    }
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
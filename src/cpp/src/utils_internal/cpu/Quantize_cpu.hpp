@@ -0,0 +1,46 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_QUANTIZE_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_QUANTIZE_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    // the error of a quantization, accumulated over all blocks
+    struct QuantizeStats {
+      double sq_err;  // sum of squared errors
+      double sq_ref;  // sum of squared inputs
+      double max_err;  // largest absolute error
+      double max_abs;  // largest absolute input
+    };
+
+    /**
+     * @brief Block-scaled symmetric quantization of n real values of type `dtype`.
+     *
+     * Each block of `block` consecutive values shares the float scale max|x| / qmax, with qmax
+     * 127 for 8 bits and 7 for 4 bits, and stores round(x / scale). 4-bit values are packed two
+     * per byte, the first in the low nibble, so `block` must be even for them. A complex array
+     * of n elements quantizes as 2n real values. Values that are not finite as a float (NaN, inf,
+     * or a double beyond the float range) are rejected.
+     *
+     * Float inputs take an AVX2 path when the CPU has it; other floating point types are widened
+     * to float block by block. Blocks are spread over `convert_threads` threads.
+     *
+     * @param q the quantized values, n bytes for 8 bits or (n + 1) / 2 for 4 bits
+     * @param scales ceil(n / block) scales
+     * @param in n values of type dtype, a real floating point type
+     * @param stats when given, receives the error of the quantization
+     */
+    void Quantize_cpu(cytnx_int8 *q, cytnx_float *scales, const void *in,
+                      const unsigned int &dtype, const cytnx_uint64 &n,
+                      const cytnx_uint64 &block, const int &bits, QuantizeStats *stats);
+
+    // the inverse of Quantize_cpu, writing n real values of type dtype to out
+    void Dequantize_cpu(void *out, const unsigned int &dtype, const cytnx_int8 *q,
+                        const cytnx_float *scales, const cytnx_uint64 &n,
+                        const cytnx_uint64 &block, const int &bits);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_QUANTIZE_CPU_H_
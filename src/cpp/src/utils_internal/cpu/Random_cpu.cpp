@@ -0,0 +1,285 @@
+#include "Random_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #include <immintrin.h>
+  #define CYTNX_HAS_AVX2_RANDOM_PATH
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // the Philox4x32 multipliers and Weyl key increments
+      constexpr cytnx_uint32 kM0 = 0xD2511F53, kM1 = 0xCD9E8D57;
+      constexpr cytnx_uint32 kW0 = 0x9E3779B9, kW1 = 0xBB67AE85;
+      constexpr int kRounds = 10;
+      // blocks drawn at once by a thread before they are mapped to values
+      constexpr cytnx_uint64 kBatch = 64;
+
+      void philox_scalar(cytnx_uint32 *words, const cytnx_uint64 &first, const cytnx_uint64 &n,
+                         const cytnx_uint64 &seed) {
+        for (cytnx_uint64 b = 0; b < n; b++) {
+          const cytnx_uint64 ctr = first + b;
+          cytnx_uint32 c0 = cytnx_uint32(ctr), c1 = cytnx_uint32(ctr >> 32), c2 = 0, c3 = 0;
+          cytnx_uint32 k0 = cytnx_uint32(seed), k1 = cytnx_uint32(seed >> 32);
+          for (int r = 0; r < kRounds; r++) {
+            const cytnx_uint64 p0 = cytnx_uint64(kM0) * c0, p1 = cytnx_uint64(kM1) * c2;
+            c0 = cytnx_uint32(p1 >> 32) ^ c1 ^ k0;
+            c1 = cytnx_uint32(p1);
+            c2 = cytnx_uint32(p0 >> 32) ^ c3 ^ k1;
+            c3 = cytnx_uint32(p0);
+            k0 += kW0;
+            k1 += kW1;
+          }
+          words[4 * b] = c0;
+          words[4 * b + 1] = c1;
+          words[4 * b + 2] = c2;
+          words[4 * b + 3] = c3;
+        }
+      }
+
+#ifdef CYTNX_HAS_AVX2_RANDOM_PATH
+      // the high and low 32 bits of the eight products a * m
+      __attribute__((target("avx2"))) void mulhilo(const __m256i &a, const cytnx_uint32 &m,
+                                                   __m256i &hi, __m256i &lo) {
+        const __m256i vm = _mm256_set1_epi32(int(m));
+        const __m256i even = _mm256_mul_epu32(a, vm);
+        const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), vm);
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+      }
+
+      __attribute__((target("avx2"))) void philox_avx2(cytnx_uint32 *words,
+                                                       const cytnx_uint64 &first,
+                                                       const cytnx_uint64 &n,
+                                                       const cytnx_uint64 &seed) {
+        cytnx_uint64 b = 0;
+        for (; b + 8 <= n; b += 8) {
+          alignas(32) cytnx_uint32 lanes[4][8];
+          for (int l = 0; l < 8; l++) {
+            lanes[0][l] = cytnx_uint32(first + b + l);
+            lanes[1][l] = cytnx_uint32((first + b + l) >> 32);
+          }
+          __m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes[0]));
+          __m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes[1]));
+          __m256i c2 = _mm256_setzero_si256(), c3 = _mm256_setzero_si256();
+          __m256i k0 = _mm256_set1_epi32(int(cytnx_uint32(seed)));
+          __m256i k1 = _mm256_set1_epi32(int(cytnx_uint32(seed >> 32)));
+          const __m256i w0 = _mm256_set1_epi32(int(kW0)), w1 = _mm256_set1_epi32(int(kW1));
+          for (int r = 0; r < kRounds; r++) {
+            __m256i hi0, lo0, hi1, lo1;
+            mulhilo(c0, kM0, hi0, lo0);
+            mulhilo(c2, kM1, hi1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), k0);
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), k1);
+            c3 = lo0;
+            k0 = _mm256_add_epi32(k0, w0);
+            k1 = _mm256_add_epi32(k1, w1);
+          }
+          _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[0]), c0);
+          _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[1]), c1);
+          _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[2]), c2);
+          _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[3]), c3);
+          for (int l = 0; l < 8; l++)
+            for (int w = 0; w < 4; w++) words[4 * (b + l) + w] = lanes[w][l];
+        }
+        // the caller maps the words with SSE code of libm, which a dirty upper state slows down
+        // several times over
+        _mm256_zeroupper();
+        philox_scalar(words + 4 * b, first + b, n - b, seed);
+      }
+#endif
+
+      using PhiloxKernel = void (*)(cytnx_uint32 *, const cytnx_uint64 &, const cytnx_uint64 &,
+                                    const cytnx_uint64 &);
+
+      PhiloxKernel philox_kernel() {
+        static const PhiloxKernel k = []() -> PhiloxKernel {
+#ifdef CYTNX_HAS_AVX2_RANDOM_PATH
+          if (Device.has_simd("avx2")) return philox_avx2;
+#endif
+          return philox_scalar;
+        }();
+        return k;
+      }
+
+      // A block of four words gives four values in [0, 1) of float precision or two of double
+      // precision, or as many standard normal values by the Box-Muller transform.
+      template <class R>
+      struct Draws;
+
+      template <>
+      struct Draws<float> {
+        static constexpr cytnx_uint64 per_block = 4;
+        static float unit(const cytnx_uint32 &w) { return float(w >> 8) * 0x1p-24f; }
+        static void uniform(const cytnx_uint32 *w, float *v) {
+          for (int i = 0; i < 4; i++) v[i] = unit(w[i]);
+        }
+        static void normal(const cytnx_uint32 *w, float *v) {
+          for (int i = 0; i < 4; i += 2) {
+            // u1 in (0, 1], so the logarithm stays finite
+            const float r = std::sqrt(-2.0f * std::log(unit(w[i]) + 0x1p-24f));
+            const float t = 6.28318530717958647692f * unit(w[i + 1]);
+            v[i] = r * std::cos(t);
+            v[i + 1] = r * std::sin(t);
+          }
+        }
+      };
+
+      template <>
+      struct Draws<double> {
+        static constexpr cytnx_uint64 per_block = 2;
+        static double unit(const cytnx_uint32 &hi, const cytnx_uint32 &lo) {
+          return double(((cytnx_uint64(hi) << 32) | lo) >> 11) * 0x1p-53;
+        }
+        static void uniform(const cytnx_uint32 *w, double *v) {
+          v[0] = unit(w[0], w[1]);
+          v[1] = unit(w[2], w[3]);
+        }
+        static void normal(const cytnx_uint32 *w, double *v) {
+          const double r = std::sqrt(-2.0 * std::log(unit(w[0], w[1]) + 0x1p-53));
+          const double t = 6.28318530717958647692 * unit(w[2], w[3]);
+          v[0] = r * std::cos(t);
+          v[1] = r * std::sin(t);
+        }
+      };
+
+      // the scalar type C a T is made of, and the precision R its values are drawn in
+      template <class T>
+      struct Components {
+        using C = T;
+        using R = T;
+        static constexpr cytnx_uint64 per_elem = 1;
+      };
+      template <>
+      struct Components<cytnx_float16> {
+        using C = cytnx_float16;
+        using R = float;
+        static constexpr cytnx_uint64 per_elem = 1;
+      };
+      template <>
+      struct Components<cytnx_bfloat16> {
+        using C = cytnx_bfloat16;
+        using R = float;
+        static constexpr cytnx_uint64 per_elem = 1;
+      };
+      template <class T>
+      struct Components<std::complex<T>> : Components<T> {
+        static constexpr cytnx_uint64 per_elem = 2;
+      };
+
+      /**
+       * out[j] = a + b * v for the n positions first + j of the stream, v drawn by `draw`.
+       * Each chunk covers whole runs of positions and draws exactly the blocks overlapping them,
+       * so the chunking leaves no trace in the values.
+       */
+      template <class C, class R, class Draw>
+      void fill_affine(C *out, const cytnx_uint64 &n, const cytnx_uint64 &first,
+                       const cytnx_uint64 &seed, const R &a, const R &b, Draw draw,
+                       const BlockingParams &params) {
+        constexpr cytnx_uint64 P = Draws<R>::per_block;
+        const PhiloxKernel philox = philox_kernel();
+        const cytnx_uint64 chunk = std::max(BlockElems(params.fill_chunk_bytes, sizeof(C)),
+                                            kBatch * P);
+        const cytnx_uint64 nchunks = (n + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.fill_threads)
+        for (cytnx_uint64 c = 0; c < nchunks; c++) {
+          const cytnx_uint64 lo = first + c * chunk, hi = first + std::min(n, (c + 1) * chunk);
+          cytnx_uint32 words[4 * kBatch];
+          R v[P];
+          for (cytnx_uint64 blk = lo / P, last = (hi - 1) / P; blk <= last; blk += kBatch) {
+            const cytnx_uint64 nblk = std::min(kBatch, last - blk + 1);
+            philox(words, blk, nblk, seed);
+            for (cytnx_uint64 i = 0; i < nblk; i++) {
+              draw(words + 4 * i, v);
+              const cytnx_uint64 base = (blk + i) * P;
+              for (cytnx_uint64 l = 0; l < P; l++) {
+                if (base + l >= lo && base + l < hi) out[base + l - first] = C(a + b * v[l]);
+              }
+            }
+          }
+        }
+      }
+    }  // namespace
+
+    void Philox4x32_cpu(cytnx_uint32 *words, const cytnx_uint64 &first, const cytnx_uint64 &n,
+                        const cytnx_uint64 &seed) {
+      philox_kernel()(words, first, n, seed);
+    }
+
+    template <class T>
+    void Uniform_cpu(T *out, const cytnx_uint64 &count, const double &low, const double &high,
+                     const cytnx_uint64 &seed, const cytnx_uint64 &offset,
+                     const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.random");
+      CYTNX_PERF_SCOPE("kernel.random");
+      using C = typename Components<T>::C;
+      using R = typename Components<T>::R;
+      constexpr cytnx_uint64 k = Components<T>::per_elem;
+      fill_affine(reinterpret_cast<C *>(out), count * k, offset * k, seed, R(low),
+                  R(high - low), Draws<R>::uniform, params);
+    }
+
+    template <class T>
+    void Uniform_cpu(T *out, const cytnx_uint64 &count, const double &low, const double &high,
+                     const cytnx_uint64 &seed, const cytnx_uint64 &offset) {
+      Uniform_cpu(out, count, low, high, seed, offset, GetBlockingParams());
+    }
+
+    template <class T>
+    void Normal_cpu(T *out, const cytnx_uint64 &count, const double &mean, const double &std,
+                    const cytnx_uint64 &seed, const cytnx_uint64 &offset,
+                    const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.random");
+      CYTNX_PERF_SCOPE("kernel.random");
+      using C = typename Components<T>::C;
+      using R = typename Components<T>::R;
+      constexpr cytnx_uint64 k = Components<T>::per_elem;
+      fill_affine(reinterpret_cast<C *>(out), count * k, offset * k, seed, R(mean), R(std),
+                  Draws<R>::normal, params);
+    }
+
+    template <class T>
+    void Normal_cpu(T *out, const cytnx_uint64 &count, const double &mean, const double &std,
+                    const cytnx_uint64 &seed, const cytnx_uint64 &offset) {
+      Normal_cpu(out, count, mean, std, seed, offset, GetBlockingParams());
+    }
+
+#define CYTNX_RANDOM_INSTANTIATE(T)                                                             \
+  template void Uniform_cpu<T>(T *, const cytnx_uint64 &, const double &, const double &,       \
+                               const cytnx_uint64 &, const cytnx_uint64 &,                      \
+                               const BlockingParams &);                                         \
+  template void Uniform_cpu<T>(T *, const cytnx_uint64 &, const double &, const double &,       \
+                               const cytnx_uint64 &, const cytnx_uint64 &);                     \
+  template void Normal_cpu<T>(T *, const cytnx_uint64 &, const double &, const double &,        \
+                              const cytnx_uint64 &, const cytnx_uint64 &, const BlockingParams &); \
+  template void Normal_cpu<T>(T *, const cytnx_uint64 &, const double &, const double &,        \
+                              const cytnx_uint64 &, const cytnx_uint64 &);
+
+    CYTNX_RANDOM_INSTANTIATE(cytnx_double)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_float)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_complex128)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_complex64)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_float16)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_bfloat16)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_complex32)
+    CYTNX_RANDOM_INSTANTIATE(cytnx_bcomplex32)
+
+#undef CYTNX_RANDOM_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
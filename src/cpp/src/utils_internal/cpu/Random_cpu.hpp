@@ -0,0 +1,52 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_RANDOM_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_RANDOM_CPU_H_
+
+#include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief The Philox4x32-10 blocks `first` to `first + n - 1` of the stream `seed`, four
+     * 32-bit words each, into words[0, 4n).
+     *
+     * Block b is the bijection of the 128-bit counter (b, 0) under the 64-bit key `seed`
+     * (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11), so any block can be
+     * drawn without the ones before it. Eight blocks are computed at once with AVX2 when the CPU
+     * has it, with the same result.
+     */
+    void Philox4x32_cpu(cytnx_uint32 *words, const cytnx_uint64 &first, const cytnx_uint64 &n,
+                        const cytnx_uint64 &seed);
+
+    /**
+     * @brief Fill `count` elements at `out` with uniform values in [low, high), or with normal
+     * values of mean `a` and standard deviation `b`, for T a floating point or complex type of
+     * Type_list.
+     *
+     * The real and imaginary parts of a complex element are drawn independently. Element i takes
+     * the values at position `offset + i` of the stream `seed` and nothing else, so the result
+     * does not depend on the number of threads, and a buffer filled in pieces with matching
+     * offsets equals one filled at once. The work is split in chunks of
+     * `params.fill_chunk_bytes` over `params.fill_threads` threads.
+     */
+    template <class T>
+    void Uniform_cpu(T *out, const cytnx_uint64 &count, const double &low, const double &high,
+                     const cytnx_uint64 &seed, const cytnx_uint64 &offset,
+                     const BlockingParams &params);
+    template <class T>
+    void Uniform_cpu(T *out, const cytnx_uint64 &count, const double &low, const double &high,
+                     const cytnx_uint64 &seed, const cytnx_uint64 &offset);
+
+    template <class T>
+    void Normal_cpu(T *out, const cytnx_uint64 &count, const double &mean, const double &std,
+                    const cytnx_uint64 &seed, const cytnx_uint64 &offset,
+                    const BlockingParams &params);
+    template <class T>
+    void Normal_cpu(T *out, const cytnx_uint64 &count, const double &mean, const double &std,
+                    const cytnx_uint64 &seed, const cytnx_uint64 &offset);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_RANDOM_CPU_H_
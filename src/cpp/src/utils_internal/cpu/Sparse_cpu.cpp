@@ -0,0 +1,247 @@
+#include "Sparse_cpu.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      // a block smaller than this costs more to schedule than it saves
+      constexpr cytnx_uint64 min_block_work = 8192;
+
+      template <class T>
+      T conj_of(const T &a) {
+        if constexpr (is_complex_v<T>)
+          return std::conj(a);
+        else
+          return a;
+      }
+
+      /**
+       * Rows [r0, r1) of y = A x with K (or k when K is 0) right-hand sides. For a half-stored
+       * A the rows are accumulated: the transposed entries of earlier rows of the block have
+       * already landed in them, and those beyond the block go to buf, which starts at row r1.
+       */
+      template <class T, cytnx_uint64 K>
+      void spmm_rows(T *y, const T *x, const cytnx_uint64 &kdyn, const cytnx_uint64 *indptr,
+                     const cytnx_uint64 *indices, const T *values, const int &symmetry,
+                     const cytnx_uint64 &r0, const cytnx_uint64 &r1, T *buf) {
+        const cytnx_uint64 k = K ? K : kdyn;
+        if (symmetry == 0) {
+          for (cytnx_uint64 i = r0; i < r1; i++) {
+            T *yi = y + i * k;
+            if constexpr (K == 1) {
+              T s = 0;
+              for (cytnx_uint64 e = indptr[i]; e < indptr[i + 1]; e++)
+                s += values[e] * x[indices[e]];
+              yi[0] = s;
+            } else {
+              std::fill(yi, yi + k, T(0));
+              for (cytnx_uint64 e = indptr[i]; e < indptr[i + 1]; e++) {
+                const T a = values[e];
+                const T *xj = x + indices[e] * k;
+                for (cytnx_uint64 c = 0; c < k; c++) yi[c] += a * xj[c];
+              }
+            }
+          }
+          return;
+        }
+        const bool herm = symmetry == 2;
+        std::fill(y + r0 * k, y + r1 * k, T(0));
+        for (cytnx_uint64 i = r0; i < r1; i++) {
+          T *yi = y + i * k;
+          const T *xi = x + i * k;
+          for (cytnx_uint64 e = indptr[i]; e < indptr[i + 1]; e++) {
+            const cytnx_uint64 j = indices[e];
+            const T a = values[e];
+            const T *xj = x + j * k;
+            for (cytnx_uint64 c = 0; c < k; c++) yi[c] += a * xj[c];
+            if (j == i) continue;
+            const T at = herm ? conj_of(a) : a;
+            T *yj = j < r1 ? y + j * k : buf + (j - r1) * k;
+            for (cytnx_uint64 c = 0; c < k; c++) yj[c] += at * xi[c];
+          }
+        }
+      }
+
+      // a triplet in its row's bucket: the column and the position in the input
+      struct Entry {
+        cytnx_uint64 col, idx;
+      };
+    }  // namespace
+
+    CsrPartition PartitionCsr_cpu(const cytnx_uint64 *indptr, const cytnx_uint64 *indices,
+                                  const cytnx_uint64 &nrows, const int &parts, const bool &half) {
+      // each row weighs its nonzeros plus one, for the row's own overhead
+      const cytnx_uint64 total = indptr[nrows] + nrows;
+      cytnx_uint64 n = std::max(parts, 1);
+      n = std::max<cytnx_uint64>(1, std::min(n, total / min_block_work));
+      CsrPartition out;
+      out.bounds.assign(n + 1, nrows);
+      out.bounds[0] = 0;
+      for (cytnx_uint64 p = 1; p < n; p++) {
+        const cytnx_uint64 target = total * p / n;
+        cytnx_uint64 lo = out.bounds[p - 1], hi = nrows;
+        while (lo < hi) {
+          const cytnx_uint64 mid = lo + (hi - lo) / 2;
+          if (indptr[mid] + mid < target)
+            lo = mid + 1;
+          else
+            hi = mid;
+        }
+        out.bounds[p] = lo;
+      }
+      if (!half) return out;
+      out.reach.resize(n);
+#pragma omp parallel for schedule(static, 1) if (n > 1) num_threads(n)
+      for (cytnx_uint64 p = 0; p < n; p++) {
+        cytnx_uint64 reach = out.bounds[p + 1];
+        for (cytnx_uint64 e = indptr[out.bounds[p]]; e < indptr[out.bounds[p + 1]]; e++)
+          reach = std::max(reach, indices[e] + 1);
+        out.reach[p] = reach;
+      }
+      return out;
+    }
+
+    template <class T>
+    void SpMM_cpu(T *y, const T *x, const cytnx_uint64 &k, const cytnx_uint64 *indptr,
+                  const cytnx_uint64 *indices, const T *values, const int &symmetry,
+                  const CsrPartition &part) {
+      CYTNX_TRACE_SCOPE("kernel.spmm");
+      CYTNX_PERF_SCOPE("kernel.spmm");
+      const cytnx_uint64 parts = part.bounds.size() - 1;
+      const bool half = symmetry != 0;
+      vector<vector<T>> bufs(half ? parts : 0);
+#pragma omp parallel for schedule(static, 1) if (parts > 1) num_threads(parts)
+      for (cytnx_uint64 p = 0; p < parts; p++) {
+        const cytnx_uint64 r0 = part.bounds[p], r1 = part.bounds[p + 1];
+        T *buf = nullptr;
+        if (half) {
+          bufs[p].assign((part.reach[p] - r1) * k, T(0));
+          buf = bufs[p].data();
+        }
+        if (k == 1)
+          spmm_rows<T, 1>(y, x, k, indptr, indices, values, symmetry, r0, r1, buf);
+        else
+          spmm_rows<T, 0>(y, x, k, indptr, indices, values, symmetry, r0, r1, buf);
+      }
+      // the transposed entries that crossed a block boundary, in block order
+      for (cytnx_uint64 p = 0; p < bufs.size(); p++) {
+        const cytnx_uint64 len = bufs[p].size();
+        const T *src = bufs[p].data();
+        T *dst = y + part.bounds[p + 1] * k;
+#pragma omp parallel for schedule(static) if (len > 16 * min_block_work) num_threads(parts)
+        for (cytnx_uint64 i = 0; i < len; i++) dst[i] += src[i];
+      }
+    }
+
+    template <class T>
+    cytnx_uint64 CooToCsr_cpu(cytnx_uint64 *indptr, cytnx_uint64 *indices, T *values,
+                              const cytnx_uint64 *rows, const cytnx_uint64 *cols, const T *vals,
+                              const cytnx_uint64 &n, const cytnx_uint64 &nrows, const bool &upper,
+                              const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.coo_to_csr");
+      CYTNX_PERF_SCOPE("kernel.coo_to_csr");
+      const int threads = int(std::max<cytnx_uint64>(
+        1, std::min<cytnx_uint64>(std::max(params.convert_threads, 1), n / min_block_work)));
+      auto kept = [&](const cytnx_uint64 &i) { return !upper || cols[i] >= rows[i]; };
+
+      // bucket the triplets by row: count, offsets, then scatter; the atomics cost a third of
+      // the time on one thread, so that case goes without them
+      vector<cytnx_uint64> start(nrows + 1, 0);
+      if (threads == 1) {
+        for (cytnx_uint64 i = 0; i < n; i++)
+          if (kept(i)) start[rows[i] + 1]++;
+      } else {
+#pragma omp parallel for schedule(static) num_threads(threads)
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          if (!kept(i)) continue;
+#pragma omp atomic
+          start[rows[i] + 1]++;
+        }
+      }
+      for (cytnx_uint64 r = 0; r < nrows; r++) start[r + 1] += start[r];
+      vector<cytnx_uint64> fill(start.begin(), start.end() - 1);
+      vector<Entry> bucket(start[nrows]);
+      if (threads == 1) {
+        for (cytnx_uint64 i = 0; i < n; i++)
+          if (kept(i)) bucket[fill[rows[i]]++] = {cols[i], i};
+      } else {
+#pragma omp parallel for schedule(static) num_threads(threads)
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          if (!kept(i)) continue;
+          cytnx_uint64 o;
+#pragma omp atomic capture
+          o = fill[rows[i]]++;
+          bucket[o] = {cols[i], i};
+        }
+      }
+
+      // sort each row by (column, input position), so the order the threads scattered in does
+      // not matter and repeats are summed in the order given; indptr holds the counts for now
+      indptr[0] = 0;
+#pragma omp parallel for schedule(dynamic, 1024) if (threads > 1) num_threads(threads)
+      for (cytnx_uint64 r = 0; r < nrows; r++) {
+        Entry *b = bucket.data() + start[r], *e = bucket.data() + start[r + 1];
+        std::sort(b, e, [](const Entry &x, const Entry &y) {
+          return x.col < y.col || (x.col == y.col && x.idx < y.idx);
+        });
+        cytnx_uint64 u = 0;
+        for (const Entry *p = b; p < e; p++) u += p == b || p[-1].col != p->col;
+        indptr[r + 1] = u;
+      }
+      for (cytnx_uint64 r = 0; r < nrows; r++) indptr[r + 1] += indptr[r];
+
+#pragma omp parallel for schedule(dynamic, 1024) if (threads > 1) num_threads(threads)
+      for (cytnx_uint64 r = 0; r < nrows; r++) {
+        cytnx_uint64 o = indptr[r];
+        for (cytnx_uint64 p = start[r]; p < start[r + 1]; o++) {
+          const cytnx_uint64 col = bucket[p].col;
+          T s = vals[bucket[p].idx];
+          for (p++; p < start[r + 1] && bucket[p].col == col; p++) s += vals[bucket[p].idx];
+          indices[o] = col;
+          values[o] = s;
+        }
+      }
+      return indptr[nrows];
+    }
+
+    template <class T>
+    cytnx_uint64 CooToCsr_cpu(cytnx_uint64 *indptr, cytnx_uint64 *indices, T *values,
+                              const cytnx_uint64 *rows, const cytnx_uint64 *cols, const T *vals,
+                              const cytnx_uint64 &n, const cytnx_uint64 &nrows,
+                              const bool &upper) {
+      return CooToCsr_cpu(indptr, indices, values, rows, cols, vals, n, nrows, upper,
+                          GetBlockingParams());
+    }
+
+#define CYTNX_SPARSE_INSTANTIATE(T)                                                             \
+  template void SpMM_cpu<T>(T *, const T *, const cytnx_uint64 &, const cytnx_uint64 *,         \
+                            const cytnx_uint64 *, const T *, const int &, const CsrPartition &); \
+  template cytnx_uint64 CooToCsr_cpu<T>(cytnx_uint64 *, cytnx_uint64 *, T *,                    \
+                                        const cytnx_uint64 *, const cytnx_uint64 *, const T *,  \
+                                        const cytnx_uint64 &, const cytnx_uint64 &,             \
+                                        const bool &, const BlockingParams &);                  \
+  template cytnx_uint64 CooToCsr_cpu<T>(cytnx_uint64 *, cytnx_uint64 *, T *,                    \
+                                        const cytnx_uint64 *, const cytnx_uint64 *, const T *,  \
+                                        const cytnx_uint64 &, const cytnx_uint64 &, const bool &);
+
+    CYTNX_SPARSE_INSTANTIATE(cytnx_double)
+    CYTNX_SPARSE_INSTANTIATE(cytnx_float)
+    CYTNX_SPARSE_INSTANTIATE(cytnx_complex128)
+    CYTNX_SPARSE_INSTANTIATE(cytnx_complex64)
+
+#undef CYTNX_SPARSE_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
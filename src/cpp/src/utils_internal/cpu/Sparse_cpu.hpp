@@ -0,0 +1,68 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPARSE_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPARSE_CPU_H_
+
+#include <vector>
+
+#include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Rows of a CSR matrix split into contiguous blocks, one per thread.
+     *
+     * Block p holds the rows [bounds[p], bounds[p + 1]). The blocks carry about the same number
+     * of nonzeros plus rows, so a few dense rows do not leave the other threads idle. For a
+     * half-stored matrix, reach[p] is one past the largest column block p touches, which bounds
+     * the scatter buffer of its transposed half.
+     */
+    struct CsrPartition {
+      std::vector<cytnx_uint64> bounds;
+      std::vector<cytnx_uint64> reach;
+    };
+
+    // split the nrows rows into at most `parts` blocks; reach is filled when `half` is set
+    CsrPartition PartitionCsr_cpu(const cytnx_uint64 *indptr, const cytnx_uint64 *indices,
+                                  const cytnx_uint64 &nrows, const int &parts, const bool &half);
+
+    /**
+     * @brief y = A x for a CSR matrix A and k right-hand sides, T = double, float,
+     * complex<double> or complex<float>.
+     *
+     * x is ncols x k and y is nrows x k, both row-major, and must not overlap. `symmetry` is 0
+     * for a general matrix, 1 for a symmetric and 2 for a Hermitian one of which only the upper
+     * triangle (with the diagonal) is stored; the lower triangle is then applied as the
+     * transpose, or the conjugate transpose, of the stored entries. Each block of `part` runs on
+     * its own thread; the transposed entries landing beyond a block go through a per-block buffer
+     * that is summed into y afterwards in block order, so the result does not depend on timing.
+     */
+    template <class T>
+    void SpMM_cpu(T *y, const T *x, const cytnx_uint64 &k, const cytnx_uint64 *indptr,
+                  const cytnx_uint64 *indices, const T *values, const int &symmetry,
+                  const CsrPartition &part);
+
+    /**
+     * @brief Sort n COO triplets by (row, col) into CSR arrays and sum the duplicates, in the
+     * order they were given.
+     *
+     * indptr has nrows + 1 elements, indices and values room for n. With `upper` the entries
+     * below the diagonal are dropped. The triplets are bucketed by row, then each row is sorted
+     * by column, both in parallel over `params.convert_threads` threads; that is linear in n
+     * apart from the short per-row sorts. Returns the number of nonzeros written.
+     */
+    template <class T>
+    cytnx_uint64 CooToCsr_cpu(cytnx_uint64 *indptr, cytnx_uint64 *indices, T *values,
+                              const cytnx_uint64 *rows, const cytnx_uint64 *cols, const T *vals,
+                              const cytnx_uint64 &n, const cytnx_uint64 &nrows, const bool &upper,
+                              const BlockingParams &params);
+    template <class T>
+    cytnx_uint64 CooToCsr_cpu(cytnx_uint64 *indptr, cytnx_uint64 *indices, T *values,
+                              const cytnx_uint64 *rows, const cytnx_uint64 *cols, const T *vals,
+                              const cytnx_uint64 &n, const cytnx_uint64 &nrows,
+                              const bool &upper);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPARSE_CPU_H_
@@ -0,0 +1,499 @@
+#include "SplitComplex_cpu.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <cytnx_core/Device.hpp>
+#include <cytnx_core/PerfCounters.hpp>
+#include <cytnx_core/Trace.hpp>
+
+#ifdef UNI_OMP
+  #include <omp.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #include <immintrin.h>
+  #define CYTNX_HAS_AVX2_SPLIT_PATH
+#endif
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    namespace {
+      template <class T>
+      void deinterleave_scalar(T *re, T *im, const complex<T> *in, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          re[i] = in[i].real();
+          im[i] = in[i].imag();
+        }
+      }
+      template <class T>
+      void interleave_scalar(complex<T> *out, const T *re, const T *im, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) out[i] = complex<T>(re[i], im[i]);
+      }
+      template <class T>
+      void add_scalar(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          ore[i] = are[i] + bre[i];
+          oim[i] = aim[i] + bim[i];
+        }
+      }
+      template <class T>
+      void mul_scalar(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          const T ar = are[i], ai = aim[i], br = bre[i], bi = bim[i];
+          ore[i] = ar * br - ai * bi;
+          oim[i] = ar * bi + ai * br;
+        }
+      }
+      template <class T>
+      void scal_scalar(T *re, T *im, T sr, T si, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          const T xr = re[i], xi = im[i];
+          re[i] = sr * xr - si * xi;
+          im[i] = sr * xi + si * xr;
+        }
+      }
+      template <class T>
+      void axpy_scalar(T *yre, T *yim, T sr, T si, const T *xre, const T *xim, cytnx_uint64 n) {
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          const T xr = xre[i], xi = xim[i];
+          yre[i] += sr * xr - si * xi;
+          yim[i] += sr * xi + si * xr;
+        }
+      }
+      // the reductions return (real, imaginary) or (norm2, 0)
+      template <class T>
+      complex<T> sum_scalar(const T *re, const T *im, const T *, const T *, cytnx_uint64 n) {
+        T sr = 0, si = 0;
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          sr += re[i];
+          si += im[i];
+        }
+        return complex<T>(sr, si);
+      }
+      template <class T>
+      complex<T> vdot_scalar(const T *are, const T *aim, const T *bre, const T *bim,
+                             cytnx_uint64 n) {
+        T sr = 0, si = 0;
+        for (cytnx_uint64 i = 0; i < n; i++) {
+          sr += are[i] * bre[i] + aim[i] * bim[i];
+          si += are[i] * bim[i] - aim[i] * bre[i];
+        }
+        return complex<T>(sr, si);
+      }
+      template <class T>
+      complex<T> norm2_scalar(const T *re, const T *im, const T *, const T *, cytnx_uint64 n) {
+        T s = 0;
+        for (cytnx_uint64 i = 0; i < n; i++) s += re[i] * re[i] + im[i] * im[i];
+        return complex<T>(s, 0);
+      }
+
+#ifdef CYTNX_HAS_AVX2_SPLIT_PATH
+      // one AVX register of T and the operations the kernels need
+      template <class T>
+      struct Avx;
+
+      template <>
+      struct Avx<double> {
+        typedef __m256d reg;
+        static const cytnx_uint64 width = 4;
+        __attribute__((target("avx2,fma"))) static reg load(const double *p) {
+          return _mm256_loadu_pd(p);
+        }
+        __attribute__((target("avx2,fma"))) static void store(double *p, reg v) {
+          _mm256_storeu_pd(p, v);
+        }
+        __attribute__((target("avx2,fma"))) static reg set1(double x) {
+          return _mm256_set1_pd(x);
+        }
+        __attribute__((target("avx2,fma"))) static reg zero() { return _mm256_setzero_pd(); }
+        __attribute__((target("avx2,fma"))) static reg add(reg a, reg b) {
+          return _mm256_add_pd(a, b);
+        }
+        __attribute__((target("avx2,fma"))) static reg mul(reg a, reg b) {
+          return _mm256_mul_pd(a, b);
+        }
+        // a * b + c and c - a * b
+        __attribute__((target("avx2,fma"))) static reg fmadd(reg a, reg b, reg c) {
+          return _mm256_fmadd_pd(a, b, c);
+        }
+        __attribute__((target("avx2,fma"))) static reg fnmadd(reg a, reg b, reg c) {
+          return _mm256_fnmadd_pd(a, b, c);
+        }
+        __attribute__((target("avx2,fma"))) static double hsum(reg v) {
+          const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+          return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+        }
+        // (r0 i0 r1 i1 | r2 i2 r3 i3) -> (r0 r1 r2 r3), (i0 i1 i2 i3)
+        __attribute__((target("avx2,fma"))) static void split(const double *in, reg &re,
+                                                               reg &im) {
+          const reg a = _mm256_loadu_pd(in), b = _mm256_loadu_pd(in + 4);
+          re = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xd8);
+          im = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xd8);
+        }
+        __attribute__((target("avx2,fma"))) static void merge(double *out, reg re, reg im) {
+          re = _mm256_permute4x64_pd(re, 0xd8);
+          im = _mm256_permute4x64_pd(im, 0xd8);
+          _mm256_storeu_pd(out, _mm256_unpacklo_pd(re, im));
+          _mm256_storeu_pd(out + 4, _mm256_unpackhi_pd(re, im));
+        }
+      };
+
+      template <>
+      struct Avx<float> {
+        typedef __m256 reg;
+        static const cytnx_uint64 width = 8;
+        __attribute__((target("avx2,fma"))) static reg load(const float *p) {
+          return _mm256_loadu_ps(p);
+        }
+        __attribute__((target("avx2,fma"))) static void store(float *p, reg v) {
+          _mm256_storeu_ps(p, v);
+        }
+        __attribute__((target("avx2,fma"))) static reg set1(float x) { return _mm256_set1_ps(x); }
+        __attribute__((target("avx2,fma"))) static reg zero() { return _mm256_setzero_ps(); }
+        __attribute__((target("avx2,fma"))) static reg add(reg a, reg b) {
+          return _mm256_add_ps(a, b);
+        }
+        __attribute__((target("avx2,fma"))) static reg mul(reg a, reg b) {
+          return _mm256_mul_ps(a, b);
+        }
+        __attribute__((target("avx2,fma"))) static reg fmadd(reg a, reg b, reg c) {
+          return _mm256_fmadd_ps(a, b, c);
+        }
+        __attribute__((target("avx2,fma"))) static reg fnmadd(reg a, reg b, reg c) {
+          return _mm256_fnmadd_ps(a, b, c);
+        }
+        __attribute__((target("avx2,fma"))) static float hsum(reg v) {
+          __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+          s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+          return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehdup_ps(s)));
+        }
+        // shuffle within lanes, then put the 64-bit halves back in order
+        __attribute__((target("avx2,fma"))) static void split(const float *in, reg &re,
+                                                               reg &im) {
+          const reg a = _mm256_loadu_ps(in), b = _mm256_loadu_ps(in + 8);
+          re = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), 0xd8));
+          im = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), 0xd8));
+        }
+        __attribute__((target("avx2,fma"))) static void merge(float *out, reg re, reg im) {
+          re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), 0xd8));
+          im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), 0xd8));
+          _mm256_storeu_ps(out, _mm256_unpacklo_ps(re, im));
+          _mm256_storeu_ps(out + 8, _mm256_unpackhi_ps(re, im));
+        }
+      };
+
+      template <class T>
+      __attribute__((target("avx2,fma"))) void deinterleave_avx2(T *re, T *im,
+                                                                 const complex<T> *in,
+                                                                 cytnx_uint64 n) {
+        typedef Avx<T> V;
+        const T *p = reinterpret_cast<const T *>(in);
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          typename V::reg r, m;
+          V::split(p + 2 * i, r, m);
+          V::store(re + i, r);
+          V::store(im + i, m);
+        }
+        deinterleave_scalar(re + i, im + i, in + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) void interleave_avx2(complex<T> *out, const T *re,
+                                                               const T *im, cytnx_uint64 n) {
+        typedef Avx<T> V;
+        T *p = reinterpret_cast<T *>(out);
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width)
+          V::merge(p + 2 * i, V::load(re + i), V::load(im + i));
+        interleave_scalar(out + i, re + i, im + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) void add_avx2(T *ore, T *oim, const T *are,
+                                                        const T *aim, const T *bre,
+                                                        const T *bim, cytnx_uint64 n) {
+        typedef Avx<T> V;
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          V::store(ore + i, V::add(V::load(are + i), V::load(bre + i)));
+          V::store(oim + i, V::add(V::load(aim + i), V::load(bim + i)));
+        }
+        add_scalar(ore + i, oim + i, are + i, aim + i, bre + i, bim + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) void mul_avx2(T *ore, T *oim, const T *are,
+                                                        const T *aim, const T *bre,
+                                                        const T *bim, cytnx_uint64 n) {
+        typedef Avx<T> V;
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          const typename V::reg ar = V::load(are + i), ai = V::load(aim + i);
+          const typename V::reg br = V::load(bre + i), bi = V::load(bim + i);
+          V::store(ore + i, V::fnmadd(ai, bi, V::mul(ar, br)));
+          V::store(oim + i, V::fmadd(ai, br, V::mul(ar, bi)));
+        }
+        mul_scalar(ore + i, oim + i, are + i, aim + i, bre + i, bim + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) void scal_avx2(T *re, T *im, T sr, T si,
+                                                         cytnx_uint64 n) {
+        typedef Avx<T> V;
+        const typename V::reg vr = V::set1(sr), vi = V::set1(si);
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          const typename V::reg xr = V::load(re + i), xi = V::load(im + i);
+          V::store(re + i, V::fnmadd(vi, xi, V::mul(vr, xr)));
+          V::store(im + i, V::fmadd(vi, xr, V::mul(vr, xi)));
+        }
+        scal_scalar(re + i, im + i, sr, si, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) void axpy_avx2(T *yre, T *yim, T sr, T si,
+                                                         const T *xre, const T *xim,
+                                                         cytnx_uint64 n) {
+        typedef Avx<T> V;
+        const typename V::reg vr = V::set1(sr), vi = V::set1(si);
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          const typename V::reg xr = V::load(xre + i), xi = V::load(xim + i);
+          V::store(yre + i, V::fnmadd(vi, xi, V::fmadd(vr, xr, V::load(yre + i))));
+          V::store(yim + i, V::fmadd(vi, xr, V::fmadd(vr, xi, V::load(yim + i))));
+        }
+        axpy_scalar(yre + i, yim + i, sr, si, xre + i, xim + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) complex<T> sum_avx2(const T *re, const T *im,
+                                                              const T *, const T *,
+                                                              cytnx_uint64 n) {
+        typedef Avx<T> V;
+        typename V::reg sr = V::zero(), si = V::zero();
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          sr = V::add(sr, V::load(re + i));
+          si = V::add(si, V::load(im + i));
+        }
+        return complex<T>(V::hsum(sr), V::hsum(si)) +
+               sum_scalar<T>(re + i, im + i, nullptr, nullptr, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) complex<T> vdot_avx2(const T *are, const T *aim,
+                                                               const T *bre, const T *bim,
+                                                               cytnx_uint64 n) {
+        typedef Avx<T> V;
+        typename V::reg sr = V::zero(), si = V::zero();
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          const typename V::reg ar = V::load(are + i), ai = V::load(aim + i);
+          const typename V::reg br = V::load(bre + i), bi = V::load(bim + i);
+          sr = V::fmadd(ai, bi, V::fmadd(ar, br, sr));
+          si = V::fnmadd(ai, br, V::fmadd(ar, bi, si));
+        }
+        return complex<T>(V::hsum(sr), V::hsum(si)) +
+               vdot_scalar(are + i, aim + i, bre + i, bim + i, n - i);
+      }
+      template <class T>
+      __attribute__((target("avx2,fma"))) complex<T> norm2_avx2(const T *re, const T *im,
+                                                                const T *, const T *,
+                                                                cytnx_uint64 n) {
+        typedef Avx<T> V;
+        typename V::reg s = V::zero();
+        cytnx_uint64 i = 0;
+        for (; i + V::width <= n; i += V::width) {
+          const typename V::reg xr = V::load(re + i), xi = V::load(im + i);
+          s = V::fmadd(xi, xi, V::fmadd(xr, xr, s));
+        }
+        return complex<T>(V::hsum(s), 0) + norm2_scalar<T>(re + i, im + i, nullptr, nullptr, n - i);
+      }
+#endif
+
+      template <class T>
+      struct Kernels {
+        void (*deinterleave)(T *, T *, const complex<T> *, cytnx_uint64);
+        void (*interleave)(complex<T> *, const T *, const T *, cytnx_uint64);
+        void (*add)(T *, T *, const T *, const T *, const T *, const T *, cytnx_uint64);
+        void (*mul)(T *, T *, const T *, const T *, const T *, const T *, cytnx_uint64);
+        void (*scal)(T *, T *, T, T, cytnx_uint64);
+        void (*axpy)(T *, T *, T, T, const T *, const T *, cytnx_uint64);
+        // the reductions share a signature so that reduce() can run any of them
+        complex<T> (*sum)(const T *, const T *, const T *, const T *, cytnx_uint64);
+        complex<T> (*vdot)(const T *, const T *, const T *, const T *, cytnx_uint64);
+        complex<T> (*norm2)(const T *, const T *, const T *, const T *, cytnx_uint64);
+      };
+
+      template <class T>
+      const Kernels<T> &kernels() {
+        static const Kernels<T> k = []() {
+#ifdef CYTNX_HAS_AVX2_SPLIT_PATH
+          if (Device.has_simd("avx2") && Device.has_simd("fma"))
+            return Kernels<T>{deinterleave_avx2<T>, interleave_avx2<T>, add_avx2<T>,
+                              mul_avx2<T>,          scal_avx2<T>,       axpy_avx2<T>,
+                              sum_avx2<T>,          vdot_avx2<T>,       norm2_avx2<T>};
+#endif
+          return Kernels<T>{deinterleave_scalar<T>, interleave_scalar<T>, add_scalar<T>,
+                            mul_scalar<T>,          scal_scalar<T>,       axpy_scalar<T>,
+                            sum_scalar<T>,          vdot_scalar<T>,       norm2_scalar<T>};
+        }();
+        return k;
+      }
+
+      // run fn(begin, count) over chunks of n complex values moving elem_bytes each
+      template <class Fn>
+      void for_chunks(const cytnx_uint64 &n, const cytnx_uint64 &elem_bytes,
+                      const BlockingParams &params, const Fn &fn) {
+        const cytnx_uint64 chunk = BlockElems(params.convert_chunk_bytes, elem_bytes);
+        const cytnx_uint64 nchunks = (n + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+        for (cytnx_uint64 c = 0; c < nchunks; c++) {
+          const cytnx_uint64 begin = c * chunk;
+          fn(begin, std::min(chunk, n - begin));
+        }
+      }
+
+      // a reduction over chunks, added up in order so that the result does not depend on the
+      // number of threads
+      template <class T, class Fn>
+      complex<T> reduce(Fn fn, const T *a, const T *b, const T *c, const T *d,
+                        const cytnx_uint64 &n) {
+        const BlockingParams &params = GetBlockingParams();
+        const cytnx_uint64 chunk = BlockElems(params.convert_chunk_bytes, 4 * sizeof(T));
+        const cytnx_uint64 nchunks = (n + chunk - 1) / chunk;
+        vector<complex<T>> partial(nchunks);
+#pragma omp parallel for schedule(static) if (nchunks > 1) num_threads(params.convert_threads)
+        for (cytnx_uint64 k = 0; k < nchunks; k++) {
+          const cytnx_uint64 i = k * chunk, m = std::min(chunk, n - i);
+          partial[k] = fn(a + i, b + i, c ? c + i : nullptr, d ? d + i : nullptr, m);
+        }
+        complex<T> out = 0;
+        for (const auto &p : partial) out += p;
+        return out;
+      }
+    }  // namespace
+
+    template <class T>
+    void Deinterleave_cpu(T *re, T *im, const complex<T> *in, const cytnx_uint64 &n,
+                          const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.deinterleave");
+      CYTNX_PERF_SCOPE("kernel.deinterleave");
+      const auto fn = kernels<T>().deinterleave;
+      for_chunks(n, 4 * sizeof(T), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(re + i, im + i, in + i, m); });
+    }
+    template <class T>
+    void Deinterleave_cpu(T *re, T *im, const complex<T> *in, const cytnx_uint64 &n) {
+      Deinterleave_cpu(re, im, in, n, GetBlockingParams());
+    }
+
+    template <class T>
+    void Interleave_cpu(complex<T> *out, const T *re, const T *im, const cytnx_uint64 &n,
+                        const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.interleave");
+      CYTNX_PERF_SCOPE("kernel.interleave");
+      const auto fn = kernels<T>().interleave;
+      for_chunks(n, 4 * sizeof(T), params,
+                 [&](cytnx_uint64 i, cytnx_uint64 m) { fn(out + i, re + i, im + i, m); });
+    }
+    template <class T>
+    void Interleave_cpu(complex<T> *out, const T *re, const T *im, const cytnx_uint64 &n) {
+      Interleave_cpu(out, re, im, n, GetBlockingParams());
+    }
+
+    template <class T>
+    void SplitAdd_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_add");
+      const auto fn = kernels<T>().add;
+      for_chunks(n, 6 * sizeof(T), GetBlockingParams(), [&](cytnx_uint64 i, cytnx_uint64 m) {
+        fn(ore + i, oim + i, are + i, aim + i, bre + i, bim + i, m);
+      });
+    }
+
+    template <class T>
+    void SplitMul_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n, const BlockingParams &params) {
+      CYTNX_TRACE_SCOPE("kernel.split_mul");
+      CYTNX_PERF_SCOPE("kernel.split_mul");
+      const auto fn = kernels<T>().mul;
+      for_chunks(n, 6 * sizeof(T), params, [&](cytnx_uint64 i, cytnx_uint64 m) {
+        fn(ore + i, oim + i, are + i, aim + i, bre + i, bim + i, m);
+      });
+    }
+    template <class T>
+    void SplitMul_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n) {
+      SplitMul_cpu(ore, oim, are, aim, bre, bim, n, GetBlockingParams());
+    }
+
+    template <class T>
+    void SplitScal_cpu(T *re, T *im, const complex<T> &alpha, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_scal");
+      const auto fn = kernels<T>().scal;
+      for_chunks(n, 4 * sizeof(T), GetBlockingParams(), [&](cytnx_uint64 i, cytnx_uint64 m) {
+        fn(re + i, im + i, alpha.real(), alpha.imag(), m);
+      });
+    }
+
+    template <class T>
+    void SplitAxpy_cpu(T *yre, T *yim, const complex<T> &alpha, const T *xre, const T *xim,
+                       const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_axpy");
+      const auto fn = kernels<T>().axpy;
+      for_chunks(n, 6 * sizeof(T), GetBlockingParams(), [&](cytnx_uint64 i, cytnx_uint64 m) {
+        fn(yre + i, yim + i, alpha.real(), alpha.imag(), xre + i, xim + i, m);
+      });
+    }
+
+    template <class T>
+    complex<T> SplitSum_cpu(const T *re, const T *im, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_sum");
+      return reduce<T>(kernels<T>().sum, re, im, (const T *)nullptr, (const T *)nullptr, n);
+    }
+
+    template <class T>
+    complex<T> SplitVdot_cpu(const T *are, const T *aim, const T *bre, const T *bim,
+                             const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_vdot");
+      return reduce<T>(kernels<T>().vdot, are, aim, bre, bim, n);
+    }
+
+    template <class T>
+    T SplitNorm2_cpu(const T *re, const T *im, const cytnx_uint64 &n) {
+      CYTNX_TRACE_SCOPE("kernel.split_norm2");
+      return reduce<T>(kernels<T>().norm2, re, im, (const T *)nullptr, (const T *)nullptr, n)
+        .real();
+    }
+
+#define CYTNX_SPLIT_INSTANTIATE(T)                                                              \
+  template void Deinterleave_cpu<T>(T *, T *, const complex<T> *, const cytnx_uint64 &);        \
+  template void Deinterleave_cpu<T>(T *, T *, const complex<T> *, const cytnx_uint64 &,         \
+                                    const BlockingParams &);                                    \
+  template void Interleave_cpu<T>(complex<T> *, const T *, const T *, const cytnx_uint64 &);    \
+  template void Interleave_cpu<T>(complex<T> *, const T *, const T *, const cytnx_uint64 &,     \
+                                  const BlockingParams &);                                      \
+  template void SplitAdd_cpu<T>(T *, T *, const T *, const T *, const T *, const T *,           \
+                                const cytnx_uint64 &);                                          \
+  template void SplitMul_cpu<T>(T *, T *, const T *, const T *, const T *, const T *,           \
+                                const cytnx_uint64 &);                                          \
+  template void SplitMul_cpu<T>(T *, T *, const T *, const T *, const T *, const T *,           \
+                                const cytnx_uint64 &, const BlockingParams &);                  \
+  template void SplitScal_cpu<T>(T *, T *, const complex<T> &, const cytnx_uint64 &);           \
+  template void SplitAxpy_cpu<T>(T *, T *, const complex<T> &, const T *, const T *,            \
+                                 const cytnx_uint64 &);                                         \
+  template complex<T> SplitSum_cpu<T>(const T *, const T *, const cytnx_uint64 &);              \
+  template complex<T> SplitVdot_cpu<T>(const T *, const T *, const T *, const T *,              \
+                                       const cytnx_uint64 &);                                   \
+  template T SplitNorm2_cpu<T>(const T *, const T *, const cytnx_uint64 &);
+
+    CYTNX_SPLIT_INSTANTIATE(cytnx_double)
+    CYTNX_SPLIT_INSTANTIATE(cytnx_float)
+
+#undef CYTNX_SPLIT_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
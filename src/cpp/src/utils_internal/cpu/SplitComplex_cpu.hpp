@@ -0,0 +1,71 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPLITCOMPLEX_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPLITCOMPLEX_CPU_H_
+
+#include <complex>
+
+#include <cytnx_core/Type.hpp>
+#include "Blocking_cpu.hpp"
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    /**
+     * @brief Kernels on split-complex arrays, n complex values held as a plane of real parts
+     * `re` and a plane of imaginary parts `im`, for T = double and float.
+     *
+     * Without the interleaved layout a complex multiply is four plain FMAs on full vectors with
+     * no shuffles. The kernels take an AVX2/FMA path when the CPU has it and are parallelized in
+     * chunks of `params.convert_chunk_bytes` over `params.convert_threads` threads. Reductions
+     * sum the chunks in order, so their result does not depend on the number of threads.
+     *
+     * Outputs may alias inputs element by element (e.g. ore == are), not with an offset.
+     */
+
+    // interleaved <-> split conversion; out and in must not overlap
+    template <class T>
+    void Deinterleave_cpu(T *re, T *im, const std::complex<T> *in, const cytnx_uint64 &n);
+    template <class T>
+    void Interleave_cpu(std::complex<T> *out, const T *re, const T *im, const cytnx_uint64 &n);
+
+    // o = a + b
+    template <class T>
+    void SplitAdd_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n);
+    // o = a * b
+    template <class T>
+    void SplitMul_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n);
+    // x *= alpha
+    template <class T>
+    void SplitScal_cpu(T *re, T *im, const std::complex<T> &alpha, const cytnx_uint64 &n);
+    // y += alpha * x
+    template <class T>
+    void SplitAxpy_cpu(T *yre, T *yim, const std::complex<T> &alpha, const T *xre, const T *xim,
+                       const cytnx_uint64 &n);
+
+    // sum of x
+    template <class T>
+    std::complex<T> SplitSum_cpu(const T *re, const T *im, const cytnx_uint64 &n);
+    // sum of conj(a) * b
+    template <class T>
+    std::complex<T> SplitVdot_cpu(const T *are, const T *aim, const T *bre, const T *bim,
+                                  const cytnx_uint64 &n);
+    // sum of |x|^2
+    template <class T>
+    T SplitNorm2_cpu(const T *re, const T *im, const cytnx_uint64 &n);
+
+    // same as above with explicit blocking
+    template <class T>
+    void Deinterleave_cpu(T *re, T *im, const std::complex<T> *in, const cytnx_uint64 &n,
+                          const BlockingParams &params);
+    template <class T>
+    void Interleave_cpu(std::complex<T> *out, const T *re, const T *im, const cytnx_uint64 &n,
+                        const BlockingParams &params);
+    template <class T>
+    void SplitMul_cpu(T *ore, T *oim, const T *are, const T *aim, const T *bre, const T *bim,
+                      const cytnx_uint64 &n, const BlockingParams &params);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_SPLITCOMPLEX_CPU_H_
@@ -0,0 +1,57 @@
+#include "Svd_cpu.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <cytnx_core/Trace.hpp>
+#include <cytnx_core/errors/cytnx_error.hpp>
+#include <cytnx_core/lapack_wrapper.hpp>
+
+using namespace std;
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    template <class T>
+    void Svd_cpu(T *a, const blas_int &m, const blas_int &n, const bool &vectors,
+                 svd_real_t<T> *s, T *u, T *vt) {
+      CYTNX_TRACE_SCOPE("kernel.svd");
+      typedef svd_real_t<T> R;
+      const blas_int k = std::min(m, n);
+      if (k == 0) return;
+      const char job = vectors ? 'S' : 'N';
+      // the leading dimensions must be at least 1 even when u and vt are not referenced
+      const blas_int ldu = vectors ? m : 1, ldvt = vectors ? k : 1;
+      blas_int lwork = -1, info;
+      T q = 0;
+      vector<R> rwork(is_complex_v<T> ? 5 * size_t(k) : 0);
+      const auto call = [&](T *work) {
+        if constexpr (std::is_same_v<T, cytnx_double>)
+          dgesvd(&job, &job, &m, &n, a, &m, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
+        else if constexpr (std::is_same_v<T, cytnx_float>)
+          sgesvd(&job, &job, &m, &n, a, &m, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
+        else if constexpr (std::is_same_v<T, cytnx_complex128>)
+          zgesvd(&job, &job, &m, &n, a, &m, s, u, &ldu, vt, &ldvt, work, &lwork, rwork.data(),
+                 &info);
+        else
+          cgesvd(&job, &job, &m, &n, a, &m, s, u, &ldu, vt, &ldvt, work, &lwork, rwork.data(),
+                 &info);
+      };
+      call(&q);
+      lwork = std::max<blas_int>(1, blas_int(std::real(q)));
+      vector<T> work(lwork);
+      call(work.data());
+      cytnx_system_error_msg(info != 0, "[ERROR] svd: ?gesvd failed (info %d).\n", int(info));
+    }
+
+#define CYTNX_SVD_INSTANTIATE(T)                                                                \
+  template void Svd_cpu<T>(T *, const blas_int &, const blas_int &, const bool &,               \
+                           svd_real_t<T> *, T *, T *);
+    CYTNX_SVD_INSTANTIATE(cytnx_double)
+    CYTNX_SVD_INSTANTIATE(cytnx_float)
+    CYTNX_SVD_INSTANTIATE(cytnx_complex128)
+    CYTNX_SVD_INSTANTIATE(cytnx_complex64)
+#undef CYTNX_SVD_INSTANTIATE
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
@@ -0,0 +1,31 @@
+#ifndef CYTNX_BACKEND_UTILS_INTERNAL_CPU_SVD_CPU_H_
+#define CYTNX_BACKEND_UTILS_INTERNAL_CPU_SVD_CPU_H_
+
+#include <complex>
+#include <utility>
+
+#include <cytnx_core/Type.hpp>
+
+namespace cytnx_core {
+  namespace utils_internal {
+
+    // the real type of the singular values of a T matrix
+    template <class T>
+    using svd_real_t = decltype(std::real(std::declval<T>()));
+
+    /**
+     * @brief The thin singular value decomposition a = u diag(s) vt of the m x n matrix a,
+     * column-major, by ?gesvd.
+     *
+     * a is destroyed; s holds k = min(m, n) elements, in descending order. With `vectors`, u
+     * (m x k) and vt (k x n) receive the singular vectors, column-major; otherwise they are not
+     * referenced. Thread-safe, the workspace is allocated per call.
+     */
+    template <class T>
+    void Svd_cpu(T *a, const blas_int &m, const blas_int &n, const bool &vectors,
+                 svd_real_t<T> *s, T *u, T *vt);
+
+  }  // namespace utils_internal
+}  // namespace cytnx_core
+
+#endif  // CYTNX_BACKEND_UTILS_INTERNAL_CPU_SVD_CPU_H_
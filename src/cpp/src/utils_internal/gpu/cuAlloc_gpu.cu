@@ -1,5 +1,7 @@
 #include "cuAlloc_gpu.hpp"
 
+#include <cytnx_core/Trace.hpp>
+
 using namespace std;
 
 namespace cytnx_core {
@@ -9,12 +11,14 @@ namespace cytnx_core {
     //     return calloc(M,perelem_bytes);
     // }
     void* cuCalloc_gpu(const cytnx_uint64& N, const cytnx_uint64& perelem_bytes) {
+      CYTNX_TRACE_SCOPE("alloc.cuda_calloc");
       void* ptr;
       checkCudaErrors(cudaMallocManaged((void**)&ptr, perelem_bytes * N));
       checkCudaErrors(cudaMemset(ptr, 0, perelem_bytes * N));
       return ptr;
     }
     void* cuMalloc_gpu(const cytnx_uint64& bytes) {
+      CYTNX_TRACE_SCOPE("alloc.cuda_malloc");
       void* ptr;
       checkCudaErrors(cudaMallocManaged(&ptr, bytes));
       return ptr;
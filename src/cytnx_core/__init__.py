@@ -1,4 +1,33 @@
 #  import this so the openblas can be properly pre-load
 import scipy_openblas64  # noqa F401
 
-from cytnx_core._core import Type as Type, device as device
+from cytnx_core._core import (
+    CheckError as CheckError,
+    CooMatrix as CooMatrix,
+    CsrMatrix as CsrMatrix,
+    DenseLinOp as DenseLinOp,
+    Error as Error,
+    KrylovExpmv as KrylovExpmv,
+    LinOp as LinOp,
+    QuantizationError as QuantizationError,
+    QuantizedStorage as QuantizedStorage,
+    SparseLinOp as SparseLinOp,
+    SparseSymmetry as SparseSymmetry,
+    SplitComplexStorage as SplitComplexStorage,
+    Storage as Storage,
+    StorageView as StorageView,
+    SystemFailure as SystemFailure,
+    Type as Type,
+    autotune as autotune,
+    check_level as check_level,
+    counters as counters,
+    device as device,
+    from_dlpack as from_dlpack,
+    io as io,
+    linalg as linalg,
+    num_workers as num_workers,
+    openmp as openmp,
+    perf as perf,
+    random as random,
+    trace as trace,
+)
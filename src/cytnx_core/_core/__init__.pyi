@@ -1,8 +1,28 @@
 from __future__ import annotations
 
 from enum import Enum
+from concurrent.futures import Future
+from typing import Any, Callable, Sequence, overload
 
-from . import device as device
+import numpy as np
+
+from . import (
+    autotune as autotune,
+    counters as counters,
+    device as device,
+    io as io,
+    linalg as linalg,
+    perf as perf,
+    random as random,
+    trace as trace,
+)
+
+class Error(RuntimeError): ...
+class CheckError(Error): ...
+class SystemFailure(Error): ...
+
+check_level: int
+openmp: bool
 
 class Type(Enum):
     @property
@@ -29,3 +49,272 @@ class Type(Enum):
     def ComplexFloat(self) -> int: ...
     @property
     def ComplexDouble(self) -> int: ...
+    @property
+    def ComplexHalf(self) -> int: ...
+    @property
+    def ComplexBFloat16(self) -> int: ...
+    @property
+    def Half(self) -> int: ...
+    @property
+    def BFloat16(self) -> int: ...
+    @property
+    def Int8(self) -> int: ...
+
+class Storage:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(
+        self,
+        size: int,
+        dtype: Type = ...,
+        device: int = ...,
+        init_zero: bool = True,
+    ) -> None: ...
+    @overload
+    def __init__(self, buffer: Any) -> None: ...
+    @staticmethod
+    def from_numpy(array: np.ndarray) -> Storage: ...
+    def numpy(self) -> np.ndarray: ...
+    def size(self) -> int: ...
+    def __len__(self) -> int: ...
+    def nbytes(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    def dtype_str(self) -> str: ...
+    def device(self) -> int: ...
+    def device_str(self) -> str: ...
+    def same_data(self, rhs: Storage) -> bool: ...
+    def use_count(self) -> int: ...
+    def clone(self) -> Storage: ...
+    def astype(self, dtype: Type) -> Storage: ...
+    def clone_async(self) -> Future[Storage]: ...
+    def fill(self, val: bool | int | float | complex) -> None: ...
+    def fill_async(self, val: bool | int | float | complex) -> Future[None]: ...
+    def __dlpack__(self, stream: Any = None, **kwargs: Any) -> Any: ...
+    def __dlpack_device__(self) -> tuple[int, int]: ...
+    @staticmethod
+    def from_dlpack(obj: Any) -> Storage: ...
+def num_workers() -> int: ...
+
+class StorageView:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(self, storage: Storage) -> None: ...
+    @overload
+    def __init__(self, storage: Storage, shape: Sequence[int]) -> None: ...
+    @overload
+    def __init__(
+        self,
+        storage: Storage,
+        offset: int,
+        shape: Sequence[int],
+        strides: Sequence[int],
+    ) -> None: ...
+    def storage(self) -> Storage: ...
+    @property
+    def offset(self) -> int: ...
+    @property
+    def shape(self) -> list[int]: ...
+    @property
+    def strides(self) -> list[int]: ...
+    def rank(self) -> int: ...
+    def size(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    def device(self) -> int: ...
+    def is_contiguous(self) -> bool: ...
+    def is_shared(self) -> bool: ...
+    def is_conj(self) -> bool: ...
+    def conj(self) -> StorageView: ...
+    def slice(self, axis: int, start: int, stop: int, step: int = 1) -> StorageView: ...
+    def permute(self, axes: Sequence[int]) -> StorageView: ...
+    def transpose(self, a: int, b: int) -> StorageView: ...
+    def reshape(self, shape: Sequence[int]) -> StorageView: ...
+    def contiguous(self) -> StorageView: ...
+    def to_storage(self) -> Storage: ...
+    def numpy(self) -> np.ndarray: ...
+
+class SplitComplexStorage:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(self, size: int, dtype: Type = Type.ComplexDouble) -> None: ...
+    @staticmethod
+    def from_interleaved(storage: Storage) -> SplitComplexStorage: ...
+    @overload
+    def to_interleaved(self) -> Storage: ...
+    @overload
+    def to_interleaved(self, out: Storage) -> None: ...
+    def assign(self, storage: Storage) -> None: ...
+    def size(self) -> int: ...
+    def __len__(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    def device(self) -> int: ...
+    def real(self) -> Storage: ...
+    def imag(self) -> Storage: ...
+    def clone(self) -> SplitComplexStorage: ...
+    def add(self, rhs: SplitComplexStorage) -> None: ...
+    def mul(self, rhs: SplitComplexStorage) -> None: ...
+    def scale(self, alpha: complex) -> None: ...
+    def axpy(self, alpha: complex, x: SplitComplexStorage) -> None: ...
+    def sum(self) -> complex: ...
+    def vdot(self, rhs: SplitComplexStorage) -> complex: ...
+    def norm(self) -> float: ...
+
+class SparseSymmetry(Enum):
+    General = 0
+    Symmetric = 1
+    Hermitian = 2
+
+class CooMatrix:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(
+        self,
+        nrows: int,
+        ncols: int,
+        rows: Sequence[int],
+        cols: Sequence[int],
+        values: Storage,
+    ) -> None: ...
+    @property
+    def nrows(self) -> int: ...
+    @property
+    def ncols(self) -> int: ...
+    def nnz(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    @property
+    def rows(self) -> list[int]: ...
+    @property
+    def cols(self) -> list[int]: ...
+    @property
+    def values(self) -> Storage: ...
+    def to_csr(self, symmetry: SparseSymmetry = ...) -> CsrMatrix: ...
+
+class CsrMatrix:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(
+        self,
+        nrows: int,
+        ncols: int,
+        indptr: Sequence[int],
+        indices: Sequence[int],
+        values: Storage,
+        symmetry: SparseSymmetry = ...,
+    ) -> None: ...
+    @property
+    def nrows(self) -> int: ...
+    @property
+    def ncols(self) -> int: ...
+    def nnz(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    @property
+    def symmetry(self) -> SparseSymmetry: ...
+    @property
+    def indptr(self) -> list[int]: ...
+    @property
+    def indices(self) -> list[int]: ...
+    @property
+    def values(self) -> Storage: ...
+    def row_blocks(self) -> list[int]: ...
+    @overload
+    def matvec(self, x: Storage) -> Storage: ...
+    @overload
+    def matvec(self, x: Storage, y: Storage) -> None: ...
+    @overload
+    def matmat(self, x: StorageView) -> StorageView: ...
+    @overload
+    def matmat(self, x: StorageView, y: StorageView) -> None: ...
+    def to_dense(self) -> Storage: ...
+
+class LinOp:
+    def __init__(
+        self,
+        fn: Callable[[np.ndarray, np.ndarray], np.ndarray | None],
+        nx: int,
+        dtype: Type = ...,
+    ) -> None: ...
+    def nx(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    @overload
+    def matvec(self, x: Storage) -> Storage: ...
+    @overload
+    def matvec(self, x: Storage, y: Storage) -> None: ...
+    @overload
+    def matmat(self, x: StorageView) -> StorageView: ...
+    @overload
+    def matmat(self, x: StorageView, y: StorageView) -> None: ...
+
+class DenseLinOp(LinOp):
+    def __init__(self, matrix: StorageView) -> None: ...
+    @property
+    def matrix(self) -> StorageView: ...
+
+class SparseLinOp(LinOp):
+    def __init__(self, matrix: CsrMatrix) -> None: ...
+    @property
+    def matrix(self) -> CsrMatrix: ...
+
+class KrylovExpmv:
+    class Stats:
+        @property
+        def steps(self) -> int: ...
+        @property
+        def rejected(self) -> int: ...
+        @property
+        def matvecs(self) -> int: ...
+        @property
+        def error(self) -> float: ...
+
+    def __init__(self, op: LinOp, krylov_dim: int = 30, tol: float = 1e-12) -> None: ...
+    @property
+    def op(self) -> LinOp: ...
+    def krylov_dim(self) -> int: ...
+    def tol(self) -> float: ...
+    def apply(self, v: Storage, t: complex) -> None: ...
+    @property
+    def stats(self) -> KrylovExpmv.Stats: ...
+
+class QuantizationError:
+    @property
+    def max_abs(self) -> float: ...
+    @property
+    def rms(self) -> float: ...
+    @property
+    def rel_rms(self) -> float: ...
+    @property
+    def max_value(self) -> float: ...
+
+class QuantizedStorage:
+    def __init__(self) -> None: ...
+    @staticmethod
+    def quantize(
+        src: Storage, bits: int = 8, block_size: int = 64
+    ) -> QuantizedStorage: ...
+    def dequantize(self) -> Storage: ...
+    def size(self) -> int: ...
+    def __len__(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    @property
+    def bits(self) -> int: ...
+    @property
+    def block_size(self) -> int: ...
+    def nbytes(self) -> int: ...
+    def compression_ratio(self) -> float: ...
+    @property
+    def error(self) -> QuantizationError: ...
+    def values(self) -> Storage: ...
+    def scales(self) -> Storage: ...
+
+def from_dlpack(obj: Any) -> Storage: ...
+def num_workers() -> int: ...
@@ -0,0 +1,21 @@
+from __future__ import annotations
+
+from concurrent.futures import Future
+
+class Entry:
+    @property
+    def kernel(self) -> str: ...
+    @property
+    def block_bytes(self) -> int: ...
+    @property
+    def threads(self) -> int: ...
+    @property
+    def seconds(self) -> float: ...
+
+def cache_path() -> str: ...
+def enabled() -> bool: ...
+def entries() -> list[Entry]: ...
+def tuned_entries() -> list[Entry]: ...
+def prewarm(force: bool = False) -> list[Entry]: ...
+def prewarm_async(force: bool = False) -> Future[list[Entry]]: ...
+def clear_cache() -> None: ...
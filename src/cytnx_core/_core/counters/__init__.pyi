@@ -0,0 +1,22 @@
+from __future__ import annotations
+
+class Entry:
+    @property
+    def routine(self) -> str: ...
+    @property
+    def dtype(self) -> int: ...
+    @property
+    def calls(self) -> int: ...
+    @property
+    def flops(self) -> float: ...
+    @property
+    def bytes(self) -> float: ...
+    @property
+    def seconds(self) -> float: ...
+
+def enable(on: bool = True) -> None: ...
+def disable() -> None: ...
+def enabled() -> bool: ...
+def reset() -> None: ...
+def entries() -> list[Entry]: ...
+def report(peak_gflops: float = 0, peak_gbs: float = 0) -> str: ...
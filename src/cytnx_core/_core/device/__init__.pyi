@@ -4,6 +4,18 @@ Cpu: int = ...
 Cuda: int = ...
 Ngpus: int = ...
 Ncpus: int = ...
+Cpu_model: str = ...
+Nsockets: int = ...
+Nnuma: int = ...
+Ncores: int = ...
+Nsmt: int = ...
+L1d_size: int = ...
+L2_size: int = ...
+L3_size: int = ...
+Cacheline_size: int = ...
+Simd: list[str] = ...
 
 def print_property() -> None: ...
 def getname(device_id: int) -> str: ...
+def has_simd(ext: str) -> bool: ...
+def cpu_signature() -> str: ...
@@ -0,0 +1,102 @@
+from __future__ import annotations
+
+from concurrent.futures import Future
+
+from .. import Storage, Type
+
+tensor_file_version: int
+default_chunk_bytes: int
+
+class TensorFileInfo:
+    @property
+    def version(self) -> int: ...
+    @property
+    def dtype(self) -> Type: ...
+    @property
+    def shape(self) -> list[int]: ...
+    @property
+    def size(self) -> int: ...
+    @property
+    def chunk_bytes(self) -> int: ...
+    @property
+    def payload_offset(self) -> int: ...
+    @property
+    def checksums(self) -> list[int]: ...
+
+def save(
+    path: str, storage: Storage, shape: list[int] = ..., chunk_bytes: int = ...
+) -> None: ...
+def save_async(
+    path: str, storage: Storage, shape: list[int] = ..., chunk_bytes: int = ...
+) -> Future[None]: ...
+def load(path: str, verify: bool = False) -> tuple[Storage, list[int]]: ...
+def load_async(path: str, verify: bool = False) -> Future[tuple[Storage, list[int]]]: ...
+def info(path: str) -> TensorFileInfo: ...
+def verify(path: str) -> list[int]: ...
+def save_stream(
+    path: str,
+    storage: Storage,
+    shape: list[int] = ...,
+    chunk_bytes: int = ...,
+    shuffle: bool = True,
+    compress: bool = True,
+    threads: int = 0,
+) -> None: ...
+def save_stream_async(
+    path: str,
+    storage: Storage,
+    shape: list[int] = ...,
+    chunk_bytes: int = ...,
+    shuffle: bool = True,
+    compress: bool = True,
+    threads: int = 0,
+) -> Future[None]: ...
+
+class StreamChunk:
+    @property
+    def offset(self) -> int: ...
+    @property
+    def stored_bytes(self) -> int: ...
+    @property
+    def checksum(self) -> int: ...
+    @property
+    def codec(self) -> int: ...
+
+class StreamReader:
+    def __init__(self, path: str) -> None: ...
+    @property
+    def dtype(self) -> Type: ...
+    @property
+    def shape(self) -> list[int]: ...
+    @property
+    def size(self) -> int: ...
+    @property
+    def chunk_bytes(self) -> int: ...
+    @property
+    def chunks(self) -> list[StreamChunk]: ...
+    def nchunks(self) -> int: ...
+    def __len__(self) -> int: ...
+    def chunk_begin(self, i: int) -> int: ...
+    def chunk_size(self, i: int) -> int: ...
+    def read_chunk(self, i: int) -> Storage: ...
+    def read(self, threads: int = 0) -> Storage: ...
+
+def load_stream(path: str, threads: int = 0) -> tuple[Storage, list[int]]: ...
+def load_stream_async(path: str, threads: int = 0) -> Future[tuple[Storage, list[int]]]: ...
+
+class DeltaCheckpoint:
+    def __init__(self, path: str, chunk_bytes: int = ..., compact_ratio: float = 4.0) -> None: ...
+    def stage(self, name: str, storage: Storage, shape: list[int] = ...) -> None: ...
+    def remove(self, name: str) -> None: ...
+    def commit(self) -> int: ...
+    def restore(self) -> dict[str, tuple[Storage, list[int]]]: ...
+    def compact(self) -> None: ...
+    @property
+    def epoch(self) -> int: ...
+    @property
+    def chunk_bytes(self) -> int: ...
+    @property
+    def log_bytes(self) -> int: ...
+    @property
+    def live_bytes(self) -> int: ...
+    def names(self) -> list[str]: ...
@@ -0,0 +1,37 @@
+from __future__ import annotations
+
+from typing import overload
+
+from .. import StorageView
+
+def BlockEigh(
+    blocks: list[StorageView], is_V: bool = True, row_v: bool = False
+) -> list[list[StorageView]]: ...
+def BlockSvd(
+    blocks: list[StorageView], is_UvT: bool = True
+) -> list[list[StorageView]]: ...
+def BlockSvdTruncate(
+    blocks: list[StorageView], keepdim: int, err: float = 0, is_UvT: bool = True
+) -> list[list[StorageView]]: ...
+def Eigh(
+    a: StorageView, is_V: bool = True, row_v: bool = False
+) -> list[StorageView]: ...
+def EighIndex(
+    a: StorageView, il: int, iu: int, is_V: bool = True, row_v: bool = False
+) -> list[StorageView]: ...
+def EighInterval(
+    a: StorageView, vl: float, vu: float, is_V: bool = True, row_v: bool = False
+) -> list[StorageView]: ...
+def Expm(a: StorageView) -> StorageView: ...
+@overload
+def Matmul(a: StorageView, b: StorageView) -> StorageView: ...
+@overload
+def Matmul(
+    a: StorageView,
+    b: StorageView,
+    c: StorageView,
+    alpha: complex = 1,
+    beta: complex = 0,
+) -> None: ...
+def Matvec(a: StorageView, x: StorageView) -> StorageView: ...
+def Svd(a: StorageView, is_UvT: bool = True) -> list[StorageView]: ...
@@ -0,0 +1,35 @@
+from __future__ import annotations
+
+from types import TracebackType
+
+class Region:
+    @property
+    def name(self) -> str: ...
+    @property
+    def calls(self) -> int: ...
+    @property
+    def seconds(self) -> float: ...
+    @property
+    def counts(self) -> dict[str, float]: ...
+    @property
+    def ipc(self) -> float | None: ...
+
+class scope:
+    def __init__(self, name: str) -> None: ...
+    def __enter__(self) -> scope: ...
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc: BaseException | None,
+        tb: TracebackType | None,
+    ) -> None: ...
+
+def available() -> bool: ...
+def events() -> dict[str, bool]: ...
+def status() -> str: ...
+def enable(on: bool = True) -> None: ...
+def disable() -> None: ...
+def enabled() -> bool: ...
+def reset() -> None: ...
+def regions() -> list[Region]: ...
+def report() -> str: ...
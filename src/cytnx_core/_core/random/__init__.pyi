@@ -0,0 +1,34 @@
+from __future__ import annotations
+
+from .. import Storage, Type
+
+def uniform_(
+    s: Storage,
+    low: float = 0.0,
+    high: float = 1.0,
+    seed: int | None = None,
+    offset: int = 0,
+) -> None: ...
+def normal_(
+    s: Storage,
+    mean: float = 0.0,
+    std: float = 1.0,
+    seed: int | None = None,
+    offset: int = 0,
+) -> None: ...
+def uniform(
+    size: int,
+    low: float = 0.0,
+    high: float = 1.0,
+    dtype: Type = ...,
+    seed: int | None = None,
+    offset: int = 0,
+) -> Storage: ...
+def normal(
+    size: int,
+    mean: float = 0.0,
+    std: float = 1.0,
+    dtype: Type = ...,
+    seed: int | None = None,
+    offset: int = 0,
+) -> Storage: ...
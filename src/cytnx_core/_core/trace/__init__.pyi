@@ -0,0 +1,12 @@
+from __future__ import annotations
+
+ring_capacity: int
+
+def compiled() -> bool: ...
+def enable(on: bool = True) -> None: ...
+def disable() -> None: ...
+def enabled() -> bool: ...
+def clear() -> None: ...
+def num_events() -> int: ...
+def chrome_json() -> str: ...
+def dump(path: str) -> None: ...
@@ -0,0 +1,19 @@
+import numpy as np
+
+from cytnx_core import Storage, StorageView
+
+
+def random_array(shape, dtype, seed):
+    # standard normal entries, with an independent imaginary part for a complex dtype;
+    # seed is anything np.random.default_rng takes, a Generator continuing its stream
+    rng = np.random.default_rng(seed)
+    values = rng.standard_normal(shape)
+    if np.issubdtype(dtype, np.complexfloating):
+        values = values + 1j * rng.standard_normal(shape)
+    return values.astype(dtype)
+
+
+def as_view(x):
+    # a StorageView over a copy of the numpy array x, of the same shape
+    storage = Storage.from_numpy(np.ascontiguousarray(x).ravel())
+    return StorageView(storage, list(x.shape))
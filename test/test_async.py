@@ -0,0 +1,49 @@
+import asyncio
+import threading
+
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, Type, num_workers
+
+
+def test_fill_async():
+    s = Storage(1000, Type.Double)
+    assert s.fill_async(3.0).result(timeout=30) is None
+    assert np.all(s.numpy() == 3.0)
+
+
+def test_clone_async():
+    s = Storage(16, Type.ComplexFloat)
+    s.fill(1j)
+    t = s.clone_async().result(timeout=30)
+    assert not t.same_data(s)
+    assert np.all(t.numpy() == 1j)
+
+
+def test_async_error():
+    s = Storage(4, Type.Double)
+    with pytest.raises(RuntimeError):
+        s.fill_async(1 + 1j).result(timeout=30)
+
+
+def test_awaitable():
+    async def run():
+        stores = [Storage(100, Type.Float) for _ in range(4)]
+        futures = [asyncio.wrap_future(s.fill_async(i)) for i, s in enumerate(stores)]
+        await asyncio.gather(*futures)
+        return stores
+
+    stores = asyncio.run(run())
+    for i, s in enumerate(stores):
+        assert np.all(s.numpy() == i)
+    assert num_workers() >= 1
+
+
+def test_fill_releases_gil():
+    s = Storage(1 << 22, Type.Double)
+    t = threading.Thread(target=s.fill, args=(2.0,))
+    t.start()
+    t.join(timeout=30)
+    assert not t.is_alive()
+    assert s.numpy()[-1] == 2.0
@@ -0,0 +1,48 @@
+import os
+
+from cytnx_core import autotune, device
+
+
+def test_prewarm(tmp_path, monkeypatch):
+    cache = tmp_path / "autotune.txt"
+    monkeypatch.setenv("CYTNX_AUTOTUNE_CACHE", str(cache))
+    assert autotune.cache_path() == str(cache)
+
+    entries = autotune.prewarm()
+    assert os.path.exists(cache)
+    assert {e.kernel for e in entries} >= {"fill", "convert", "permute"}
+    for e in entries:
+        assert e.block_bytes > 0
+        assert e.threads >= 1
+
+    # the cache is keyed by the cpu signature and reloaded as is
+    assert device.cpu_signature() in cache.read_text()
+    assert [e.kernel for e in autotune.entries()] == [e.kernel for e in entries]
+
+    autotune.clear_cache()
+    assert not os.path.exists(cache)
+    assert autotune.entries() == []
+
+
+def test_opt_in(monkeypatch):
+    # tuning takes seconds, so a kernel's first use never runs it unless asked to
+    monkeypatch.delenv("CYTNX_AUTOTUNE", raising=False)
+    assert not autotune.enabled()
+    monkeypatch.setenv("CYTNX_AUTOTUNE", "1")
+    assert autotune.enabled()
+
+
+def test_cached_threads_are_capped(tmp_path, monkeypatch):
+    # a cache tuned on a larger thread budget must not oversubscribe this process
+    cache = tmp_path / "autotune.txt"
+    cache.write_text(
+        "# cytnx_core autotune cache v1\n"
+        f"signature {device.cpu_signature()}\n"
+        "fill 65536 100000 0.1\n"
+    )
+    monkeypatch.setenv("CYTNX_AUTOTUNE_CACHE", str(cache))
+    monkeypatch.delenv("CYTNX_AUTOTUNE", raising=False)
+    assert [e.threads for e in autotune.entries()] == [100000]
+    (fill,) = autotune.tuned_entries()
+    assert fill.block_bytes == 65536
+    assert 1 <= fill.threads <= (os.cpu_count() or 1)
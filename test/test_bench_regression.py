@@ -0,0 +1,86 @@
+"""Performance regression check against a stored baseline.
+
+The statistics are always tested. The benchmark comparison itself runs when
+both CYTNX_BENCH (the cytnx_core_bench binary, built with
+-DBUILD_BENCHMARKS=ON) and CYTNX_BENCH_BASELINE (a JSON file written by
+``python bench/regression.py run --save``) are set:
+
+    CYTNX_BENCH=build/bench/cytnx_core_bench \\
+    CYTNX_BENCH_BASELINE=baseline.json uv run pytest -m benchmark
+
+CYTNX_BENCH_ARGS passes extra flags to the benchmarks, e.g. --filter=gemm.
+"""
+
+import importlib.util
+import os
+import pathlib
+import sys
+
+import pytest
+
+_path = pathlib.Path(__file__).parents[1] / "bench" / "regression.py"
+_spec = importlib.util.spec_from_file_location("bench_regression", _path)
+regression = importlib.util.module_from_spec(_spec)
+sys.modules[_spec.name] = regression
+_spec.loader.exec_module(regression)
+
+
+def _doc(samples):
+    return {
+        "context": {"cpu": "test"},
+        "benchmarks": [{"id": k, "seconds": v} for k, v in samples.items()],
+    }
+
+
+def test_mann_whitney_exact():
+    # the only ordering with U = 9 out of C(6, 3) = 20
+    assert regression.mann_whitney_greater([4, 5, 6], [1, 2, 3]) == pytest.approx(0.05)
+    assert regression.mann_whitney_greater([1, 2, 3], [4, 5, 6]) == pytest.approx(1.0)
+
+
+def test_mann_whitney_ties():
+    x = [1, 1, 2, 2, 3, 3, 4, 2, 1, 3]
+    y = [2, 3, 3, 4, 5, 5, 6, 6, 4, 3]
+    # the exact permutation p-value is 0.0026
+    assert regression.mann_whitney_greater(y, x) == pytest.approx(0.0026, abs=1e-3)
+    assert regression.mann_whitney_greater(x, x) > 0.4
+
+
+def test_compare():
+    base = [1.0 + 0.01 * i for i in range(15)]
+    result = regression.compare(
+        _doc({"slow": base, "noisy": base, "fast": base, "gone": base}),
+        _doc(
+            {
+                "slow": [t * 1.2 for t in base],
+                "noisy": [t * 1.01 for t in base],
+                "fast": [t * 0.7 for t in base],
+                "added": base,
+            }
+        ),
+    )
+    verdicts = {c.id: c.verdict for c in result}
+    assert verdicts == {
+        "slow": "regression",
+        "noisy": "same",  # within the threshold
+        "fast": "improvement",
+        "gone": "missing",
+        "added": "new",
+    }
+    table = regression.format_table(result)
+    assert "+20.0%" in table and "regression" in table
+
+
+@pytest.mark.benchmark
+@pytest.mark.skipif(
+    not (os.environ.get("CYTNX_BENCH") and os.environ.get("CYTNX_BENCH_BASELINE")),
+    reason="set CYTNX_BENCH and CYTNX_BENCH_BASELINE to run the benchmarks",
+)
+def test_no_regression():
+    args = os.environ.get("CYTNX_BENCH_ARGS", "").split()
+    with open(os.environ["CYTNX_BENCH_BASELINE"]) as f:
+        baseline = regression.json.load(f)
+    current = regression.run_bench(os.environ["CYTNX_BENCH"], args)
+    result = regression.compare(baseline, current)
+    regressions = [c for c in result if c.verdict == "regression"]
+    assert not regressions, "\n" + regression.format_table(result)
@@ -0,0 +1,33 @@
+import pytest
+
+from cytnx_core import counters
+
+
+@pytest.fixture
+def counting():
+    counters.reset()
+    counters.enable()
+    yield
+    counters.disable()
+    counters.reset()
+
+
+def test_toggle():
+    counters.enable()
+    assert counters.enabled()
+    counters.disable()
+    assert not counters.enabled()
+
+
+def test_report(counting):
+    header = counters.report().splitlines()[0].split()
+    assert header[:3] == ["op", "dtype", "calls"]
+    assert "flop/B" in header
+    assert "%roof" not in header
+    assert "%roof" in counters.report(peak_gflops=100, peak_gbs=20).splitlines()[0]
+    assert counters.report().splitlines()[-1].split()[0] == "total"
+
+
+def test_reset(counting):
+    counters.reset()
+    assert counters.entries() == []
@@ -0,0 +1,117 @@
+import json
+import os
+
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, io, trace
+
+
+def test_only_changed_chunks_are_written(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    a = np.arange(200000, dtype=np.float64)
+    b = np.arange(1000, dtype=np.int32)
+    ckpt = io.DeltaCheckpoint(path, chunk_bytes=65536, compact_ratio=0)
+    ckpt.stage("a", Storage.from_numpy(a), [400, 500])
+    ckpt.stage("b", Storage.from_numpy(b))
+    first = ckpt.commit()
+
+    a[12345] = -1.0
+    ckpt.stage("a", Storage.from_numpy(a), [400, 500])
+    second = ckpt.commit()
+    assert ckpt.epoch == 2
+    assert second < 65536 < first
+
+    del ckpt
+    state = io.DeltaCheckpoint(path).restore()
+    assert sorted(state) == ["a", "b"]
+    s, shape = state["a"]
+    assert shape == [400, 500]
+    assert np.array_equal(s.numpy(), a)
+    assert np.array_equal(state["b"][0].numpy(), b)
+
+
+def test_remove_and_compact(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    ckpt = io.DeltaCheckpoint(path, chunk_bytes=4096, compact_ratio=0)
+    x = np.random.default_rng(0).random(5000)
+    for k in range(5):
+        ckpt.stage("x", Storage.from_numpy(x * k))
+        ckpt.stage("y", Storage.from_numpy(np.full(100, k, dtype=np.int64)))
+        ckpt.commit()
+    ckpt.remove("y")
+    ckpt.commit()
+    assert ckpt.names() == ["x"]
+
+    before = ckpt.log_bytes
+    ckpt.compact()
+    assert ckpt.log_bytes < before
+    assert ckpt.log_bytes >= ckpt.live_bytes
+    assert np.array_equal(ckpt.restore()["x"][0].numpy(), x * 4)
+
+
+def test_torn_tail_is_discarded(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    arr = np.arange(3000, dtype=np.float32)
+    ckpt = io.DeltaCheckpoint(path, chunk_bytes=1024)
+    ckpt.stage("t", Storage.from_numpy(arr))
+    ckpt.commit()
+    del ckpt
+    with open(path, "ab") as f:
+        f.write(b"\x02\x00\x00\x00partial record")
+
+    ckpt = io.DeltaCheckpoint(path)
+    assert ckpt.epoch == 1
+    assert np.array_equal(ckpt.restore()["t"][0].numpy(), arr)
+
+
+def test_single_writer(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    ckpt = io.DeltaCheckpoint(path)
+    with pytest.raises(RuntimeError):
+        io.DeltaCheckpoint(path)
+    del ckpt
+
+
+def test_failed_compaction_keeps_the_commit(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    ckpt = io.DeltaCheckpoint(path, chunk_bytes=1024, compact_ratio=1.5)
+    # a directory in place of the temporary file makes the compaction fail
+    os.mkdir(f"{path}.tmp{os.getpid()}")
+    arr = np.arange(1000, dtype=np.float64)
+    for k in range(4):
+        ckpt.stage("x", Storage.from_numpy(arr * k))
+        ckpt.commit()
+    assert ckpt.epoch == 4
+    before = ckpt.log_bytes
+    assert before > 1.5 * ckpt.live_bytes
+
+    # the deferred compaction runs at the next commit
+    os.rmdir(f"{path}.tmp{os.getpid()}")
+    ckpt.stage("x", Storage.from_numpy(arr * 4))
+    ckpt.commit()
+    assert ckpt.log_bytes < before
+    assert np.array_equal(ckpt.restore()["x"][0].numpy(), arr * 4)
+
+
+@pytest.mark.skipif(not trace.compiled(), reason="needs a build with USE_TRACE")
+def test_compaction_syncs_the_directory(tmp_path):
+    path = str(tmp_path / "state.cdl")
+    ckpt = io.DeltaCheckpoint(path, chunk_bytes=1024, compact_ratio=0)
+    for k in range(3):
+        ckpt.stage("x", Storage.from_numpy(np.arange(1000.0) * k))
+        ckpt.commit()
+    trace.clear()
+    trace.enable()
+    try:
+        ckpt.compact()
+    finally:
+        trace.disable()
+    events = json.loads(trace.chrome_json())["traceEvents"]
+    trace.clear()
+    spans = [e for e in events if e["ph"] == "X"]
+    # the rename of the compacted log is made durable before compact() returns
+    (compact,) = [e for e in spans if e["name"] == "io.checkpoint_compact"]
+    syncs = [e for e in spans if e["name"] == "io.sync_dir"]
+    end = compact["ts"] + compact["dur"]
+    assert any(compact["ts"] <= e["ts"] and e["ts"] + e["dur"] <= end for e in syncs)
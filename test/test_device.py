@@ -8,6 +8,19 @@ def test_device():
     assert isinstance(device.Ncpus, int)
 
 
+def test_device_topology():
+    assert device.Nsockets >= 1
+    assert device.Nnuma >= 1
+    assert 1 <= device.Ncores <= device.Ncpus
+    assert device.Nsmt >= 1
+    assert device.L1d_size > 0 and device.L2_size > 0 and device.L3_size > 0
+    assert device.Cacheline_size > 0
+    assert isinstance(device.Cpu_model, str)
+    assert all(isinstance(ext, str) for ext in device.Simd)
+    for ext in device.Simd:
+        assert device.has_simd(ext)
+
+
 def test_device_prop():
     device.print_property()
 
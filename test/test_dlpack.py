@@ -0,0 +1,51 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, Type, from_dlpack
+
+
+@pytest.mark.parametrize(
+    "np_dtype, dtype",
+    [
+        (np.complex128, Type.ComplexDouble),
+        (np.complex64, Type.ComplexFloat),
+        (np.float64, Type.Double),
+        (np.float32, Type.Float),
+        (np.int64, Type.Int64),
+        (np.uint32, Type.Uint32),
+        (np.int16, Type.Int16),
+        (np.float16, Type.Half),
+    ],
+)
+def test_import_numpy(np_dtype, dtype):
+    arr = np.arange(6, dtype=np_dtype).reshape(2, 3)
+    s = from_dlpack(arr)
+    assert s.dtype == dtype
+    assert s.size() == 6
+    s.fill(3)
+    assert np.all(arr == 3)
+
+
+def test_export_numpy():
+    s = Storage(5, Type.Double)
+    assert s.__dlpack_device__() == (1, 0)
+    arr = np.from_dlpack(s)
+    s.fill(2.0)
+    assert np.all(arr == 2.0)
+    del s
+    assert arr.sum() == 10.0
+
+
+def test_roundtrip():
+    s = Storage(4, Type.ComplexFloat)
+    t = Storage.from_dlpack(s)
+    assert t.same_data(s)
+    assert t.dtype == Type.ComplexFloat
+
+
+def test_capsule_consumed_once():
+    s = Storage(4, Type.Float)
+    capsule = s.__dlpack__()
+    from_dlpack(capsule)
+    with pytest.raises(RuntimeError):
+        from_dlpack(capsule)
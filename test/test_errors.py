@@ -0,0 +1,63 @@
+import numpy as np
+import pytest
+
+import cytnx_core
+from conftest import as_view
+from cytnx_core import (
+    CheckError,
+    DenseLinOp,
+    Error,
+    KrylovExpmv,
+    Storage,
+    SystemFailure,
+    Type,
+    device,
+    from_dlpack,
+    io,
+)
+
+
+def test_hierarchy():
+    assert issubclass(Error, RuntimeError)
+    assert issubclass(CheckError, Error)
+    assert issubclass(SystemFailure, Error)
+    assert cytnx_core.check_level in (0, 1, 2)
+
+
+@pytest.mark.skipif(cytnx_core.check_level == 0, reason="built without argument checks")
+def test_check_error():
+    with pytest.raises(CheckError, match="Void"):
+        Storage(4, Type.Void)
+
+
+def test_input_error_at_every_level():
+    # input the code cannot continue past is rejected even at check level none
+    with pytest.raises(CheckError, match="contiguous"):
+        Storage.from_numpy(np.zeros((4, 4))[:, ::2])
+    with pytest.raises(CheckError, match="no matching cytnx Type"):
+        Storage.from_numpy(np.zeros(4, dtype="S4"))
+    if device.Ngpus == 0:
+        with pytest.raises(CheckError, match="without CUDA"):
+            Storage(4, Type.Double, device=0)
+    capsule = Storage(4, Type.Float).__dlpack__()
+    from_dlpack(capsule)
+    with pytest.raises(CheckError, match="consumed"):
+        from_dlpack(capsule)
+
+
+def test_system_failure(tmp_path):
+    missing = str(tmp_path / "missing.ctf")
+    with pytest.raises(SystemFailure, match="cannot open"):
+        io.load(missing)
+    err = io.load_async(missing).exception(timeout=30)
+    assert isinstance(err, SystemFailure)
+
+
+def test_numerical_failure_at_every_level():
+    # a NaN operator never meets tol: the step-size loop must stop even at level none
+    h = np.eye(4) + 0.1
+    h[1, 1] = np.nan
+    op = DenseLinOp(as_view(h))
+    v = Storage.from_numpy(np.ones(4, dtype=np.complex128))
+    with pytest.raises(SystemFailure, match="step size"):
+        KrylovExpmv(op, 3, 1e-8).apply(v, 1)
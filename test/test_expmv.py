@@ -0,0 +1,179 @@
+import numpy as np
+import pytest
+
+from conftest import as_view, random_array
+from cytnx_core import (
+    CooMatrix,
+    DenseLinOp,
+    Error,
+    KrylovExpmv,
+    LinOp,
+    SparseLinOp,
+    Storage,
+    Type,
+    linalg,
+)
+
+
+def hermitian(n, seed, real=False):
+    a = random_array((n, n), np.float64 if real else np.complex128, seed)
+    return (a + a.conj().T) / 2
+
+
+def expm_hermitian(h, t):
+    # exp(t H) of a Hermitian H from its eigendecomposition
+    w, u = np.linalg.eigh(h)
+    return (u * np.exp(t * w)) @ u.conj().T
+
+
+@pytest.mark.parametrize("real", [False, True])
+def test_time_evolution(real):
+    n = 120
+    h = hermitian(n, 0, real)
+    op = DenseLinOp(as_view(h))
+    assert op.dtype == (Type.Double if real else Type.ComplexDouble)
+    k = KrylovExpmv(op, 30, 1e-10)
+    assert k.krylov_dim() == 30 and k.tol() == 1e-10
+
+    v0 = random_array(n, np.complex128, 1)
+    v = Storage.from_numpy(v0.copy())
+    k.apply(v, -2.5j)
+    expect = expm_hermitian(h, -2.5j) @ v0
+    np.testing.assert_allclose(v.numpy(), expect, atol=1e-8 * np.linalg.norm(v0))
+    # the evolution is unitary
+    assert abs(np.linalg.norm(v.numpy()) - np.linalg.norm(v0)) < 1e-9
+
+    s = k.stats
+    assert s.steps >= 1 and s.matvecs >= s.steps * 30 and s.error < 1e-8
+
+
+def test_real_time_and_decay():
+    # a complex t mixes evolution with decay
+    h = hermitian(60, 2)
+    v0 = random_array(60, np.complex128, 3)
+    k = KrylovExpmv(DenseLinOp(as_view(h)), 20)
+    v = Storage.from_numpy(v0.copy())
+    k.apply(v, -0.3 - 1j)
+    np.testing.assert_allclose(
+        v.numpy(), expm_hermitian(h, -0.3 - 1j) @ v0, rtol=1e-9, atol=1e-9
+    )
+
+
+def test_adaptive_steps():
+    # a long time over a small Krylov space takes several steps, each reusing the basis
+    n = 200
+    h = hermitian(n, 4, real=True)
+    k = KrylovExpmv(DenseLinOp(as_view(h)), 12)
+    v0 = random_array(n, np.complex128, 5)
+    v = Storage.from_numpy(v0.copy())
+    k.apply(v, -10j)
+    assert k.stats.steps > 1
+    np.testing.assert_allclose(
+        v.numpy(), expm_hermitian(h, -10j) @ v0, atol=1e-8 * np.linalg.norm(v0)
+    )
+    # time stepping in pieces gives the same state
+    w = Storage.from_numpy(v0.copy())
+    for _ in range(4):
+        k.apply(w, -2.5j)
+    np.testing.assert_allclose(w.numpy(), v.numpy(), atol=1e-8 * np.linalg.norm(v0))
+
+
+def test_sparse_and_callback():
+    # the 1D tight-binding chain, as a sparse matrix and as a Python callback
+    n = 300
+    rows = np.concatenate([np.arange(n - 1), np.arange(1, n)])
+    cols = np.concatenate([np.arange(1, n), np.arange(n - 1)])
+    values = Storage.from_numpy(-np.ones(2 * (n - 1)))
+    csr = CooMatrix(n, n, rows.tolist(), cols.tolist(), values).to_csr()
+    h = np.zeros((n, n))
+    h[rows, cols] = -1
+
+    def apply(x, y):
+        y[...] = h @ x
+
+    v0 = np.zeros(n, dtype=np.complex128)
+    v0[n // 2] = 1
+    expect = expm_hermitian(h, -5j) @ v0
+    for op in [SparseLinOp(csr), LinOp(apply, n)]:
+        v = Storage.from_numpy(v0.copy())
+        KrylovExpmv(op).apply(v, -5j)
+        np.testing.assert_allclose(v.numpy(), expect, atol=1e-10)
+
+
+def test_invariant_subspace():
+    # a Krylov space as large as the operator ends in one exact step
+    d = np.diag(np.arange(5.0))
+    k = KrylovExpmv(DenseLinOp(as_view(d)))
+    assert k.krylov_dim() == 5
+    v = Storage.from_numpy(np.ones(5, dtype=np.complex128))
+    k.apply(v, 0.5)
+    np.testing.assert_allclose(v.numpy(), np.exp(0.5 * np.arange(5)), rtol=1e-13)
+    assert k.stats.steps == 1 and k.stats.rejected == 0
+
+    # so does a vector in an invariant subspace, here an eigenvector
+    v = Storage.from_numpy(np.eye(5, dtype=np.complex128)[2])
+    k.apply(v, -1j)
+    np.testing.assert_allclose(v.numpy(), np.exp(-2j) * np.eye(5)[2], atol=1e-14)
+    assert k.stats.matvecs == 1
+
+
+def test_breakdown_ignores_tol():
+    # the residual 1e-3 of the first Arnoldi step is below a loose tol, but the space
+    # of e0 is not invariant: over t = 1000 the weak coupling moves most of the weight
+    h = np.array([[1.0, 1e-3], [1e-3, 1.0]])
+    k = KrylovExpmv(DenseLinOp(as_view(h)), tol=1e-2)
+    v = Storage.from_numpy(np.array([1.0, 0.0], dtype=np.complex128))
+    k.apply(v, -1000j)
+    np.testing.assert_allclose(v.numpy(), expm_hermitian(h, -1000j)[:, 0], atol=1e-8)
+
+
+def test_zero():
+    k = KrylovExpmv(DenseLinOp(as_view(hermitian(10, 6))))
+    v = Storage.from_numpy(random_array(10, np.complex128, 7))
+    before = v.numpy().copy()
+    k.apply(v, 0)
+    np.testing.assert_array_equal(v.numpy(), before)
+    z = Storage(10, Type.ComplexDouble)
+    k.apply(z, 1j)
+    np.testing.assert_array_equal(z.numpy(), 0)
+    assert k.stats.matvecs == 0
+
+
+def test_expm():
+    rng = np.random.default_rng(8)
+    for n, scale in [(1, 1), (4, 0.01), (16, 1), (30, 20)]:
+        a = scale * random_array((n, n), np.complex128, rng)
+        h = (a + a.conj().T) / 2
+        e = linalg.Expm(as_view(-1j * h))
+        assert e.dtype == Type.ComplexDouble and e.shape == [n, n]
+        np.testing.assert_allclose(
+            e.numpy(), expm_hermitian(h, -1j), atol=1e-11 * max(1, scale)
+        )
+    # a real matrix, and a transposed view
+    h = hermitian(8, 9, real=True)
+    np.testing.assert_allclose(
+        linalg.Expm(as_view(h)).numpy(), expm_hermitian(h, 1), rtol=1e-12
+    )
+    a = random_array((6, 6), np.float64, rng)
+    at = linalg.Expm(as_view(a).transpose(0, 1)).numpy()
+    np.testing.assert_allclose(at, linalg.Expm(as_view(a)).numpy().T, rtol=1e-12)
+
+
+def test_errors():
+    op = DenseLinOp(as_view(np.eye(4, dtype=np.float32)))
+    with pytest.raises(Error):
+        KrylovExpmv(op)
+    op = DenseLinOp(as_view(np.eye(4)))
+    with pytest.raises(Error):
+        KrylovExpmv(op, 0)
+    with pytest.raises(Error):
+        KrylovExpmv(op, 10, 0)
+    k = KrylovExpmv(op)
+    with pytest.raises(Error):
+        k.apply(Storage(4, Type.Double), 1)
+    with pytest.raises(Error):
+        k.apply(Storage(5, Type.ComplexDouble), 1)
+    with pytest.raises(Error):
+        linalg.Expm(as_view(np.eye(3)[:2]))
+    with pytest.raises(Error):
+        linalg.Expm(as_view(np.eye(3, dtype=np.float32)))
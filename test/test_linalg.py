@@ -0,0 +1,299 @@
+import json
+
+import numpy as np
+import pytest
+
+from conftest import as_view, random_array
+from cytnx_core import Error, Storage, StorageView, Type, counters, linalg, trace
+
+DTYPES = [
+    (np.float64, 1e-12),
+    (np.float32, 1e-4),
+    (np.complex128, 1e-12),
+    (np.complex64, 1e-4),
+]
+
+
+def span_names():
+    events = json.loads(trace.chrome_json())["traceEvents"]
+    return {e["name"] for e in events if e["ph"] == "X"}
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_matmul_of_views(np_dtype, rtol):
+    ra = random_array((7, 5), np_dtype, 0)
+    a = as_view(ra)
+    rb = random_array((5, 6), np_dtype, 1)
+    b = as_view(rb)
+    rx = random_array((6, 5), np_dtype, 2)
+    x = as_view(rx)
+    cases = [
+        (a, b, ra @ rb),
+        (x.transpose(0, 1).conj(), b, rx.T.conj() @ rb),
+        (a, x.transpose(0, 1), ra @ rx.T),
+        (a.conj(), b.conj(), ra.conj() @ rb.conj()),
+        (a.slice(0, 0, 7, 2), b.slice(1, 1, 6, 2), ra[::2] @ rb[:, 1::2]),
+    ]
+    for lhs, rhs, expect in cases:
+        c = linalg.Matmul(lhs, rhs)
+        assert c.shape == list(expect.shape) and c.is_contiguous()
+        np.testing.assert_allclose(c.numpy(), expect, rtol=rtol, atol=rtol)
+
+    y = linalg.Matvec(x.transpose(0, 1).conj(), b.slice(1, 2, 3).reshape([5]))
+    np.testing.assert_allclose(y.numpy(), rx.T.conj() @ rb[:, 2], rtol=rtol, atol=rtol)
+
+
+def test_matmul_into():
+    ra = random_array((4, 3), np.complex128, 3)
+    a = as_view(ra)
+    rb = random_array((3, 5), np.complex128, 4)
+    b = as_view(rb)
+    rc = random_array((5, 4), np.complex128, 5)
+    c = as_view(rc)
+    # a column-major c, shared with `keep` so the write detaches it
+    keep = c.storage()
+    ct = c.transpose(0, 1)
+    linalg.Matmul(a.conj(), b, ct, alpha=0.5 + 1j, beta=2)
+    expect = (0.5 + 1j) * (ra.conj() @ rb) + 2 * rc.T
+    np.testing.assert_allclose(ct.numpy(), expect, rtol=1e-12)
+    np.testing.assert_array_equal(keep.numpy(), rc.ravel())
+
+
+def test_conj_view():
+    ref = random_array((3, 4), np.complex64, 6)
+    v = as_view(ref)
+    w = v.conj()
+    assert w.is_conj() and not v.is_conj() and not w.conj().is_conj()
+    assert w.storage().same_data(v.storage())
+    np.testing.assert_array_equal(w.numpy(), ref.conj())
+    np.testing.assert_array_equal(w.contiguous().numpy(), ref.conj())
+    assert not w.contiguous().is_conj()
+    r = as_view(random_array((3,), np.float64, 7))
+    assert not r.conj().is_conj()
+
+
+def test_lazy_adjoint_is_not_packed():
+    if not trace.compiled():
+        pytest.skip("tracing is compiled out")
+    rx = random_array((64, 32), np.complex128, 8)
+    x = as_view(rx)
+    rb = random_array((64, 16), np.complex128, 9)
+    b = as_view(rb)
+    trace.clear()
+    trace.enable()
+    try:
+        c = linalg.Matmul(x.transpose(0, 1).conj(), b)
+        linalg.Matvec(x.transpose(0, 1).conj(), b.slice(1, 0, 1).reshape([64]))
+    finally:
+        trace.disable()
+    names = span_names()
+    trace.clear()
+    assert "linalg.matmul" in names
+    assert "view.copy_packed" not in names and "linalg.pack_operand" not in names
+    np.testing.assert_allclose(c.numpy(), rx.T.conj() @ rb, rtol=1e-12)
+
+
+def hermitian_view(n, np_dtype, seed):
+    ra = random_array((n, n), np_dtype, seed)
+    a = as_view(ra)
+    # only the lower triangle is read: the upper one is left random
+    h = np.tril(ra) + np.tril(ra, -1).conj().T
+    if np.issubdtype(np_dtype, np.complexfloating):
+        h[np.diag_indices(n)] = h.diagonal().real
+    return a, h
+
+
+def check_eigenpairs(h, e, v, expect, rtol):
+    scale = np.abs(expect).max(initial=1)
+    np.testing.assert_allclose(e, expect, atol=rtol * scale)
+    np.testing.assert_allclose(h @ v, v * e, atol=10 * rtol * scale)
+    np.testing.assert_allclose(
+        v.conj().T @ v, np.eye(len(e)), atol=10 * rtol * max(1, len(h) / 10)
+    )
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_eigh(np_dtype, rtol):
+    n = 40
+    a, h = hermitian_view(n, np_dtype, 13)
+    before = a.numpy().copy()
+    expect = np.linalg.eigvalsh(h.astype(np.complex128))
+    e, v = linalg.Eigh(a)
+    assert e.shape == [n] and v.shape == [n, n]
+    assert e.numpy().dtype == np.finfo(np_dtype).dtype
+    check_eigenpairs(h, e.numpy(), v.numpy(), expect, rtol)
+
+    (w,) = linalg.Eigh(a, is_V=False)
+    np.testing.assert_allclose(w.numpy(), e.numpy(), atol=rtol * 10)
+    _, vr = linalg.Eigh(a, row_v=True)
+    np.testing.assert_allclose(vr.numpy(), v.numpy().T, atol=rtol)
+
+    # the input is left intact, and a conjugated view is read as such
+    np.testing.assert_array_equal(a.numpy(), before)
+    et, vt = linalg.Eigh(as_view(h).conj())
+    check_eigenpairs(h.conj(), et.numpy(), vt.numpy(), expect, rtol)
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_eigh_subsets(np_dtype, rtol):
+    n = 60
+    a, h = hermitian_view(n, np_dtype, 14)
+    expect = np.linalg.eigvalsh(h.astype(np.complex128))
+    # a few eigenpairs (MRRR), most of them (divide and conquer), and none
+    for il, iu in [(0, 1), (5, 12), (3, 57), (10, 10)]:
+        e, v = linalg.EighIndex(a, il, iu)
+        assert e.shape == [iu - il] and v.shape == [n, iu - il]
+        check_eigenpairs(h, e.numpy(), v.numpy(), expect[il:iu], rtol)
+        (w,) = linalg.EighIndex(a, il, iu, is_V=False)
+        np.testing.assert_allclose(w.numpy(), e.numpy(), atol=rtol * 10)
+
+    vl, vu = -2.5, 1.5
+    inside = expect[(expect > vl) & (expect <= vu)]
+    e, v = linalg.EighInterval(a, vl, vu, row_v=True)
+    assert v.shape == [len(inside), n]
+    check_eigenpairs(h, e.numpy(), v.numpy().T, inside, rtol)
+    (w,) = linalg.EighInterval(a, vl, vu, is_V=False)
+    np.testing.assert_allclose(w.numpy(), inside, atol=rtol * 10)
+
+
+def test_eigh_driver_selection():
+    a, h = hermitian_view(100, np.float64, 15)
+    counters.reset()
+    counters.enable()
+    try:
+        calls = {}
+        for name, fn in [
+            ("all", lambda: linalg.Eigh(a)),
+            ("few", lambda: linalg.EighIndex(a, 0, 10)),
+            ("most", lambda: linalg.EighIndex(a, 0, 50)),
+            ("values", lambda: linalg.EighIndex(a, 0, 10, is_V=False)),
+            ("interval", lambda: linalg.EighInterval(a, -1, 1)),
+        ]:
+            counters.reset()
+            fn()
+            calls[name] = {e.routine for e in counters.entries()}
+    finally:
+        counters.disable()
+        counters.reset()
+    assert calls["all"] == {"syevd"} and calls["most"] == {"syevd"}
+    assert calls["values"] == {"syevd"}
+    assert calls["few"] == {"syevr"} and calls["interval"] == {"syevr"}
+
+
+def test_eigh_invalid():
+    a = as_view(random_array((3, 4), np.float64, 16))
+    with pytest.raises(Error):
+        linalg.Eigh(a)
+    s = as_view(random_array((4, 4), np.float64, 17))
+    with pytest.raises(Error):
+        linalg.EighIndex(s, 3, 2)
+    with pytest.raises(Error):
+        linalg.EighIndex(s, 0, 5)
+    with pytest.raises(Error):
+        linalg.EighInterval(s, 1, 1)
+    with pytest.raises(Error):
+        linalg.Eigh(StorageView(Storage(16, Type.Int64), [4, 4]))
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_svd(np_dtype, rtol):
+    for shape in [(9, 4), (4, 9), (6, 6)]:
+        ra = random_array(shape, np_dtype, 18)
+        a = as_view(ra)
+        before = a.numpy().copy()
+        s, u, vt = linalg.Svd(a)
+        k = min(shape)
+        assert s.shape == [k] and u.shape == [shape[0], k]
+        assert vt.shape == [k, shape[1]]
+        assert s.numpy().dtype == np.finfo(np_dtype).dtype
+        np.testing.assert_allclose(
+            s.numpy(), np.linalg.svd(ra, compute_uv=False), atol=10 * rtol
+        )
+        us = u.numpy() * s.numpy()
+        np.testing.assert_allclose(us @ vt.numpy(), ra, atol=10 * rtol)
+        uu = u.numpy().conj().T @ u.numpy()
+        np.testing.assert_allclose(uu, np.eye(k), atol=10 * rtol)
+        np.testing.assert_array_equal(a.numpy(), before)
+        (w,) = linalg.Svd(a, is_UvT=False)
+        np.testing.assert_allclose(w.numpy(), s.numpy(), atol=10 * rtol)
+    # a conjugated, transposed view
+    s, u, vt = linalg.Svd(a.transpose(0, 1).conj())
+    us = u.numpy() * s.numpy()
+    np.testing.assert_allclose(us @ vt.numpy(), ra.conj().T, atol=10 * rtol)
+
+
+def uneven_blocks(np_dtype, seed):
+    # the charge sectors of a symmetric tensor: a few large blocks among many small ones
+    shapes = [(60, 50), (1, 1), (3, 5), (0, 4), (25, 25), (8, 2), (2, 7), (40, 12)]
+    return [random_array(shape, np_dtype, seed + i) for i, shape in enumerate(shapes)]
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_block_svd(np_dtype, rtol):
+    blocks = uneven_blocks(np_dtype, 19)
+    views = [as_view(b) for b in blocks]
+    out = linalg.BlockSvd(views)
+    assert len(out) == len(blocks)
+    for (s, u, vt), rb in zip(out, blocks):
+        us = u.numpy() * s.numpy()
+        np.testing.assert_allclose(us @ vt.numpy(), rb, atol=10 * rtol)
+
+    values = np.sort(np.concatenate([s.numpy() for s, _, _ in out]))[::-1]
+    for keepdim in [0, 1, 7, 30, len(values) + 5]:
+        kept = linalg.BlockSvdTruncate(views, keepdim)
+        total = sum(s.shape[0] for s, _, _ in kept)
+        assert total == min(keepdim, len(values))
+        for (s, u, vt), (full, _, _) in zip(kept, out):
+            k = s.shape[0]
+            assert u.shape[1] == k and vt.shape[0] == k
+            # the leading values of each block, and all above those dropped anywhere
+            np.testing.assert_array_equal(s.numpy(), full.numpy()[:k])
+            if total:
+                assert np.all(s.numpy() >= values[total - 1])
+    # err drops the values at or below err times the largest
+    kept = linalg.BlockSvdTruncate(views, 1000, err=0.3, is_UvT=False)
+    assert all(len(r) == 1 for r in kept)
+    total = sum(r[0].shape[0] for r in kept)
+    assert total == np.count_nonzero(values > 0.3 * values[0])
+
+
+def test_block_eigh():
+    blocks = [hermitian_view(n, np.complex128, 20 + n) for n in [30, 1, 4, 0, 12]]
+    out = linalg.BlockEigh([a for a, _ in blocks])
+    for (e, v), (_, h) in zip(out, blocks):
+        check_eigenpairs(h, e.numpy(), v.numpy(), np.linalg.eigvalsh(h), 1e-12)
+    values = linalg.BlockEigh([a for a, _ in blocks], is_V=False)
+    for (w,), (e, _) in zip(values, out):
+        np.testing.assert_allclose(w.numpy(), e.numpy(), atol=1e-12)
+    assert linalg.BlockSvd([]) == []
+
+
+def test_block_invalid():
+    a = as_view(random_array((3, 3), np.float64, 21))
+    f = as_view(random_array((3, 3), np.float32, 22))
+    r = as_view(random_array((3, 4), np.float64, 23))
+    with pytest.raises(Error):
+        linalg.BlockSvd([a, f])
+    with pytest.raises(Error):
+        linalg.BlockEigh([a, r])
+    with pytest.raises(Error):
+        linalg.BlockSvd([a, StorageView(Storage(9, Type.Int64), [9])])
+    with pytest.raises(Error):
+        linalg.BlockSvdTruncate([a], 2, err=-1)
+    with pytest.raises(Error):
+        linalg.Svd(StorageView(Storage(9, Type.Int64), [3, 3]))
+
+
+def test_invalid():
+    a = as_view(random_array((2, 3), np.float64, 10))
+    b = as_view(random_array((2, 3), np.float64, 11))
+    f = as_view(random_array((3, 2), np.float32, 12))
+    with pytest.raises(Error):
+        linalg.Matmul(a, b)
+    with pytest.raises(Error):
+        linalg.Matmul(a, f)
+    with pytest.raises(Error):
+        c = StorageView(Storage(4, Type.Double), [2, 2])
+        linalg.Matmul(a, b.transpose(0, 1), c, alpha=1j)
+    with pytest.raises(Error):
+        linalg.Matvec(a, a)
@@ -0,0 +1,183 @@
+import json
+
+import numpy as np
+import pytest
+
+from conftest import as_view, random_array
+from cytnx_core import (
+    CooMatrix,
+    DenseLinOp,
+    Error,
+    LinOp,
+    SparseLinOp,
+    SparseSymmetry,
+    Storage,
+    StorageView,
+    Type,
+    trace,
+)
+
+
+def test_callback_in_place():
+    a = random_array((20, 20), np.float64, 0)
+    shapes = []
+
+    def apply(x, y):
+        shapes.append(x.shape)
+        assert not x.flags.writeable and y.flags.writeable
+        y[...] = a @ x
+
+    op = LinOp(apply, 20)
+    assert op.nx() == 20 and op.dtype == Type.Double
+
+    x = np.arange(20.0)
+    np.testing.assert_allclose(op.matvec(Storage.from_numpy(x)).numpy(), a @ x)
+
+    xs = random_array((20, 5), np.float64, 1)
+    np.testing.assert_allclose(op.matmat(as_view(xs)).numpy(), a @ xs)
+    # one Python call for the whole block
+    assert shapes == [(20,), (20, 5)]
+
+
+def test_callback_returns():
+    a = random_array((8, 8), np.complex128, 2)
+    op = LinOp(lambda x, y: a @ x, 8, Type.ComplexDouble)
+    xs = random_array((8, 3), np.complex128, 3)
+    np.testing.assert_allclose(op.matmat(as_view(xs)).numpy(), a @ xs)
+
+    y = StorageView(Storage(24, Type.ComplexDouble), [8, 3])
+    op.matmat(as_view(xs), y)
+    np.testing.assert_allclose(y.numpy(), a @ xs)
+
+    bad = LinOp(lambda x, y: np.zeros(3), 8, Type.ComplexDouble)
+    with pytest.raises(Error):
+        bad.matvec(Storage(8, Type.ComplexDouble))
+
+
+def test_callback_zero_copy():
+    xs = Storage.from_numpy(np.arange(6.0))
+    seen = []
+
+    def apply(x, y):
+        seen.append(x.ctypes.data)
+        y[...] = 2 * x
+
+    y = Storage(6)
+    LinOp(apply, 6).matvec(xs, y)
+    assert seen == [np.asarray(xs).ctypes.data]
+    np.testing.assert_array_equal(y.numpy(), 2 * np.arange(6.0))
+
+
+def test_callback_transposed_block():
+    # a strided block reaches the callable as a contiguous (nx, k) array
+    xs = random_array((4, 10), np.float64, 4)
+    t = as_view(xs).transpose(0, 1)
+    op = LinOp(lambda x, y: 3 * x, 10)
+    np.testing.assert_allclose(op.matmat(t).numpy(), 3 * xs.T)
+
+
+def test_callback_error_propagates():
+    def apply(x, y):
+        raise ValueError("boom")
+
+    with pytest.raises(ValueError):
+        LinOp(apply, 4).matvec(Storage(4))
+
+
+@pytest.mark.parametrize(
+    "np_dtype, dtype, rtol",
+    [
+        (np.float64, Type.Double, 1e-12),
+        (np.float32, Type.Float, 1e-4),
+        (np.complex128, Type.ComplexDouble, 1e-12),
+        (np.complex64, Type.ComplexFloat, 1e-4),
+    ],
+)
+def test_dense_linop(np_dtype, dtype, rtol):
+    a = random_array((30, 30), np_dtype, 5)
+    op = DenseLinOp(as_view(a))
+    assert op.nx() == 30 and op.dtype == dtype
+
+    x = random_array(30, np_dtype, 6)
+    np.testing.assert_allclose(
+        op.matvec(Storage.from_numpy(x)).numpy(), a @ x, rtol=rtol, atol=rtol
+    )
+    xs = random_array((30, 4), np_dtype, 7)
+    np.testing.assert_allclose(
+        op.matmat(as_view(xs)).numpy(), a @ xs, rtol=rtol, atol=rtol
+    )
+
+    # the adjoint of a view goes to gemm without a copy
+    adj = DenseLinOp(as_view(a).transpose(0, 1).conj())
+    np.testing.assert_allclose(
+        adj.matmat(as_view(xs)).numpy(), a.conj().T @ xs, rtol=rtol, atol=rtol
+    )
+
+
+@pytest.mark.skipif(not trace.compiled(), reason="tracing is compiled out")
+def test_dense_matvec_in_place():
+    # a solver applies the operator every iteration: gemv writes y, nothing is allocated
+    a = random_array((16, 16), np.float64, 9)
+    op = DenseLinOp(as_view(a))
+    x = random_array(16, np.float64, 10)
+    xs, y = Storage.from_numpy(x), Storage(16)
+    trace.clear()
+    trace.enable()
+    try:
+        op.matvec(xs, y)
+    finally:
+        trace.disable()
+    events = json.loads(trace.chrome_json())["traceEvents"]
+    trace.clear()
+    names = [e["name"] for e in events if e["ph"] == "X"]
+    assert "linalg.matvec" in names
+    assert not any(name.startswith("alloc.") for name in names)
+    np.testing.assert_allclose(y.numpy(), a @ x, rtol=1e-12)
+
+
+def test_sparse_linop():
+    rng = np.random.default_rng(8)
+    rows, cols = rng.integers(0, 50, 300), rng.integers(0, 50, 300)
+    values = rng.standard_normal(300)
+    coo = CooMatrix(50, 50, rows.tolist(), cols.tolist(), Storage.from_numpy(values))
+    csr = coo.to_csr()
+    dense = np.zeros((50, 50))
+    np.add.at(dense, (rows, cols), values)
+
+    op = SparseLinOp(csr)
+    x = rng.standard_normal(50)
+    np.testing.assert_allclose(op.matvec(Storage.from_numpy(x)).numpy(), dense @ x)
+    xs = rng.standard_normal((50, 6))
+    np.testing.assert_allclose(op.matmat(as_view(xs)).numpy(), dense @ xs)
+
+    keep = cols >= rows
+    upper_values = Storage.from_numpy(values[keep])
+    sym = CooMatrix(
+        50, 50, rows[keep].tolist(), cols[keep].tolist(), upper_values
+    ).to_csr(SparseSymmetry.Symmetric)
+    upper = np.triu(dense)
+    full = upper + np.triu(upper, 1).T
+    np.testing.assert_allclose(
+        SparseLinOp(sym).matmat(as_view(xs)).numpy(), full @ xs
+    )
+
+
+def test_errors():
+    op = LinOp(lambda x, y: x, 4)
+    with pytest.raises(Error):
+        op.matvec(Storage(5))
+    with pytest.raises(Error):
+        op.matvec(Storage(4, Type.Float))
+    s = Storage(4)
+    with pytest.raises(Error):
+        op.matvec(s, s)
+    with pytest.raises(Error):
+        op.matmat(StorageView(Storage(8), [2, 4]))
+    with pytest.raises(Error):
+        op.matmat(StorageView(Storage(8), [4, 2]), StorageView(Storage(8), [2, 4]))
+    with pytest.raises(Error):
+        DenseLinOp(StorageView(Storage(6), [2, 3]))
+    with pytest.raises(Error):
+        SparseLinOp(CooMatrix(2, 3, [0], [0], Storage(1)).to_csr())
+    with pytest.raises(Error):
+        LinOp(lambda x, y: x, 4, Type.BFloat16)
@@ -0,0 +1,58 @@
+import pytest
+
+from cytnx_core import Storage, Type, perf
+
+
+@pytest.fixture
+def profiling():
+    perf.reset()
+    perf.enable()
+    yield
+    perf.disable()
+    perf.reset()
+
+
+def test_toggle():
+    perf.enable()
+    assert perf.enabled()
+    perf.disable()
+    assert not perf.enabled()
+
+
+def test_status():
+    events = perf.events()
+    assert "cycles" in events and "dtlb_misses" in events
+    assert perf.available() == any(events.values())
+    if all(events.values()):
+        assert perf.status() == "ok"
+    else:
+        assert "missing events" in perf.status()
+
+
+def test_regions(profiling):
+    s = Storage(100000, Type.Double)
+    s.fill(2.0)
+    with perf.scope("test.block"):
+        s.fill(3.0)
+    perf.disable()
+
+    regions = {r.name: r for r in perf.regions()}
+    assert regions["kernel.fill"].calls == 2
+    assert regions["test.block"].calls == 1
+    assert regions["test.block"].seconds >= 0
+    # events that cannot be counted here are left out rather than reported as zero
+    available = {name for name, ok in perf.events().items() if ok}
+    assert set(regions["kernel.fill"].counts) <= available
+    if regions["kernel.fill"].ipc is not None:
+        assert regions["kernel.fill"].ipc > 0
+
+    assert "kernel.fill" in perf.report()
+    perf.reset()
+    assert perf.regions() == []
+
+
+def test_disabled():
+    perf.reset()
+    perf.disable()
+    Storage(1000, Type.Double).fill(1.0)
+    assert perf.regions() == []
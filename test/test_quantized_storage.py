@@ -0,0 +1,73 @@
+import numpy as np
+import pytest
+
+from cytnx_core import CheckError, QuantizedStorage, Storage, Type
+
+
+@pytest.mark.parametrize("bits, qmax", [(8, 127), (4, 7)])
+def test_roundtrip(bits, qmax):
+    rng = np.random.default_rng(0)
+    values = rng.standard_normal(1001)
+    q = QuantizedStorage.quantize(Storage.from_numpy(values), bits=bits, block_size=32)
+    assert q.dtype == Type.Double and q.size() == 1001 and q.bits == bits
+
+    back = q.dequantize()
+    assert back.dtype == Type.Double
+    scales = q.scales().numpy()
+    assert scales.size == 32  # ceil(1001 / 32)
+    # each value is within half a quantization step of its block
+    err = np.abs(back.numpy() - values)
+    assert np.all(err <= 0.5001 * np.repeat(scales, 32)[:1001])
+
+    assert q.error.max_abs == pytest.approx(err.max(), rel=1e-3)
+    rel = np.sqrt(np.sum(err**2) / np.sum(values**2))
+    assert q.error.rel_rms == pytest.approx(rel, rel=1e-3)
+    assert q.error.max_value == pytest.approx(np.abs(values).max(), rel=1e-6)
+
+
+def test_compression():
+    s = Storage(1 << 12, Type.Double)
+    q8 = QuantizedStorage.quantize(s, bits=8)
+    q4 = QuantizedStorage.quantize(s, bits=4)
+    assert q8.nbytes() == (1 << 12) + 4 * (1 << 12) // 64
+    assert q4.nbytes() == (1 << 11) + 4 * (1 << 12) // 64
+    assert q8.compression_ratio() > 7 and q4.compression_ratio() > 14
+    assert q8.error.rel_rms == 0
+
+
+def test_subnormal_block():
+    # amax / 127 underflows to 0 for a subnormal amax
+    values = np.zeros(64, dtype=np.float32)
+    values[3] = 1e-44
+    back = QuantizedStorage.quantize(Storage.from_numpy(values)).dequantize().numpy()
+    assert np.all(np.isfinite(back)) and np.all(np.abs(back) <= 1e-44)
+
+
+@pytest.mark.parametrize("bad", [np.nan, np.inf, -np.inf, 1e300])
+def test_non_finite(bad):
+    # no finite scale codes a NaN or an inf, nor a double overflowing to one as a float
+    values = np.sin(np.arange(200.0))
+    values[130] = bad
+    with pytest.raises(CheckError, match="NaN, inf"):
+        QuantizedStorage.quantize(Storage.from_numpy(values))
+    with np.errstate(over="ignore"):
+        single = values.astype(np.float32)
+    with pytest.raises(CheckError, match="NaN, inf"):
+        QuantizedStorage.quantize(Storage.from_numpy(single), bits=4)
+
+
+def test_complex():
+    values = np.exp(1j * np.linspace(0, 6, 100)).astype(np.complex64)
+    q = QuantizedStorage.quantize(Storage.from_numpy(values))
+    back = q.dequantize().numpy()
+    assert back.dtype == np.complex64
+    assert np.allclose(back, values, atol=1 / 127)
+
+
+def test_invalid():
+    with pytest.raises(RuntimeError):
+        QuantizedStorage.quantize(Storage(4, Type.Int32))
+    with pytest.raises(RuntimeError):
+        QuantizedStorage.quantize(Storage(4, Type.Double), bits=2)
+    with pytest.raises(RuntimeError):
+        QuantizedStorage.quantize(Storage(4, Type.Double), bits=4, block_size=3)
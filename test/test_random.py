@@ -0,0 +1,94 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Error, Storage, Type, random
+
+# Philox4x32-10 of counter 0 under key 0 (Random123 known answer)
+PHILOX_ZERO = [0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8]
+
+FLOAT_DTYPES = [
+    (Type.Double, np.float64),
+    (Type.Float, np.float32),
+    (Type.ComplexDouble, np.complex128),
+    (Type.ComplexFloat, np.complex64),
+    (Type.Half, np.float16),
+]
+
+
+def test_known_answer():
+    s = random.uniform(2, seed=0)
+    words = [
+        (PHILOX_ZERO[0] << 32) | PHILOX_ZERO[1],
+        (PHILOX_ZERO[2] << 32) | PHILOX_ZERO[3],
+    ]
+    np.testing.assert_array_equal(s.numpy(), [(w >> 11) * 2.0**-53 for w in words])
+
+    f = random.uniform(4, dtype=Type.Float, seed=0)
+    np.testing.assert_array_equal(f.numpy(), [(w >> 8) * 2.0**-24 for w in PHILOX_ZERO])
+
+
+@pytest.mark.parametrize("dtype, np_dtype", FLOAT_DTYPES)
+def test_reproducible(dtype, np_dtype):
+    a = random.normal(10001, dtype=dtype, seed=42)
+    b = random.normal(10001, dtype=dtype, seed=42)
+    assert a.numpy().dtype == np_dtype
+    np.testing.assert_array_equal(a.numpy(), b.numpy())
+    c = random.normal(10001, dtype=dtype, seed=43)
+    assert not np.array_equal(a.numpy(), c.numpy())
+
+
+@pytest.mark.parametrize("dtype, np_dtype", FLOAT_DTYPES)
+def test_offset_pieces(dtype, np_dtype):
+    # a buffer filled in pieces at matching offsets equals one filled at once
+    n = 100003
+    whole = random.uniform(n, -1, 2, dtype=dtype, seed=7, offset=5)
+    parts = [
+        random.uniform(m, -1, 2, dtype=dtype, seed=7, offset=5 + start)
+        for start, m in [(0, 3), (3, 60000), (60003, n - 60003)]
+    ]
+    np.testing.assert_array_equal(
+        whole.numpy(), np.concatenate([p.numpy() for p in parts])
+    )
+
+
+def test_complex_interleaves_real():
+    z = random.normal(1000, dtype=Type.ComplexDouble, seed=3, offset=10)
+    x = random.normal(2000, dtype=Type.Double, seed=3, offset=20)
+    np.testing.assert_array_equal(z.numpy().view(np.float64), x.numpy())
+
+
+def test_statistics():
+    n = 1 << 20
+    u = random.uniform(n, -2, 3, seed=1).numpy()
+    assert u.min() >= -2 and u.max() < 3
+    assert abs(u.mean() - 0.5) < 0.01 and abs(u.var() - 25 / 12) < 0.02
+
+    x = random.normal(n, 1, 2, dtype=Type.Float, seed=2).numpy()
+    assert abs(x.mean() - 1) < 0.01 and abs(x.std() - 2) < 0.01
+
+    z = random.normal(n, dtype=Type.ComplexDouble, seed=4).numpy()
+    assert abs(z.real.std() - 1) < 0.01 and abs(z.imag.std() - 1) < 0.01
+    assert abs(np.corrcoef(z.real, z.imag)[0, 1]) < 0.01
+
+
+def test_in_place():
+    s = Storage(1000, Type.Float)
+    random.normal_(s, 0, 1, seed=5)
+    np.testing.assert_array_equal(
+        s.numpy(), random.normal(1000, dtype=Type.Float, seed=5).numpy()
+    )
+    random.uniform_(s, 4, 5, seed=5)
+    assert s.numpy().min() >= 4
+    # no seed draws a fresh one each call
+    assert not np.array_equal(random.uniform(100).numpy(), random.uniform(100).numpy())
+
+
+def test_errors():
+    with pytest.raises(Error):
+        random.uniform_(Storage(4, Type.Int64))
+    with pytest.raises(Error):
+        random.normal_(Storage(4, Type.Bool))
+    with pytest.raises(Error):
+        random.uniform(4, 1, 0)
+    with pytest.raises(Error):
+        random.normal(4, 0, -1)
@@ -0,0 +1,141 @@
+import numpy as np
+import pytest
+
+from conftest import as_view, random_array
+from cytnx_core import (
+    CooMatrix,
+    CsrMatrix,
+    Error,
+    SparseSymmetry,
+    Storage,
+    Type,
+)
+
+DTYPES = [
+    (np.float64, 1e-12),
+    (np.float32, 1e-4),
+    (np.complex128, 1e-12),
+    (np.complex64, 1e-4),
+]
+
+
+def random_coo(nrows, ncols, nnz, np_dtype, seed):
+    rng = np.random.default_rng(seed)
+    rows = rng.integers(0, nrows, nnz)
+    cols = rng.integers(0, ncols, nnz)
+    # repeated triplets are summed
+    rows = np.concatenate([rows, rows[:10]])
+    cols = np.concatenate([cols, cols[:10]])
+    values = random_array(len(rows), np_dtype, rng)
+    return rows, cols, values
+
+
+@pytest.mark.parametrize("np_dtype, rtol", DTYPES)
+def test_general(np_dtype, rtol):
+    rows, cols, values = random_coo(40, 30, 300, np_dtype, 0)
+    coo = CooMatrix(40, 30, rows.tolist(), cols.tolist(), Storage.from_numpy(values))
+    assert coo.nnz() == 310
+    a = coo.to_csr()
+    dense = np.zeros((40, 30), np_dtype)
+    np.add.at(dense, (rows, cols), values)
+    assert a.symmetry == SparseSymmetry.General
+    assert a.nnz() == np.count_nonzero(dense)
+    assert a.indptr[0] == 0 and a.indptr[-1] == a.nnz()
+    np.testing.assert_allclose(a.to_dense().numpy().reshape(40, 30), dense, rtol=rtol)
+
+    rng = np.random.default_rng(1)
+    x = random_array(30, np_dtype, rng)
+    np.testing.assert_allclose(
+        a.matvec(Storage.from_numpy(x)).numpy(), dense @ x, rtol=rtol, atol=rtol
+    )
+    y = Storage(40, coo.dtype)
+    a.matvec(Storage.from_numpy(x), y)
+    np.testing.assert_allclose(y.numpy(), dense @ x, rtol=rtol, atol=rtol)
+
+    xs = random_array((30, 3), np_dtype, rng)
+    block = as_view(xs)
+    np.testing.assert_allclose(
+        a.matmat(block).numpy(), dense @ xs, rtol=rtol, atol=rtol
+    )
+    # a strided, transposed block is packed first
+    t = as_view(xs.T).transpose(0, 1)
+    np.testing.assert_allclose(a.matmat(t).numpy(), dense @ xs, rtol=rtol, atol=rtol)
+
+
+@pytest.mark.parametrize(
+    "np_dtype, symmetry",
+    [
+        (np.float64, SparseSymmetry.Symmetric),
+        (np.complex128, SparseSymmetry.Symmetric),
+        (np.complex128, SparseSymmetry.Hermitian),
+        (np.complex64, SparseSymmetry.Hermitian),
+    ],
+)
+def test_half_storage(np_dtype, symmetry):
+    rows, cols, values = random_coo(50, 50, 400, np_dtype, 2)
+    # only the upper triangle is given
+    keep = cols >= rows
+    rows, cols, values = rows[keep], cols[keep], values[keep]
+    coo = CooMatrix(50, 50, rows.tolist(), cols.tolist(), Storage.from_numpy(values))
+    a = coo.to_csr(symmetry)
+    upper = np.zeros((50, 50), np_dtype)
+    np.add.at(upper, (rows, cols), values)
+    lower = np.triu(upper, 1).T
+    if symmetry == SparseSymmetry.Hermitian:
+        lower = lower.conj()
+    dense = upper + lower
+    assert a.nnz() == np.count_nonzero(upper)
+    rtol = 1e-4 if np_dtype == np.complex64 else 1e-12
+    np.testing.assert_allclose(
+        a.to_dense().numpy().reshape(50, 50), dense, rtol=rtol, atol=rtol
+    )
+
+    x = random_array(50, np_dtype, 3)
+    np.testing.assert_allclose(
+        a.matvec(Storage.from_numpy(x)).numpy(), dense @ x, rtol=rtol, atol=rtol
+    )
+    xs = random_array((50, 2), np_dtype, 4)
+    block = as_view(xs)
+    np.testing.assert_allclose(
+        a.matmat(block).numpy(), dense @ xs, rtol=rtol, atol=rtol
+    )
+
+
+def test_csr_arrays():
+    # [[1, 0, 2], [0, 0, 0], [0, 3, 0]]
+    values = Storage.from_numpy(np.array([1.0, 2, 3]))
+    a = CsrMatrix(3, 3, [0, 2, 2, 3], [0, 2, 1], values)
+    assert a.nrows == 3 and a.ncols == 3 and a.dtype == Type.Double
+    assert a.row_blocks()[0] == 0 and a.row_blocks()[-1] == 3
+    np.testing.assert_array_equal(
+        a.matvec(Storage.from_numpy(np.array([1.0, 10, 100]))).numpy(), [201, 0, 30]
+    )
+    empty = CooMatrix(4, 4, [], [], Storage(0, Type.Float)).to_csr()
+    assert empty.nnz() == 0 and empty.indptr == [0] * 5
+    np.testing.assert_array_equal(empty.matvec(Storage(4, Type.Float)).numpy(), 0)
+
+
+def test_invalid():
+    values = Storage.from_numpy(np.array([1.0, 2.0]))
+    with pytest.raises(Error):
+        CooMatrix(2, 2, [0, 2], [0, 1], values)
+    with pytest.raises(Error):
+        CooMatrix(2, 2, [0], [0, 1], values)
+    with pytest.raises(Error):
+        CooMatrix(2, 2, [0, 1], [0, 1], Storage(2, Type.Int64))
+    with pytest.raises(Error):
+        CooMatrix(2, 3, [0, 1], [0, 1], values).to_csr(SparseSymmetry.Symmetric)
+    # a triplet below the diagonal is neither dropped nor mirrored
+    for symmetry in (SparseSymmetry.Symmetric, SparseSymmetry.Hermitian):
+        with pytest.raises(Error):
+            CooMatrix(2, 2, [0, 1], [1, 0], values).to_csr(symmetry)
+    with pytest.raises(Error):
+        CsrMatrix(2, 2, [0, 1, 2], [1, 0], values, SparseSymmetry.Symmetric)
+    with pytest.raises(Error):
+        CsrMatrix(2, 2, [0, 2, 1], [0, 1], values)
+    a = CsrMatrix(2, 2, [0, 1, 2], [0, 1], values)
+    x = Storage(2, Type.Double)
+    with pytest.raises(Error):
+        a.matvec(x, x)
+    with pytest.raises(Error):
+        a.matvec(Storage(3, Type.Double))
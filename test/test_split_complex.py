@@ -0,0 +1,65 @@
+import numpy as np
+import pytest
+
+from conftest import random_array
+from cytnx_core import Error, SplitComplexStorage, Storage, Type
+
+
+@pytest.mark.parametrize(
+    "np_dtype, dtype",
+    [(np.complex128, Type.ComplexDouble), (np.complex64, Type.ComplexFloat)],
+)
+def test_roundtrip(np_dtype, dtype):
+    a = random_array(1001, np_dtype, 0)
+    s = SplitComplexStorage.from_interleaved(Storage.from_numpy(a))
+    assert s.dtype == dtype and s.size() == 1001
+    np.testing.assert_array_equal(s.real().numpy(), a.real)
+    np.testing.assert_array_equal(s.imag().numpy(), a.imag)
+    np.testing.assert_array_equal(s.to_interleaved().numpy(), a)
+
+    # into memory the caller holds
+    out = Storage(1001, dtype)
+    s.to_interleaved(out)
+    np.testing.assert_array_equal(out.numpy(), a)
+    s.assign(Storage.from_numpy(np.conj(a)))
+    np.testing.assert_array_equal(s.imag().numpy(), -a.imag)
+
+
+@pytest.mark.parametrize(
+    "np_dtype, rtol", [(np.complex128, 1e-12), (np.complex64, 1e-4)]
+)
+def test_arithmetic(np_dtype, rtol):
+    a = random_array(515, np_dtype, 1)
+    b = random_array(515, np_dtype, 2)
+    sa = SplitComplexStorage.from_interleaved(Storage.from_numpy(a))
+    sb = SplitComplexStorage.from_interleaved(Storage.from_numpy(b))
+    alpha = 0.5 - 2j
+
+    c = sa.clone()
+    c.mul(sb)
+    np.testing.assert_allclose(c.to_interleaved().numpy(), a * b, rtol=rtol)
+    c = sa.clone()
+    c.add(sb)
+    np.testing.assert_allclose(c.to_interleaved().numpy(), a + b, rtol=rtol)
+    c = sa.clone()
+    c.scale(alpha)
+    np.testing.assert_allclose(c.to_interleaved().numpy(), alpha * a, rtol=rtol)
+    c = sa.clone()
+    c.axpy(alpha, sb)
+    np.testing.assert_allclose(c.to_interleaved().numpy(), a + alpha * b, rtol=rtol)
+
+    assert sa.sum() == pytest.approx(a.sum(), rel=rtol)
+    assert sa.vdot(sb) == pytest.approx(np.vdot(a, b), rel=rtol)
+    assert sa.norm() == pytest.approx(np.linalg.norm(a), rel=rtol)
+
+
+def test_invalid():
+    with pytest.raises(Error):
+        SplitComplexStorage(4, Type.Double)
+    with pytest.raises(Error):
+        SplitComplexStorage.from_interleaved(Storage(4, Type.Double))
+    s = SplitComplexStorage(4)
+    with pytest.raises(Error):
+        s.add(SplitComplexStorage(5))
+    with pytest.raises(Error):
+        s.to_interleaved(Storage(4, Type.ComplexFloat))
@@ -0,0 +1,91 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, Type
+
+
+def test_alloc_fill():
+    s = Storage(8, Type.ComplexDouble)
+    assert s.size() == 8 and len(s) == 8
+    assert s.dtype == Type.ComplexDouble
+    assert s.nbytes() == 8 * 16
+    s.fill(1.5 + 2j)
+    assert np.all(s.numpy() == 1.5 + 2j)
+
+
+@pytest.mark.parametrize(
+    "np_dtype, dtype",
+    [
+        (np.complex128, Type.ComplexDouble),
+        (np.complex64, Type.ComplexFloat),
+        (np.float64, Type.Double),
+        (np.float32, Type.Float),
+        (np.int64, Type.Int64),
+        (np.uint64, Type.Uint64),
+        (np.int32, Type.Int32),
+        (np.uint32, Type.Uint32),
+        (np.int16, Type.Int16),
+        (np.uint16, Type.Uint16),
+        (np.bool_, Type.Bool),
+        (np.float16, Type.Half),
+        (np.int8, Type.Int8),
+    ],
+)
+def test_numpy_zero_copy(np_dtype, dtype):
+    arr = np.zeros((3, 4), dtype=np_dtype)
+    s = Storage.from_numpy(arr)
+    assert s.dtype == dtype
+    assert s.size() == 12
+
+    # both directions share the memory
+    view = np.asarray(s)
+    assert view.dtype == np_dtype
+    assert np.shares_memory(view, arr)
+    s.fill(1)
+    assert np.all(arr == 1)
+
+
+def test_numpy_owner_kept_alive():
+    s = Storage(np.arange(5, dtype=np.float64))
+    view = s.numpy()
+    del s
+    assert list(view) == [0.0, 1.0, 2.0, 3.0, 4.0]
+
+
+def test_non_contiguous_rejected():
+    arr = np.zeros((4, 4))[:, ::2]
+    with pytest.raises(RuntimeError):
+        Storage.from_numpy(arr)
+
+
+def test_clone():
+    s = Storage(4, Type.Int32)
+    c = s.clone()
+    assert not c.same_data(s)
+    c.fill(7)
+    assert np.all(s.numpy() == 0)
+
+
+@pytest.mark.parametrize(
+    "dtype, tol",
+    [(Type.Half, 2**-11), (Type.BFloat16, 2**-8)],
+)
+def test_astype_half(dtype, tol):
+    values = np.linspace(-3, 3, 1001, dtype=np.float32)
+    s = Storage.from_numpy(values).astype(dtype)
+    assert s.dtype == dtype and s.nbytes() == 2 * values.size
+    back = s.astype(Type.Float).numpy()
+    assert np.all(np.abs(back - values) <= tol * np.abs(values))
+    assert np.array_equal(s.astype(Type.Double).numpy(), back.astype(np.float64))
+    if dtype == Type.Half:
+        assert np.array_equal(s.numpy(), values.astype(np.float16))
+
+
+def test_astype_complex_half():
+    s = Storage(4, Type.ComplexBFloat16)
+    s.fill(1.5 - 2j)
+    assert np.all(s.astype(Type.ComplexDouble).numpy() == 1.5 - 2j)
+    with pytest.raises(RuntimeError):
+        s.numpy()
+    with pytest.raises(RuntimeError):
+        s.astype(Type.Float)
@@ -0,0 +1,82 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Error, Storage, StorageView, Type
+
+
+def make_view(shape):
+    values = np.arange(np.prod(shape), dtype=np.float64)
+    return StorageView(Storage.from_numpy(values), list(shape)), values.reshape(shape)
+
+
+def test_contiguous_view():
+    v, ref = make_view((2, 3, 4))
+    assert v.shape == [2, 3, 4] and v.strides == [12, 4, 1] and v.offset == 0
+    assert v.is_contiguous() and v.size() == 24 and v.dtype == Type.Double
+    assert v.to_storage().same_data(v.storage())
+    np.testing.assert_array_equal(v.numpy(), ref)
+
+
+def test_views_share_the_buffer():
+    v, ref = make_view((4, 5, 6))
+    w = v.slice(1, 1, 5, 2).permute([2, 0, 1])
+    assert w.storage().same_data(v.storage())
+    assert not w.is_contiguous()
+    assert w.shape == [6, 4, 2] and w.strides == [1, 30, 12] and w.offset == 6
+    np.testing.assert_array_equal(w.numpy(), ref[:, 1:5:2].transpose(2, 0, 1))
+
+    packed = w.contiguous()
+    assert packed.is_contiguous() and not packed.storage().same_data(v.storage())
+    expect = ref[:, 1:5:2].transpose(2, 0, 1).ravel()
+    np.testing.assert_array_equal(packed.storage().numpy(), expect)
+
+
+def test_transpose():
+    v, ref = make_view((37, 53))
+    t = v.transpose(0, 1)
+    np.testing.assert_array_equal(t.to_storage().numpy(), ref.T.ravel())
+
+
+def test_reshape():
+    v, ref = make_view((4, 6))
+    # a contiguous view reshapes in place
+    r = v.reshape([2, 2, 3, 2])
+    assert r.storage().same_data(v.storage())
+    np.testing.assert_array_equal(r.numpy(), ref.reshape(2, 2, 3, 2))
+    # splitting a sliced axis keeps the buffer, merging a transposed one copies
+    s = v.slice(0, 0, 4, 2).reshape([2, 2, 3])
+    assert s.storage().same_data(v.storage())
+    np.testing.assert_array_equal(s.numpy(), ref[::2].reshape(2, 2, 3))
+    t = v.transpose(0, 1).reshape([24])
+    assert not t.storage().same_data(v.storage())
+    np.testing.assert_array_equal(t.numpy(), ref.T.ravel())
+    with pytest.raises(Error):
+        v.reshape([5, 5])
+
+
+def test_copy_on_write():
+    storage = Storage(10, Type.Double)
+    v = StorageView(storage)
+    assert v.is_shared()
+    del storage
+    assert not v.is_shared()
+    w = StorageView(v.storage(), 2, [3], [2])
+    assert w.is_shared() and v.storage().use_count() >= 2
+    # numpy() aliases the shared buffer: writing through it would bypass copy-on-write
+    arr = w.numpy()
+    assert not arr.flags.writeable
+    with pytest.raises(ValueError):
+        arr[0] = 1.0
+
+
+def test_invalid():
+    s = Storage(10)
+    with pytest.raises(Error):
+        StorageView(s, [3, 4])
+    with pytest.raises(Error):
+        StorageView(s, 5, [3], [2])
+    v = StorageView(s, [2, 5])
+    with pytest.raises(Error):
+        v.slice(1, 3, 6)
+    with pytest.raises(Error):
+        v.permute([0, 0])
@@ -0,0 +1,61 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, Type, io
+
+
+def test_roundtrip(tmp_path):
+    path = str(tmp_path / "t.ctf")
+    arr = (np.arange(600) + 1j * np.arange(600)).astype(np.complex128)
+    io.save(path, Storage.from_numpy(arr), [20, 30], chunk_bytes=1024)
+
+    info = io.info(path)
+    assert info.version == io.tensor_file_version
+    assert info.dtype == Type.ComplexDouble
+    assert info.shape == [20, 30]
+    assert info.payload_offset % 64 == 0
+    assert len(info.checksums) == (600 * 16 + 1023) // 1024
+
+    s, shape = io.load(path, verify=True)
+    assert shape == [20, 30]
+    assert np.array_equal(s.numpy(), arr)
+
+
+def test_mapping_is_private(tmp_path):
+    path = str(tmp_path / "t.ctf")
+    src = Storage(100, Type.Float)
+    src.fill(1.0)
+    io.save(path, src)
+    s, _ = io.load(path)
+    s.fill(2.0)
+    t, _ = io.load(path)
+    assert np.all(t.numpy() == 1.0)
+
+
+def test_corruption_detected(tmp_path):
+    path = str(tmp_path / "t.ctf")
+    src = Storage(4096, Type.Int64)
+    io.save(path, src, chunk_bytes=4096)
+    offset = io.info(path).payload_offset
+    with open(path, "r+b") as f:
+        f.seek(offset + 3 * 4096 + 5)
+        f.write(b"\x01")
+    assert io.verify(path) == [3]
+    io.load(path)  # lazy load does not check
+    with pytest.raises(RuntimeError):
+        io.load(path, verify=True)
+
+
+def test_bad_shape(tmp_path):
+    with pytest.raises(RuntimeError):
+        io.save(str(tmp_path / "t.ctf"), Storage(10), [3, 3])
+
+
+def test_async(tmp_path):
+    path = str(tmp_path / "t.ctf")
+    src = Storage(10, Type.Uint16)
+    src.fill(7)
+    io.save_async(path, src).result(timeout=30)
+    s, shape = io.load_async(path, verify=True).result(timeout=30)
+    assert shape == [10]
+    assert np.all(s.numpy() == 7)
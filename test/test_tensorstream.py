@@ -0,0 +1,60 @@
+import numpy as np
+import pytest
+
+from cytnx_core import Storage, Type, io
+
+
+@pytest.mark.parametrize(
+    "shuffle, compress", [(True, True), (False, True), (True, False)]
+)
+def test_roundtrip(tmp_path, shuffle, compress):
+    path = str(tmp_path / "s.cts")
+    arr = np.repeat(np.arange(5000, dtype=np.float64), 20)
+    io.save_stream(
+        path,
+        Storage.from_numpy(arr),
+        [100, 1000],
+        chunk_bytes=8000,
+        shuffle=shuffle,
+        compress=compress,
+    )
+    s, shape = io.load_stream(path)
+    assert shape == [100, 1000]
+    assert np.array_equal(s.numpy(), arr)
+
+
+def test_random_access(tmp_path):
+    path = str(tmp_path / "s.cts")
+    arr = (np.arange(10007) % 13).astype(np.int32)
+    io.save_stream(path, Storage.from_numpy(arr), chunk_bytes=1002)
+
+    r = io.StreamReader(path)
+    assert r.dtype == Type.Int32
+    assert r.chunk_bytes == 1000  # whole elements only
+    assert len(r) == (10007 * 4 + 999) // 1000
+    for i in (0, 7, len(r) - 1):
+        b = r.chunk_begin(i)
+        assert np.array_equal(r.read_chunk(i).numpy(), arr[b : b + r.chunk_size(i)])
+    assert sum(c.stored_bytes for c in r.chunks) < arr.nbytes
+
+
+def test_corruption_detected(tmp_path):
+    path = str(tmp_path / "s.cts")
+    io.save_stream(path, Storage(100000, Type.Double), chunk_bytes=65536)
+    chunk = io.StreamReader(path).chunks[1]
+    with open(path, "r+b") as f:
+        f.seek(chunk.offset + chunk.stored_bytes // 2)
+        f.write(b"\x7f")
+    r = io.StreamReader(path)
+    r.read_chunk(0)
+    with pytest.raises(RuntimeError):
+        r.read_chunk(1)
+
+
+def test_async(tmp_path):
+    path = str(tmp_path / "s.cts")
+    src = Storage(1000, Type.ComplexFloat)
+    src.fill(1 - 2j)
+    io.save_stream_async(path, src).result(timeout=30)
+    s, _ = io.load_stream_async(path).result(timeout=30)
+    assert np.all(s.numpy() == 1 - 2j)
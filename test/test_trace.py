@@ -0,0 +1,72 @@
+import json
+import threading
+
+import pytest
+
+from cytnx_core import Storage, Type, trace
+
+
+@pytest.fixture
+def tracing():
+    trace.clear()
+    trace.enable()
+    yield
+    trace.disable()
+    trace.clear()
+
+
+def test_toggle():
+    trace.enable()
+    assert trace.enabled()
+    trace.disable()
+    assert not trace.enabled()
+
+
+def test_dump(tmp_path, tracing):
+    s = Storage(100000, Type.Double)
+    s.fill(2.0)
+    s.clone()
+    trace.disable()
+
+    path = tmp_path / "trace.json"
+    trace.dump(str(path))
+    events = json.loads(path.read_text())["traceEvents"]
+    spans = [e for e in events if e["ph"] == "X"]
+    if not trace.compiled():
+        assert spans == []
+        return
+    names = {e["name"] for e in spans}
+    assert {"alloc.malloc", "kernel.fill", "storage.clone"} <= names
+    for e in spans:
+        assert e["dur"] >= 0
+        assert e["cat"] == e["name"].split(".")[0]
+    assert trace.num_events() == len(spans)
+
+    trace.clear()
+    assert trace.num_events() == 0
+    assert json.loads(trace.chrome_json())["traceEvents"] is not None
+
+
+@pytest.mark.skipif(not trace.compiled(), reason="tracing is compiled out")
+def test_thread_churn(tracing):
+    def work():
+        Storage(1000, Type.Double).fill(1.0)
+
+    def lanes():
+        events = json.loads(trace.chrome_json())["traceEvents"]
+        return sum(e["ph"] == "M" for e in events)
+
+    work()
+    before = lanes()
+    for _ in range(100):
+        t = threading.Thread(target=work)
+        t.start()
+        t.join()
+    # the buffer of a finished thread is reused by the next one; a thread may still be
+    # releasing its buffer when the next starts, so allow a few more
+    assert lanes() <= before + 4
+    # and the spans of the finished threads are kept
+    events = json.loads(trace.chrome_json())["traceEvents"]
+    spans = [e for e in events if e["ph"] == "X"]
+    assert sum(e["name"] == "kernel.fill" for e in spans) == 101
+    assert trace.num_events() == len(spans)
@@ -14,3 +14,8 @@ def test_type():
     assert isinstance(Type.Double, Type)
     assert isinstance(Type.ComplexFloat, Type)
     assert isinstance(Type.ComplexDouble, Type)
+    assert isinstance(Type.Half, Type)
+    assert isinstance(Type.BFloat16, Type)
+    assert isinstance(Type.ComplexHalf, Type)
+    assert isinstance(Type.ComplexBFloat16, Type)
+    assert isinstance(Type.Int8, Type)